@@ -19,6 +19,7 @@
 #endif
 
 #ifndef QT_NO_DEBUG
+#include "ApduRecorder.h"
 #include "UIPlugInWebSocket.h"
 #endif
 
@@ -62,6 +63,7 @@ CommandLineParser::CommandLineParser()
 	, mOptionPort(QStringLiteral("port"), QStringLiteral("Use listening port."), QStringLiteral("24727"))
 #ifndef QT_NO_DEBUG
 	, mOptionPortWebSocket(QStringLiteral("port-websocket"), QStringLiteral("Use listening port for websocket."), QString::number(UIPlugInWebSocket::WEBSOCKET_DEFAULT_PORT))
+	, mOptionRecordApdu(QStringLiteral("record-apdu"), QStringLiteral("Record APDUs to file."), QStringLiteral("file"))
 #endif
 {
 	addOptions();
@@ -96,6 +98,7 @@ void CommandLineParser::addOptions()
 
 #ifndef QT_NO_DEBUG
 	mParser.addOption(mOptionPortWebSocket);
+	mParser.addOption(mOptionRecordApdu);
 #endif
 }
 
@@ -158,6 +161,11 @@ void CommandLineParser::parse(QCoreApplication* pApp)
 			qCWarning(cmdline) << "Cannot use value as websocket port:" << mParser.value(mOptionPortWebSocket);
 		}
 	}
+
+	if (mParser.isSet(mOptionRecordApdu))
+	{
+		ApduRecorder::getInstance().start(mParser.value(mOptionRecordApdu));
+	}
 #endif
 }
 
@@ -23,6 +23,7 @@ class CommandLineParser
 		const QCommandLineOption mOptionPort;
 #ifndef QT_NO_DEBUG
 		const QCommandLineOption mOptionPortWebSocket;
+		const QCommandLineOption mOptionRecordApdu;
 #endif
 
 		Q_DISABLE_COPY(CommandLineParser)
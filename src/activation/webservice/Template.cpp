@@ -4,9 +4,9 @@
 
 #include "Template.h"
 
-#include <QFileInfo>
+#include <QHash>
 #include <QLoggingCategory>
-#include <QRegularExpression>
+#include <QMutex>
 
 
 using namespace governikus;
@@ -16,8 +16,17 @@ Q_DECLARE_LOGGING_CATEGORY(activation)
 
 Template Template::fromFile(const QString& pTemplateFileName)
 {
+	static QHash<QString, Template> cache;
+	static QMutex mutex;
+
+	const QMutexLocker locker(&mutex);
+	const auto& cached = cache.constFind(pTemplateFileName);
+	if (cached != cache.constEnd())
+	{
+		return cached.value();
+	}
+
 	QFile templateFile(pTemplateFileName);
-	QString fileContent;
 	if (!templateFile.exists())
 	{
 		qCCritical(activation) << "Template file not found" << pTemplateFileName;
@@ -28,26 +37,57 @@ Template Template::fromFile(const QString& pTemplateFileName)
 	}
 	else
 	{
-		fileContent = QString::fromUtf8(templateFile.readAll());
+		return cache.insert(pTemplateFileName, Template(QString::fromUtf8(templateFile.readAll()))).value();
 	}
-	return Template(fileContent);
+	return Template(QString());
 }
 
 
 Template::Template(const QString& pTemplate)
-	: mTemplate(pTemplate)
+	: mSegments()
 	, mKeys()
 	, mContext()
 {
-	const QRegularExpression keyRegEx(QStringLiteral("(\\$\\{(?<key>[^\\$\\{\\}]*)\\})"));
-	auto matches = keyRegEx.globalMatch(mTemplate);
-	while (matches.hasNext())
+	parse(pTemplate);
+}
+
+
+void Template::parse(const QString& pTemplate)
+{
+	static const QString KEY_START = QStringLiteral("${");
+
+	int literalStart = 0;
+	int pos = 0;
+	while ((pos = pTemplate.indexOf(KEY_START, pos)) != -1)
 	{
-		const QString& match = matches.next().captured(QStringLiteral("key"));
-		if (!mKeys.contains(match))
+		// A key is terminated by '}' and must not contain '$', '{' or '}'
+		int keyEnd = pos + KEY_START.size();
+		while (keyEnd < pTemplate.size() && pTemplate.at(keyEnd) != QLatin1Char('$') && pTemplate.at(keyEnd) != QLatin1Char('{') && pTemplate.at(keyEnd) != QLatin1Char('}'))
+		{
+			++keyEnd;
+		}
+
+		if (keyEnd == pTemplate.size() || pTemplate.at(keyEnd) != QLatin1Char('}'))
+		{
+			++pos;
+			continue;
+		}
+
+		if (pos > literalStart)
 		{
-			mKeys += match;
+			mSegments += Segment {pTemplate.mid(literalStart, pos - literalStart), false};
 		}
+
+		const QString& key = pTemplate.mid(pos + KEY_START.size(), keyEnd - pos - KEY_START.size());
+		mSegments += Segment {key, true};
+		mKeys += key;
+
+		literalStart = pos = keyEnd + 1;
+	}
+
+	if (literalStart < pTemplate.size())
+	{
+		mSegments += Segment {pTemplate.mid(literalStart), false};
 	}
 }
 
@@ -76,15 +116,25 @@ bool Template::setContextParameter(const QString& pKey, const QString& pValue)
 
 QString Template::render() const
 {
-	QString output = mTemplate;
 	for (const auto& key : mKeys)
 	{
-		const auto& value = mContext.value(key);
-		if (value.isNull())
+		if (mContext.value(key).isNull())
 		{
 			qCWarning(activation) << "No parameter specified, replace with empty string" << key;
 		}
-		output = output.replace(QStringLiteral("${%1}").arg(key), value);
+	}
+
+	int size = 0;
+	for (const auto& segment : mSegments)
+	{
+		size += segment.mKey ? mContext.value(segment.mText).size() : segment.mText.size();
+	}
+
+	QString output;
+	output.reserve(size);
+	for (const auto& segment : mSegments)
+	{
+		output += segment.mKey ? mContext.value(segment.mText) : segment.mText;
 	}
 	return output;
 }
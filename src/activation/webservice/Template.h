@@ -11,6 +11,7 @@
 #include <QMap>
 #include <QSet>
 #include <QString>
+#include <QVector>
 
 
 namespace governikus
@@ -18,13 +19,26 @@ namespace governikus
 
 class Template
 {
-	QString mTemplate;
+	/*!
+	 * A template is parsed once into literal text and context keys,
+	 * a key segment holds the key name in mText.
+	 */
+	struct Segment
+	{
+		QString mText;
+		bool mKey;
+	};
+
+	QVector<Segment> mSegments;
 	QSet<QString> mKeys;
 	QMap<QString, QString> mContext;
 
+	void parse(const QString& pTemplate);
+
 	public:
 		/*!
-		 * \brief Construct a template from file
+		 * \brief Construct a template from file. The file is read and parsed
+		 * only once, later calls return a copy of the parsed template.
 		 */
 		static Template fromFile(const QString& pTemplateFileName);
 
@@ -50,7 +64,8 @@ class Template
 		/*!
 		 * \brief Renders the template by replacing all contained context
 		 * keys by context values. If for a contained key no value is specified,
-		 * the key is replaced by the empty string.
+		 * the key is replaced by the empty string. The output is allocated once
+		 * and filled in a single pass over the parsed template.
 		 */
 		QString render() const;
 };
@@ -12,6 +12,7 @@
 #include "WebserviceActivationContext.h"
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QFile>
 #include <QLoggingCategory>
 #include <QUrlQuery>
@@ -23,6 +24,7 @@ Q_DECLARE_LOGGING_CATEGORY(activation)
 WebserviceActivationHandler::WebserviceActivationHandler()
 	: ActivationHandler()
 	, mServer()
+	, mResourceCache()
 {
 }
 
@@ -162,24 +164,75 @@ void WebserviceActivationHandler::handleShowUiRequest(UiModule pUiModule, const
 }
 
 
-void WebserviceActivationHandler::handleImageRequest(const QSharedPointer<HttpRequest>& pRequest, const QString& pImagePath)
+const WebserviceActivationHandler::CachedResource* WebserviceActivationHandler::getCachedResource(const QString& pPath)
 {
-	HttpResponse response;
+	const auto& cached = mResourceCache.constFind(pPath);
+	if (cached != mResourceCache.constEnd())
+	{
+		return &cached.value();
+	}
 
-	QFile imageFile(pImagePath);
-	if (imageFile.open(QIODevice::ReadOnly))
+	QFile file(pPath);
+	if (!file.open(QIODevice::ReadOnly))
 	{
-		response.setStatus(HttpStatusCode::OK);
-		response.setBody(imageFile.readAll(), guessImageContentType(pImagePath));
-		imageFile.close();
+		return nullptr;
 	}
-	else
+
+	CachedResource resource;
+	resource.mBody = file.readAll();
+	resource.mContentType = guessImageContentType(pPath);
+	resource.mETag = '"' + QCryptographicHash::hash(resource.mBody, QCryptographicHash::Sha1).toHex() + '"';
+
+	// qCompress prepends the uncompressed size to a zlib stream, which is what HTTP calls deflate.
+	// Only keep it if it pays off, most images are already compressed.
+	const QByteArray& deflated = qCompress(resource.mBody, 9).mid(4);
+	if (deflated.size() < resource.mBody.size() * 9 / 10)
+	{
+		resource.mDeflatedBody = deflated;
+	}
+
+	return &mResourceCache.insert(pPath, resource).value();
+}
+
+
+void WebserviceActivationHandler::handleImageRequest(const QSharedPointer<HttpRequest>& pRequest, const QString& pImagePath)
+{
+	const CachedResource* resource = getCachedResource(pImagePath);
+	if (resource == nullptr)
 	{
 		qCCritical(activation) << "Unknown image file requested" << pImagePath;
-		response.setStatus(HttpStatusCode::NOT_FOUND);
-		response.setBody(QByteArrayLiteral("Not found"), QByteArrayLiteral("text/plain; charset=utf-8"));
+		pRequest->send(HttpResponse(HttpStatusCode::NOT_FOUND, QByteArrayLiteral("Not found"), QByteArrayLiteral("text/plain; charset=utf-8")));
+		return;
+	}
+
+	const auto& ifNoneMatch = pRequest->getHeader(QByteArrayLiteral("if-none-match"));
+	for (const auto& eTag : ifNoneMatch.split(','))
+	{
+		const auto& trimmed = eTag.trimmed();
+		if (trimmed == resource->mETag || trimmed == QByteArrayLiteral("*"))
+		{
+			HttpResponse response(HttpStatusCode::NOT_MODIFIED);
+			response.setHeader(QByteArrayLiteral("ETag"), resource->mETag);
+			pRequest->send(response);
+			return;
+		}
+	}
+
+	HttpResponse response(HttpStatusCode::OK);
+	response.setHeader(QByteArrayLiteral("ETag"), resource->mETag);
+	if (!resource->mDeflatedBody.isEmpty())
+	{
+		response.setHeader(QByteArrayLiteral("Vary"), QByteArrayLiteral("Accept-Encoding"));
+		if (pRequest->getHeader(QByteArrayLiteral("accept-encoding")).contains("deflate"))
+		{
+			response.setHeader(QByteArrayLiteral("Content-Encoding"), QByteArrayLiteral("deflate"));
+			response.setBody(resource->mDeflatedBody, resource->mContentType);
+			pRequest->send(response);
+			return;
+		}
 	}
 
+	response.setBody(resource->mBody, resource->mContentType);
 	pRequest->send(response);
 }
 
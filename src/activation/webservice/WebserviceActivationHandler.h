@@ -7,6 +7,8 @@
 #include "ActivationHandler.h"
 #include "HttpServer.h"
 
+#include <QHash>
+
 class test_WebserviceActivationHandler;
 
 namespace governikus
@@ -25,10 +27,24 @@ class WebserviceActivationHandler
 
 	private:
 		friend class ::test_WebserviceActivationHandler;
+
+		/*!
+		 * Static resources are read once and served from memory.
+		 */
+		struct CachedResource
+		{
+			QByteArray mBody;
+			QByteArray mDeflatedBody;
+			QByteArray mContentType;
+			QByteArray mETag;
+		};
+
 		QSharedPointer<HttpServer> mServer;
+		QHash<QString, CachedResource> mResourceCache;
 
 		static void addStatusLine(QString& pContent, StatusFormat pStatusFormat, const QString& pKey, const QString& pValue);
 
+		const CachedResource* getCachedResource(const QString& pPath);
 		void handleImageRequest(const QSharedPointer<HttpRequest>& pRequest, const QString& pImagePath);
 		QByteArray guessImageContentType(const QString& pFileName) const;
 		void handleShowUiRequest(UiModule pUiModule, const QSharedPointer<HttpRequest>& pRequest);
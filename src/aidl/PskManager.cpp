@@ -46,20 +46,9 @@ QByteArray PskManager::generatePsk()
 		timeStamp >>= 8;
 	}
 
-	QByteArray randomBytes;
-	randomBytes.reserve(RANDOM_BYTE_COUNT);
-
 	Randomizer& randomizer = Randomizer::getInstance();
 	mSecureRandomPsk = randomizer.isSecureRandom();
-	std::mt19937& generator = randomizer.getGenerator();
-	for (int i = 0; i < RANDOM_BYTE_COUNT; i += 4)
-	{
-		const auto randomNumber = generator();
-		randomBytes += static_cast<char>(randomNumber & 0xFF);
-		randomBytes += static_cast<char>((randomNumber >> 8) & 0xFF);
-		randomBytes += static_cast<char>((randomNumber >> 16) & 0xFF);
-		randomBytes += static_cast<char>((randomNumber >> 24) & 0xFF);
-	}
+	const QByteArray randomBytes = randomizer.createBytes(RANDOM_BYTE_COUNT);
 
 	QByteArray mServerInputBytes;
 	mServerInputBytes.reserve(TIMESTAMP_BYTE_COUNT + RANDOM_BYTE_COUNT);
@@ -89,6 +89,8 @@ CommandApdu::CommandApdu(char pCla, char pIns, char pP1, char pP2, const QByteAr
 		return;
 	}
 
+	// header, extended Lc, data and extended Le: allocate the buffer just once
+	mBuffer.reserve(4 + 3 + pData.size() + 3);
 	mBuffer += pCla;
 	mBuffer += pIns;
 	mBuffer += pP1;
@@ -212,19 +214,29 @@ int CommandApdu::getLe() const
 
 
 QByteArray CommandApdu::getData() const
+{
+	const QByteArray data = getDataView();
+	return QByteArray(data.constData(), data.size());
+}
+
+
+QByteArray CommandApdu::getHeaderView() const
+{
+	return QByteArray::fromRawData(mBuffer.constData(), qMin(length(), 4));
+}
+
+
+QByteArray CommandApdu::getDataView() const
 {
 	int lc = getLc();
 	if (lc == 0)
 	{
 		return QByteArray();
 	}
-	if (isExtendedLength())
-	{
-		// 4 bytes header + 3 bytes length
-		return mBuffer.mid(7, lc);
-	}
-	// 4 bytes header + 1 bytes length
-	return mBuffer.mid(5, lc);
+
+	// 4 bytes header + 3 bytes length for extended length, otherwise 1 byte length
+	const int offset = isExtendedLength() ? 7 : 5;
+	return QByteArray::fromRawData(mBuffer.constData() + offset, qMin(lc, length() - offset));
 }
 
 
@@ -271,6 +283,17 @@ QByteArray ResponseApdu::getData() const
 }
 
 
+QByteArray ResponseApdu::getDataView() const
+{
+	if (length() < RETURN_CODE_LENGTH)
+	{
+		return QByteArray();
+	}
+
+	return QByteArray::fromRawData(mBuffer.constData(), getDataLength());
+}
+
+
 int ResponseApdu::getDataLength() const
 {
 	return length() - RETURN_CODE_LENGTH;
@@ -284,7 +307,12 @@ StatusCode ResponseApdu::getReturnCode() const
 		return StatusCode::EMPTY;
 	}
 
-	const int returnCodeAsInt = getReturnCodeAsHex().toInt(nullptr, 16);
+	// Use the last two bytes or the single byte of a truncated response
+	int returnCodeAsInt = static_cast<uchar>(mBuffer.at(length() - 1));
+	if (length() >= RETURN_CODE_LENGTH)
+	{
+		returnCodeAsInt |= static_cast<uchar>(mBuffer.at(length() - RETURN_CODE_LENGTH)) << 8;
+	}
 	return Enum<StatusCode>::isValue(returnCodeAsInt) ? StatusCode(returnCodeAsInt) : StatusCode::INVALID;
 }
 
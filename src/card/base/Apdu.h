@@ -109,6 +109,14 @@ class CommandApdu
 		int getLc() const;
 		int getLe() const;
 		QByteArray getData() const;
+
+		/*!
+		 * Returns the header or the data without copying them. The returned
+		 * QByteArray references the buffer of this APDU and must not outlive it.
+		 */
+		QByteArray getHeaderView() const;
+		QByteArray getDataView() const;
+
 		bool isUpdateRetryCounter() const;
 
 		static bool isExtendedLength(const QByteArray& pData, int pLe);
@@ -129,6 +137,13 @@ class ResponseApdu
 
 		virtual void setBuffer(const QByteArray& pBuffer);
 		QByteArray getData() const;
+
+		/*!
+		 * Returns the data without copying it. The returned QByteArray
+		 * references the buffer of this APDU and must not outlive it.
+		 */
+		QByteArray getDataView() const;
+
 		int getDataLength() const;
 		StatusCode getReturnCode() const;
 		QByteArray getReturnCodeAsHex() const;
@@ -0,0 +1,194 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "ApduRecorder.h"
+
+#include "SingletonHelper.h"
+
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+
+using namespace governikus;
+
+Q_DECLARE_LOGGING_CATEGORY(card)
+
+defineSingleton(ApduRecorder)
+
+
+ApduRecord::ApduRecord(const QByteArray& pCommand, const QByteArray& pResponse, CardReturnCode pReturnCode, qint64 pOffset, qint64 pDuration)
+	: mCommand(pCommand)
+	, mResponse(pResponse)
+	, mReturnCode(pReturnCode)
+	, mOffset(pOffset)
+	, mDuration(pDuration)
+{
+}
+
+
+const QByteArray& ApduRecord::getCommand() const
+{
+	return mCommand;
+}
+
+
+const QByteArray& ApduRecord::getResponse() const
+{
+	return mResponse;
+}
+
+
+CardReturnCode ApduRecord::getReturnCode() const
+{
+	return mReturnCode;
+}
+
+
+qint64 ApduRecord::getOffset() const
+{
+	return mOffset;
+}
+
+
+qint64 ApduRecord::getDuration() const
+{
+	return mDuration;
+}
+
+
+QJsonObject ApduRecord::toJson() const
+{
+	QJsonObject json;
+	json[QLatin1String("command")] = QString::fromLatin1(mCommand.toHex());
+	json[QLatin1String("response")] = QString::fromLatin1(mResponse.toHex());
+	json[QLatin1String("returnCode")] = getEnumName(mReturnCode);
+	json[QLatin1String("offset")] = mOffset;
+	json[QLatin1String("duration")] = mDuration;
+	return json;
+}
+
+
+ApduRecord ApduRecord::fromJson(const QJsonObject& pJson)
+{
+	return ApduRecord(QByteArray::fromHex(pJson.value(QLatin1String("command")).toString().toLatin1()),
+			QByteArray::fromHex(pJson.value(QLatin1String("response")).toString().toLatin1()),
+			Enum<CardReturnCode>::fromString(pJson.value(QLatin1String("returnCode")).toString(), CardReturnCode::UNDEFINED),
+			static_cast<qint64>(pJson.value(QLatin1String("offset")).toDouble()),
+			static_cast<qint64>(pJson.value(QLatin1String("duration")).toDouble()));
+}
+
+
+ApduRecorder::ApduRecorder()
+	: mMutex()
+	, mFile()
+	, mTimer()
+{
+}
+
+
+ApduRecorder::~ApduRecorder()
+{
+	stop();
+}
+
+
+ApduRecorder& ApduRecorder::getInstance()
+{
+	return *Instance;
+}
+
+
+bool ApduRecorder::start(const QString& pFilename)
+{
+	QMutexLocker locker(&mMutex);
+
+	if (mFile.isOpen())
+	{
+		mFile.close();
+	}
+
+	mFile.setFileName(pFilename);
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+	{
+		qCCritical(card) << "Cannot record APDUs to" << pFilename << '|' << mFile.errorString();
+		return false;
+	}
+
+	qCInfo(card) << "Recording APDUs to" << pFilename;
+	mTimer.start();
+	return true;
+}
+
+
+void ApduRecorder::stop()
+{
+	QMutexLocker locker(&mMutex);
+
+	if (mFile.isOpen())
+	{
+		qCInfo(card) << "Stop recording APDUs to" << mFile.fileName();
+		mFile.close();
+	}
+}
+
+
+bool ApduRecorder::isRecording()
+{
+	QMutexLocker locker(&mMutex);
+	return mFile.isOpen();
+}
+
+
+qint64 ApduRecorder::getElapsed()
+{
+	QMutexLocker locker(&mMutex);
+	return mTimer.isValid() ? mTimer.nsecsElapsed() / 1000 : 0;
+}
+
+
+void ApduRecorder::record(const CommandApdu& pCommand, const ResponseApdu& pResponse, CardReturnCode pReturnCode, qint64 pOffset, qint64 pDuration)
+{
+	const ApduRecord record(pCommand.getBuffer(), pResponse.getBuffer(), pReturnCode, pOffset, pDuration);
+	const QByteArray line = QJsonDocument(record.toJson()).toJson(QJsonDocument::Compact) + '\n';
+
+	QMutexLocker locker(&mMutex);
+	if (mFile.isOpen())
+	{
+		mFile.write(line);
+	}
+}
+
+
+QVector<ApduRecord> ApduRecorder::load(const QString& pFilename)
+{
+	QVector<ApduRecord> records;
+
+	QFile file(pFilename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		qCCritical(card) << "Cannot read APDU recording" << pFilename << '|' << file.errorString();
+		return records;
+	}
+
+	while (!file.atEnd())
+	{
+		const QByteArray line = file.readLine().trimmed();
+		if (line.isEmpty())
+		{
+			continue;
+		}
+
+		QJsonParseError error;
+		const auto& json = QJsonDocument::fromJson(line, &error);
+		if (error.error != QJsonParseError::NoError || !json.isObject())
+		{
+			qCWarning(card) << "Skipping invalid APDU record:" << error.errorString();
+			continue;
+		}
+
+		records += ApduRecord::fromJson(json.object());
+	}
+
+	return records;
+}
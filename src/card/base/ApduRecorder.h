@@ -0,0 +1,90 @@
+/*!
+ * \brief Records the APDUs exchanged with a card to replay them without a card.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "Apdu.h"
+#include "CardReturnCode.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QMutex>
+#include <QVector>
+
+namespace governikus
+{
+
+/*!
+ * A single command and the response of the card. The offset is the time since
+ * the start of the recording and the duration is the time the card needed to
+ * answer, both in microseconds. The difference between the end of an exchange
+ * and the offset of the next one is the time spent by the application.
+ */
+class ApduRecord
+{
+	private:
+		QByteArray mCommand;
+		QByteArray mResponse;
+		CardReturnCode mReturnCode;
+		qint64 mOffset;
+		qint64 mDuration;
+
+	public:
+		ApduRecord(const QByteArray& pCommand = QByteArray(),
+				const QByteArray& pResponse = QByteArray(),
+				CardReturnCode pReturnCode = CardReturnCode::UNDEFINED,
+				qint64 pOffset = 0,
+				qint64 pDuration = 0);
+
+		const QByteArray& getCommand() const;
+		const QByteArray& getResponse() const;
+		CardReturnCode getReturnCode() const;
+		qint64 getOffset() const;
+		qint64 getDuration() const;
+
+		QJsonObject toJson() const;
+		static ApduRecord fromJson(const QJsonObject& pJson);
+};
+
+
+/*!
+ * Writes every APDU sent to a card into a file, one JSON object per line.
+ * The APDUs are recorded as they are sent to the card, i.e. encrypted if
+ * secure messaging is established.
+ */
+class ApduRecorder
+{
+	private:
+		QMutex mMutex;
+		QFile mFile;
+		QElapsedTimer mTimer;
+
+		ApduRecorder(const ApduRecorder&) = delete;
+		ApduRecorder& operator=(const ApduRecorder&) = delete;
+
+	protected:
+		ApduRecorder();
+		~ApduRecorder();
+
+	public:
+		static ApduRecorder& getInstance();
+
+		bool start(const QString& pFilename);
+		void stop();
+		bool isRecording();
+
+		/*!
+		 * Returns the elapsed time of the recording in microseconds.
+		 */
+		qint64 getElapsed();
+		void record(const CommandApdu& pCommand, const ResponseApdu& pResponse, CardReturnCode pReturnCode, qint64 pOffset, qint64 pDuration);
+
+		static QVector<ApduRecord> load(const QString& pFilename);
+};
+
+
+} /* namespace governikus */
@@ -3,6 +3,8 @@
  */
 
 #include "CardConnectionWorker.h"
+
+#include "ApduRecorder.h"
 #include "pace/PaceHandler.h"
 
 #include <QLoggingCategory>
@@ -17,6 +19,7 @@ CardConnectionWorker::CardConnectionWorker(Reader* pReader)
 	, QEnableSharedFromThis()
 	, mReader(pReader)
 	, mSecureMessaging()
+	, mTransmitCount(0)
 {
 	connect(mReader, &Reader::fireCardInserted, this, &CardConnectionWorker::onReaderInfoChanged);
 	connect(mReader, &Reader::fireCardRemoved, this, &CardConnectionWorker::onReaderInfoChanged);
@@ -70,6 +73,21 @@ void CardConnectionWorker::onReaderInfoChanged(const QString& pReaderName)
 }
 
 
+CardReturnCode CardConnectionWorker::transmitToCard(const CommandApdu& pCommandApdu, ResponseApdu& pResponseApdu)
+{
+	auto& recorder = ApduRecorder::getInstance();
+	if (!recorder.isRecording())
+	{
+		return mReader->getCard()->transmit(pCommandApdu, pResponseApdu);
+	}
+
+	const qint64 offset = recorder.getElapsed();
+	const CardReturnCode returnCode = mReader->getCard()->transmit(pCommandApdu, pResponseApdu);
+	recorder.record(pCommandApdu, pResponseApdu, returnCode, offset, recorder.getElapsed() - offset);
+	return returnCode;
+}
+
+
 CardReturnCode CardConnectionWorker::transmit(const CommandApdu& pCommandApdu, ResponseApdu& pResponseApdu)
 {
 	if (!hasCard())
@@ -78,12 +96,13 @@ CardReturnCode CardConnectionWorker::transmit(const CommandApdu& pCommandApdu, R
 	}
 
 	CardReturnCode returnCode;
+	++mTransmitCount;
 
 	if (mSecureMessaging)
 	{
 		CommandApdu securedCommandApdu = mSecureMessaging->encrypt(pCommandApdu);
 		ResponseApdu securedResponseApdu;
-		returnCode = mReader->getCard()->transmit(securedCommandApdu, securedResponseApdu);
+		returnCode = transmitToCard(securedCommandApdu, securedResponseApdu);
 		if (!mSecureMessaging->decrypt(securedResponseApdu, pResponseApdu))
 		{
 			return CardReturnCode::COMMAND_FAILED;
@@ -91,7 +110,7 @@ CardReturnCode CardConnectionWorker::transmit(const CommandApdu& pCommandApdu, R
 	}
 	else
 	{
-		returnCode = mReader->getCard()->transmit(pCommandApdu, pResponseApdu);
+		returnCode = transmitToCard(pCommandApdu, pResponseApdu);
 	}
 
 	if (pCommandApdu.isUpdateRetryCounter())
@@ -104,6 +123,12 @@ CardReturnCode CardConnectionWorker::transmit(const CommandApdu& pCommandApdu, R
 }
 
 
+int CardConnectionWorker::getTransmitCount() const
+{
+	return mTransmitCount;
+}
+
+
 CardReturnCode CardConnectionWorker::readFile(const FileRef& pFileRef, QByteArray& pFileContent)
 {
 	if (!hasCard())
@@ -111,6 +136,17 @@ CardReturnCode CardConnectionWorker::readFile(const FileRef& pFileRef, QByteArra
 		return CardReturnCode::CARD_NOT_FOUND;
 	}
 
+	if (pFileRef.shortFileId != 0)
+	{
+		if (readFileByShortFileId(pFileRef, pFileContent) == CardReturnCode::OK)
+		{
+			return CardReturnCode::OK;
+		}
+
+		qCDebug(card) << "Cannot read file by short file identifier, using SELECT" << pFileRef.path.toHex();
+		pFileContent.clear();
+	}
+
 	ResponseApdu selectRes;
 	CommandApdu select = SelectBuilder(pFileRef).build();
 	CardReturnCode returnCode = transmit(select, selectRes);
@@ -119,18 +155,54 @@ CardReturnCode CardConnectionWorker::readFile(const FileRef& pFileRef, QByteArra
 		return CardReturnCode::COMMAND_FAILED;
 	}
 
+	return readSelectedFile(pFileContent);
+}
+
+
+CardReturnCode CardConnectionWorker::readFileByShortFileId(const FileRef& pFileRef, QByteArray& pFileContent)
+{
+	// The whole file is requested at once if the reader is capable of extended length.
+	const int le = getReaderInfo().sufficientApduLength() ? CommandApdu::EXTENDED_MAX_LE : 0xff;
+
+	ResponseApdu res;
+	const CardReturnCode returnCode = transmit(ReadBinaryBuilder(0, le, pFileRef.shortFileId).build(), res);
+	if (returnCode != CardReturnCode::OK)
+	{
+		return returnCode;
+	}
+
+	const StatusCode statusCode = res.getReturnCode();
+	if (statusCode != StatusCode::SUCCESS && statusCode != StatusCode::END_OF_FILE)
+	{
+		return CardReturnCode::COMMAND_FAILED;
+	}
+
+	pFileContent = res.getData();
+	if (statusCode == StatusCode::END_OF_FILE || pFileContent.size() < le)
+	{
+		return CardReturnCode::OK;
+	}
+
+	// The file is selected now, read the remaining data like before
+	return readSelectedFile(pFileContent);
+}
+
+
+CardReturnCode CardConnectionWorker::readSelectedFile(QByteArray& pFileContent)
+{
 	while (true)
 	{
 		ResponseApdu res;
 		ReadBinaryBuilder rb(static_cast<uint>(pFileContent.count()), 0xff);
-		returnCode = transmit(rb.build(), res);
+		const CardReturnCode returnCode = transmit(rb.build(), res);
 		if (returnCode != CardReturnCode::OK)
 		{
 			break;
 		}
 
-		pFileContent += res.getData();
-		if (res.getData().size() != 0xff && res.getReturnCode() == StatusCode::END_OF_FILE)
+		const QByteArray data = res.getDataView();
+		pFileContent += data;
+		if (data.size() != 0xff && res.getReturnCode() == StatusCode::END_OF_FILE)
 		{
 			return CardReturnCode::OK;
 		}
@@ -193,7 +265,7 @@ CardReturnCode CardConnectionWorker::establishPaceChannel(PACE_PASSWORD_ID pPass
 			pChannelOutput.setIdIcc(paceHandler.getIdIcc());
 			pChannelOutput.setEfCardAccess(getEfCardAccess()->getContentBytes());
 			pChannelOutput.setPaceReturnCode(CardReturnCode::OK);
-			mSecureMessaging.reset(new SecureMessaging(paceHandler.getPaceProtocol(), paceHandler.getEncryptionKey(), paceHandler.getMacKey()));
+			mSecureMessaging.reset(new SecureMessaging(paceHandler.getPaceProtocolDescriptor(), paceHandler.getEncryptionKey(), paceHandler.getMacKey()));
 		}
 	}
 	else
@@ -221,7 +293,7 @@ CardReturnCode CardConnectionWorker::destroyPaceChannel()
 		stopSecureMessaging();
 		MSEBuilder builder(MSEBuilder::P1::ERASE, MSEBuilder::P2::DEFAULT_CHANNEL);
 		ResponseApdu response;
-		CardReturnCode cardReturnCode = mReader->getCard()->transmit(builder.build(), response);
+		CardReturnCode cardReturnCode = transmitToCard(builder.build(), response);
 		qCDebug(card) << "Destroying PACE channel with invalid command causing 6700 as return code";
 		return cardReturnCode;
 	}
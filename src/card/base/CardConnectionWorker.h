@@ -41,7 +41,15 @@ class CardConnectionWorker
 		 */
 		QScopedPointer<SecureMessaging> mSecureMessaging;
 
+		/*!
+		 * Number of commands sent to the card by this connection
+		 */
+		int mTransmitCount;
+
 		bool hasCard() const;
+		CardReturnCode transmitToCard(const CommandApdu& pCommandApdu, ResponseApdu& pResponseApdu);
+		CardReturnCode readSelectedFile(QByteArray& pFileContent);
+		CardReturnCode readFileByShortFileId(const FileRef& pFileRef, QByteArray& pFileContent);
 		inline QSharedPointer<const EFCardAccess> getEfCardAccess() const;
 
 	private Q_SLOTS:
@@ -68,6 +76,12 @@ class CardConnectionWorker
 
 		virtual CardReturnCode updateRetryCounter();
 
+		int getTransmitCount() const;
+
+		/*!
+		 * Reads a file with READ BINARY using its short file identifier if available.
+		 * Cards rejecting that are accessed by SELECT and READ BINARY.
+		 */
 		virtual CardReturnCode readFile(const FileRef& pFileRef, QByteArray& pFileContent);
 
 		virtual CardReturnCode transmit(const CommandApdu& pCommandApdu, ResponseApdu& pResponseApdu);
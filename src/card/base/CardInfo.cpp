@@ -126,6 +126,7 @@ bool CardInfoFactory::create(const QSharedPointer<CardConnectionWorker>& pCardCo
 
 	pReaderInfo.setCardInfo(CardInfo(CardType::EID_CARD, efCardAccess));
 	pCardConnectionWorker->updateRetryCounter();
+	qCDebug(card) << "Card recognition finished with" << pCardConnectionWorker->getTransmitCount() << "commands";
 	return true;
 }
 
@@ -154,22 +155,30 @@ bool CardInfoFactory::isGermanEidCard(const QSharedPointer<CardConnectionWorker>
 		return false;
 	}
 
-	// 1. CL=00, INS=A4=SELECT, P1= 02, P2=0C, Lc=02, Data=2F00 (FI of EF.DIR), Le=absent
-	command = SelectBuilder(FileRef::efDir()).build();
+	// 1. CL=00, INS=B0=Read Binary, P1=9E (SFI of EF.DIR), P2=00 (no offset), Le=5A
+	command = ReadBinaryBuilder(0, 0x5A, FileRef::efDir().shortFileId).build();
 	returnCode = pCardConnectionWorker->transmit(command, response);
 	if (returnCode != CardReturnCode::OK || response.getReturnCode() != StatusCode::SUCCESS)
 	{
-		qCWarning(card) << "Cannot select EF.DIR";
-		return false;
-	}
+		qCDebug(card) << "Cannot read EF.DIR by short file identifier, using SELECT";
 
-	// 2. CL=00, INS=B0=Read Binary, P1=00, P2=00 (no offset), Lc=00, Le=5A
-	command = CommandApdu(QByteArray::fromHex("00B000005A"));
-	returnCode = pCardConnectionWorker->transmit(command, response);
-	if (returnCode != CardReturnCode::OK || response.getReturnCode() != StatusCode::SUCCESS)
-	{
-		qCWarning(card) << "Cannot read EF.DIR";
-		return false;
+		// 1a. CL=00, INS=A4=SELECT, P1= 02, P2=0C, Lc=02, Data=2F00 (FI of EF.DIR), Le=absent
+		command = SelectBuilder(FileRef::efDir()).build();
+		returnCode = pCardConnectionWorker->transmit(command, response);
+		if (returnCode != CardReturnCode::OK || response.getReturnCode() != StatusCode::SUCCESS)
+		{
+			qCWarning(card) << "Cannot select EF.DIR";
+			return false;
+		}
+
+		// 1b. CL=00, INS=B0=Read Binary, P1=00, P2=00 (no offset), Lc=00, Le=5A
+		command = CommandApdu(QByteArray::fromHex("00B000005A"));
+		returnCode = pCardConnectionWorker->transmit(command, response);
+		if (returnCode != CardReturnCode::OK || response.getReturnCode() != StatusCode::SUCCESS)
+		{
+			qCWarning(card) << "Cannot read EF.DIR";
+			return false;
+		}
 	}
 
 	// matching value from CIF
@@ -325,10 +325,11 @@ CommandApdu GABuilder::build()
 }
 
 
-ReadBinaryBuilder::ReadBinaryBuilder(uint pOffset, int pLe)
+ReadBinaryBuilder::ReadBinaryBuilder(uint pOffset, int pLe, char pShortFileId)
 	: CommandApduBuilder()
 	, mOffset(pOffset)
 	, mLe(pLe)
+	, mShortFileId(pShortFileId)
 {
 }
 
@@ -336,6 +337,12 @@ ReadBinaryBuilder::ReadBinaryBuilder(uint pOffset, int pLe)
 CommandApdu ReadBinaryBuilder::build()
 {
 	static const char INS = char(0xB0);
+	if (mShortFileId != 0)
+	{
+		// P1: b8=1 indicates the short EF identifier in b5-b1, P2: offset
+		Q_ASSERT(mOffset <= 0xff);
+		return CommandApdu(CommandApdu::CLA, INS, static_cast<char>(0x80 | (mShortFileId & 0x1f)), static_cast<char>(mOffset & 0xff), QByteArray(), mLe);
+	}
 	return CommandApdu(CommandApdu::CLA, INS, static_cast<char>((mOffset & 0xff00) >> 8), static_cast<char>(mOffset & 0xff), QByteArray(), mLe);
 }
 
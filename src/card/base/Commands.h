@@ -168,9 +168,14 @@ class ReadBinaryBuilder
 	private:
 		uint mOffset;
 		int mLe;
+		char mShortFileId;
 
 	public:
-		ReadBinaryBuilder(uint pOffset, int pLe);
+		/*!
+		 * If a short file identifier is given, the file is selected implicitly
+		 * and the offset is limited to 0xff.
+		 */
+		ReadBinaryBuilder(uint pOffset, int pLe, char pShortFileId = 0);
 		CommandApdu build() override;
 };
 
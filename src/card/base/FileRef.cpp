@@ -9,7 +9,7 @@ using namespace governikus;
 
 FileRef FileRef::efDir()
 {
-	return FileRef(static_cast<char>(SelectBuilder::P1::CHILD_EF), QByteArray::fromHex("2f00"));
+	return FileRef(static_cast<char>(SelectBuilder::P1::CHILD_EF), QByteArray::fromHex("2f00"), 0x1e);
 }
 
 
@@ -22,18 +22,18 @@ FileRef FileRef::masterFile()
 FileRef FileRef::efCardAccess()
 {
 	/*
-	 * File ID 011C specified in TR-03110-3
+	 * File ID 011C and short file ID 1C specified in TR-03110-3
 	 */
-	return FileRef(static_cast<char>(SelectBuilder::P1::CHILD_EF), QByteArray::fromHex("011c"));
+	return FileRef(static_cast<char>(SelectBuilder::P1::CHILD_EF), QByteArray::fromHex("011c"), 0x1c);
 }
 
 
 FileRef FileRef::efCardSecurity()
 {
 	/*
-	 * File ID 011D specified in TR-03110-3
+	 * File ID 011D and short file ID 1D specified in TR-03110-3
 	 */
-	return FileRef(static_cast<char>(SelectBuilder::P1::CHILD_EF), QByteArray::fromHex("011d"));
+	return FileRef(static_cast<char>(SelectBuilder::P1::CHILD_EF), QByteArray::fromHex("011d"), 0x1d);
 }
 
 
@@ -43,8 +43,9 @@ FileRef FileRef::appESign()
 }
 
 
-FileRef::FileRef(char pType, const QByteArray& pPath)
+FileRef::FileRef(char pType, const QByteArray& pPath, char pShortFileId)
 	: type(pType)
 	, path(pPath)
+	, shortFileId(pShortFileId)
 {
 }
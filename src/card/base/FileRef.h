@@ -13,11 +13,16 @@ namespace governikus
 
 struct FileRef
 {
-	FileRef(char pType, const QByteArray& pPath);
+	FileRef(char pType, const QByteArray& pPath, char pShortFileId = 0);
 
 	const char type;
 	const QByteArray path;
 
+	/*!
+	 * Short EF identifier (ISO 7816-4, 1 to 30) or 0 if the file cannot be addressed this way.
+	 */
+	const char shortFileId;
+
 	static FileRef masterFile();
 	static FileRef efDir();
 	static FileRef efCardAccess();
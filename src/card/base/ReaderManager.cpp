@@ -21,6 +21,8 @@ ReaderManager::ReaderManager()
 	, mThread()
 	, mWorker()
 	, mRemoteClient()
+	, mReaderNames()
+	, mReaderOwners()
 {
 	mThread.setObjectName(QStringLiteral("ReaderManagerThread"));
 }
@@ -75,6 +77,15 @@ void ReaderManager::init(const QSharedPointer<RemoteClient>& pRemoteClient)
 		connect(this, &ReaderManager::fireCardInserted, this, &ReaderManager::fireReaderEvent);
 		connect(this, &ReaderManager::fireCardRemoved, this, &ReaderManager::fireReaderEvent);
 		connect(this, &ReaderManager::fireReaderPropertiesUpdated, this, &ReaderManager::fireReaderEvent);
+
+		// Cache the known readers to check a reservation without a blocking call to the worker
+		connect(this, &ReaderManager::fireReaderAdded, this, [this](const QString& pReaderName){
+					mReaderNames.insert(pReaderName);
+				});
+		connect(this, &ReaderManager::fireReaderRemoved, this, [this](const QString& pReaderName){
+					mReaderNames.remove(pReaderName);
+					mReaderOwners.remove(pReaderName);
+				});
 	}
 
 	mThread.start();
@@ -90,6 +101,7 @@ void ReaderManager::shutdown()
 		mThread.quit();
 		mThread.wait(2500);
 		qCDebug(card) << "Stopping..." << mThread.isRunning();
+		mReaderNames.clear();
 	}
 }
 
@@ -188,3 +200,69 @@ QSharedPointer<RemoteClient> ReaderManager::getRemoteClient()
 {
 	return mRemoteClient;
 }
+
+
+bool ReaderManager::reserveReader(const QString& pReaderName, const QObject* pOwner)
+{
+	Q_ASSERT(pOwner);
+
+	if (!mReaderNames.contains(pReaderName))
+	{
+		qCWarning(card) << "Cannot reserve unknown reader:" << pReaderName;
+		return false;
+	}
+
+	if (!isReaderAvailable(pReaderName, pOwner))
+	{
+		qCDebug(card) << "Reader is already reserved:" << pReaderName;
+		return false;
+	}
+
+	mReaderOwners.insert(pReaderName, pOwner);
+	connect(pOwner, &QObject::destroyed, this, &ReaderManager::onOwnerDestroyed, Qt::UniqueConnection);
+	return true;
+}
+
+
+void ReaderManager::releaseReader(const QString& pReaderName, const QObject* pOwner)
+{
+	if (isReaderReserved(pReaderName, pOwner))
+	{
+		mReaderOwners.remove(pReaderName);
+	}
+}
+
+
+void ReaderManager::releaseReaders(const QObject* pOwner)
+{
+	for (auto iter = mReaderOwners.begin(); iter != mReaderOwners.end();)
+	{
+		if (iter.value() == pOwner)
+		{
+			iter = mReaderOwners.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
+
+void ReaderManager::onOwnerDestroyed(QObject* pOwner)
+{
+	releaseReaders(pOwner);
+}
+
+
+bool ReaderManager::isReaderAvailable(const QString& pReaderName, const QObject* pOwner) const
+{
+	const auto owner = mReaderOwners.value(pReaderName, nullptr);
+	return owner == nullptr || owner == pOwner;
+}
+
+
+bool ReaderManager::isReaderReserved(const QString& pReaderName, const QObject* pOwner) const
+{
+	return pOwner != nullptr && mReaderOwners.value(pReaderName, nullptr) == pOwner;
+}
@@ -10,7 +10,9 @@
 #include "ReaderManagerWorker.h"
 #include "RemoteClient.h"
 
+#include <QHash>
 #include <QPointer>
+#include <QSet>
 #include <QThread>
 
 namespace governikus
@@ -25,6 +27,11 @@ class ReaderManager
 		QThread mThread;
 		QPointer<ReaderManagerWorker> mWorker;
 		QSharedPointer<RemoteClient> mRemoteClient;
+		QSet<QString> mReaderNames;
+		QHash<QString, const QObject*> mReaderOwners;
+
+	private Q_SLOTS:
+		void onOwnerDestroyed(QObject* pOwner);
 
 	protected:
 		ReaderManager();
@@ -95,6 +102,24 @@ class ReaderManager
 		void disconnectReader(const QString& pReaderName);
 		void disconnectAllReaders();
 
+		/*!
+		 * Reserves a reader for exclusive use by the given owner, e.g. a workflow
+		 * context or a remote client. A reservation is released explicitly, if
+		 * the reader is removed or if the owner is destroyed. Unknown readers cannot be reserved. A reader is
+		 * known as soon as fireReaderAdded was emitted. Must only be called from
+		 * the main thread.
+		 * \return true if the reader is reserved by pOwner afterwards.
+		 */
+		bool reserveReader(const QString& pReaderName, const QObject* pOwner);
+		void releaseReader(const QString& pReaderName, const QObject* pOwner);
+		void releaseReaders(const QObject* pOwner);
+
+		/*!
+		 * Checks if the reader is not reserved or reserved by the given owner.
+		 */
+		bool isReaderAvailable(const QString& pReaderName, const QObject* pOwner = nullptr) const;
+		bool isReaderReserved(const QString& pReaderName, const QObject* pOwner) const;
+
 		QSharedPointer<RemoteClient> getRemoteClient();
 
 	Q_SIGNALS:
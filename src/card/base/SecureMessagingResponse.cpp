@@ -49,7 +49,7 @@ SecureMessagingResponse::SecureMessagingResponse(const QByteArray& pBuffer)
 	, mChecksum()
 {
 	ResponseApdu::setBuffer(pBuffer);
-	QByteArray data = getData();
+	QByteArray data = getDataView();
 
 	if (auto tmp = decodeObject<SM_ENCRYPTED_DATA>(data))
 	{
@@ -47,17 +47,8 @@ void freeAsn1Object<chipauthenticationinfo_st>(chipauthenticationinfo_st* pObjec
 
 bool ChipAuthenticationInfo::acceptsProtocol(const ASN1_OBJECT* pObjectIdentifier)
 {
-	using namespace KnownOIDs;
-
-	const auto protocol = Asn1ObjectUtil::convertTo(pObjectIdentifier);
-	return protocol == id_ca::DH_3DES_CBC_CBC
-		   || protocol == id_ca::DH_AES_CBC_CMAC_128
-		   || protocol == id_ca::DH_AES_CBC_CMAC_192
-		   || protocol == id_ca::DH_AES_CBC_CMAC_256
-		   || protocol == id_ca::ECDH_3DES_CBC_CBC
-		   || protocol == id_ca::ECDH_AES_CBC_CMAC_128
-		   || protocol == id_ca::ECDH_AES_CBC_CMAC_192
-		   || protocol == id_ca::ECDH_AES_CBC_CMAC_256;
+	const auto* descriptor = KnownOIDs::getProtocolDescriptor(Asn1ObjectUtil::getValue(pObjectIdentifier));
+	return descriptor != nullptr && descriptor->mProtocol == SecurityProtocol::ID_CA;
 }
 
 
@@ -4,9 +4,70 @@
 
 #include "KnownOIDs.h"
 
+#include <cstring>
+
 using namespace governikus::KnownOIDs;
 
 
+namespace
+{
+const int cProtocolValueLength = 10;
+const int cProtocolCipherCount = 4;
+
+/*
+ * The table is indexed by the last three arcs of the object identifier:
+ * id-CA-DH, id-CA-ECDH, id-PACE-DH-GM, id-PACE-ECDH-GM, id-PACE-DH-IM, id-PACE-ECDH-IM
+ * each followed by 3DES-CBC-CBC, AES-CBC-CMAC-128, AES-CBC-CMAC-192 and AES-CBC-CMAC-256.
+ */
+constexpr ProtocolDescriptor cProtocolDescriptors[] = {
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x01\x01", SecurityProtocol::ID_CA, false, Mapping::NONE, Cipher::DES3_CBC_CBC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x01\x02", SecurityProtocol::ID_CA, false, Mapping::NONE, Cipher::AES_CBC_CMAC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x01\x03", SecurityProtocol::ID_CA, false, Mapping::NONE, Cipher::AES_CBC_CMAC, 24, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x01\x04", SecurityProtocol::ID_CA, false, Mapping::NONE, Cipher::AES_CBC_CMAC, 32, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x02\x01", SecurityProtocol::ID_CA, true, Mapping::NONE, Cipher::DES3_CBC_CBC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x02\x02", SecurityProtocol::ID_CA, true, Mapping::NONE, Cipher::AES_CBC_CMAC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x02\x03", SecurityProtocol::ID_CA, true, Mapping::NONE, Cipher::AES_CBC_CMAC, 24, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x03\x02\x04", SecurityProtocol::ID_CA, true, Mapping::NONE, Cipher::AES_CBC_CMAC, 32, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x01\x01", SecurityProtocol::ID_PACE, false, Mapping::GM, Cipher::DES3_CBC_CBC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x01\x02", SecurityProtocol::ID_PACE, false, Mapping::GM, Cipher::AES_CBC_CMAC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x01\x03", SecurityProtocol::ID_PACE, false, Mapping::GM, Cipher::AES_CBC_CMAC, 24, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x01\x04", SecurityProtocol::ID_PACE, false, Mapping::GM, Cipher::AES_CBC_CMAC, 32, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x02\x01", SecurityProtocol::ID_PACE, true, Mapping::GM, Cipher::DES3_CBC_CBC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x02\x02", SecurityProtocol::ID_PACE, true, Mapping::GM, Cipher::AES_CBC_CMAC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x02\x03", SecurityProtocol::ID_PACE, true, Mapping::GM, Cipher::AES_CBC_CMAC, 24, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x02\x04", SecurityProtocol::ID_PACE, true, Mapping::GM, Cipher::AES_CBC_CMAC, 32, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x03\x01", SecurityProtocol::ID_PACE, false, Mapping::IM, Cipher::DES3_CBC_CBC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x03\x02", SecurityProtocol::ID_PACE, false, Mapping::IM, Cipher::AES_CBC_CMAC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x03\x03", SecurityProtocol::ID_PACE, false, Mapping::IM, Cipher::AES_CBC_CMAC, 24, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x03\x04", SecurityProtocol::ID_PACE, false, Mapping::IM, Cipher::AES_CBC_CMAC, 32, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x04\x01", SecurityProtocol::ID_PACE, true, Mapping::IM, Cipher::DES3_CBC_CBC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x04\x02", SecurityProtocol::ID_PACE, true, Mapping::IM, Cipher::AES_CBC_CMAC, 16, QCryptographicHash::Sha1},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x04\x03", SecurityProtocol::ID_PACE, true, Mapping::IM, Cipher::AES_CBC_CMAC, 24, QCryptographicHash::Sha256},
+	{"\x04\x00\x7f\x00\x07\x02\x02\x04\x04\x04", SecurityProtocol::ID_PACE, true, Mapping::IM, Cipher::AES_CBC_CMAC, 32, QCryptographicHash::Sha256}
+};
+
+
+const ProtocolDescriptor* getProtocolDescriptor(int pFamily, int pCipher)
+{
+	if (pCipher < 1 || pCipher > cProtocolCipherCount)
+	{
+		return nullptr;
+	}
+	return &cProtocolDescriptors[pFamily * cProtocolCipherCount + pCipher - 1];
+}
+
+
+const ProtocolDescriptor* getProtocolDescriptor(int pValue, int pFirstFamily, int pSecondFamily)
+{
+	// The enums list the two families with their base object identifier followed by the four ciphers
+	const int family = pValue <= cProtocolCipherCount ? pFirstFamily : pSecondFamily;
+	return getProtocolDescriptor(family, pValue % (cProtocolCipherCount + 1));
+}
+
+
+}  // namespace
+
+
 QByteArray governikus::toByteArray(Base pValue)
 {
 	switch (pValue)
@@ -278,3 +339,56 @@ QByteArray governikus::toByteArray(id_PACE::ECDH pValue)
 
 	Q_UNREACHABLE();
 }
+
+
+QByteArray ProtocolDescriptor::getValue() const
+{
+	return QByteArray::fromRawData(mValue, cProtocolValueLength);
+}
+
+
+const ProtocolDescriptor* governikus::KnownOIDs::getProtocolDescriptor(const QByteArray& pValue)
+{
+	if (pValue.size() != cProtocolValueLength)
+	{
+		return nullptr;
+	}
+
+	const int protocol = pValue.at(7);
+	const int family = pValue.at(8);
+	const int cipher = pValue.at(9);
+
+	const ProtocolDescriptor* descriptor = nullptr;
+	if (protocol == 0x03 && family >= 1 && family <= 2)
+	{
+		descriptor = ::getProtocolDescriptor(family - 1, cipher);
+	}
+	else if (protocol == 0x04 && family >= 1 && family <= 4)
+	{
+		descriptor = ::getProtocolDescriptor(family + 1, cipher);
+	}
+
+	if (descriptor == nullptr || std::memcmp(descriptor->mValue, pValue.constData(), cProtocolValueLength) != 0)
+	{
+		return nullptr;
+	}
+	return descriptor;
+}
+
+
+const ProtocolDescriptor* governikus::KnownOIDs::getProtocolDescriptor(id_ca pValue)
+{
+	return ::getProtocolDescriptor(static_cast<int>(pValue), 0, 1);
+}
+
+
+const ProtocolDescriptor* governikus::KnownOIDs::getProtocolDescriptor(id_PACE::DH pValue)
+{
+	return ::getProtocolDescriptor(static_cast<int>(pValue), 2, 4);
+}
+
+
+const ProtocolDescriptor* governikus::KnownOIDs::getProtocolDescriptor(id_PACE::ECDH pValue)
+{
+	return ::getProtocolDescriptor(static_cast<int>(pValue), 3, 5);
+}
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <QByteArray>
+#include <QCryptographicHash>
 
 namespace governikus
 {
@@ -116,6 +117,54 @@ enum class ECDH
 
 }  // namespace KnownOIDs::id_PACE
 
+
+enum class Cipher
+{
+	DES3_CBC_CBC,
+	AES_CBC_CMAC
+};
+
+enum class Mapping
+{
+	NONE,
+	GM,
+	IM
+};
+
+
+/*!
+ * Algorithms of a PACE or CA protocol object identifier, see TR-03110 Part 3, A.1.1.
+ * The descriptors are held in a static table and compared by the DER encoded
+ * content of the object identifier, so a protocol is resolved once without
+ * converting it to its dotted text representation.
+ */
+struct ProtocolDescriptor
+{
+	const char* mValue;
+	SecurityProtocol mProtocol;
+	bool mEcdh;
+	Mapping mMapping;
+	Cipher mCipher;
+	int mKeySize;
+	QCryptographicHash::Algorithm mHashAlgorithm;
+
+	/*!
+	 * Returns the DER encoded content of the object identifier without tag and length.
+	 */
+	QByteArray getValue() const;
+};
+
+
+/*!
+ * Looks up the descriptor of a PACE or CA protocol.
+ * \param pValue the DER encoded content of the object identifier without tag and length.
+ * \return the descriptor or nullptr, if the protocol is unknown.
+ */
+const ProtocolDescriptor* getProtocolDescriptor(const QByteArray& pValue);
+const ProtocolDescriptor* getProtocolDescriptor(id_ca pValue);
+const ProtocolDescriptor* getProtocolDescriptor(id_PACE::DH pValue);
+const ProtocolDescriptor* getProtocolDescriptor(id_PACE::ECDH pValue);
+
 }  // namespace KnownOIDs
 
 #define DEFINE_TO_BYTE_ARRAY(type)\
@@ -52,30 +52,18 @@ void freeAsn1Object<paceinfo_st>(paceinfo_st* pObject)
 
 bool PACEInfo::acceptsProtocol(const ASN1_OBJECT* pObjectIdentifier)
 {
-	const auto protocol = Asn1ObjectUtil::convertTo(pObjectIdentifier);
-	return protocol == id_PACE::DH::GM_3DES_CBC_CBC
-		   || protocol == id_PACE::DH::GM_AES_CBC_CMAC_128
-		   || protocol == id_PACE::DH::GM_AES_CBC_CMAC_192
-		   || protocol == id_PACE::DH::GM_AES_CBC_CMAC_256
-		   || protocol == id_PACE::ECDH::GM_3DES_CBC_CBC
-		   || protocol == id_PACE::ECDH::GM_AES_CBC_CMAC_128
-		   || protocol == id_PACE::ECDH::GM_AES_CBC_CMAC_192
-		   || protocol == id_PACE::ECDH::GM_AES_CBC_CMAC_256
-		   || protocol == id_PACE::DH::IM_3DES_CBC_CBC
-		   || protocol == id_PACE::DH::IM_AES_CBC_CMAC_128
-		   || protocol == id_PACE::DH::IM_AES_CBC_CMAC_192
-		   || protocol == id_PACE::DH::IM_AES_CBC_CMAC_256
-		   || protocol == id_PACE::ECDH::IM_3DES_CBC_CBC
-		   || protocol == id_PACE::ECDH::IM_AES_CBC_CMAC_128
-		   || protocol == id_PACE::ECDH::IM_AES_CBC_CMAC_192
-		   || protocol == id_PACE::ECDH::IM_AES_CBC_CMAC_256;
+	const auto* descriptor = KnownOIDs::getProtocolDescriptor(Asn1ObjectUtil::getValue(pObjectIdentifier));
+	return descriptor != nullptr && descriptor->mProtocol == SecurityProtocol::ID_PACE;
 }
 
 
 PACEInfo::PACEInfo(const QSharedPointer<const paceinfo_st>& pDelegate)
 	: SecurityInfo()
 	, mDelegate(pDelegate)
+	, mProtocolDescriptor(KnownOIDs::getProtocolDescriptor(Asn1ObjectUtil::getValue(pDelegate->mProtocol)))
 {
+	Q_ASSERT(mProtocolDescriptor != nullptr);
+
 	if (getVersion() != 2)
 	{
 		qCWarning(card) << "Expect version=2, got: " << getVersion();
@@ -106,33 +94,21 @@ int PACEInfo::getVersion() const
 }
 
 
+const ProtocolDescriptor* PACEInfo::getProtocolDescriptor() const
+{
+	return mProtocolDescriptor;
+}
+
+
 KeyAgreementType PACEInfo::getKeyAgreementType() const
 {
-	const auto& protocol = getProtocol();
-	if (protocol.startsWith(toByteArray(KnownOIDs::id_PACE::DH::GM))
-			|| protocol.startsWith(toByteArray(KnownOIDs::id_PACE::DH::IM)))
-	{
-		return KeyAgreementType::DH;
-	}
-	else
-	{
-		return KeyAgreementType::ECDH;
-	}
+	return mProtocolDescriptor->mEcdh ? KeyAgreementType::ECDH : KeyAgreementType::DH;
 }
 
 
 MappingType PACEInfo::getMappingType() const
 {
-	const auto& protocol = getProtocol();
-	if (protocol.startsWith(toByteArray(KnownOIDs::id_PACE::DH::GM))
-			|| protocol.startsWith(toByteArray((KnownOIDs::id_PACE::ECDH::GM))))
-	{
-		return MappingType::GM;
-	}
-	else
-	{
-		return MappingType::IM;
-	}
+	return mProtocolDescriptor->mMapping == Mapping::GM ? MappingType::GM : MappingType::IM;
 }
 
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "EnumHelper.h"
+#include "KnownOIDs.h"
 #include "SecurityInfo.h"
 
 
@@ -62,6 +63,7 @@ class PACEInfo
 	: public SecurityInfo
 {
 	const QSharedPointer<const paceinfo_st> mDelegate;
+	const KnownOIDs::ProtocolDescriptor* const mProtocolDescriptor;
 
 	PACEInfo(const QSharedPointer<const paceinfo_st>& pDelegate);
 
@@ -86,6 +88,11 @@ class PACEInfo
 		QByteArray getParameterId() const;
 		int getParameterIdAsInt() const;
 		int getVersion() const;
+
+		/*!
+		 * Returns the algorithms of the protocol, resolved once on decoding.
+		 */
+		const KnownOIDs::ProtocolDescriptor* getProtocolDescriptor() const;
 		KeyAgreementType getKeyAgreementType() const;
 		MappingType getMappingType() const;
 		bool isStandardizedDomainParameters() const;
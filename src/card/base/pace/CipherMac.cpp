@@ -2,7 +2,6 @@
  * \copyright Copyright (c) 2014-2018 Governikus GmbH & Co. KG, Germany
  */
 
-#include "asn1/KnownOIDs.h"
 #include "pace/CipherMac.h"
 
 #include <openssl/evp.h>
@@ -16,39 +15,42 @@ using namespace governikus;
 Q_DECLARE_LOGGING_CATEGORY(card)
 
 
-CipherMac::CipherMac(const QByteArray& pPaceAlgorithm, const QByteArray& pKeyBytes)
+CipherMac::CipherMac(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm, const QByteArray& pKeyBytes)
 	: mKeyBytes(pKeyBytes)
 	, mCtx(nullptr)
 {
-	using namespace governikus::KnownOIDs;
-
-	const EVP_CIPHER* cipher;
-	if (pPaceAlgorithm == id_PACE::DH::GM_3DES_CBC_CBC || pPaceAlgorithm == id_PACE::DH::IM_3DES_CBC_CBC || pPaceAlgorithm == id_PACE::ECDH::GM_3DES_CBC_CBC
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_3DES_CBC_CBC)
+	if (pPaceAlgorithm == nullptr)
 	{
-		qCCritical(card) << "3DES not supported";
+		qCCritical(card) << "Unknown algorithm";
 		return;
 	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_128 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_128 || pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_128
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_128)
-	{
-		cipher = EVP_aes_128_cbc();
-	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_192 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_192 || pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_192
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_192)
-	{
-		cipher = EVP_aes_192_cbc();
-	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_256 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_256 || pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_256
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_256)
+
+	if (pPaceAlgorithm->mCipher == KnownOIDs::Cipher::DES3_CBC_CBC)
 	{
-		cipher = EVP_aes_256_cbc();
+		qCCritical(card) << "3DES not supported";
+		return;
 	}
-	else
+
+	const EVP_CIPHER* cipher;
+	switch (pPaceAlgorithm->mKeySize)
 	{
-		qCCritical(card) << "Unknown algorithm: " << pPaceAlgorithm;
-		return;
+		case 16:
+			cipher = EVP_aes_128_cbc();
+			break;
+
+		case 24:
+			cipher = EVP_aes_192_cbc();
+			break;
+
+		case 32:
+			cipher = EVP_aes_256_cbc();
+			break;
+
+		default:
+			qCCritical(card) << "Unknown key size:" << pPaceAlgorithm->mKeySize;
+			return;
 	}
+
 	if (mKeyBytes.size() != EVP_CIPHER_key_length(cipher))
 	{
 		qCCritical(card) << "Key has wrong size (expected/got):" << EVP_CIPHER_key_length(cipher) << "/" << mKeyBytes.size();
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "asn1/KnownOIDs.h"
+
 #include <openssl/cmac.h>
 #include <QByteArray>
 
@@ -27,7 +29,7 @@ class CipherMac
 		 *        PACE protocol of id_PACE::DH::GM_AES_CBC_CMAC_128 will result in AES to be used for CMAC.
 		 * \param pKeyBytes the bytes of the key
 		 */
-		CipherMac(const QByteArray& pPaceAlgorithm, const QByteArray& pKeyBytes);
+		CipherMac(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm, const QByteArray& pKeyBytes);
 		virtual ~CipherMac();
 
 		/*!
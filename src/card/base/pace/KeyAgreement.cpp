@@ -72,7 +72,7 @@ KeyAgreement::KeyAgreement(const QSharedPointer<const PACEInfo>& pPaceInfo, cons
 	, mCarCurr()
 	, mCarPrev()
 	, mPaceInfo(pPaceInfo)
-	, mKeyDerivationFunction(pPaceInfo->getProtocol())
+	, mKeyDerivationFunction(pPaceInfo->getProtocolDescriptor())
 {
 }
 
@@ -129,7 +129,7 @@ CardOperationResult<QByteArray> KeyAgreement::determineNonce(const QString& pPin
 
 	QByteArray encryptedNonce = result.getPayload();
 	QByteArray symmetricKey = mKeyDerivationFunction.pi(pPin);
-	SymmetricCipher nonceDecrypter(mPaceInfo->getProtocol(), symmetricKey);
+	SymmetricCipher nonceDecrypter(mPaceInfo->getProtocolDescriptor(), symmetricKey);
 
 	return CardOperationResult<QByteArray>(CardReturnCode::OK, nonceDecrypter.decrypt(encryptedNonce));
 }
@@ -137,7 +137,7 @@ CardOperationResult<QByteArray> KeyAgreement::determineNonce(const QString& pPin
 
 KeyAgreementStatus KeyAgreement::performMutualAuthenticate()
 {
-	CipherMac cmac(mPaceInfo->getProtocol(), mMacKey);
+	CipherMac cmac(mPaceInfo->getProtocolDescriptor(), mMacKey);
 
 	QByteArray uncompressedCardPublicKey = getUncompressedCardPublicKey();
 	QByteArray mutualAuthenticationCardData = cmac.generate(uncompressedCardPublicKey);
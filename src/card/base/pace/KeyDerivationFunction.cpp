@@ -2,7 +2,6 @@
  * \copyright Copyright (c) 2014-2018 Governikus GmbH & Co. KG, Germany
  */
 
-#include "asn1/KnownOIDs.h"
 #include "pace/KeyDerivationFunction.h"
 
 #include <QLoggingCategory>
@@ -14,38 +13,22 @@ using namespace governikus;
 Q_DECLARE_LOGGING_CATEGORY(card)
 
 
-KeyDerivationFunction::KeyDerivationFunction(const QByteArray& pPaceAlgorithm)
+KeyDerivationFunction::KeyDerivationFunction(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm)
 	: mHashAlgorithm()
 	, mKeySize(0)
 {
-	using namespace KnownOIDs;
-
-	if (pPaceAlgorithm == id_PACE::DH::GM_3DES_CBC_CBC || pPaceAlgorithm == id_PACE::DH::IM_3DES_CBC_CBC || pPaceAlgorithm == id_PACE::ECDH::GM_3DES_CBC_CBC
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_3DES_CBC_CBC)
-	{
-		qCCritical(card) << "3DES not supported";
-	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_128 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_128 || pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_128
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_128)
+	if (pPaceAlgorithm == nullptr)
 	{
-		mHashAlgorithm = QCryptographicHash::Sha1;
-		mKeySize = 16;
+		qCCritical(card) << "Unknown algorithm";
 	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_192 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_192 || pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_192
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_192)
+	else if (pPaceAlgorithm->mCipher == KnownOIDs::Cipher::DES3_CBC_CBC)
 	{
-		mHashAlgorithm = QCryptographicHash::Sha256;
-		mKeySize = 24;
-	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_256 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_256 || pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_256
-			|| pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_256)
-	{
-		mHashAlgorithm = QCryptographicHash::Sha256;
-		mKeySize = 32;
+		qCCritical(card) << "3DES not supported";
 	}
 	else
 	{
-		qCCritical(card) << "Unknown algorithm: " << pPaceAlgorithm;
+		mHashAlgorithm = pPaceAlgorithm->mHashAlgorithm;
+		mKeySize = pPaceAlgorithm->mKeySize;
 	}
 }
 
@@ -61,15 +44,15 @@ bool KeyDerivationFunction::isInitialized()
 }
 
 
-QByteArray KeyDerivationFunction::enc(const QByteArray& pSecret)
+QByteArray KeyDerivationFunction::enc(const QByteArray& pSecret, const QByteArray& pNonce)
 {
-	return deriveKey(pSecret, QByteArray(), 1);
+	return deriveKey(pSecret, pNonce, 1);
 }
 
 
-QByteArray KeyDerivationFunction::mac(const QByteArray& pSecret)
+QByteArray KeyDerivationFunction::mac(const QByteArray& pSecret, const QByteArray& pNonce)
 {
-	return deriveKey(pSecret, QByteArray(), 2);
+	return deriveKey(pSecret, pNonce, 2);
 }
 
 
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "asn1/KnownOIDs.h"
+
 #include <QByteArray>
 #include <QCryptographicHash>
 #include <QString>
@@ -24,9 +26,9 @@ class KeyDerivationFunction
 		/*!
 		 * \brief Creates a new instance with derivation function algorithm determined by parameter.
 		 * \param pPaceAlgorithm algorithm of PACE protocol. This will determine the key derivation algorithm to use. E.g. a
-		 *        PACE protocol of id_PACE::DH::GM_AES_CBC_CMAC_128 will result in SHA256 to be used internally to derive keys.
+		 *        PACE protocol of id_PACE::DH::GM_AES_CBC_CMAC_192 will result in SHA256 to be used internally to derive keys.
 		 */
-		KeyDerivationFunction(const QByteArray& pPaceAlgorithm);
+		KeyDerivationFunction(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm);
 		virtual ~KeyDerivationFunction();
 
 		/*!
@@ -37,16 +39,18 @@ class KeyDerivationFunction
 		/*!
 		 * \brief Derive the encryption key
 		 * \param pSecret the secret to use.
+		 * \param pNonce the nonce of Chip Authentication or empty for PACE.
 		 * \return the encryption key
 		 */
-		QByteArray enc(const QByteArray& pSecret);
+		QByteArray enc(const QByteArray& pSecret, const QByteArray& pNonce = QByteArray());
 
 		/*!
 		 * \brief Derive the MAC key
 		 * \param pSecret the secret to use.
+		 * \param pNonce the nonce of Chip Authentication or empty for PACE.
 		 * \return the MAC key
 		 */
-		QByteArray mac(const QByteArray& pSecret);
+		QByteArray mac(const QByteArray& pSecret, const QByteArray& pNonce = QByteArray());
 
 		/*!
 		 * \brief Derive the password key
@@ -44,6 +44,16 @@ QByteArray PaceHandler::getPaceProtocol() const
 }
 
 
+const KnownOIDs::ProtocolDescriptor* PaceHandler::getPaceProtocolDescriptor() const
+{
+	if (!mPaceInfo)
+	{
+		return nullptr;
+	}
+	return mPaceInfo->getProtocolDescriptor();
+}
+
+
 CardReturnCode PaceHandler::establishPaceChannel(PACE_PASSWORD_ID pPasswordId, const QString& pPassword)
 {
 	auto efCardAccess = mCardConnectionWorker->getReaderInfo().getCardInfo().getEfCardAccess();
@@ -130,11 +140,9 @@ bool PaceHandler::isSupportedProtocol(const QSharedPointer<const PACEInfo>& pPac
 		return false;
 	}
 
-	const auto protocol = pPaceInfo->getProtocol();
+	const auto* protocol = pPaceInfo->getProtocolDescriptor();
 
-	if (protocol == KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128 ||
-			protocol == KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_192 ||
-			protocol == KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256)
+	if (protocol->mEcdh && protocol->mMapping == KnownOIDs::Mapping::GM && protocol->mCipher == KnownOIDs::Cipher::AES_CBC_CMAC)
 	{
 		if (pPaceInfo->isStandardizedDomainParameters())
 		{
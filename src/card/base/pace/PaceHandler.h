@@ -114,6 +114,12 @@ class PaceHandler
 		 * \return the PACE protocol OID as string.
 		 */
 		QByteArray getPaceProtocol() const;
+
+		/*!
+		 * The algorithms of the used PACE protocol.
+		 * \return the descriptor or nullptr, if no PACE protocol was chosen.
+		 */
+		const KnownOIDs::ProtocolDescriptor* getPaceProtocolDescriptor() const;
 };
 
 } /* namespace governikus */
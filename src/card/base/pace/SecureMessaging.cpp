@@ -34,7 +34,7 @@ IMPLEMENT_ASN1_OBJECT(SM_PROTECTED_LE)
 }  // namespace governikus
 
 
-SecureMessaging::SecureMessaging(const QByteArray& pPaceAlgorithm, const QByteArray& pEncKey, const QByteArray& pMacKey)
+SecureMessaging::SecureMessaging(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm, const QByteArray& pEncKey, const QByteArray& pMacKey)
 	: mCipher(pPaceAlgorithm, pEncKey)
 	, mCipherMac(pPaceAlgorithm, pMacKey)
 	, mSendSequenceCounter(0)
@@ -63,6 +63,7 @@ QByteArray SecureMessaging::padToCipherBlockSize(const QByteArray& pData) const
 	int paddingSize = (remainder == 0) ? mCipher.getBlockSize() : mCipher.getBlockSize() - remainder;
 
 	QByteArray paddedData;
+	paddedData.reserve(pData.size() + paddingSize);
 	paddedData += pData;
 	paddedData += ISO_LEADING_PAD_BYTE;
 	paddedData += QByteArray(paddingSize - 1, ISO_PAD_BYTE);
@@ -104,9 +105,10 @@ CommandApdu SecureMessaging::encrypt(const CommandApdu& pCommandApdu)
 	qCDebug(secure) << "Plain CommandApdu: " << pCommandApdu.getBuffer().toHex();
 
 	QByteArray formattedEncryptedData;
-	if (!pCommandApdu.getData().isEmpty())
+	const QByteArray commandData = pCommandApdu.getDataView();
+	if (!commandData.isEmpty())
 	{
-		QByteArray paddedCommandData = padToCipherBlockSize(pCommandApdu.getData());
+		QByteArray paddedCommandData = padToCipherBlockSize(commandData);
 		mCipher.setIv(getEncryptedIv());
 		QByteArray encryptedData = mCipher.encrypt(paddedCommandData).prepend(0x01);
 
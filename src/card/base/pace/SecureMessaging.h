@@ -44,7 +44,7 @@ class SecureMessaging
 		QByteArray createSecuredLe(int pLe);
 
 	public:
-		SecureMessaging(const QByteArray& pPaceAlgorithm, const QByteArray& pEncKey, const QByteArray& pMacKey);
+		SecureMessaging(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm, const QByteArray& pEncKey, const QByteArray& pMacKey);
 		virtual ~SecureMessaging();
 
 		/*!
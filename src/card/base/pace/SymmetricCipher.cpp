@@ -2,7 +2,6 @@
  * \copyright Copyright (c) 2014-2018 Governikus GmbH & Co. KG, Germany
  */
 
-#include "asn1/KnownOIDs.h"
 #include "pace/SymmetricCipher.h"
 
 #include <openssl/evp.h>
@@ -15,39 +14,41 @@ using namespace governikus;
 Q_DECLARE_LOGGING_CATEGORY(card)
 
 
-SymmetricCipher::SymmetricCipher(const QByteArray& pPaceAlgorithm, const QByteArray& pKeyBytes)
+SymmetricCipher::SymmetricCipher(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm, const QByteArray& pKeyBytes)
 	: mCtx(nullptr)
 	, mCipher(nullptr)
 	, mIv()
 	, mKeyBytes(pKeyBytes)
 {
-	using namespace governikus::KnownOIDs;
-
-	if (pPaceAlgorithm == id_PACE::DH::GM_3DES_CBC_CBC || pPaceAlgorithm == id_PACE::DH::IM_3DES_CBC_CBC
-			|| pPaceAlgorithm == id_PACE::ECDH::GM_3DES_CBC_CBC || pPaceAlgorithm == id_PACE::ECDH::IM_3DES_CBC_CBC)
+	if (pPaceAlgorithm == nullptr)
 	{
-		qCCritical(card) << "3DES not supported";
+		qCCritical(card) << "Unknown algorithm";
 		return;
 	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_128 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_128
-			|| pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_128 || pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_128)
-	{
-		mCipher = EVP_aes_128_cbc();
-	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_192 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_192
-			|| pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_192 || pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_192)
-	{
-		mCipher = EVP_aes_192_cbc();
-	}
-	else if (pPaceAlgorithm == id_PACE::DH::GM_AES_CBC_CMAC_256 || pPaceAlgorithm == id_PACE::DH::IM_AES_CBC_CMAC_256
-			|| pPaceAlgorithm == id_PACE::ECDH::GM_AES_CBC_CMAC_256 || pPaceAlgorithm == id_PACE::ECDH::IM_AES_CBC_CMAC_256)
+
+	if (pPaceAlgorithm->mCipher == KnownOIDs::Cipher::DES3_CBC_CBC)
 	{
-		mCipher = EVP_aes_256_cbc();
+		qCCritical(card) << "3DES not supported";
+		return;
 	}
-	else
+
+	switch (pPaceAlgorithm->mKeySize)
 	{
-		qCCritical(card) << "Unknown algorithm: " << pPaceAlgorithm;
-		return;
+		case 16:
+			mCipher = EVP_aes_128_cbc();
+			break;
+
+		case 24:
+			mCipher = EVP_aes_192_cbc();
+			break;
+
+		case 32:
+			mCipher = EVP_aes_256_cbc();
+			break;
+
+		default:
+			qCCritical(card) << "Unknown key size:" << pPaceAlgorithm->mKeySize;
+			return;
 	}
 
 	mIv.fill(0, EVP_CIPHER_iv_length(mCipher));
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "asn1/KnownOIDs.h"
+
 #include <openssl/evp.h>
 #include <QByteArray>
 
@@ -28,7 +30,7 @@ class SymmetricCipher
 		 *        PACE protocol of id_PACE::DH::GM_AES_CBC_CMAC_128 will result in AES to be used.
 		 * \param pKeyBytes the bytes of the key
 		 */
-		SymmetricCipher(const QByteArray& pPaceAlgorithm, const QByteArray& pKeyBytes);
+		SymmetricCipher(const KnownOIDs::ProtocolDescriptor* pPaceAlgorithm, const QByteArray& pKeyBytes);
 		~SymmetricCipher();
 
 		/*!
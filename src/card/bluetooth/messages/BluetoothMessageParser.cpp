@@ -30,8 +30,9 @@ Q_DECLARE_LOGGING_CATEGORY(card)
 
 
 BluetoothMessageParser::BluetoothMessageParser(const QByteArray& pData)
-	: mMessages()
-	, mRemainingBytes(pData)
+	: mData(pData)
+	, mMessages()
+	, mRemainingBytes()
 {
 	parse();
 }
@@ -45,67 +46,68 @@ BluetoothMessageParser::~BluetoothMessageParser()
 
 void BluetoothMessageParser::parse()
 {
-	while (mRemainingBytes.size() >= 4)
+	int offset = 0;
+	while (mData.size() - offset >= 4)
 	{
-		BluetoothMsgId msgId = static_cast<BluetoothMsgId>(mRemainingBytes.at(0));
-		int parameterCount = mRemainingBytes.at(1);
+		BluetoothMsgId msgId = static_cast<BluetoothMsgId>(mData.at(offset));
+		int parameterCount = mData.at(offset + 1);
 		auto message = createMessage(msgId);
 
-		if (parseParameter(message, parameterCount))
+		int parameterOffset = offset + 4; // skip the message header
+		if (parseParameter(message, parameterCount, parameterOffset))
 		{
 			mMessages += message;
+			offset = parameterOffset;
 		}
 		else
 		{
 			break;
 		}
 	}
+
+	mRemainingBytes = offset == 0 ? mData : mData.mid(offset);
 }
 
 
-bool BluetoothMessageParser::parseParameter(QSharedPointer<BluetoothMessage> pMessage, int pParamCount)
+bool BluetoothMessageParser::parseParameter(const QSharedPointer<BluetoothMessage>& pMessage, int pParamCount, int& pOffset) const
 {
-	QByteArray data = mRemainingBytes.mid(4); // the message header is parsed by parse(QByteArray)
-
+	int offset = pOffset;
 	for (int i = 0; i < pParamCount; ++i)
 	{
-		if (data.size() >= 4)
+		if (mData.size() - offset < 4)
 		{
-			BluetoothParamId paramId = static_cast<BluetoothParamId>(data.at(0));
-			ushort paramLength = getParamLength(static_cast<uchar>(data.at(2)), static_cast<uchar>(data.at(3)));
-			data = data.mid(4);
-
-			/*!
-			 * According to the SAP specification, see chapter 5.1
-			 * "The length of each Parameter shall be a multiple of four bytes. Therefore, one to three
-			 *   additional bytes have to be added directly after the "Parameter Value""
-			 */
-			if (data.size() >= paramLength + BluetoothUtils::getPaddingLength(paramLength))
-			{
-				QByteArray value = data.mid(0, paramLength);
-				auto param = createMessageParameter(paramId, value);
-				pMessage->addParameter(param);
-				data = data.mid(paramLength + BluetoothUtils::getPaddingLength(paramLength));
-			}
-			else
-			{
-				return false;
-			}
+			return false;
 		}
-		else
+
+		BluetoothParamId paramId = static_cast<BluetoothParamId>(mData.at(offset));
+		ushort paramLength = getParamLength(offset);
+		offset += 4;
+
+		/*!
+		 * According to the SAP specification, see chapter 5.1
+		 * "The length of each Parameter shall be a multiple of four bytes. Therefore, one to three
+		 *   additional bytes have to be added directly after the "Parameter Value""
+		 */
+		const int paddedLength = paramLength + BluetoothUtils::getPaddingLength(paramLength);
+		if (mData.size() - offset < paddedLength)
 		{
 			return false;
 		}
+
+		pMessage->addParameter(createMessageParameter(paramId, offset, paramLength));
+		offset += paddedLength;
 	}
 
-	mRemainingBytes = data;
+	pOffset = offset;
 	return true;
 }
 
 
-ushort BluetoothMessageParser::getParamLength(uchar pHigh, uchar pLow) const
+ushort BluetoothMessageParser::getParamLength(int pOffset) const
 {
-	return static_cast<ushort>((pHigh << 8) + pLow);
+	const auto high = static_cast<uchar>(mData.at(pOffset + 2));
+	const auto low = static_cast<uchar>(mData.at(pOffset + 3));
+	return static_cast<ushort>((high << 8) + low);
 }
 
 
@@ -121,7 +123,7 @@ const QByteArray& BluetoothMessageParser::getRemainingBytes() const
 }
 
 
-QSharedPointer<BluetoothMessage> BluetoothMessageParser::createMessage(BluetoothMsgId pMsgId)
+QSharedPointer<BluetoothMessage> BluetoothMessageParser::createMessage(BluetoothMsgId pMsgId) const
 {
 	BluetoothMessage* msg = nullptr;
 
@@ -172,39 +174,38 @@ QSharedPointer<BluetoothMessage> BluetoothMessageParser::createMessage(Bluetooth
 }
 
 
-QSharedPointer<BluetoothMessageParameter> BluetoothMessageParser::createMessageParameter(BluetoothParamId pParamId,
-		const QByteArray& pValue)
+QSharedPointer<BluetoothMessageParameter> BluetoothMessageParser::createMessageParameter(BluetoothParamId pParamId, int pOffset, int pLength) const
 {
 	BluetoothMessageParameter* param = nullptr;
 
 	switch (pParamId)
 	{
 		case BluetoothParamId::StatusChange:
-			param = new BluetoothMessageParameterStatusChange(pValue);
+			param = new BluetoothMessageParameterStatusChange(mData.mid(pOffset, pLength));
 			break;
 
 		case BluetoothParamId::ResultCode:
-			param = new BluetoothMessageParameterResultCode(pValue);
+			param = new BluetoothMessageParameterResultCode(mData.mid(pOffset, pLength));
 			break;
 
 		case BluetoothParamId::ConnectionStatus:
-			param = new BluetoothMessageParameterConnectionStatus(pValue);
+			param = new BluetoothMessageParameterConnectionStatus(mData.mid(pOffset, pLength));
 			break;
 
 		case BluetoothParamId::ResponseAPDU:
-			param = new BluetoothMessageParameterApduResponse(pValue);
+			param = new BluetoothMessageParameterApduResponse(mData, pOffset, pLength);
 			break;
 
 		case BluetoothParamId::MaxMsgSize:
-			param = new BluetoothMessageParameterMaxMsgSize(pValue);
+			param = new BluetoothMessageParameterMaxMsgSize(mData.mid(pOffset, pLength));
 			break;
 
 		case BluetoothParamId::CardReaderStatus:
-			param = new BluetoothMessageParameterCardReaderStatus(pValue);
+			param = new BluetoothMessageParameterCardReaderStatus(mData.mid(pOffset, pLength));
 			break;
 
 		default:
-			param = new BluetoothMessageParameter(pParamId, pValue);
+			param = new BluetoothMessageParameter(pParamId, mData, pOffset, pLength);
 	}
 
 	Q_ASSERT(param != nullptr);
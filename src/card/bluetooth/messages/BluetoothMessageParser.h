@@ -1,6 +1,10 @@
 /*!
  * \brief Parses messages of bluetooth SIM ACCESS protocol.
  *
+ * The input is parsed in a single pass by moving an offset over the buffer.
+ * Large parameter values like response APDUs reference the shared input
+ * buffer instead of copying it.
+ *
  * \copyright Copyright (c) 2015-2018 Governikus GmbH & Co. KG, Germany
  */
 
@@ -14,15 +18,16 @@ namespace governikus
 class BluetoothMessageParser
 {
 	private:
+		QByteArray mData;
 		QVector<BluetoothMessage::Ptr> mMessages;
 		QByteArray mRemainingBytes;
 
-		inline ushort getParamLength(uchar pHigh, uchar pLow) const;
+		inline ushort getParamLength(int pOffset) const;
 		void parse();
-		bool parseParameter(QSharedPointer<BluetoothMessage> pMessage, int pParamCount);
+		bool parseParameter(const QSharedPointer<BluetoothMessage>& pMessage, int pParamCount, int& pOffset) const;
 
-		QSharedPointer<BluetoothMessage> createMessage(BluetoothMsgId pMsgId);
-		QSharedPointer<BluetoothMessageParameter> createMessageParameter(BluetoothParamId pParamId, const QByteArray& pValue);
+		QSharedPointer<BluetoothMessage> createMessage(BluetoothMsgId pMsgId) const;
+		QSharedPointer<BluetoothMessageParameter> createMessageParameter(BluetoothParamId pParamId, int pOffset, int pLength) const;
 
 	public:
 		BluetoothMessageParser(const QByteArray& pData);
@@ -32,7 +32,7 @@ bool BluetoothMessageTransferApduResponse::hasResponseAPDU() const
 }
 
 
-const QByteArray& BluetoothMessageTransferApduResponse::getResponseAPDU() const
+QByteArray BluetoothMessageTransferApduResponse::getResponseAPDU() const
 {
 	const auto& param = getParameter(BluetoothParamId::ResponseAPDU);
 	return param.staticCast<const BluetoothMessageParameterApduResponse>()->getResponseApdu();
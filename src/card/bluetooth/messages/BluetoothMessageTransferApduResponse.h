@@ -21,7 +21,7 @@ class BluetoothMessageTransferApduResponse
 
 		BluetoothResultCode getResultCode() const;
 		bool hasResponseAPDU() const;
-		const QByteArray& getResponseAPDU() const;
+		QByteArray getResponseAPDU() const;
 };
 
 } /* namespace governikus */
@@ -20,12 +20,23 @@ QDebug operator<<(QDebug pDbg, const BluetoothMessageParameter& pMsg)
 
 BluetoothMessageParameter::BluetoothMessageParameter(BluetoothParamId pParamId, const QByteArray& pValue)
 	: mParamId(pParamId)
+	, mBuffer()
 	, mValue(pValue)
 	, mValid(true)
 {
 }
 
 
+BluetoothMessageParameter::BluetoothMessageParameter(BluetoothParamId pParamId, const QByteArray& pBuffer, int pOffset, int pLength)
+	: mParamId(pParamId)
+	, mBuffer(pBuffer)
+	, mValue(QByteArray::fromRawData(mBuffer.constData() + pOffset, pLength))
+	, mValid(true)
+{
+	Q_ASSERT(pOffset >= 0 && pLength >= 0 && pOffset + pLength <= mBuffer.size());
+}
+
+
 BluetoothMessageParameter::~BluetoothMessageParameter()
 {
 }
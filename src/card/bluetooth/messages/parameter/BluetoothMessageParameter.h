@@ -18,6 +18,7 @@ class BluetoothMessageParameter
 {
 	private:
 		BluetoothParamId mParamId;
+		QByteArray mBuffer;
 
 	protected:
 		QByteArray mValue;
@@ -53,6 +54,12 @@ class BluetoothMessageParameter
 		using Ptr = QSharedPointer<const BluetoothMessageParameter>;
 
 		BluetoothMessageParameter(BluetoothParamId pParamId, const QByteArray& pValue);
+
+		/*!
+		 * Creates a parameter whose value references pLength bytes at pOffset of pBuffer without copying them.
+		 * The parameter keeps a shared reference to pBuffer, so pBuffer must own its data.
+		 */
+		BluetoothMessageParameter(BluetoothParamId pParamId, const QByteArray& pBuffer, int pOffset, int pLength);
 		virtual ~BluetoothMessageParameter();
 
 		BluetoothParamId getParameterId() const;
@@ -12,19 +12,27 @@ BluetoothMessageParameterApduResponse::BluetoothMessageParameterApduResponse(con
 }
 
 
+BluetoothMessageParameterApduResponse::BluetoothMessageParameterApduResponse(const QByteArray& pBuffer, int pOffset, int pLength)
+	: BluetoothMessageParameter(BluetoothParamId::ResponseAPDU, pBuffer, pOffset, pLength)
+{
+}
+
+
 BluetoothMessageParameterApduResponse::~BluetoothMessageParameterApduResponse()
 {
 }
 
 
-const QByteArray& BluetoothMessageParameterApduResponse::getResponseApdu() const
+QByteArray BluetoothMessageParameterApduResponse::getResponseApdu() const
 {
-	return getValue();
+	// The value may reference the buffer of the parsed message, so detach it.
+	const QByteArray& value = getValue();
+	return QByteArray(value.constData(), value.size());
 }
 
 
 QString BluetoothMessageParameterApduResponse::toStringValue() const
 {
-	const QString responseApdu = QString::fromLatin1(getResponseApdu().toHex());
+	const QString responseApdu = QString::fromLatin1(getValue().toHex());
 	return QStringLiteral("(ResponseApdu: %1)").arg(responseApdu);
 }
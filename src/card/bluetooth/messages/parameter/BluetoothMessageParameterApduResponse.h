@@ -16,9 +16,13 @@ class BluetoothMessageParameterApduResponse
 {
 	public:
 		BluetoothMessageParameterApduResponse(const QByteArray& pApdu);
+		BluetoothMessageParameterApduResponse(const QByteArray& pBuffer, int pOffset, int pLength);
 		virtual ~BluetoothMessageParameterApduResponse() override;
 
-		const QByteArray& getResponseApdu() const;
+		/*!
+		 * Returns a copy of the response APDU that stays valid after the message is destroyed.
+		 */
+		QByteArray getResponseApdu() const;
 		virtual QString toStringValue() const override;
 };
 
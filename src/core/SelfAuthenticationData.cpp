@@ -6,7 +6,6 @@
 
 #include "LanguageLoader.h"
 
-#include <QDomDocument>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(secure)
@@ -56,21 +55,65 @@ SelfAuthenticationData::SelfData::SelfData(const QByteArray& pData)
 	}
 	qCDebug(secure) << "parsing data:" << pData;
 
-	QDomDocument doc(QStringLiteral("dataXML"));
+	// The response is parsed in a single pass. The permissions of the structured
+	// place of residence can only be derived after both sections were read.
+	QXmlStreamReader reader(pData);
+	QVector<SelfAuthData> placeOfResidenceData;
+	bool rootElement = true;
+	bool operationsAllowedFound = false;
+	bool personalDataFound = false;
+	while (!reader.atEnd())
+	{
+		if (reader.readNext() != QXmlStreamReader::StartElement)
+		{
+			continue;
+		}
 
-	QString errorMsg;
-	int errorLine;
-	int errorColumn;
-	if (!doc.setContent(pData, true, &errorMsg, &errorLine, &errorColumn))
+		if (rootElement)
+		{
+			rootElement = false;
+		}
+		else if (!operationsAllowedFound && reader.name() == QLatin1String("OperationsAllowedByUser"))
+		{
+			operationsAllowedFound = true;
+			parseOperationsAllowedByUser(reader);
+		}
+		else if (!personalDataFound && reader.name() == QLatin1String("PersonalData"))
+		{
+			personalDataFound = true;
+			parsePersonalData(reader, placeOfResidenceData);
+		}
+	}
+
+	if (reader.hasError())
+	{
+		qDebug() << "XML parsing failed. No valid values to parse. Error in line" << reader.lineNumber() << "column"
+				 << reader.columnNumber() << ":" << reader.errorString();
+		mOperationsAllowed.clear();
+		mSelfAuthData.clear();
+		return;
+	}
+
+	if (!operationsAllowedFound)
 	{
-		qDebug() << "XML parsing failed. No valid values to parse. Error in line" << errorLine << "column"
-				 << errorColumn << ":" << errorMsg;
+		qCritical() << "XML parsing failed. No valid values to parse for:" << QStringLiteral("OperationsAllowedByUser");
+		mOperationsAllowed.clear();
+		mSelfAuthData.clear();
 		return;
 	}
 
-	const auto& parseOperations = std::bind(&SelfAuthenticationData::SelfData::parseOperationsAllowedByUser, this, std::placeholders::_1);
-	const auto& parsePersonal = std::bind(&SelfAuthenticationData::SelfData::parsePersonalData, this, std::placeholders::_1);
-	mValid = parse(doc, QStringLiteral("OperationsAllowedByUser"), parseOperations) && parse(doc, QStringLiteral("PersonalData"), parsePersonal);
+	if (!personalDataFound)
+	{
+		qCritical() << "XML parsing failed. No valid values to parse for:" << QStringLiteral("PersonalData");
+		return;
+	}
+
+	const auto placeOfResidencePermission = mOperationsAllowed.value(SelfAuthData::PlaceOfResidence);
+	for (const auto authData : qAsConst(placeOfResidenceData))
+	{
+		mOperationsAllowed.insert(authData, placeOfResidencePermission);
+	}
+	mValid = true;
 }
 
 
@@ -94,107 +137,186 @@ QString SelfAuthenticationData::SelfData::getValue(SelfAuthData pData) const
 }
 
 
-bool SelfAuthenticationData::SelfData::parseOperationsAllowedByUser(const QDomElement& pElement)
+QString SelfAuthenticationData::SelfData::readText(QXmlStreamReader& pReader)
 {
-	for (auto elem = pElement; !elem.isNull(); elem = elem.nextSiblingElement())
+	// Collect the text of the current element and its children like QDomElement::text(),
+	// which ignores text nodes consisting of whitespace only. The result is null if
+	// there is no text at all.
+	QString text;
+	QString pending;
+	for (int depth = 1; depth > 0 && !pReader.atEnd();)
 	{
-		auto authData = Enum<SelfAuthData>::fromString(elem.tagName(), SelfAuthData::UNKNOWN);
+		const auto token = pReader.readNext();
+		if (token == QXmlStreamReader::Characters)
+		{
+			pending += pReader.text();
+			continue;
+		}
+
+		if (!pending.trimmed().isEmpty())
+		{
+			text += pending;
+		}
+		pending.clear();
+
+		if (token == QXmlStreamReader::StartElement)
+		{
+			++depth;
+		}
+		else if (token == QXmlStreamReader::EndElement)
+		{
+			--depth;
+		}
+	}
+	return text;
+}
+
+
+QString SelfAuthenticationData::SelfData::readChildText(QXmlStreamReader& pReader, const QString& pChildName)
+{
+	QString text;
+	bool found = false;
+	while (pReader.readNextStartElement())
+	{
+		if (!found && pReader.name() == pChildName)
+		{
+			found = true;
+			text = readText(pReader);
+		}
+		else
+		{
+			pReader.skipCurrentElement();
+		}
+	}
+	return text;
+}
+
+
+void SelfAuthenticationData::SelfData::parseOperationsAllowedByUser(QXmlStreamReader& pReader)
+{
+	while (pReader.readNextStartElement())
+	{
+		const QString& tagName = pReader.name().toString();
+		auto authData = Enum<SelfAuthData>::fromString(tagName, SelfAuthData::UNKNOWN);
 		if (authData == SelfAuthData::UNKNOWN)
 		{
-			qWarning() << "SelfAuthData is unknown:" << elem.tagName();
+			qWarning() << "SelfAuthData is unknown:" << tagName;
+			pReader.skipCurrentElement();
 			continue;
 		}
 
-		auto permission = Enum<SelfAuthDataPermission>::fromString(elem.text(), SelfAuthDataPermission::UNKNOWN);
+		auto permission = Enum<SelfAuthDataPermission>::fromString(readText(pReader), SelfAuthDataPermission::UNKNOWN);
 		if (permission == SelfAuthDataPermission::UNKNOWN)
 		{
-			qWarning() << "SelfAuthDataPermission is unknown:" << elem.tagName();
+			qWarning() << "SelfAuthDataPermission is unknown:" << tagName;
 			continue;
 		}
 
 		mOperationsAllowed.insert(authData, permission);
 	}
-
-	return true;
 }
 
 
-bool SelfAuthenticationData::SelfData::parsePersonalData(const QDomElement& pElement)
+void SelfAuthenticationData::SelfData::parsePersonalData(QXmlStreamReader& pReader, QVector<SelfAuthData>& pPlaceOfResidenceData)
 {
-	for (auto elem = pElement; !elem.isNull(); elem = elem.nextSiblingElement())
+	while (pReader.readNextStartElement())
 	{
-		auto authData = Enum<SelfAuthData>::fromString(elem.tagName(), SelfAuthData::UNKNOWN);
+		const QString& tagName = pReader.name().toString();
+		auto authData = Enum<SelfAuthData>::fromString(tagName, SelfAuthData::UNKNOWN);
 		if (authData == SelfAuthData::UNKNOWN)
 		{
-			qWarning() << "PersonalData is unknown:" << elem.tagName();
+			qWarning() << "PersonalData is unknown:" << tagName;
+			pReader.skipCurrentElement();
 			continue;
 		}
 
 		if (authData == SelfAuthData::DateOfBirth)
 		{
-			tryToInsertChild(elem.firstChildElement(QStringLiteral("DateValue")), authData);
+			tryToInsert(readChildText(pReader, QStringLiteral("DateValue")), authData);
 		}
 		else if (authData == SelfAuthData::PlaceOfBirth)
 		{
-			tryToInsertChild(elem.firstChildElement(QStringLiteral("FreetextPlace")), authData);
+			tryToInsert(readChildText(pReader, QStringLiteral("FreetextPlace")), authData);
 		}
 		else if (authData == SelfAuthData::PlaceOfResidence)
 		{
-			if (tryToInsertChild(elem.firstChildElement(QStringLiteral("NoPlaceInfo")), SelfAuthData::PlaceOfResidenceNoPlaceInfo))
-			{
-				mOperationsAllowed.insert(SelfAuthData::PlaceOfResidenceNoPlaceInfo, mOperationsAllowed.value(authData));
-			}
-			else
+			parsePlaceOfResidence(pReader, pPlaceOfResidenceData);
+		}
+		else
+		{
+			tryToInsert(readText(pReader), authData);
+		}
+	}
+}
+
+
+void SelfAuthenticationData::SelfData::parsePlaceOfResidence(QXmlStreamReader& pReader, QVector<SelfAuthData>& pPlaceOfResidenceData)
+{
+	static const QMap<QString, SelfAuthData> placeInfo = {
+		{QStringLiteral("City"), SelfAuthData::PlaceOfResidenceCity},
+		{QStringLiteral("Country"), SelfAuthData::PlaceOfResidenceCountry},
+		{QStringLiteral("Street"), SelfAuthData::PlaceOfResidenceStreet},
+		{QStringLiteral("ZipCode"), SelfAuthData::PlaceOfResidenceZipCode}
+	};
+
+	QString noPlaceInfo;
+	bool noPlaceInfoFound = false;
+	bool structuredPlaceFound = false;
+	QMap<SelfAuthData, QString> structuredPlace;
+	while (pReader.readNextStartElement())
+	{
+		if (!noPlaceInfoFound && pReader.name() == QLatin1String("NoPlaceInfo"))
+		{
+			noPlaceInfoFound = true;
+			noPlaceInfo = readText(pReader);
+		}
+		else if (!structuredPlaceFound && pReader.name() == QLatin1String("StructuredPlace"))
+		{
+			structuredPlaceFound = true;
+			while (pReader.readNextStartElement())
 			{
-				static const QMap<QString, SelfAuthData> placeInfo = {
-					{QStringLiteral("City"), SelfAuthData::PlaceOfResidenceCity},
-					{QStringLiteral("Country"), SelfAuthData::PlaceOfResidenceCountry},
-					{QStringLiteral("Street"), SelfAuthData::PlaceOfResidenceStreet},
-					{QStringLiteral("ZipCode"), SelfAuthData::PlaceOfResidenceZipCode}
-				};
-
-				auto structuredPlace = elem.firstChildElement(QStringLiteral("StructuredPlace"));
-				for (auto iter = placeInfo.constBegin(); iter != placeInfo.constEnd(); ++iter)
+				const auto authData = placeInfo.value(pReader.name().toString(), SelfAuthData::UNKNOWN);
+				if (authData != SelfAuthData::UNKNOWN && !structuredPlace.contains(authData))
+				{
+					structuredPlace.insert(authData, readText(pReader));
+				}
+				else
 				{
-					if (tryToInsertChild(structuredPlace.firstChildElement(iter.key()), iter.value()))
-					{
-						mOperationsAllowed.insert(iter.value(), mOperationsAllowed.value(authData));
-					}
+					pReader.skipCurrentElement();
 				}
 			}
 		}
 		else
 		{
-			tryToInsertChild(elem, authData);
+			pReader.skipCurrentElement();
 		}
 	}
 
-	return true;
-}
-
-
-bool SelfAuthenticationData::SelfData::tryToInsertChild(const QDomElement& pElement, SelfAuthData pAuthData)
-{
-	if (pElement.isNull() || pElement.text().isNull())
+	if (tryToInsert(noPlaceInfo, SelfAuthData::PlaceOfResidenceNoPlaceInfo))
 	{
-		return false;
+		pPlaceOfResidenceData += SelfAuthData::PlaceOfResidenceNoPlaceInfo;
+		return;
 	}
 
-	mSelfAuthData.insert(pAuthData, pElement.text());
-	return true;
+	for (auto iter = structuredPlace.constBegin(); iter != structuredPlace.constEnd(); ++iter)
+	{
+		if (tryToInsert(iter.value(), iter.key()))
+		{
+			pPlaceOfResidenceData += iter.key();
+		}
+	}
 }
 
 
-bool SelfAuthenticationData::SelfData::parse(const QDomDocument& pDoc, const QString& pElementName, const std::function<bool(const QDomElement&)>& pParserFunc)
+bool SelfAuthenticationData::SelfData::tryToInsert(const QString& pText, SelfAuthData pAuthData)
 {
-	const QDomNodeList nodeList = pDoc.documentElement().elementsByTagName(pElementName);
-	if (nodeList.size() == 0)
+	if (pText.isNull())
 	{
-		qCritical() << "XML parsing failed. No valid values to parse for:" << pElementName;
 		return false;
 	}
 
-	return pParserFunc(nodeList.at(0).toElement().firstChildElement());
+	mSelfAuthData.insert(pAuthData, pText);
+	return true;
 }
 
 
@@ -8,16 +8,14 @@
 
 #include "EnumHelper.h"
 
-#include <functional>
-
 #include <QCoreApplication>
 #include <QDateTime>
-#include <QDomElement>
 #include <QMap>
 #include <QPair>
 #include <QSharedData>
 #include <QString>
 #include <QVector>
+#include <QXmlStreamReader>
 
 namespace governikus
 {
@@ -66,10 +64,13 @@ class SelfAuthenticationData
 			Q_DECLARE_TR_FUNCTIONS(governikus::SelfData)
 
 			private:
-				bool parse(const QDomDocument& pDoc, const QString& pElementName, const std::function<bool(const QDomElement&)>& pParserFunc);
-				bool parseOperationsAllowedByUser(const QDomElement& pElement);
-				bool parsePersonalData(const QDomElement& pElement);
-				bool tryToInsertChild(const QDomElement& pElement, SelfAuthData pAuthData);
+				static QString readText(QXmlStreamReader& pReader);
+				static QString readChildText(QXmlStreamReader& pReader, const QString& pChildName);
+
+				void parseOperationsAllowedByUser(QXmlStreamReader& pReader);
+				void parsePersonalData(QXmlStreamReader& pReader, QVector<SelfAuthData>& pPlaceOfResidenceData);
+				void parsePlaceOfResidence(QXmlStreamReader& pReader, QVector<SelfAuthData>& pPlaceOfResidenceData);
+				bool tryToInsert(const QString& pText, SelfAuthData pAuthData);
 
 			public:
 				bool mValid;
@@ -14,6 +14,7 @@ RemoteServiceContext::RemoteServiceContext()
 	, mNewPin()
 	, mEstablishPaceChannelMessage()
 	, mModifyPinMessage()
+	, mMessageHandler()
 {
 }
 
@@ -73,6 +74,18 @@ const QSharedPointer<const IfdModifyPin>& RemoteServiceContext::getModifyPinMess
 }
 
 
+void RemoteServiceContext::setMessageHandler(const QSharedPointer<ServerMessageHandler>& pHandler)
+{
+	mMessageHandler = pHandler;
+}
+
+
+const QSharedPointer<ServerMessageHandler>& RemoteServiceContext::getMessageHandler() const
+{
+	return mMessageHandler;
+}
+
+
 void RemoteServiceContext::onResetMessageHandler()
 {
 	setCardConnection(QSharedPointer<CardConnection>());
@@ -83,4 +96,15 @@ void RemoteServiceContext::onResetMessageHandler()
 	resetLastPaceResultAndRetryCounter();
 	mEstablishPaceChannelMessage = QSharedPointer<const IfdEstablishPaceChannel>();
 	mModifyPinMessage = QSharedPointer<const IfdModifyPin>();
+	mMessageHandler.reset();
+}
+
+
+void RemoteServiceContext::onMessageHandlerClosed()
+{
+	// Other clients do not affect the request of the current one.
+	if (mMessageHandler && mMessageHandler.data() == sender())
+	{
+		onResetMessageHandler();
+	}
 }
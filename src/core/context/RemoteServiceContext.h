@@ -10,6 +10,7 @@
 #include "messages/IfdModifyPin.h"
 #include "RemoteServer.h"
 #include "SelfAuthenticationData.h"
+#include "ServerMessageHandler.h"
 #include "WorkflowContext.h"
 
 #include <QSharedPointer>
@@ -28,6 +29,7 @@ class RemoteServiceContext
 		QString mNewPin;
 		QSharedPointer<const IfdEstablishPaceChannel> mEstablishPaceChannelMessage;
 		QSharedPointer<const IfdModifyPin> mModifyPinMessage;
+		QSharedPointer<ServerMessageHandler> mMessageHandler;
 
 	Q_SIGNALS:
 		void fireCancelPasswordRequest();
@@ -48,8 +50,16 @@ class RemoteServiceContext
 		void setModifyPinMessage(const QSharedPointer<const IfdModifyPin>& pMessage);
 		const QSharedPointer<const IfdModifyPin>& getModifyPinMessage() const;
 
+		/*!
+		 * The handler of the client that sent the current EstablishPaceChannel
+		 * or ModifyPin message. The response has to be sent to this client.
+		 */
+		void setMessageHandler(const QSharedPointer<ServerMessageHandler>& pHandler);
+		const QSharedPointer<ServerMessageHandler>& getMessageHandler() const;
+
 	public Q_SLOTS:
 		void onResetMessageHandler();
+		void onMessageHandlerClosed();
 };
 
 } /* namespace governikus */
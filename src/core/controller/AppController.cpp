@@ -20,8 +20,12 @@
 #include "LanguageLoader.h"
 #include "LogHandler.h"
 #include "NetworkManager.h"
+#include "ProviderConfiguration.h"
+#include "ReaderConfiguration.h"
 #include "ReaderManager.h"
+#include "RemoteHelper.h"
 #include "ResourceLoader.h"
+#include "SecureStorage.h"
 #include "view/UILoader.h"
 #include "view/UIPlugIn.h"
 
@@ -86,14 +90,13 @@ AppController::AppController()
 	: mCurrentAction(Action::NONE)
 	, mWaitingRequest()
 	, mActiveController()
+	, mStartupTimeline()
 {
 	setObjectName(QStringLiteral("AppController"));
 
 	connect(&AppSettings::getInstance().getGeneralSettings(), &GeneralSettings::fireSettingsChanged, this, &AppController::onSettingsChanged, Qt::DirectConnection);
 	onSettingsChanged();
 
-	ResourceLoader::getInstance().init();
-
 #ifndef QT_NO_NETWORKPROXY
 	NetworkManager::setApplicationProxyFactory();
 	connect(Env::getSingleton<NetworkManager>(), &NetworkManager::fireProxyAuthenticationRequired, this, &AppController::fireProxyAuthenticationRequired);
@@ -123,19 +126,8 @@ bool AppController::eventFilter(QObject* pObj, QEvent* pEvent)
 }
 
 
-bool AppController::start()
+bool AppController::startActivationHandlers()
 {
-	ReaderManager::getInstance().init(QSharedPointer<RemoteClient>(Env::create<RemoteClient*>()));
-	connect(this, &AppController::fireShutdown, &ReaderManager::getInstance(), &ReaderManager::shutdown, Qt::DirectConnection);
-	connect(&ReaderManager::getInstance(), &ReaderManager::fireInitialized, this, &AppController::fireStarted, Qt::QueuedConnection);
-
-	connect(&UILoader::getInstance(), &UILoader::fireLoadedPlugin, this, &AppController::onUiPlugin);
-	if (!UILoader::getInstance().load())
-	{
-		qCritical() << "Cannot start without UI";
-		return false;
-	}
-
 	for (const auto& handler : ActivationHandler::getInstances())
 	{
 		connect(handler, &ActivationHandler::fireShowUserInformation, this, &AppController::fireShowUserInformation);
@@ -151,12 +143,84 @@ bool AppController::start()
 		qDebug() << "Successfully started activation handler:" << handler;
 	}
 
+	return true;
+}
+
+
+bool AppController::start()
+{
+	using Execution = StartupTimeline::Execution;
+
+	mStartupTimeline.addStep(QStringLiteral("ResourceLoader"), Execution::BLOCKING, [](){
+				ResourceLoader::getInstance().init();
+				return true;
+			});
+
+	// The secure storage is a thread-safe global static, so the first
+	// user on the main thread simply waits for the worker to finish.
+	mStartupTimeline.addStep(QStringLiteral("SecureStorage"), Execution::CONCURRENT, [](){
+				SecureStorage::getInstance();
+				return true;
+			}, {QStringLiteral("ResourceLoader")});
+
+	mStartupTimeline.addStep(QStringLiteral("ReaderManager"), Execution::BLOCKING, [this](){
+				ReaderManager::getInstance().init(QSharedPointer<RemoteClient>(Env::create<RemoteClient*>()));
+				connect(this, &AppController::fireShutdown, &ReaderManager::getInstance(), &ReaderManager::shutdown, Qt::DirectConnection);
+				connect(&ReaderManager::getInstance(), &ReaderManager::fireInitialized, this, &AppController::fireStarted, Qt::QueuedConnection);
+				return true;
+			}, {QStringLiteral("ResourceLoader")});
+
+	mStartupTimeline.addStep(QStringLiteral("UILoader"), Execution::BLOCKING, [this](){
+				connect(&UILoader::getInstance(), &UILoader::fireLoadedPlugin, this, &AppController::onUiPlugin);
+				if (!UILoader::getInstance().load())
+				{
+					qCritical() << "Cannot start without UI";
+					return false;
+				}
+				return true;
+			}, {QStringLiteral("ResourceLoader")});
+
+	mStartupTimeline.addStep(QStringLiteral("ActivationHandler"), Execution::BLOCKING, [this](){
+				return startActivationHandlers();
+			}, {QStringLiteral("UILoader")});
+
+	// The configurations are not needed by the JSON API and the CLI. They are parsed on first
+	// use anyway. Parsing them on the main thread keeps the QObjects and Env away from the workers.
+	mStartupTimeline.addStep(QStringLiteral("ProviderConfiguration"), Execution::DEFERRED, [](){
+				Env::getSingleton<ProviderConfiguration>();
+				return true;
+			}, {QStringLiteral("ResourceLoader")});
+
+	mStartupTimeline.addStep(QStringLiteral("ReaderConfiguration"), Execution::DEFERRED, [](){
+				Env::getSingleton<ReaderConfiguration>();
+				return true;
+			}, {QStringLiteral("ResourceLoader")});
+
+	// A missing identity for the remote reader is generated in background,
+	// so pairing or starting the remote service does not block on it later.
+	mStartupTimeline.addStep(QStringLiteral("RemoteIdentity"), Execution::DEFERRED, [](){
+				RemoteHelper::prepareKey();
+				return true;
+			}, {QStringLiteral("SecureStorage")});
+
+	connect(this, &AppController::fireStarted, &mStartupTimeline, &StartupTimeline::ready);
+	if (!mStartupTimeline.run())
+	{
+		return false;
+	}
+
 	QCoreApplication::instance()->installEventFilter(this);
 
 	return true;
 }
 
 
+const StartupTimeline& AppController::getStartupTimeline() const
+{
+	return mStartupTimeline;
+}
+
+
 void AppController::onWorkflowFinished()
 {
 	qDebug() << mActiveController->metaObject()->className() << "done";
@@ -164,6 +228,7 @@ void AppController::onWorkflowFinished()
 
 	Q_EMIT fireWorkflowFinished(mActiveController->getContext());
 
+	ReaderManager::getInstance().releaseReaders(mActiveController->getContext().data());
 	mActiveController.reset();
 	qCInfo(support) << "Finished workflow" << mCurrentAction;
 	mCurrentAction = Action::NONE;
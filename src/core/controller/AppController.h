@@ -8,6 +8,7 @@
 
 #include "ActivationHandler.h"
 #include "EnumHelper.h"
+#include "StartupTimeline.h"
 
 #include <QSharedPointer>
 
@@ -45,8 +46,10 @@ class AppController
 		Action mCurrentAction;
 		QScopedPointer<WorkflowRequest> mWaitingRequest;
 		QScopedPointer<WorkflowController> mActiveController;
+		StartupTimeline mStartupTimeline;
 
 		bool canStartNewAction();
+		bool startActivationHandlers();
 
 	public:
 		AppController();
@@ -55,6 +58,7 @@ class AppController
 		virtual bool eventFilter(QObject* pObj, QEvent* pEvent) override;
 
 		bool start();
+		const StartupTimeline& getStartupTimeline() const;
 
 	Q_SIGNALS:
 		void fireStarted();
@@ -52,10 +52,13 @@ void StateSelectReader::onReaderInfoChanged()
 	Q_ASSERT(context);
 
 	const QVector<ReaderManagerPlugInType>& plugInTypes = context->getReaderPlugInTypes();
-	const auto allReaders = ReaderManager::getInstance().getReaderInfos(plugInTypes);
-	const QVector<ReaderInfo> selectableReaders = filter<ReaderInfo>([](const ReaderInfo& info)
+	ReaderManager& readerManager = ReaderManager::getInstance();
+	const auto allReaders = readerManager.getReaderInfos(plugInTypes);
+	const QVector<ReaderInfo> selectableReaders = filter<ReaderInfo>([&readerManager, &context](const ReaderInfo& info)
 			{
-				return info.isConnected() && (!requiresCard(info.getPlugInType()) || info.hasEidCard());
+				// Readers reserved by another workflow are not selectable
+				return info.isConnected() && (!requiresCard(info.getPlugInType()) || info.hasEidCard())
+					   && readerManager.isReaderAvailable(info.getName(), context.data());
 			}, allReaders);
 
 	if (selectableReaders.isEmpty())
@@ -67,6 +70,18 @@ void StateSelectReader::onReaderInfoChanged()
 
 	const ReaderInfo& readerInfo = selectableReaders.first();
 	const QString readerName = readerInfo.getName();
+	if (!readerManager.reserveReader(readerName, context.data()))
+	{
+		qCDebug(statemachine) << "Cannot reserve reader" << readerName;
+
+		return;
+	}
+
+	const QString& previousReaderName = context->getReaderName();
+	if (!previousReaderName.isEmpty() && previousReaderName != readerName)
+	{
+		readerManager.releaseReader(previousReaderName, context.data());
+	}
 	context->setReaderName(readerName);
 	qCDebug(statemachine) << "Select first found reader" << readerName << "of type" << readerInfo.getPlugInType();
 
@@ -84,6 +99,7 @@ void StateSelectReader::onAbort()
 	const auto& readerName = context->getReaderName();
 	if (!readerName.isEmpty())
 	{
+		ReaderManager::getInstance().releaseReader(readerName, context.data());
 		const ReaderInfo readerInfo = ReaderManager::getInstance().getReaderInfo(readerName);
 		if (readerInfo.isConnected())
 		{
@@ -37,9 +37,7 @@ void StateChangePinRemote::onEntry(QEvent* pEvent)
 	mModifyPinMessage = context->getModifyPinMessage();
 	Q_ASSERT(mModifyPinMessage);
 
-	const QSharedPointer<RemoteServer> remoteServer = context->getRemoteServer();
-	Q_ASSERT(remoteServer);
-	mMessageHandler = remoteServer->getMessageHandler();
+	mMessageHandler = context->getMessageHandler();
 	Q_ASSERT(mMessageHandler);
 
 	auto cardConnection = context->getCardConnection();
@@ -51,7 +49,7 @@ void StateChangePinRemote::onEntry(QEvent* pEvent)
 
 	mConnections += connect(context.data(), &RemoteServiceContext::fireCancelPasswordRequest, this, &StateChangePinRemote::onCancelChangePin);
 	mConnections += connect(cardConnection.data(), &CardConnection::fireReaderInfoChanged, this, &StateChangePinRemote::onReaderInfoChanged);
-	mConnections += connect(remoteServer.data(), &RemoteServer::fireConnectedChanged, this, &AbstractState::fireContinue);
+	mConnections += connect(mMessageHandler.data(), &ServerMessageHandler::fireClosed, this, &AbstractState::fireContinue);
 }
 
 
@@ -35,9 +35,7 @@ void StateEstablishPaceChannel::onEntry(QEvent* pEvent)
 	mEstablishPaceChannelMessage = context->getEstablishPaceChannelMessage();
 	Q_ASSERT(mEstablishPaceChannelMessage);
 
-	const QSharedPointer<RemoteServer> remoteServer = context->getRemoteServer();
-	Q_ASSERT(remoteServer);
-	mMessageHandler = remoteServer->getMessageHandler();
+	mMessageHandler = context->getMessageHandler();
 	Q_ASSERT(mMessageHandler);
 
 	auto cardConnection = context->getCardConnection();
@@ -49,7 +47,7 @@ void StateEstablishPaceChannel::onEntry(QEvent* pEvent)
 
 	mConnections += connect(cardConnection.data(), &CardConnection::fireReaderInfoChanged, this, &StateEstablishPaceChannel::onReaderInfoChanged);
 	mConnections += connect(getContext().data(), &RemoteServiceContext::fireCancelPasswordRequest, this, &StateEstablishPaceChannel::onCancelEstablishPaceChannel);
-	mConnections += connect(getContext()->getRemoteServer().data(), &RemoteServer::fireConnectedChanged, this, &AbstractState::fireContinue);
+	mConnections += connect(mMessageHandler.data(), &ServerMessageHandler::fireClosed, this, &AbstractState::fireContinue);
 }
 
 
@@ -30,18 +30,34 @@ void StateProcessRemoteMessages::run()
 
 	mConnections += connect(server.data(), &RemoteServer::fireMessageHandlerAdded, this, &StateProcessRemoteMessages::onMessageHandlerAdded);
 
-	const auto messageHandler = server->getMessageHandler();
-	if (messageHandler)
+	const auto& messageHandlers = server->getMessageHandlers();
+	for (const auto& messageHandler : messageHandlers)
 	{
-		onMessageHandlerAdded(server->getMessageHandler());
+		onMessageHandlerAdded(messageHandler);
 	}
-	else
+
+	if (messageHandlers.isEmpty())
 	{
 		context->onResetMessageHandler();
 	}
 }
 
 
+QSharedPointer<ServerMessageHandler> StateProcessRemoteMessages::getSendingMessageHandler() const
+{
+	const auto& messageHandlers = getContext()->getRemoteServer()->getMessageHandlers();
+	for (const auto& messageHandler : messageHandlers)
+	{
+		if (messageHandler.data() == sender())
+		{
+			return messageHandler;
+		}
+	}
+
+	return QSharedPointer<ServerMessageHandler>();
+}
+
+
 void StateProcessRemoteMessages::onMessageHandlerAdded(const QSharedPointer<ServerMessageHandler>& pHandler)
 {
 	if (!pHandler)
@@ -57,12 +73,14 @@ void StateProcessRemoteMessages::onMessageHandlerAdded(const QSharedPointer<Serv
 
 void StateProcessRemoteMessages::onClosed()
 {
-	for (const auto& connection : qAsConst(mMessageConnections))
+	const auto* messageHandler = sender();
+	disconnect(messageHandler, nullptr, this, nullptr);
+
+	const QSharedPointer<RemoteServiceContext> context = getContext();
+	if (context->getMessageHandler().data() == messageHandler)
 	{
-		disconnect(connection);
+		context->onResetMessageHandler();
 	}
-
-	getContext()->onResetMessageHandler();
 }
 
 
@@ -70,6 +88,10 @@ void StateProcessRemoteMessages::onEstablishPaceChannel(const QSharedPointer<con
 {
 	Q_ASSERT(pMessage);
 
+	const auto& messageHandler = getSendingMessageHandler();
+	Q_ASSERT(messageHandler);
+
+	getContext()->setMessageHandler(messageHandler);
 	getContext()->setEstablishPaceChannelMessage(pMessage);
 	getContext()->setCardConnection(pConnection);
 	Q_EMIT fireEstablishPaceChannel();
@@ -83,6 +105,10 @@ void StateProcessRemoteMessages::onModifyPin(const QSharedPointer<const IfdModif
 	const QSharedPointer<RemoteServiceContext> context = getContext();
 	Q_ASSERT(context);
 
+	const auto& messageHandler = getSendingMessageHandler();
+	Q_ASSERT(messageHandler);
+
+	context->setMessageHandler(messageHandler);
 	context->setModifyPinMessage(pMessage);
 	context->setCardConnection(pConnection);
 	Q_EMIT fireModifyPin();
@@ -25,6 +25,7 @@ class StateProcessRemoteMessages
 
 		StateProcessRemoteMessages(const QSharedPointer<WorkflowContext>& pContext);
 		virtual void run() override;
+		QSharedPointer<ServerMessageHandler> getSendingMessageHandler() const;
 
 	private Q_SLOTS:
 		void onMessageHandlerAdded(const QSharedPointer<ServerMessageHandler>& pHandler);
@@ -40,5 +40,5 @@ void StateStartRemoteService::run()
 void StateStartRemoteService::onMessageHandlerAdded(QSharedPointer<ServerMessageHandler> pHandler)
 {
 	const QSharedPointer<RemoteServiceContext> context = getContext();
-	connect(pHandler.data(), &ServerMessageHandler::fireClosed, context.data(), &RemoteServiceContext::onResetMessageHandler, Qt::QueuedConnection);
+	connect(pHandler.data(), &ServerMessageHandler::fireClosed, context.data(), &RemoteServiceContext::onMessageHandlerClosed, Qt::QueuedConnection);
 }
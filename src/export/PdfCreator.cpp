@@ -6,22 +6,29 @@
 
 #include <QDebug>
 #include <QPagedPaintDevice>
-#include <QPainter>
 #include <QSvgRenderer>
 
 using namespace governikus;
 
 
-PdfCreator::PdfCreator(const QString& pFilename, const QString& pTitle, const QString& pHeadline, const QString& pContent)
+PdfCreator::PdfCreator(const QString& pFilename, const QString& pTitle, const QString& pHeadline)
 	: mPdfWriter(pFilename)
+	, mPainter()
 	, mHeader()
 	, mContent()
 	, mFooter()
+	, mContentPageSize()
+	, mHeaderHeight(0)
+	, mPosition(0)
+	, mPageCount(0)
 {
 	mHeader.setUndoRedoEnabled(false);
 	mContent.setUndoRedoEnabled(false);
 	mFooter.setUndoRedoEnabled(false);
 
+	// Blocks are drawn seamlessly one below the other
+	mContent.setDocumentMargin(0);
+
 	qDebug() << "Use filename for PDF:" << pFilename;
 
 	const QPageLayout layout(QPageSize(QPageSize::A4), QPageLayout::Portrait, QMargins(20, 20, 20, 15), QPageLayout::Millimeter);
@@ -35,7 +42,21 @@ PdfCreator::PdfCreator(const QString& pFilename, const QString& pTitle, const QS
 
 	createHeader(pTitle, pHeadline);
 	createFooter();
-	createContent(pContent);
+}
+
+
+const QImage& PdfCreator::getLogo()
+{
+	static const QImage logo = [](){
+				QSvgRenderer renderer(QStringLiteral(":/images/npa.svg"));
+				QImage image(768, 768, QImage::Format_RGB32);
+				image.fill(0x00FFFFFF);
+				QPainter imagePainter(&image);
+				renderer.render(&imagePainter);
+				return image;
+			}();
+
+	return logo;
 }
 
 
@@ -57,23 +78,11 @@ void PdfCreator::createHeader(const QString& pTitle, const QString& pHeadline)
 			tr("AusweisApp2 is a product of Governikus GmbH & Co. KG - on behalf of the Federal Ministry of the Interior, Building and Community."),
 			pHeadline);
 
-	QSvgRenderer renderer(QStringLiteral(":/images/npa.svg"));
-	QImage image(768, 768, QImage::Format_RGB32);
-	image.fill(0x00FFFFFF);
-	QPainter imagePainter(&image);
-	renderer.render(&imagePainter);
-
-	mHeader.addResource(QTextDocument::ImageResource, QUrl(QStringLiteral("pdflogo")), image);
+	mHeader.addResource(QTextDocument::ImageResource, QUrl(QStringLiteral("pdflogo")), getLogo());
 	mHeader.setHtml(header);
 }
 
 
-void PdfCreator::createContent(const QString& pContent)
-{
-	mContent.setHtml(pContent);
-}
-
-
 void PdfCreator::createFooter()
 {
 	const auto& footer = QStringLiteral("<h3>%1</h3>").arg(
@@ -83,14 +92,30 @@ void PdfCreator::createFooter()
 }
 
 
+void PdfCreator::startPage()
+{
+	if (mPageCount > 0)
+	{
+		mPdfWriter.newPage();
+	}
+	++mPageCount;
+	mPosition = 0;
+
+	mPainter.resetTransform();
+	mHeader.drawContents(&mPainter);
+	mPainter.translate(0, mHeaderHeight + mContentPageSize.height());
+	mFooter.drawContents(&mPainter);
+	mPainter.resetTransform();
+}
+
+
 int qt_defaultDpi();
-bool PdfCreator::save()
+bool PdfCreator::begin()
 {
 	mPdfWriter.setResolution(qt_defaultDpi());
 	const QRect pageArea(mPdfWriter.pageLayout().paintRectPixels(mPdfWriter.resolution()));
 
-	QPainter painter(&mPdfWriter);
-	if (!painter.isActive())
+	if (!mPainter.begin(&mPdfWriter))
 	{
 		qCritical() << "Cannot paint into pdf file. Check file system permissions!";
 		return false;
@@ -98,33 +123,65 @@ bool PdfCreator::save()
 
 	mHeader.setPageSize(pageArea.size());
 	mFooter.setPageSize(pageArea.size());
-	const qreal headerHeight = mHeader.size().height();
-	const QSizeF contentMaxPageSize(pageArea.width(), pageArea.height() - headerHeight - mFooter.size().height());
-	mContent.setPageSize(contentMaxPageSize);
+	mHeaderHeight = mHeader.size().height();
+	mContentPageSize = QSizeF(pageArea.width(), pageArea.height() - mHeaderHeight - mFooter.size().height());
+
+	startPage();
+	return true;
+}
 
-	const QRect contentRect = QRect(QPoint(0, 0), mContent.size().toSize());
-	QRect currentRect = QRect(QPoint(0, 0), contentMaxPageSize.toSize());
-	while (currentRect.intersects(contentRect))
-	{
-		painter.resetTransform();
 
-		mHeader.drawContents(&painter);
-		painter.translate(0, headerHeight);
+void PdfCreator::addContent(const QString& pHtml)
+{
+	Q_ASSERT(mPainter.isActive());
 
-		painter.save();
-		painter.translate(0, -currentRect.y());
-		mContent.drawContents(&painter, currentRect);
-		painter.restore();
-		painter.translate(0, currentRect.height());
+	mContent.setHtml(pHtml);
+	mContent.setTextWidth(mContentPageSize.width());
+	const qreal height = mContent.size().height();
+	const qreal pageHeight = mContentPageSize.height();
 
-		mFooter.drawContents(&painter);
+	if (mPosition > 0 && mPosition + height > pageHeight)
+	{
+		startPage();
+	}
 
-		currentRect.translate(0, currentRect.height());
-		if (currentRect.intersects(contentRect))
+	if (height <= pageHeight)
+	{
+		mPainter.save();
+		mPainter.translate(0, mHeaderHeight + mPosition);
+		mContent.drawContents(&mPainter);
+		mPainter.restore();
+		mPosition += height;
+		return;
+	}
+
+	// A block that does not fit on a single page is paginated by the document itself
+	mContent.setPageSize(mContentPageSize);
+	const int pageCount = mContent.pageCount();
+	for (int page = 0; page < pageCount; ++page)
+	{
+		if (page > 0)
 		{
-			mPdfWriter.newPage();
+			startPage();
 		}
+
+		const QRectF pageRect(QPointF(0, page * pageHeight), mContentPageSize);
+		mPainter.save();
+		mPainter.translate(0, mHeaderHeight - pageRect.y());
+		mContent.drawContents(&mPainter, pageRect);
+		mPainter.restore();
 	}
+	mPosition = qMin(pageHeight, mContent.size().height() - (pageCount - 1) * pageHeight);
+}
 
-	return true;
+
+bool PdfCreator::end()
+{
+	return mPainter.end();
+}
+
+
+int PdfCreator::getPageCount() const
+{
+	return mPageCount;
 }
@@ -1,12 +1,18 @@
 /*!
  * \brief Tool to create PDF-Documents.
  *
+ * The content is added in blocks of HTML. Every block is laid out on its own
+ * and drawn directly into the current page, so the memory consumption does not
+ * grow with the size of the document.
+ *
  * \copyright Copyright (c) 2016-2018 Governikus GmbH & Co. KG, Germany
  */
 
 #pragma once
 
 #include <QCoreApplication>
+#include <QImage>
+#include <QPainter>
 #include <QPdfWriter>
 #include <QString>
 #include <QTextDocument>
@@ -20,17 +26,29 @@ class PdfCreator
 
 	private:
 		QPdfWriter mPdfWriter;
+		QPainter mPainter;
 		QTextDocument mHeader;
 		QTextDocument mContent;
 		QTextDocument mFooter;
+		QSizeF mContentPageSize;
+		qreal mHeaderHeight;
+		qreal mPosition;
+		int mPageCount;
+
+		static const QImage& getLogo();
 
 		void createHeader(const QString& pTitle, const QString& pHeadline);
-		void createContent(const QString& pContent);
 		void createFooter();
+		void startPage();
 
 	public:
-		PdfCreator(const QString& pFilename, const QString& pTitle, const QString& pHeadline, const QString& pContent);
-		bool save();
+		PdfCreator(const QString& pFilename, const QString& pTitle, const QString& pHeadline);
+
+		bool begin();
+		void addContent(const QString& pHtml);
+		bool end();
+
+		int getPageCount() const;
 };
 
 
@@ -9,6 +9,8 @@
 #include "PdfCreator.h"
 
 #include <QDesktopServices>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 using namespace governikus;
 
@@ -28,10 +30,12 @@ QString getValueOrWhitespace(const QStringList& pValues, int i)
 
 
 PdfExporter::PdfExporter(const QString& pFilename, bool pOpenFile, bool pFixFilename)
-	: mFilename(pFilename)
+	: QObject()
+	, mFilename(pFilename)
 	, mOpenFile(pOpenFile)
 	, mColoredRow(false)
 	, mColumnCount(0)
+	, mColumnWidths()
 	, mContent()
 {
 	if (pFixFilename && !mFilename.isEmpty()
@@ -42,12 +46,6 @@ PdfExporter::PdfExporter(const QString& pFilename, bool pOpenFile, bool pFixFile
 }
 
 
-QString PdfExporter::getContent() const
-{
-	return mContent.join(QString());
-}
-
-
 void PdfExporter::checkOpenFile(bool pSuccess)
 {
 	if (mOpenFile && pSuccess)
@@ -62,10 +60,11 @@ void PdfExporter::initTable(int pColumnCount, const QList<int>& pWidth, const QS
 	Q_ASSERT(mColumnCount == 0);
 
 	mColumnCount = pColumnCount;
-	mContent << QStringLiteral("<table width='100%' cellspacing='0' cellpadding='6'><tr>");
+	mColumnWidths = pWidth;
+	mContent << QStringLiteral("<tr>");
 	for (int i = 0; i < mColumnCount; ++i)
 	{
-		const auto& width = i < pWidth.size() ? QStringLiteral(" width='%1'").arg(pWidth.at(i)) : QString();
+		const auto& width = i < mColumnWidths.size() ? QStringLiteral(" width='%1'").arg(mColumnWidths.at(i)) : QString();
 		mContent << QStringLiteral("<th align='left'%1>%2</th>").arg(width, getValueOrWhitespace(pValues, i));
 	}
 	mContent << QStringLiteral("</tr>");
@@ -74,19 +73,36 @@ void PdfExporter::initTable(int pColumnCount, const QList<int>& pWidth, const QS
 
 void PdfExporter::addTableRow(const QStringList& pValues)
 {
+	// Every block is laid out as a table of its own, so its first row defines the column widths again
+	const bool firstRow = mContent.isEmpty();
+
 	mContent << (mColoredRow ? QStringLiteral("<tr style='background-color:#f6f6f6'>") : QStringLiteral("<tr>"));
 	for (int i = 0; i < mColumnCount; ++i)
 	{
-		mContent << QStringLiteral("<td>%2</td>").arg(getValueOrWhitespace(pValues, i));
+		const auto& width = firstRow && i < mColumnWidths.size() ? QStringLiteral(" width='%1'").arg(mColumnWidths.at(i)) : QString();
+		mContent << QStringLiteral("<td%1>%2</td>").arg(width, getValueOrWhitespace(pValues, i));
 	}
 	mContent << QStringLiteral("</tr>");
 }
 
 
-void PdfExporter::closeTable()
+void PdfExporter::flushTable(PdfCreator& pPdf)
 {
-	mContent << QStringLiteral("</table>");
+	if (mContent.isEmpty())
+	{
+		return;
+	}
+
+	pPdf.addContent(QStringLiteral("<table width='100%' cellspacing='0' cellpadding='6'>") + mContent.join(QString()) + QStringLiteral("</table>"));
+	mContent.clear();
+}
+
+
+void PdfExporter::closeTable(PdfCreator& pPdf)
+{
+	flushTable(pPdf);
 	mColumnCount = 0;
+	mColumnWidths.clear();
 	mColoredRow = false;
 }
 
@@ -97,67 +113,127 @@ void PdfExporter::toggleRowColor()
 }
 
 
-bool PdfExporter::exportHistory()
+bool PdfExporter::writeHistory(const QVector<HistoryInfo>& pInfos)
 {
-	if (mFilename.isEmpty())
+	const auto& locale = LanguageLoader::getInstance().getUsedLocale();
+
+	const auto& now = QDateTime::currentDateTime();
+	QString date = locale.toString(now, tr("dd.MM.yyyy"));
+	QString time = locale.toString(now, tr("hh:mm AP"));
+	const auto& headline = tr("At %1 %2 the following data were saved:").arg(date, time);
+
+	PdfCreator pdf(mFilename, tr("History"), headline);
+	if (!pdf.begin())
 	{
 		return false;
 	}
-	mContent.clear();
-
-	const auto& locale = LanguageLoader::getInstance().getUsedLocale();
 
+	mContent.clear();
 	initTable(3, {180, 80}, {tr("Date"), tr("Details")});
 	const auto& dateTimeFormat = tr("dd.MM.yyyy hh:mm AP");
-	const auto& infos = AppSettings::getInstance().getHistorySettings().getHistoryInfos();
-	for (const auto& entry : infos)
+	const int total = pInfos.size();
+	int percent = 0;
+	for (int i = 0; i < total; ++i)
 	{
+		const auto& entry = pInfos.at(i);
+
 		toggleRowColor();
 		const QString& dateTimeEntry = locale.toString(entry.getDateTime(), dateTimeFormat);
 		addTableRow({dateTimeEntry, tr("Provider:"), entry.getSubjectName()});
 		addTableRow({QString(), tr("Purpose:"), entry.getPurpose()});
 		addTableRow({QString(), tr("Data:"), entry.getRequestedData()});
+		flushTable(pdf);
+
+		const int currentPercent = 100 * (i + 1) / total;
+		if (currentPercent != percent)
+		{
+			percent = currentPercent;
+			Q_EMIT fireProgress(i + 1, total);
+		}
 	}
-	closeTable();
+	closeTable(pdf);
+
+	return pdf.end();
+}
+
+
+bool PdfExporter::exportHistory()
+{
+	return exportHistory(AppSettings::getInstance().getHistorySettings().getHistoryInfos());
+}
 
-	const auto& now = QDateTime::currentDateTime();
-	QString date = locale.toString(now, tr("dd.MM.yyyy"));
-	QString time = locale.toString(now, tr("hh:mm AP"));
-	const auto& headline = tr("At %1 %2 the following data were saved:").arg(date, time);
 
-	PdfCreator pdf(mFilename, tr("History"), headline, getContent());
-	const bool success = pdf.save();
+bool PdfExporter::exportHistory(const QVector<HistoryInfo>& pInfos)
+{
+	if (mFilename.isEmpty())
+	{
+		return false;
+	}
+
+	const bool success = writeHistory(pInfos);
 	checkOpenFile(success);
 	return success;
 }
 
 
-bool PdfExporter::exportSelfInfo(const QDateTime& pDate, const QVector<QPair<QString, QString> >& pInfoData)
+QFuture<bool> PdfExporter::exportHistoryAsync()
 {
 	if (mFilename.isEmpty())
 	{
-		return false;
+		return QtConcurrent::run([](){
+					return false;
+				});
 	}
-	mContent.clear();
 
-	initTable(2, {180}, {tr("Entry"), tr("Content")});
-	for (const auto& entry : pInfoData)
+	// QSettings must not be shared between threads, so the history is read here
+	const auto& infos = AppSettings::getInstance().getHistorySettings().getHistoryInfos();
+	const auto& future = QtConcurrent::run([this, infos](){
+				return writeHistory(infos);
+			});
+
+	auto* const watcher = new QFutureWatcher<bool>(this);
+	connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher](){
+				watcher->deleteLater();
+				checkOpenFile(watcher->result());
+			});
+	watcher->setFuture(future);
+
+	return future;
+}
+
+
+bool PdfExporter::exportSelfInfo(const QDateTime& pDate, const QVector<QPair<QString, QString> >& pInfoData)
+{
+	if (mFilename.isEmpty())
 	{
-		if (!entry.first.isEmpty())
-		{
-			toggleRowColor();
-		}
-		addTableRow({entry.first, entry.second});
+		return false;
 	}
-	closeTable();
 
 	const auto& locale = LanguageLoader::getInstance().getUsedLocale();
 	QString date = locale.toString(pDate, tr("dd.MM.yyyy"));
 	QString time = locale.toString(pDate, tr("hh:mm AP"));
 	const auto& headline = tr("At %1 %2 the following data has been read out of your ID card:").arg(date, time);
 
-	PdfCreator pdf(mFilename, tr("Information"), headline, getContent());
-	const bool success = pdf.save();
+	PdfCreator pdf(mFilename, tr("Information"), headline);
+	bool success = pdf.begin();
+	if (success)
+	{
+		mContent.clear();
+		initTable(2, {180}, {tr("Entry"), tr("Content")});
+		for (const auto& entry : pInfoData)
+		{
+			if (!entry.first.isEmpty())
+			{
+				// Keep the lines of an entry together on one page
+				flushTable(pdf);
+				toggleRowColor();
+			}
+			addTableRow({entry.first, entry.second});
+		}
+		closeTable(pdf);
+		success = pdf.end();
+	}
+
 	checkOpenFile(success);
 	return success;
 }
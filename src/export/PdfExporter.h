@@ -6,38 +6,56 @@
 
 #pragma once
 
-#include <QCoreApplication>
+#include "HistoryInfo.h"
+
 #include <QDateTime>
+#include <QFuture>
 #include <QList>
+#include <QObject>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
 namespace governikus
 {
+class PdfCreator;
+
 class PdfExporter
+	: public QObject
 {
-	Q_DECLARE_TR_FUNCTIONS(governikus::PdfExporter)
+	Q_OBJECT
 
 	private:
 		QString mFilename;
 		bool mOpenFile;
 		bool mColoredRow;
 		int mColumnCount;
+		QList<int> mColumnWidths;
 		QStringList mContent;
 
-		QString getContent() const;
-
 		void checkOpenFile(bool pSuccess);
 		void initTable(int pColumnCount, const QList<int>& pWidth, const QStringList& pValues);
-		void closeTable();
+		void closeTable(PdfCreator& pPdf);
+		void flushTable(PdfCreator& pPdf);
 		void addTableRow(const QStringList& pValues);
 		void toggleRowColor();
+		bool writeHistory(const QVector<HistoryInfo>& pInfos);
 
 	public:
 		PdfExporter(const QString& pFilename, bool pOpenFile = true, bool pFixFilename = true);
 		bool exportHistory();
+		bool exportHistory(const QVector<HistoryInfo>& pInfos);
+
+		/*!
+		 * Exports the current history on a worker thread. The exporter
+		 * must not be destroyed or used otherwise until the future has finished.
+		 */
+		QFuture<bool> exportHistoryAsync();
+
 		bool exportSelfInfo(const QDateTime& pDate, const QVector<QPair<QString, QString> >& pInfoData);
+
+	Q_SIGNALS:
+		void fireProgress(int pCurrent, int pTotal);
 };
 
 } /* namespace governikus */
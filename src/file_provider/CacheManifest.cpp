@@ -0,0 +1,177 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "CacheManifest.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWeakPointer>
+
+using namespace governikus;
+
+Q_DECLARE_LOGGING_CATEGORY(fileprovider)
+
+namespace
+{
+const QLatin1Char Sep('/');
+const QLatin1Char TimestampSep('_');
+const int TimestampSize = 14; // yyyyMMddhhmmss
+const QLatin1String DirtySuffix(".dirty");
+const QLatin1String ETagSuffix(".etag");
+}
+
+
+CacheManifest::CacheManifest(const QString& pPath)
+	: QObject()
+	, mPath(pPath)
+	, mWatcher(this)
+	, mMutex()
+	, mLoaded(false)
+	, mLoadCount(0)
+	, mFiles()
+	, mDirtyFiles()
+{
+	connect(&mWatcher, &QFileSystemWatcher::directoryChanged, this, &CacheManifest::onDirectoryChanged);
+	if (!mWatcher.addPath(mPath))
+	{
+		qCWarning(fileprovider) << "Cannot watch cache folder:" << mPath;
+	}
+
+	// The manifest is shared by all threads, but the watcher needs an event loop.
+	const auto* const app = QCoreApplication::instance();
+	if (app && thread() != app->thread())
+	{
+		moveToThread(app->thread());
+	}
+}
+
+
+QSharedPointer<CacheManifest> CacheManifest::getManifest(const QString& pPath)
+{
+	if (pPath.isEmpty())
+	{
+		return QSharedPointer<CacheManifest>();
+	}
+
+	static QMutex mutex;
+	static QHash<QString, QWeakPointer<CacheManifest> > manifests;
+
+	const QMutexLocker locker(&mutex);
+	QSharedPointer<CacheManifest> manifest = manifests.value(pPath).toStrongRef();
+	if (manifest.isNull())
+	{
+		manifest.reset(new CacheManifest(pPath));
+		manifests.insert(pPath, manifest);
+	}
+	return manifest;
+}
+
+
+void CacheManifest::load()
+{
+	if (mLoaded)
+	{
+		return;
+	}
+
+	mFiles.clear();
+	mDirtyFiles.clear();
+
+	const QStringList entries = QDir(mPath).entryList(QDir::Files);
+	for (const auto& entry : entries)
+	{
+		if (entry.endsWith(DirtySuffix))
+		{
+			mDirtyFiles.insert(entry.left(entry.size() - DirtySuffix.size()));
+			continue;
+		}
+
+		if (entry.endsWith(ETagSuffix))
+		{
+			continue;
+		}
+
+		// Files are saved in the cache with the suffix _<timestamp>, where
+		// the timestamp has the format "yyyyMMddhhmmss". Therefore, the
+		// newest version has the greatest file name.
+		const int nameSize = entry.size() - TimestampSize - 1;
+		if (nameSize < 1 || entry.at(nameSize) != TimestampSep)
+		{
+			continue;
+		}
+
+		const QString name = entry.left(nameSize);
+		auto iter = mFiles.find(name);
+		if (iter == mFiles.end())
+		{
+			mFiles.insert(name, entry);
+		}
+		else if (iter.value() < entry)
+		{
+			iter.value() = entry;
+		}
+	}
+
+	mLoaded = true;
+	++mLoadCount;
+	qCDebug(fileprovider) << "Loaded manifest of" << mPath << "with" << mFiles.size() << "files";
+}
+
+
+void CacheManifest::onDirectoryChanged()
+{
+	const QMutexLocker locker(&mMutex);
+	mLoaded = false;
+}
+
+
+QString CacheManifest::getFilePath(const QString& pName)
+{
+	const QMutexLocker locker(&mMutex);
+	load();
+
+	const auto iter = mFiles.constFind(pName);
+	return iter == mFiles.constEnd() ? QString() : mPath + Sep + iter.value();
+}
+
+
+void CacheManifest::setFileName(const QString& pName, const QString& pFileName)
+{
+	const QMutexLocker locker(&mMutex);
+	load();
+
+	const auto iter = mFiles.constFind(pName);
+	if (iter == mFiles.constEnd() || iter.value() < pFileName)
+	{
+		mFiles.insert(pName, pFileName);
+	}
+}
+
+
+bool CacheManifest::isDirty(const QString& pName)
+{
+	const QMutexLocker locker(&mMutex);
+	load();
+
+	return mDirtyFiles.contains(pName);
+}
+
+
+void CacheManifest::setDirty(const QString& pName, bool pDirty)
+{
+	const QMutexLocker locker(&mMutex);
+	load();
+
+	if (pDirty)
+	{
+		mDirtyFiles.insert(pName);
+	}
+	else
+	{
+		mDirtyFiles.remove(pName);
+	}
+}
@@ -0,0 +1,60 @@
+/*!
+ * \brief In-memory index of the files in a section of the local cache.
+ *
+ * The directory is scanned once on the first lookup. Changes made by
+ * UpdatableFile are applied to the index directly, all other changes
+ * of the directory invalidate the index until the next lookup.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+
+class test_UpdatableFile;
+
+
+namespace governikus
+{
+class CacheManifest
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		friend class ::test_UpdatableFile;
+
+		const QString mPath;
+		QFileSystemWatcher mWatcher;
+		mutable QMutex mMutex;
+		bool mLoaded;
+		int mLoadCount;
+		QHash<QString, QString> mFiles;
+		QSet<QString> mDirtyFiles;
+
+		explicit CacheManifest(const QString& pPath);
+		void load();
+
+	private Q_SLOTS:
+		void onDirectoryChanged();
+
+	public:
+		static QSharedPointer<CacheManifest> getManifest(const QString& pPath);
+
+		virtual ~CacheManifest() override = default;
+
+		QString getFilePath(const QString& pName);
+		void setFileName(const QString& pName, const QString& pFileName);
+
+		bool isDirty(const QString& pName);
+		void setDirty(const QString& pName, bool pDirty);
+};
+
+} // namespace governikus
@@ -23,29 +23,100 @@ using namespace governikus;
 defineSingleton(Downloader)
 
 
+// QNetworkAccessManager opens up to six connections per host, keep some for other requests.
+const int Downloader::cMaxConnectionsPerHost = 4;
+
+
+const QByteArray Downloader::IF_MODIFIED_SINCE = QByteArrayLiteral("If-Modified-Since");
+const QByteArray Downloader::IF_NONE_MATCH = QByteArrayLiteral("If-None-Match");
+
+
 Downloader & Downloader::getInstance()
 {
 	return *Instance;
 }
 
 
+bool Downloader::hasSameConditions(const QNetworkRequest& pRequest, const QNetworkRequest& pOther)
+{
+	return pRequest.rawHeader(IF_MODIFIED_SINCE) == pOther.rawHeader(IF_MODIFIED_SINCE)
+		   && pRequest.rawHeader(IF_NONE_MATCH) == pOther.rawHeader(IF_NONE_MATCH);
+}
+
+
+bool Downloader::isConditional(const QNetworkRequest& pRequest)
+{
+	return pRequest.hasRawHeader(IF_MODIFIED_SINCE) || pRequest.hasRawHeader(IF_NONE_MATCH);
+}
+
+
+int Downloader::getRunningRequestCount(const QString& pHost) const
+{
+	int count = 0;
+	for (const auto& request : qAsConst(mRunningRequests))
+	{
+		if (request->url().host() == pHost)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+
 void Downloader::scheduleDownload(QSharedPointer<QNetworkRequest> request)
 {
+	// A running request covers a new one if both expect the same answer. An
+	// unconditional request always downloads the file and covers every request.
+	for (const auto& runningRequest : qAsConst(mRunningRequests))
+	{
+		if (runningRequest->url() == request->url() && (!isConditional(*runningRequest) || hasSameConditions(*runningRequest, *request)))
+		{
+			qCDebug(fileprovider) << "Download is already running, coalescing request for" << request->url().fileName();
+
+			return;
+		}
+	}
+
+	// A pending request is not sent yet and can still be turned into an
+	// unconditional one that covers both requests.
+	for (const auto& pendingRequest : qAsConst(mPendingRequests))
+	{
+		if (pendingRequest->url() == request->url())
+		{
+			if (!hasSameConditions(*pendingRequest, *request))
+			{
+				qCDebug(fileprovider) << "Conditions differ, scheduling unconditional download for" << request->url().fileName();
+				pendingRequest->setRawHeader(IF_MODIFIED_SINCE, QByteArray());
+				pendingRequest->setRawHeader(IF_NONE_MATCH, QByteArray());
+			}
+
+			qCDebug(fileprovider) << "Download is already scheduled, coalescing request for" << request->url().fileName();
+
+			return;
+		}
+	}
+
 	mPendingRequests.enqueue(request);
 
 	startDownloadIfPending();
 }
 
 
-void Downloader::startDownloadIfPending()
+void Downloader::startDownload(const QSharedPointer<QNetworkRequest>& pDownloadRequest)
 {
-	if (mCurrentReply)
-	{
-		qCDebug(fileprovider) << "A download is already in progress... delaying.";
+	QNetworkReply* const reply = Env::getSingleton<NetworkManager>()->get(*pDownloadRequest);
+	mRunningRequests.insert(reply, pDownloadRequest);
 
-		return;
-	}
+	connect(reply, &QNetworkReply::sslErrors, this, &Downloader::onSslErrors);
+	connect(reply, &QNetworkReply::encrypted, this, &Downloader::onSslHandshakeDone);
+	connect(reply, &QNetworkReply::metaDataChanged, this, &Downloader::onMetadataChanged);
+	connect(reply, &QNetworkReply::finished, this, &Downloader::onNetworkReplyFinished);
+}
 
+
+void Downloader::startDownloadIfPending()
+{
 	if (mPendingRequests.isEmpty())
 	{
 		qCDebug(fileprovider) << "No pending requests to be started.";
@@ -53,48 +124,67 @@ void Downloader::startDownloadIfPending()
 		return;
 	}
 
-	mCurrentRequest = mPendingRequests.dequeue();
-	mCurrentReply = Env::getSingleton<NetworkManager>()->get(*mCurrentRequest);
+	for (int i = 0; i < mPendingRequests.size();)
+	{
+		const auto request = mPendingRequests.at(i);
+		if (getRunningRequestCount(request->url().host()) >= cMaxConnectionsPerHost)
+		{
+			++i;
+			continue;
+		}
 
-	connect(mCurrentReply, &QNetworkReply::sslErrors, this, &Downloader::onSslErrors);
-	connect(mCurrentReply, &QNetworkReply::encrypted, this, &Downloader::onSslHandshakeDone);
-	connect(mCurrentReply, &QNetworkReply::metaDataChanged, this, &Downloader::onMetadataChanged);
-	connect(mCurrentReply, &QNetworkReply::finished, this, &Downloader::onNetworkReplyFinished);
+		mPendingRequests.removeAt(i);
+		startDownload(request);
+	}
+
+	if (!mPendingRequests.isEmpty())
+	{
+		qCDebug(fileprovider) << "Connection limit reached, delaying" << mPendingRequests.size() << "downloads.";
+	}
 }
 
 
 void Downloader::onSslErrors(const QList<QSslError>& pErrors)
 {
-	TlsChecker::containsFatalError(mCurrentReply, pErrors);
+	const auto reply = qobject_cast<QNetworkReply*>(sender());
+	Q_ASSERT(reply);
+
+	TlsChecker::containsFatalError(reply, pErrors);
 }
 
 
 void Downloader::onSslHandshakeDone()
 {
-	const auto& cfg = mCurrentReply->sslConfiguration();
+	const auto reply = qobject_cast<QNetworkReply*>(sender());
+	Q_ASSERT(reply);
+
+	const auto& cfg = reply->sslConfiguration();
 	TlsChecker::logSslConfig(cfg, qInfo(network));
 
-	if (!Env::getSingleton<NetworkManager>()->checkUpdateServerCertificate(*mCurrentReply))
+	if (!Env::getSingleton<NetworkManager>()->checkUpdateServerCertificate(*reply))
 	{
-		const QString& textForLog = mCurrentRequest->url().fileName();
+		const QString& textForLog = reply->url().fileName();
 		qCritical(fileprovider).nospace() << "Untrusted certificate found [" << textForLog << "]: " << cfg.peerCertificate();
-		mCurrentReply->abort();
+		reply->abort();
 	}
 }
 
 
 void Downloader::onMetadataChanged()
 {
-	const QString& fileName = mCurrentRequest->url().fileName();
+	const auto reply = qobject_cast<QNetworkReply*>(sender());
+	Q_ASSERT(reply);
 
-	QVariant status = mCurrentReply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute);
+	const QString& fileName = reply->url().fileName();
+
+	QVariant status = reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute);
 	if (!status.isNull() && Enum<HttpStatusCode>::isValue(status.toInt()))
 	{
 		HttpStatusCode statusCode = static_cast<HttpStatusCode>(status.toInt());
 		if (statusCode != HttpStatusCode::OK)
 		{
 			qCDebug(fileprovider) << "Abort request for" << fileName << "with status" << status.toInt() << "-" << statusCode;
-			mCurrentReply->abort();
+			reply->abort();
 			return;
 		}
 		qCDebug(fileprovider) << "Continue request for" << fileName << "with status" << status.toInt() << "-" << statusCode;
@@ -109,23 +199,26 @@ void Downloader::onNetworkReplyFinished()
 {
 	qCDebug(fileprovider) << "Downloader::onNetworkReplyFinished()";
 
-	const ScopeGuard guard([this] {
-				mCurrentReply->deleteLater();
-				mCurrentReply = nullptr;
+	const auto reply = qobject_cast<QNetworkReply*>(sender());
+	Q_ASSERT(reply);
+
+	const QSharedPointer<QNetworkRequest> request = mRunningRequests.take(reply);
+	const ScopeGuard guard([this, reply] {
+				reply->deleteLater();
 				startDownloadIfPending();
 			});
 
-	if (mCurrentRequest.isNull())
+	if (request.isNull())
 	{
 		qCCritical(fileprovider) << "Internal error: no running download request.";
-		Q_EMIT fireDownloadFailed(mCurrentRequest->url(), GlobalStatus::Code::Network_Other_Error);
+		Q_EMIT fireDownloadFailed(reply->url(), GlobalStatus::Code::Network_Other_Error);
 
 		return;
 	}
 
-	const QUrl url = mCurrentRequest->url();
-	const QString& textForLog = mCurrentRequest->url().fileName();
-	if (!Env::getSingleton<NetworkManager>()->checkUpdateServerCertificate(*mCurrentReply))
+	const QUrl url = request->url();
+	const QString& textForLog = url.fileName();
+	if (!Env::getSingleton<NetworkManager>()->checkUpdateServerCertificate(*reply))
 	{
 		qCCritical(fileprovider).nospace() << "Connection not secure [" << textForLog << "]";
 		Q_EMIT fireDownloadFailed(url, GlobalStatus::Code::Network_Ssl_Establishment_Error);
@@ -133,18 +226,18 @@ void Downloader::onNetworkReplyFinished()
 		return;
 	}
 
-	QDateTime lastModified = mCurrentReply->header(QNetworkRequest::KnownHeaders::LastModifiedHeader).toDateTime();
+	QDateTime lastModified = reply->header(QNetworkRequest::KnownHeaders::LastModifiedHeader).toDateTime();
 	if (!lastModified.isValid())
 	{
 		qCWarning(fileprovider) << "Server did not provide a valid LastModifiedHeader";
 		lastModified = QDateTime::currentDateTime();
 	}
 
-	const int statusCode = mCurrentReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 	switch (static_cast<HttpStatusCode>(statusCode))
 	{
 		case HttpStatusCode::OK:
-			Q_EMIT fireDownloadSuccess(mCurrentRequest->url(), lastModified, mCurrentReply->readAll());
+			Q_EMIT fireDownloadSuccess(url, lastModified, reply->readAll(), reply->rawHeader(QByteArrayLiteral("ETag")));
 			break;
 
 		case HttpStatusCode::NOT_MODIFIED:
@@ -156,10 +249,10 @@ void Downloader::onNetworkReplyFinished()
 			break;
 
 		default:
-			if (mCurrentReply->error() != QNetworkReply::NoError)
+			if (reply->error() != QNetworkReply::NoError)
 			{
-				qCCritical(fileprovider).nospace() << mCurrentReply->errorString() << " [" << textForLog << "]";
-				Q_EMIT fireDownloadFailed(url, NetworkManager::toStatus(mCurrentReply));
+				qCCritical(fileprovider).nospace() << reply->errorString() << " [" << textForLog << "]";
+				Q_EMIT fireDownloadFailed(url, NetworkManager::toStatus(reply));
 			}
 			else
 			{
@@ -171,25 +264,25 @@ void Downloader::onNetworkReplyFinished()
 
 
 Downloader::Downloader()
-	: mCurrentRequest()
-	, mCurrentReply(nullptr)
-	, mPendingRequests()
+	: mPendingRequests()
+	, mRunningRequests()
 {
 }
 
 
 Downloader::~Downloader()
 {
-	if (mCurrentReply != nullptr)
+	for (auto iter = mRunningRequests.constBegin(); iter != mRunningRequests.constEnd(); ++iter)
 	{
-		if (mCurrentReply->isRunning() && !mCurrentRequest.isNull())
+		QNetworkReply* const reply = iter.key();
+		if (reply->isRunning())
 		{
-			const QString& textForLog = mCurrentRequest->url().fileName();
+			const QString& textForLog = iter.value()->url().fileName();
 			qCDebug(fileprovider).nospace() << "Scheduling pending update request [" << textForLog << "] for deletion";
 		}
-		mCurrentReply->deleteLater();
-		mCurrentReply = nullptr;
+		reply->deleteLater();
 	}
+	mRunningRequests.clear();
 }
 
 
@@ -202,7 +295,8 @@ void Downloader::download(const QUrl& pUpdateUrl)
 
 
 void Downloader::downloadIfNew(const QUrl& pUpdateUrl,
-		const QDateTime& pCurrentTimestamp)
+		const QDateTime& pCurrentTimestamp,
+		const QByteArray& pCurrentETag)
 {
 
 	qCDebug(fileprovider) << "Download:" << pUpdateUrl;
@@ -210,9 +304,15 @@ void Downloader::downloadIfNew(const QUrl& pUpdateUrl,
 	const QString& timeStampString = QLocale::c().toString(pCurrentTimestamp, QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'"));
 	if (!timeStampString.isEmpty())
 	{
-		request->setRawHeader(QByteArrayLiteral("If-Modified-Since"), timeStampString.toLatin1());
+		request->setRawHeader(IF_MODIFIED_SINCE, timeStampString.toLatin1());
 	}
 	// See Section 14.25 at https://www.w3.org/Protocols/rfc2616/rfc2616-sec14.html
 	// Example timestamp string:      Sun, 06 Nov 1994 08:49:37 GMT
+
+	if (!pCurrentETag.isEmpty())
+	{
+		// See Section 14.26 at https://www.w3.org/Protocols/rfc2616/rfc2616-sec14.html
+		request->setRawHeader(IF_NONE_MATCH, pCurrentETag);
+	}
 	scheduleDownload(request);
 }
@@ -2,6 +2,11 @@
  * \brief Generic class that allows to download files from a server to the
  *        local application cache.
  *
+ * Downloads of different files run in parallel with a limited number of
+ * connections per host. Requests for an URL that is already scheduled with
+ * the same conditions are coalesced, the result is signaled once for all
+ * of them. A pending request becomes unconditional if the conditions differ.
+ *
  * \copyright Copyright (c) 2015-2018 Governikus GmbH & Co. KG, Germany
  */
 
@@ -10,6 +15,7 @@
 #include "GlobalStatus.h"
 #include "NetworkManager.h"
 
+#include <QHash>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QQueue>
@@ -17,6 +23,8 @@
 #include <QSslCipher>
 #include <QUrl>
 
+class test_Downloader;
+
 namespace governikus
 {
 class Downloader
@@ -25,11 +33,20 @@ class Downloader
 	Q_OBJECT
 
 	private:
-		QSharedPointer<QNetworkRequest> mCurrentRequest;
-		QNetworkReply* mCurrentReply;
+		friend class ::test_Downloader;
+
+		static const int cMaxConnectionsPerHost;
+		static const QByteArray IF_MODIFIED_SINCE;
+		static const QByteArray IF_NONE_MATCH;
+
 		QQueue<QSharedPointer<QNetworkRequest> > mPendingRequests;
+		QHash<QNetworkReply*, QSharedPointer<QNetworkRequest> > mRunningRequests;
 
+		static bool hasSameConditions(const QNetworkRequest& pRequest, const QNetworkRequest& pOther);
+		static bool isConditional(const QNetworkRequest& pRequest);
+		int getRunningRequestCount(const QString& pHost) const;
 		void scheduleDownload(QSharedPointer<QNetworkRequest> pDownloadRequest);
+		void startDownload(const QSharedPointer<QNetworkRequest>& pDownloadRequest);
 		void startDownloadIfPending();
 
 	protected:
@@ -45,12 +62,13 @@ class Downloader
 	public:
 		Q_INVOKABLE virtual void download(const QUrl& pUpdateUrl);
 		Q_INVOKABLE virtual void downloadIfNew(const QUrl& pUpdateUrl,
-				const QDateTime& pCurrentTimestamp);
+				const QDateTime& pCurrentTimestamp,
+				const QByteArray& pCurrentETag = QByteArray());
 
 		static Downloader& getInstance();
 
 	Q_SIGNALS:
-		void fireDownloadSuccess(const QUrl& pUpdateUrl, const QDateTime& pNewTimestamp, const QByteArray& pData);
+		void fireDownloadSuccess(const QUrl& pUpdateUrl, const QDateTime& pNewTimestamp, const QByteArray& pData, const QByteArray& pETag);
 		void fireDownloadFailed(const QUrl& pUpdateUrl, GlobalStatus::Code pErrorCode);
 		void fireDownloadUnnecessary(const QUrl& pUpdateUrl);
 };
@@ -10,8 +10,10 @@
 
 #include <QDir>
 #include <QFile>
+#include <QFutureWatcher>
 #include <QLoggingCategory>
 #include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
 
 #ifndef QT_NO_DEBUG
 #include <QTemporaryDir>
@@ -58,23 +60,23 @@ const QString& UpdatableFile::getSectionCachePath() const
 
 QString UpdatableFile::qrcPath() const
 {
-	const QString prefix = QStringLiteral("updatable-files");
-	const QString path = QStringLiteral(":/") + prefix + Sep + mSection + Sep + mName;
+	// The resource bundle does not change at runtime
+	if (!mQrcPathResolved)
+	{
+		const QString prefix = QStringLiteral("updatable-files");
+		const QString path = QStringLiteral(":/") + prefix + Sep + mSection + Sep + mName;
+
+		mQrcPath = QFile::exists(path) ? path : QString();
+		mQrcPathResolved = true;
+	}
 
-	return QFile::exists(path) ? path : QString();
+	return mQrcPath;
 }
 
 
 QString UpdatableFile::cachePath() const
 {
-	QDir folder(mSectionCachePath);
-	const QStringList nameFilter = QStringList({mName + QStringLiteral("_*")});
-	const QStringList matchingFiles = folder.entryList(nameFilter, QDir::Files, QDir::Name | QDir::Reversed);
-
-	// Files are saved in the cache with the suffix _<timestamp>, where
-	// the timestamp has the format "yyyyMMddhhmmss".
-	// Therefore, the first matching file in the list has the newest timestamp.
-	return matchingFiles.isEmpty() ? QString() : mSectionCachePath + Sep + matchingFiles.first();
+	return mManifest ? mManifest->getFilePath(mName) : QString();
 }
 
 
@@ -93,6 +95,24 @@ QString UpdatableFile::dirtyFilePath() const
 }
 
 
+QString UpdatableFile::eTagFilePath() const
+{
+	return mSectionCachePath.isEmpty() ? QString() : mSectionCachePath + Sep + mName + QStringLiteral(".etag");
+}
+
+
+QByteArray UpdatableFile::cacheETag() const
+{
+	QFile file(eTagFilePath());
+	if (!file.exists() || !file.open(QIODevice::ReadOnly))
+	{
+		return QByteArray();
+	}
+
+	return file.readAll();
+}
+
+
 QString UpdatableFile::sectionCachePath(const QString& pSection) const
 {
 	const QStringList cachePaths = QStandardPaths::standardLocations(QStandardPaths::CacheLocation);
@@ -147,12 +167,18 @@ QString UpdatableFile::makeSectionCachePath(const QString& pSection)
 }
 
 
-void UpdatableFile::cleanupAfterUpdate(const std::function<void()>& pCustomAction)
+void UpdatableFile::disconnectDownloader()
 {
 	Downloader* const downloader = Env::getSingleton<Downloader>();
 	disconnect(downloader, &Downloader::fireDownloadSuccess, this, &UpdatableFile::onDownloadSuccess);
 	disconnect(downloader, &Downloader::fireDownloadFailed, this, &UpdatableFile::onDownloadFailed);
 	disconnect(downloader, &Downloader::fireDownloadUnnecessary, this, &UpdatableFile::onDownloadUnnecessary);
+}
+
+
+void UpdatableFile::cleanupAfterUpdate(const std::function<void()>& pCustomAction)
+{
+	disconnectDownloader();
 
 	pCustomAction();
 
@@ -160,25 +186,57 @@ void UpdatableFile::cleanupAfterUpdate(const std::function<void()>& pCustomActio
 }
 
 
-void UpdatableFile::onDownloadSuccess(const QUrl& pUpdateUrl, const QDateTime& pNewTimestamp, const QByteArray& pData)
+void UpdatableFile::onDownloadSuccess(const QUrl& pUpdateUrl, const QDateTime& pNewTimestamp, const QByteArray& pData, const QByteArray& pETag)
 {
 	if (pUpdateUrl == mUpdateUrl)
 	{
-		const QString dateFormat = QStringLiteral("yyyyMMddhhmmss");
-		const QString filePath = mSectionCachePath + Sep + mName + QLatin1Char('_') + pNewTimestamp.toString(dateFormat);
-
-		if (writeDataToFile(pData, filePath))
-		{
-			Q_EMIT fireUpdated();
-		}
-		else
-		{
-			qCCritical(fileprovider) << "Could not write downloaded file" << filePath;
-		}
+		// Ignore further results until the file is written, mUpdateRunning stays set.
+		disconnectDownloader();
 
-		cleanupAfterUpdate([&](){
-					clearDirty();
+		const QString dateFormat = QStringLiteral("yyyyMMddhhmmss");
+		const QString fileName = mName + QLatin1Char('_') + pNewTimestamp.toString(dateFormat);
+		const QString filePath = mSectionCachePath + Sep + fileName;
+		const QString eTagPath = eTagFilePath();
+
+		// Writing is done by a worker thread to keep the main thread responsive
+		// while a lot of files are updated at startup.
+		auto* const watcher = new QFutureWatcher<bool>(this);
+		connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, fileName, filePath](){
+					watcher->deleteLater();
+					if (watcher->result())
+					{
+						if (mManifest)
+						{
+							mManifest->setFileName(mName, fileName);
+						}
+						Q_EMIT fireUpdated();
+					}
+					else
+					{
+						qCCritical(fileprovider) << "Could not write downloaded file" << filePath;
+					}
+
+					cleanupAfterUpdate([&](){
+								clearDirty();
+							});
 				});
+
+		watcher->setFuture(QtConcurrent::run([pData, filePath, pETag, eTagPath](){
+					if (!writeDataToFile(pData, filePath))
+					{
+						return false;
+					}
+
+					if (pETag.isEmpty())
+					{
+						QFile::remove(eTagPath);
+					}
+					else
+					{
+						writeDataToFile(pETag, eTagPath, true);
+					}
+					return true;
+				}));
 	}
 }
 
@@ -236,8 +294,11 @@ UpdatableFile::UpdatableFile(const QString& pSection, const QString& pName, cons
 	, mName(pName)
 	, mDefaultPath(pDefaultPath)
 	, mSectionCachePath(makeSectionCachePath(pSection))
+	, mManifest(CacheManifest::getManifest(mSectionCachePath))
 	, mUpdateUrl(updateUrl(pSection, pName))
 	, mUpdateRunning(false)
+	, mQrcPath()
+	, mQrcPathResolved(false)
 {
 }
 
@@ -314,7 +375,7 @@ void UpdatableFile::update()
 		const QDateTime timestamp = cacheTimestamp();
 		if (timestamp.isValid())
 		{
-			downloader->downloadIfNew(mUpdateUrl, timestamp);
+			downloader->downloadIfNew(mUpdateUrl, timestamp, cacheETag());
 		}
 		else
 		{
@@ -326,12 +387,12 @@ void UpdatableFile::update()
 
 bool UpdatableFile::isDirty() const
 {
-	if (mName.isEmpty())
+	if (mName.isEmpty() || !mManifest)
 	{
 		return false;
 	}
 
-	return QFile::exists(dirtyFilePath());
+	return mManifest->isDirty(mName);
 }
 
 
@@ -349,6 +410,12 @@ void UpdatableFile::clearDirty() const
 	if (file.exists() && !file.remove())
 	{
 		qCCritical(fileprovider) << "Cannot remove file:" << filePath;
+		return;
+	}
+
+	if (mManifest && !mName.isEmpty())
+	{
+		mManifest->setDirty(mName, false);
 	}
 }
 
@@ -369,8 +436,14 @@ void UpdatableFile::markDirty() const
 		if (!file.open(QIODevice::WriteOnly))
 		{
 			qCCritical(fileprovider) << "Cannot create file:" << filePath;
+			return;
 		}
 
 		file.close();
 	}
+
+	if (mManifest && !mName.isEmpty())
+	{
+		mManifest->setDirty(mName, true);
+	}
 }
@@ -9,9 +9,11 @@
 
 #pragma once
 
+#include "CacheManifest.h"
 #include "GlobalStatus.h"
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QUrl>
 
 #include <functional>
@@ -35,8 +37,11 @@ class UpdatableFile
 		const QString mName;
 		QString mDefaultPath;
 		const QString mSectionCachePath;
+		const QSharedPointer<CacheManifest> mManifest;
 		const QUrl mUpdateUrl;
 		bool mUpdateRunning;
+		mutable QString mQrcPath;
+		mutable bool mQrcPathResolved;
 
 		const QString& getName();
 		QDateTime cacheTimestamp() const;
@@ -46,13 +51,16 @@ class UpdatableFile
 		QString cachePath() const;
 		QUrl updateUrl(const QString& pSection, const QString& pName);
 		QString dirtyFilePath() const;
+		QString eTagFilePath() const;
+		QByteArray cacheETag() const;
 		QString sectionCachePath(const QString& pSection) const;
 		QString makeSectionCachePath(const QString& pSection);
+		void disconnectDownloader();
 		void cleanupAfterUpdate(const std::function<void()>& pCustomAction);
-		bool writeDataToFile(const QByteArray& pData, const QString& pFilePath, bool pOverwrite = false);
+		static bool writeDataToFile(const QByteArray& pData, const QString& pFilePath, bool pOverwrite = false);
 
 	private Q_SLOTS:
-		void onDownloadSuccess(const QUrl& pUpdateUrl, const QDateTime& pNewTimestamp, const QByteArray& pData);
+		void onDownloadSuccess(const QUrl& pUpdateUrl, const QDateTime& pNewTimestamp, const QByteArray& pData, const QByteArray& pETag);
 		void onDownloadFailed(const QUrl& pUpdateUrl, GlobalStatus::Code pErrorCode);
 		void onDownloadUnnecessary(const QUrl& pUpdateUrl);
 
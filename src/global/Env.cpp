@@ -13,6 +13,12 @@ using namespace governikus;
 defineSingleton(Env)
 
 Env::Env()
+	: mTypeInfo()
+	, mInstancesUnmanaged()
+	, mInstancesOwnership()
+	, mSharedInstances()
+	, mMutex(QMutex::Recursive)
+	, mGeneration(1)
 {
 }
 
@@ -101,6 +107,8 @@ void Env::resetCounter()
 void Env::clear()
 {
 	auto& holder = getInstance();
+	const QMutexLocker locker(&holder.mMutex);
+	holder.mGeneration.ref();
 	holder.mInstancesOwnership.clear();
 	holder.mInstancesUnmanaged.clear();
 	holder.mTypeInfo.clear();
@@ -113,7 +121,11 @@ void Env::set(const QMetaObject& pMetaObject, void* pObject)
 {
 	Identifier className = pMetaObject.className();
 	Q_ASSERT_X(!QByteArray(className).toLower().contains("mock"), "test", "Do you really want to mock a mock?");
-	getInstance().storeSingleton(className, pObject);
+
+	auto& holder = getInstance();
+	const QMutexLocker locker(&holder.mMutex);
+	holder.mGeneration.ref();
+	holder.storeSingleton(className, pObject);
 
 }
 
@@ -122,14 +134,21 @@ void Env::set(const QMetaObject& pMetaObject, std::shared_ptr<void> pObject)
 {
 	Identifier className = pMetaObject.className();
 	Q_ASSERT_X(!QByteArray(className).toLower().contains("mock"), "test", "Do you really want to mock a mock?");
-	getInstance().storeSingleton(className, pObject);
+
+	auto& holder = getInstance();
+	const QMutexLocker locker(&holder.mMutex);
+	holder.mGeneration.ref();
+	holder.storeSingleton(className, pObject);
 }
 
 
 void Env::setShared(const QMetaObject& pMetaObject, QSharedPointer<QObject> pObject)
 {
 	Identifier className = pMetaObject.className();
-	auto& holder = getInstance().mSharedInstances;
+	auto& env = getInstance();
+	const QMutexLocker locker(&env.mMutex);
+
+	auto& holder = env.mSharedInstances;
 	if (pObject)
 	{
 		qDebug() << "Add shared instance:" << className;
@@ -8,9 +8,13 @@
 
 #include <functional>
 #include <memory>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QMap>
 #include <QMetaObject>
 #include <QMetaType>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QObject>
 #include <QSharedPointer>
 #include <QWeakPointer>
@@ -96,11 +100,24 @@ class Env
 			UNMANAGED
 		};
 
+		/*!
+		 * Every type gets a static slot that caches the result of the lookup in the maps.
+		 * A slot is valid as long as its generation matches the generation of Env, which
+		 * is only changed if a test replaces an instance or a creator.
+		 */
+		struct Slot
+		{
+			QAtomicPointer<void> mObject;
+			QAtomicInt mGeneration;
+		};
+
 		using Identifier = const char*;
 		QMap<Identifier, Type> mTypeInfo;
 		QMap<Identifier, void*> mInstancesUnmanaged;
 		QMap<Identifier, std::shared_ptr<void> > mInstancesOwnership;
 		QMap<Identifier, QWeakPointer<QObject> > mSharedInstances;
+		QMutex mMutex;
+		QAtomicInt mGeneration;
 
 		static Env& getInstance();
 
@@ -152,6 +169,23 @@ class Env
 		{
 			static_assert(QtPrivate::IsGadgetHelper<T>::Value || QtPrivate::IsPointerToTypeDerivedFromQObject<T*>::Value,
 					"Singletons needs to be a Q_GADGET or an QObject/Q_OBJECT");
+
+			static Slot slot;
+			if (slot.mGeneration.loadAcquire() == mGeneration.loadAcquire())
+			{
+				return static_cast<T*>(slot.mObject.loadAcquire());
+			}
+
+			return static_cast<T*>(resolveSingleton<T>(slot));
+		}
+
+
+		template<typename T>
+		void* resolveSingleton(Slot& pSlot)
+		{
+			// Recursive, as a singleton may fetch other singletons in its constructor
+			const QMutexLocker locker(&mMutex);
+
 			Identifier id = T::staticMetaObject.className();
 			void* obj = fetchStoredSingleton(id);
 
@@ -160,7 +194,9 @@ class Env
 				obj = storeSingleton<T>(id);
 			}
 
-			return static_cast<T*>(obj);
+			pSlot.mObject.storeRelease(obj);
+			pSlot.mGeneration.storeRelease(mGeneration.loadAcquire());
+			return obj;
 		}
 
 
@@ -196,18 +232,45 @@ class Env
 		}
 
 
+#ifndef QT_NO_DEBUG
 		template<typename T, typename ... Args>
-		T createObject(Args&& ... pArgs) const
+		inline FuncWrapper<T, Args ...>* fetchCreator()
 		{
-#ifndef QT_NO_DEBUG
+			static Slot slot;
+			if (slot.mGeneration.loadAcquire() == mGeneration.loadAcquire())
+			{
+				return static_cast<FuncWrapper<T, Args ...>*>(slot.mObject.loadAcquire());
+			}
+
+			const QMutexLocker locker(&mMutex);
+
+			FuncWrapper<T, Args ...>* creator = nullptr;
 			for (auto& mock : qAsConst(mInstancesCreator))
 			{
-				auto creator = dynamic_cast<FuncWrapper<T, Args ...>*>(mock.get());
+				creator = dynamic_cast<FuncWrapper<T, Args ...>*>(mock.get());
 				if (creator)
 				{
-					return (*creator)(std::forward<Args>(pArgs) ...);
+					break;
 				}
 			}
+
+			slot.mObject.storeRelease(creator);
+			slot.mGeneration.storeRelease(mGeneration.loadAcquire());
+			return creator;
+		}
+
+
+#endif
+
+		template<typename T, typename ... Args>
+		T createObject(Args&& ... pArgs)
+		{
+#ifndef QT_NO_DEBUG
+			auto creator = fetchCreator<T, Args ...>();
+			if (creator)
+			{
+				return (*creator)(std::forward<Args>(pArgs) ...);
+			}
 #endif
 
 			return newObject<T>(std::forward<Args>(pArgs) ...);
@@ -239,7 +302,10 @@ class Env
 			static_assert(QtPrivate::IsGadgetHelper<T>::Value || QtPrivate::IsPointerToTypeDerivedFromQObject<T*>::Value,
 					"Shared class needs to be a Q_GADGET or an QObject/Q_OBJECT");
 
-			auto& holder = getInstance().mSharedInstances;
+			auto& env = getInstance();
+			const QMutexLocker locker(&env.mMutex);
+
+			auto& holder = env.mSharedInstances;
 			const auto* className = T::staticMetaObject.className();
 
 			QSharedPointer<T> shared = qSharedPointerCast<T>(holder.value(className));
@@ -286,7 +352,11 @@ class Env
 		{
 			Q_ASSERT(pFunc);
 
-			auto& holder = getInstance().mInstancesCreator;
+			auto& env = getInstance();
+			const QMutexLocker locker(&env.mMutex);
+			env.mGeneration.ref();
+
+			auto& holder = env.mInstancesCreator;
 			const auto& value = Wrapper(new FuncWrapper<T, Args ...>(pFunc));
 
 			QMutableVectorIterator<Wrapper> iter(holder);
@@ -6,7 +6,13 @@
 
 #include "SingletonHelper.h"
 
+#include <QCryptographicHash>
+#include <QDebug>
+
 #include <chrono>
+#include <cstring>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
 #include <openssl/rand.h>
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
@@ -16,14 +22,13 @@
 #ifdef Q_OS_WIN
 	#include <windows.h>
 #elif defined(Q_OS_UNIX)
-	#if defined(Q_OS_Linux) && !defined(Q_OS_ANDROID)
+	#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
 		#include <syscall.h>
 	#endif
 	#if defined(SYS_getrandom)
 		#include <linux/random.h>
 		#include <unistd.h>
 	#else
-		#include <QDebug>
 		#include <QFile>
 	#endif
 	#if defined(Q_OS_IOS) || defined(Q_OS_MACOS)
@@ -37,6 +42,128 @@ using namespace governikus;
 defineSingleton(Randomizer)
 
 
+const int RandomGenerator::BUFFER_SIZE = 4096;
+const int RandomGenerator::RESEED_INTERVAL = 256;
+
+
+namespace
+{
+/*!
+ * Requests fresh randomness of the operating system with a single call. OpenSSL
+ * is used if getrandom is not available, it is seeded by the operating system, too.
+ */
+QByteArray getSystemRandom(int pLength)
+{
+	QByteArray data(pLength, '\0');
+
+#ifdef SYS_getrandom
+	if (syscall(SYS_getrandom, data.data(), static_cast<size_t>(pLength), 0) == pLength)
+	{
+		return data;
+	}
+#endif
+
+	if (RAND_bytes(reinterpret_cast<uchar*>(data.data()), pLength) != 1)
+	{
+		qCritical() << "Cannot get random bytes of the operating system";
+	}
+
+	return data;
+}
+
+
+}
+
+
+RandomGenerator::RandomGenerator(const QByteArray& pSeed)
+	: mKey(QCryptographicHash::hash(pSeed + getSystemRandom(KEY_SIZE), QCryptographicHash::Sha256))
+	, mBuffer(KEY_SIZE + BUFFER_SIZE, '\0')
+	, mPosition(mBuffer.size())
+	, mRefillCount(0)
+{
+}
+
+
+RandomGenerator::~RandomGenerator()
+{
+	OPENSSL_cleanse(mKey.data(), static_cast<size_t>(mKey.size()));
+	OPENSSL_cleanse(mBuffer.data(), static_cast<size_t>(mBuffer.size()));
+}
+
+
+void RandomGenerator::reseed()
+{
+	const QByteArray key = QCryptographicHash::hash(mKey + getSystemRandom(KEY_SIZE), QCryptographicHash::Sha256);
+	OPENSSL_cleanse(mKey.data(), static_cast<size_t>(mKey.size()));
+	mKey = key;
+}
+
+
+void RandomGenerator::refill()
+{
+	if (++mRefillCount % RESEED_INTERVAL == 0)
+	{
+		reseed();
+	}
+
+	// The key is used once only, so a constant IV is fine
+	static const uchar iv[16] = {};
+	auto* const buffer = reinterpret_cast<uchar*>(mBuffer.data());
+	std::memset(buffer, 0, static_cast<size_t>(mBuffer.size()));
+
+	EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+	int length = 0;
+	const bool success = ctx
+			&& EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, reinterpret_cast<const uchar*>(mKey.constData()), iv)
+			&& EVP_EncryptUpdate(ctx, buffer, &length, buffer, mBuffer.size())
+			&& length == mBuffer.size();
+	EVP_CIPHER_CTX_free(ctx);
+
+	if (!success)
+	{
+		qCritical() << "Cannot create key stream, falling back to OpenSSL";
+		if (RAND_bytes(buffer, mBuffer.size()) != 1)
+		{
+			qCritical() << "Cannot get random bytes of OpenSSL";
+		}
+	}
+
+	// Replace the key by the first block, so the previous output cannot be reconstructed
+	std::memcpy(mKey.data(), buffer, KEY_SIZE);
+	OPENSSL_cleanse(buffer, KEY_SIZE);
+	mPosition = KEY_SIZE;
+}
+
+
+void RandomGenerator::fill(char* pData, int pLength)
+{
+	while (pLength > 0)
+	{
+		if (mPosition == mBuffer.size())
+		{
+			refill();
+		}
+
+		const int length = qMin(pLength, mBuffer.size() - mPosition);
+		char* const source = mBuffer.data() + mPosition;
+		std::memcpy(pData, source, static_cast<size_t>(length));
+		OPENSSL_cleanse(source, static_cast<size_t>(length));
+
+		mPosition += length;
+		pData += length;
+		pLength -= length;
+	}
+}
+
+
+RandomGenerator::result_type RandomGenerator::operator()()
+{
+	result_type value;
+	fill(reinterpret_cast<char*>(&value), sizeof(value));
+	return value;
+}
+
+
 template<typename T, typename U = uchar> union UniversalBuffer
 {
 	T number;
@@ -97,7 +224,9 @@ template<typename T> QList<T> Randomizer::getEntropyUnixoid()
 
 #ifdef SYS_getrandom
 	UniversalBuffer<T> buffer;
-	if (syscall(SYS_getrandom, buffer.data, sizeof(buffer.data), GRND_NONBLOCK))
+	// The call returns -1 if the pool is not initialized yet (EAGAIN) or
+	// the kernel does not support it (ENOSYS), the buffer is unchanged then.
+	if (syscall(SYS_getrandom, buffer.data, sizeof(buffer.data), GRND_NONBLOCK) == static_cast<long>(sizeof(buffer.data)))
 	{
 		entropy += buffer.number;
 	}
@@ -122,7 +251,10 @@ template<typename T> QList<T> Randomizer::getEntropyUnixoid()
 		}
 		while (bytesToRead > 0);
 
-		entropy += buffer.number;
+		if (bytesToRead == 0)
+		{
+			entropy += buffer.number;
+		}
 		file.close();
 	}
 	else
@@ -152,24 +284,31 @@ template<typename T> QList<T> Randomizer::getEntropyApple()
 
 
 Randomizer::Randomizer()
+	: mSeed()
+	, mSecureRandom(false)
+	, mGenerators()
 {
-	const auto& entropy = getEntropy<std::mt19937::result_type>();
-	std::seed_seq seed(entropy.cbegin(), entropy.cend());
-	mGenerator.seed(seed);
+	const auto& entropy = getEntropy<quint64>();
+
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	for (const auto value : entropy)
+	{
+		hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+	mSeed = hash.result();
 
 	// We need to seed pseudo random pool of openssl.
 	// yes, OpenSSL is an entropy source, too. But not the only one!
-	UniversalBuffer<std::mt19937::result_type> buffer;
-	buffer.number = mGenerator();
-	RAND_seed(buffer.data, sizeof(std::mt19937::result_type));
+	RAND_seed(mSeed.constData(), mSeed.size());
 
 	static const int MINIMUM_ENTROPY_SOURCES = 5;
-	mSecureRandom = seed.size() >= MINIMUM_ENTROPY_SOURCES;
+	mSecureRandom = entropy.size() >= MINIMUM_ENTROPY_SOURCES;
 }
 
 
 Randomizer::~Randomizer()
 {
+	OPENSSL_cleanse(mSeed.data(), static_cast<size_t>(mSeed.size()));
 }
 
 
@@ -179,9 +318,14 @@ Randomizer& Randomizer::getInstance()
 }
 
 
-std::mt19937& Randomizer::getGenerator()
+RandomGenerator& Randomizer::getGenerator()
 {
-	return mGenerator;
+	if (!mGenerators.hasLocalData())
+	{
+		mGenerators.setLocalData(new RandomGenerator(mSeed));
+	}
+
+	return *mGenerators.localData();
 }
 
 
@@ -189,3 +333,27 @@ bool Randomizer::isSecureRandom() const
 {
 	return mSecureRandom;
 }
+
+
+QByteArray Randomizer::createBytes(int pCount)
+{
+	QByteArray bytes(pCount, '\0');
+	getGenerator().fill(bytes.data(), pCount);
+	return bytes;
+}
+
+
+QByteArray Randomizer::createPin(int pDigits)
+{
+	QByteArray pin;
+	pin.reserve(pDigits);
+
+	std::uniform_int_distribution<int> digit(0, 9);
+	auto& generator = getGenerator();
+	for (int i = 0; i < pDigits; ++i)
+	{
+		pin += static_cast<char>('0' + digit(generator));
+	}
+
+	return pin;
+}
@@ -6,17 +6,75 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QList>
+#include <QThreadStorage>
+
+#include <limits>
 #include <random>
 
+class test_Randomizer;
+
 namespace governikus
 {
 
+/*!
+ * Buffered random generator of a single thread. The output is the
+ * AES-256-CTR key stream of a key that is replaced by the first bytes of
+ * the stream on every refill. Returned bytes are wiped from the buffer,
+ * so a later state does not reveal previous output.
+ */
+class RandomGenerator
+{
+	friend class ::test_Randomizer;
+
+	private:
+		static const int KEY_SIZE = 32;
+		static const int BUFFER_SIZE;
+		static const int RESEED_INTERVAL;
+
+		QByteArray mKey;
+		QByteArray mBuffer;
+		int mPosition;
+		int mRefillCount;
+
+		RandomGenerator(const RandomGenerator&) = delete;
+		RandomGenerator& operator=(const RandomGenerator&) = delete;
+
+		void refill();
+		void reseed();
+
+	public:
+		using result_type = quint32;
+
+		explicit RandomGenerator(const QByteArray& pSeed);
+		~RandomGenerator();
+
+		static constexpr result_type min()
+		{
+			return std::numeric_limits<result_type>::min();
+		}
+
+
+		static constexpr result_type max()
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+
+		result_type operator()();
+		void fill(char* pData, int pLength);
+};
+
+
 class Randomizer
 {
+	friend class ::test_Randomizer;
+
 	private:
-		std::mt19937 mGenerator;
+		QByteArray mSeed;
 		bool mSecureRandom;
+		QThreadStorage<RandomGenerator*> mGenerators;
 
 		template<typename T> static QList<T> getEntropy();
 		template<typename T> static QList<T> getEntropyWin();
@@ -33,9 +91,27 @@ class Randomizer
 	public:
 		static Randomizer& getInstance();
 
-		std::mt19937& getGenerator();
+		/*!
+		 * Returns the generator of the calling thread. Every thread
+		 * gets its own generator, so it must not be shared with others.
+		 */
+		RandomGenerator& getGenerator();
 		bool isSecureRandom() const;
 
+		QByteArray createBytes(int pCount);
+
+		/*!
+		 * Creates a numeric PIN with leading zeros.
+		 */
+		QByteArray createPin(int pDigits);
+
+		template<typename T> T createNumber(T pMin = 0, T pMax = std::numeric_limits<T>::max())
+		{
+			std::uniform_int_distribution<T> distribution(pMin, pMax);
+			return distribution(getGenerator());
+		}
+
+
 };
 
 } /* namespace governikus */
@@ -0,0 +1,207 @@
+/*
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "StartupTimeline.h"
+
+#include <QLoggingCategory>
+#include <QMetaObject>
+#include <QtConcurrent/QtConcurrentRun>
+
+using namespace governikus;
+
+Q_DECLARE_LOGGING_CATEGORY(init)
+
+
+StartupTimeline::StartupTimeline()
+	: QObject()
+	, mTimer()
+	, mSteps()
+	, mNextDeferredStep(0)
+	, mReady(false)
+{
+	mTimer.start();
+}
+
+
+StartupTimeline::~StartupTimeline()
+{
+	for (auto& step : mSteps)
+	{
+		step.mFuture.waitForFinished();
+	}
+}
+
+
+int StartupTimeline::indexOf(const QString& pName) const
+{
+	for (int i = 0; i < mSteps.size(); ++i)
+	{
+		if (mSteps.at(i).mName == pName)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+
+bool StartupTimeline::waitForDependencies(const Step& pStep) const
+{
+	bool success = true;
+	for (const auto& name : pStep.mDependencies)
+	{
+		const Step& dependency = mSteps.at(indexOf(name));
+		if (dependency.mExecution == Execution::CONCURRENT)
+		{
+			success = dependency.mFuture.result() && success;
+		}
+		else
+		{
+			success = dependency.mResult && success;
+		}
+	}
+	return success;
+}
+
+
+bool StartupTimeline::execute(const QString& pName, const std::function<bool()>& pFunc)
+{
+	const qint64 started = mTimer.elapsed();
+	const bool success = pFunc();
+	const qint64 duration = mTimer.elapsed() - started;
+
+	if (success)
+	{
+		qCDebug(init) << "Startup step" << pName << "finished after" << duration << "ms";
+	}
+	else
+	{
+		qCCritical(init) << "Startup step" << pName << "failed after" << duration << "ms";
+	}
+
+	Q_EMIT fireStepFinished(pName, started, duration, success);
+	return success;
+}
+
+
+void StartupTimeline::addStep(const QString& pName, Execution pExecution, const std::function<bool()>& pFunc, const QStringList& pDependencies)
+{
+	Q_ASSERT(pFunc);
+	Q_ASSERT(indexOf(pName) == -1);
+
+	// Dependencies must be added first, so the steps are in topological order
+	for (const auto& dependency : pDependencies)
+	{
+		Q_ASSERT(indexOf(dependency) != -1);
+		Q_ASSERT(mSteps.at(indexOf(dependency)).mExecution != Execution::DEFERRED || pExecution == Execution::DEFERRED);
+		Q_UNUSED(dependency);
+	}
+
+	mSteps += {pName, pExecution, pFunc, pDependencies, QFuture<bool>(), false};
+}
+
+
+bool StartupTimeline::run()
+{
+	for (auto& step : mSteps)
+	{
+		switch (step.mExecution)
+		{
+			case Execution::BLOCKING:
+				if (!waitForDependencies(step))
+				{
+					qCCritical(init) << "Cannot run startup step" << step.mName << "because a dependency failed";
+					return false;
+				}
+
+				step.mResult = execute(step.mName, step.mFunc);
+				if (!step.mResult)
+				{
+					return false;
+				}
+				break;
+
+			case Execution::CONCURRENT:
+			{
+				// Blocking dependencies are already finished successfully at this point.
+				// The worker must not access mSteps, so it gets the futures of the others.
+				QVector<QFuture<bool> > dependencies;
+				for (const auto& name : qAsConst(step.mDependencies))
+				{
+					const Step& dependency = mSteps.at(indexOf(name));
+					if (dependency.mExecution == Execution::CONCURRENT)
+					{
+						dependencies += dependency.mFuture;
+					}
+				}
+
+				const QString name = step.mName;
+				const auto func = step.mFunc;
+				step.mFuture = QtConcurrent::run([this, name, func, dependencies](){
+							for (const auto& dependency : dependencies)
+							{
+								if (!dependency.result())
+								{
+									qCCritical(init) << "Cannot run startup step" << name << "because a dependency failed";
+									return false;
+								}
+							}
+							return execute(name, func);
+						});
+				break;
+			}
+
+			case Execution::DEFERRED:
+				break;
+		}
+	}
+
+	qCDebug(init) << "Blocking startup steps finished after" << mTimer.elapsed() << "ms";
+	return true;
+}
+
+
+qint64 StartupTimeline::elapsed() const
+{
+	return mTimer.elapsed();
+}
+
+
+void StartupTimeline::ready()
+{
+	if (mReady)
+	{
+		return;
+	}
+	mReady = true;
+
+	const qint64 elapsed = mTimer.elapsed();
+	qCInfo(init) << "Application is ready after" << elapsed << "ms";
+	Q_EMIT fireReady(elapsed);
+
+	QMetaObject::invokeMethod(this, "onRunDeferredStep", Qt::QueuedConnection);
+}
+
+
+void StartupTimeline::onRunDeferredStep()
+{
+	while (mNextDeferredStep < mSteps.size())
+	{
+		Step& step = mSteps[mNextDeferredStep++];
+		if (step.mExecution != Execution::DEFERRED)
+		{
+			continue;
+		}
+
+		step.mResult = waitForDependencies(step) && execute(step.mName, step.mFunc);
+
+		// Return to the event loop between two deferred steps to keep the user interface responsive
+		QMetaObject::invokeMethod(this, "onRunDeferredStep", Qt::QueuedConnection);
+		return;
+	}
+
+	const qint64 elapsed = mTimer.elapsed();
+	qCDebug(init) << "Deferred startup steps finished after" << elapsed << "ms";
+	Q_EMIT fireDeferredStepsFinished(elapsed);
+}
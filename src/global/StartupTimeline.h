@@ -0,0 +1,82 @@
+/*!
+ * \brief Runs the steps of the application startup in the order of their
+ * dependencies and records when each step started and finished.
+ *
+ * Blocking steps are executed by run() on the calling thread. Concurrent
+ * steps are started on the global thread pool as soon as their dependencies
+ * are finished. Deferred steps are executed on the calling thread one by one
+ * after ready() was called.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+class test_StartupTimeline;
+
+namespace governikus
+{
+
+class StartupTimeline
+	: public QObject
+{
+	Q_OBJECT
+
+	public:
+		enum class Execution
+		{
+			BLOCKING, CONCURRENT, DEFERRED
+		};
+
+	private:
+		friend class ::test_StartupTimeline;
+
+		struct Step
+		{
+			QString mName;
+			Execution mExecution;
+			std::function<bool()> mFunc;
+			QStringList mDependencies;
+			QFuture<bool> mFuture;
+			bool mResult;
+		};
+
+		QElapsedTimer mTimer;
+		QVector<Step> mSteps;
+		int mNextDeferredStep;
+		bool mReady;
+
+		int indexOf(const QString& pName) const;
+		bool waitForDependencies(const Step& pStep) const;
+		bool execute(const QString& pName, const std::function<bool()>& pFunc);
+
+	private Q_SLOTS:
+		void onRunDeferredStep();
+
+	public:
+		StartupTimeline();
+		virtual ~StartupTimeline() override;
+
+		void addStep(const QString& pName, Execution pExecution, const std::function<bool()>& pFunc, const QStringList& pDependencies = QStringList());
+		bool run();
+		qint64 elapsed() const;
+
+	public Q_SLOTS:
+		void ready();
+
+	Q_SIGNALS:
+		void fireStepFinished(const QString& pName, qint64 pStarted, qint64 pDuration, bool pSuccess);
+		void fireReady(qint64 pElapsed);
+		void fireDeferredStepsFinished(qint64 pElapsed);
+};
+
+} /* namespace governikus */
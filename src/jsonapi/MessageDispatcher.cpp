@@ -19,6 +19,7 @@
 #include "messages/MsgHandlerReader.h"
 #include "messages/MsgHandlerReaderList.h"
 #include "messages/MsgHandlerUnknownCommand.h"
+#include "ReaderManager.h"
 
 #include <QLoggingCategory>
 
@@ -31,6 +32,7 @@ using namespace governikus;
 
 MessageDispatcher::MessageDispatcher()
 	: mContext()
+	, mReaderInfos()
 {
 }
 
@@ -50,9 +52,29 @@ QByteArray MessageDispatcher::init(const QSharedPointer<WorkflowContext>& pConte
 }
 
 
-QByteArray MessageDispatcher::createMsgReader(const QString& pName) const
+MsgLevel MessageDispatcher::getApiLevel() const
 {
-	return MsgHandlerReader(pName).getOutput();
+	return mContext.getApiLevel();
+}
+
+
+QByteArray MessageDispatcher::createMsgReader(const QString& pName)
+{
+	return createMsgReader(ReaderManager::getInstance().getReaderInfo(pName));
+}
+
+
+QByteArray MessageDispatcher::createMsgReader(const ReaderInfo& pInfo)
+{
+	if (mContext.getApiLevel() < MsgLevel::v2)
+	{
+		mReaderInfos.clear();
+		return MsgHandlerReader(pInfo).getOutput();
+	}
+
+	const MsgHandlerReader msg(pInfo, mReaderInfos.value(pInfo.getName()));
+	mReaderInfos.insert(pInfo.getName(), MsgHandlerReader::createReaderInfo(pInfo));
+	return msg.getOutput();
 }
 
 
@@ -10,7 +10,9 @@
 #include "context/WorkflowContext.h"
 #include "messages/MsgContext.h"
 #include "messages/MsgHandler.h"
+#include "ReaderInfo.h"
 
+#include <QHash>
 #include <QJsonDocument>
 #include <QString>
 
@@ -23,6 +25,7 @@ class MessageDispatcher
 {
 	private:
 		MsgDispatcherContext mContext;
+		QHash<QString, QJsonObject> mReaderInfos;
 
 		MsgHandler createForStateChange(MsgType pStateType);
 		MsgHandler createForCommand(const QJsonObject& pObj);
@@ -38,8 +41,15 @@ class MessageDispatcher
 		QByteArray finish();
 		QByteArray processCommand(const QByteArray& pMsg);
 		QByteArray processStateChange(const QString& pState);
+		MsgLevel getApiLevel() const;
 
-		QByteArray createMsgReader(const QString& pName) const;
+		QByteArray createMsgReader(const QString& pName);
+
+		/*!
+		 * Creates a READER message. Since API level 2 only the fields that
+		 * changed since the last READER message of this reader are sent.
+		 */
+		QByteArray createMsgReader(const ReaderInfo& pInfo);
 };
 
 } /* namespace governikus */
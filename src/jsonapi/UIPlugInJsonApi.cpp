@@ -13,10 +13,19 @@ Q_DECLARE_LOGGING_CATEGORY(jsonapi)
 
 using namespace governikus;
 
+const int UIPlugInJsonApi::READER_EVENT_INTERVAL = 100;
+
+
 UIPlugInJsonApi::UIPlugInJsonApi()
 	: UIPlugIn()
 	, mMessageDispatcher()
+	, mReaderEventTimer()
+	, mPendingReaderEvents()
 {
+	mReaderEventTimer.setSingleShot(true);
+	mReaderEventTimer.setInterval(READER_EVENT_INTERVAL);
+	connect(&mReaderEventTimer, &QTimer::timeout, this, &UIPlugInJsonApi::onReaderEventTimeout);
+
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireReaderAdded, this, &UIPlugInJsonApi::onReaderEvent);
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireReaderRemoved, this, &UIPlugInJsonApi::onReaderEvent);
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireCardInserted, this, &UIPlugInJsonApi::onReaderEvent);
@@ -29,6 +38,16 @@ UIPlugInJsonApi::~UIPlugInJsonApi()
 }
 
 
+void UIPlugInJsonApi::setReaderEventInterval(int pMsec)
+{
+	mReaderEventTimer.setInterval(pMsec);
+	if (pMsec == 0)
+	{
+		onReaderEventTimeout();
+	}
+}
+
+
 void UIPlugInJsonApi::callFireMessage(const QByteArray& pMsg)
 {
 	if (!pMsg.isEmpty())
@@ -64,7 +83,53 @@ void UIPlugInJsonApi::onWorkflowFinished(QSharedPointer<WorkflowContext> )
 
 void UIPlugInJsonApi::onReaderEvent(const QString& pName)
 {
-	callFireMessage(mMessageDispatcher.createMsgReader(pName));
+	if (mReaderEventTimer.interval() == 0 || mMessageDispatcher.getApiLevel() < MsgLevel::v2)
+	{
+		callFireMessage(mMessageDispatcher.createMsgReader(pName));
+		return;
+	}
+
+	if (!mPendingReaderEvents.contains(pName))
+	{
+		mPendingReaderEvents += pName;
+	}
+
+	if (!mReaderEventTimer.isActive())
+	{
+		mReaderEventTimer.start();
+	}
+}
+
+
+void UIPlugInJsonApi::onReaderEventTimeout()
+{
+	mReaderEventTimer.stop();
+	if (mPendingReaderEvents.isEmpty())
+	{
+		return;
+	}
+
+	const QStringList readerNames = mPendingReaderEvents;
+	mPendingReaderEvents.clear();
+
+	if (readerNames.size() == 1)
+	{
+		callFireMessage(mMessageDispatcher.createMsgReader(readerNames.first()));
+		return;
+	}
+
+	// Query all readers at once instead of a blocking call per reader
+	QHash<QString, ReaderInfo> readerInfos;
+	const auto& infos = ReaderManager::getInstance().getReaderInfos();
+	for (const auto& info : infos)
+	{
+		readerInfos.insert(info.getName(), info);
+	}
+
+	for (const auto& name : readerNames)
+	{
+		callFireMessage(mMessageDispatcher.createMsgReader(readerInfos.value(name, ReaderInfo(name))));
+	}
 }
 
 
@@ -77,6 +142,11 @@ void UIPlugInJsonApi::onStateChanged(const QString& pNewState)
 void UIPlugInJsonApi::doMessageProcessing(const QByteArray& pMsg)
 {
 	callFireMessage(mMessageDispatcher.processCommand(pMsg));
+
+	if (mMessageDispatcher.getApiLevel() < MsgLevel::v2)
+	{
+		onReaderEventTimeout();
+	}
 }
 
 
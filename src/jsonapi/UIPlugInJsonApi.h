@@ -10,6 +10,9 @@
 #include "MessageDispatcher.h"
 #include "view/UIPlugIn.h"
 
+#include <QStringList>
+#include <QTimer>
+
 namespace governikus
 {
 
@@ -22,18 +25,30 @@ class UIPlugInJsonApi
 
 	private:
 		MessageDispatcher mMessageDispatcher;
+		QTimer mReaderEventTimer;
+		QStringList mPendingReaderEvents;
 
 		inline void callFireMessage(const QByteArray& pMsg);
 
 	public:
+		static const int READER_EVENT_INTERVAL;
+
 		UIPlugInJsonApi();
 		virtual ~UIPlugInJsonApi() override;
 
+		/*!
+		 * Reader events that occur within pMsec are merged per reader
+		 * into a single READER message. A value of 0 sends every event immediately.
+		 * Clients below API level 2 always receive every event immediately.
+		 */
+		void setReaderEventInterval(int pMsec);
+
 	private Q_SLOTS:
 		virtual void doShutdown() override;
 		virtual void onWorkflowStarted(QSharedPointer<WorkflowContext> pContext) override;
 		virtual void onWorkflowFinished(QSharedPointer<WorkflowContext> pContext) override;
 		void onReaderEvent(const QString& pName);
+		void onReaderEventTimeout();
 		void onStateChanged(const QString& pNewState);
 
 	public Q_SLOTS:
@@ -35,6 +35,43 @@ MsgHandlerReader::MsgHandlerReader(const QString& pName)
 }
 
 
+MsgHandlerReader::MsgHandlerReader(const ReaderInfo& pInfo)
+	: MsgHandler(MsgType::READER)
+{
+	Q_ASSERT(!pInfo.getName().isEmpty());
+	setReaderInfo(mJsonObject, pInfo);
+}
+
+
+MsgHandlerReader::MsgHandlerReader(const ReaderInfo& pInfo, const QJsonObject& pPrevious)
+	: MsgHandler(MsgType::READER)
+{
+	const auto& current = createReaderInfo(pInfo);
+
+	bool changed = false;
+	for (auto iter = current.constBegin(); iter != current.constEnd(); ++iter)
+	{
+		if (pPrevious.value(iter.key()) != iter.value())
+		{
+			mJsonObject[iter.key()] = iter.value();
+			changed = true;
+		}
+	}
+
+	for (auto iter = pPrevious.constBegin(); iter != pPrevious.constEnd(); ++iter)
+	{
+		if (!current.contains(iter.key()))
+		{
+			mJsonObject[iter.key()] = QJsonValue::Null;
+			changed = true;
+		}
+	}
+
+	mJsonObject[QLatin1String("name")] = pInfo.getName();
+	setVoid(!changed);
+}
+
+
 void MsgHandlerReader::setError(const QLatin1String pError)
 {
 	mJsonObject[QLatin1String("error")] = pError;
@@ -26,6 +26,14 @@ class MsgHandlerReader
 
 		MsgHandlerReader(const QJsonObject& pObj);
 		MsgHandlerReader(const QString& pName);
+		MsgHandlerReader(const ReaderInfo& pInfo);
+
+		/*!
+		 * Creates a message that contains the name and all fields of the reader
+		 * that differ from pPrevious. Fields that are missing now are set to null.
+		 * The message is void if nothing has changed.
+		 */
+		MsgHandlerReader(const ReaderInfo& pInfo, const QJsonObject& pPrevious);
 };
 
 
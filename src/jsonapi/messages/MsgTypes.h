@@ -10,7 +10,7 @@
 
 namespace governikus
 {
-defineEnumType(MsgLevel, v1 = 1) // See MsgHandler::DEFAULT_MSG_LEVEL
+defineEnumType(MsgLevel, v1 = 1, v2 = 2) // See MsgHandler::DEFAULT_MSG_LEVEL
 
 defineEnumType(MsgType,
 		INVALID,
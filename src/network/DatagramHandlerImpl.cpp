@@ -36,11 +36,16 @@ template<> DatagramHandler* createNewObject<DatagramHandler*, bool>(bool&& pList
 
 
 quint16 DatagramHandlerImpl::cPort = 24727;
+int DatagramHandlerImpl::cBroadcastRefreshInterval = 30000;
 
 
 DatagramHandlerImpl::DatagramHandlerImpl(bool pListen)
 	: DatagramHandler()
 	, mSocket(new QUdpSocket)
+	, mBroadcastAddresses()
+	, mBroadcastAddressesAge()
+	, mLastData()
+	, mLastSerializedData()
 {
 #ifndef QT_NO_NETWORKPROXY
 	mSocket->setProxy(QNetworkProxy::NoProxy);
@@ -79,9 +84,23 @@ bool DatagramHandlerImpl::isBound() const
 }
 
 
-bool DatagramHandlerImpl::send(const QJsonDocument& pData)
+void DatagramHandlerImpl::invalidateBroadcastAddresses()
+{
+	mBroadcastAddressesAge.invalidate();
+}
+
+
+const QVector<QHostAddress>& DatagramHandlerImpl::getBroadcastAddresses()
 {
-	QVector<QHostAddress> broadcastAddresses;
+	// Enumerating the interfaces is expensive as every call queries the
+	// operating system. The table is refreshed independently of the send
+	// interval and whenever a previous broadcast failed.
+	if (mBroadcastAddressesAge.isValid() && !mBroadcastAddressesAge.hasExpired(cBroadcastRefreshInterval))
+	{
+		return mBroadcastAddresses;
+	}
+
+	mBroadcastAddresses.clear();
 	const auto& interfaces = QNetworkInterface::allInterfaces();
 	for (const QNetworkInterface& interface : interfaces)
 	{
@@ -98,20 +117,43 @@ bool DatagramHandlerImpl::send(const QJsonDocument& pData)
 				continue;
 			}
 
-			broadcastAddresses += broadcastAddr;
+			mBroadcastAddresses += broadcastAddr;
 		}
 	}
 
+	mBroadcastAddressesAge.start();
+	return mBroadcastAddresses;
+}
+
+
+const QByteArray& DatagramHandlerImpl::serialize(const QJsonDocument& pData)
+{
+	if (mLastSerializedData.isNull() || pData != mLastData)
+	{
+		mLastData = pData;
+		mLastSerializedData = pData.toJson(QJsonDocument::Compact);
+	}
+
+	return mLastSerializedData;
+}
+
+
+bool DatagramHandlerImpl::send(const QJsonDocument& pData)
+{
+	const auto& broadcastAddresses = getBroadcastAddresses();
 	if (broadcastAddresses.isEmpty())
 	{
+		invalidateBroadcastAddresses();
 		return false;
 	}
 
-	for (const QHostAddress& broadcastAddr : qAsConst(broadcastAddresses))
+	const auto& data = serialize(pData);
+	for (const QHostAddress& broadcastAddr : broadcastAddresses)
 	{
-		if (!send(pData, broadcastAddr))
+		if (!send(data, broadcastAddr))
 		{
 			qDebug() << "Broadcasting to" << broadcastAddr << "failed";
+			invalidateBroadcastAddresses();
 			return false;
 		}
 	}
@@ -122,9 +164,14 @@ bool DatagramHandlerImpl::send(const QJsonDocument& pData)
 
 bool DatagramHandlerImpl::send(const QJsonDocument& pData, const QHostAddress& pAddress)
 {
-	const auto& data = pData.toJson(QJsonDocument::Compact);
+	return send(serialize(pData), pAddress);
+}
+
+
+bool DatagramHandlerImpl::send(const QByteArray& pData, const QHostAddress& pAddress)
+{
 	const quint16 remotePort = cPort == 0 ? mSocket->localPort() : cPort;
-	if (mSocket->writeDatagram(data.constData(), pAddress, remotePort) != data.size())
+	if (mSocket->writeDatagram(pData.constData(), pData.size(), pAddress, remotePort) != pData.size())
 	{
 		qCCritical(network) << "Cannot write datagram:" << mSocket->error() << '|' << mSocket->errorString();
 		return false;
@@ -8,9 +8,11 @@
 
 #include "DatagramHandler.h"
 
+#include <QElapsedTimer>
 #include <QScopedPointer>
 #include <QSharedPointer>
 #include <QUdpSocket>
+#include <QVector>
 
 class test_DatagramHandlerImpl;
 
@@ -27,9 +29,18 @@ class DatagramHandlerImpl
 		friend struct QtSharedPointer::CustomDeleter<DatagramHandlerImpl, QtSharedPointer::NormalDeleter>;
 
 		static quint16 cPort;
+		static int cBroadcastRefreshInterval;
 		QScopedPointer<QUdpSocket, QScopedPointerDeleteLater> mSocket;
 
+		QVector<QHostAddress> mBroadcastAddresses;
+		QElapsedTimer mBroadcastAddressesAge;
+		QJsonDocument mLastData;
+		QByteArray mLastSerializedData;
+
+		const QVector<QHostAddress>& getBroadcastAddresses();
+		const QByteArray& serialize(const QJsonDocument& pData);
 		bool send(const QJsonDocument& pData, const QHostAddress& pAddress);
+		bool send(const QByteArray& pData, const QHostAddress& pAddress);
 
 	public:
 		DatagramHandlerImpl(bool pListen = true);
@@ -38,6 +49,8 @@ class DatagramHandlerImpl
 		virtual bool isBound() const override;
 		virtual bool send(const QJsonDocument& pData) override;
 
+		void invalidateBroadcastAddresses();
+
 	private Q_SLOTS:
 		void onReadyRead();
 };
@@ -21,11 +21,44 @@ HttpRequest::HttpRequest(QAbstractSocket* pSocket, QObject* pParent)
 				s->flush();
 				s->deleteLater();
 			})
+	, mPipelinedData()
+	, mRequestNumber(1)
+	, mIdleTimer()
 	, mParser()
 	, mParserSettings()
 	, mFinished(false)
-	, mCurrentHeaderField()
-	, mCurrentHeaderValue()
+	, mKeepAlive(false)
+	, mHeaderValueParsed(false)
+{
+	init();
+	onReadyRead();
+}
+
+
+HttpRequest::HttpRequest(const QSharedPointer<QAbstractSocket>& pSocket, const QByteArray& pPipelinedData, int pRequestNumber, QObject* pParent)
+	: QObject(pParent)
+	, mUrl()
+	, mHeader()
+	, mBody()
+	, mSocket(pSocket)
+	, mPipelinedData(pPipelinedData)
+	, mRequestNumber(pRequestNumber)
+	, mIdleTimer()
+	, mParser()
+	, mParserSettings()
+	, mFinished(false)
+	, mKeepAlive(false)
+	, mHeaderValueParsed(false)
+{
+	init();
+
+	// The previous request may have left data in the socket buffer without a new readyRead.
+	// Parse it queued, so the caller can connect to fireMessageComplete first.
+	QMetaObject::invokeMethod(this, "onReadyRead", Qt::QueuedConnection);
+}
+
+
+void HttpRequest::init()
 {
 	Q_ASSERT(mSocket);
 
@@ -40,9 +73,13 @@ HttpRequest::HttpRequest(QAbstractSocket* pSocket, QObject* pParent)
 	mParserSettings.on_body = &HttpRequest::onBody;
 	mParserSettings.on_url = &HttpRequest::onUrl;
 
+	mHeader.reserve(16);
+
+	mIdleTimer.setSingleShot(true);
+	connect(&mIdleTimer, &QTimer::timeout, this, &HttpRequest::onIdleTimeout);
+
 	connect(mSocket.data(), &QAbstractSocket::readyRead, this, &HttpRequest::onReadyRead);
 	connect(mSocket.data(), &QAbstractSocket::disconnected, this, &HttpRequest::deleteLater);
-	onReadyRead();
 }
 
 
@@ -71,11 +108,20 @@ bool HttpRequest::isUpgrade() const
 
 QByteArray HttpRequest::getHeader(const QByteArray& pKey) const
 {
-	return mHeader.value(pKey);
+	// The last occurrence wins if a field is repeated
+	const auto& end = mHeader.crend();
+	for (auto iter = mHeader.crbegin(); iter != end; ++iter)
+	{
+		if (iter->first == pKey)
+		{
+			return iter->second;
+		}
+	}
+	return QByteArray();
 }
 
 
-const QMap<QByteArray, QByteArray>& HttpRequest::getHeader() const
+const QVector<QPair<QByteArray, QByteArray> >& HttpRequest::getHeader() const
 {
 	return mHeader;
 }
@@ -93,36 +139,129 @@ const QByteArray& HttpRequest::getBody() const
 }
 
 
+int HttpRequest::getRequestNumber() const
+{
+	return mRequestNumber;
+}
+
+
+const QByteArray& HttpRequest::getPipelinedData() const
+{
+	return mPipelinedData;
+}
+
+
+bool HttpRequest::isKeepAlive() const
+{
+	return mKeepAlive;
+}
+
+
+void HttpRequest::setKeepAlive(bool pKeepAlive)
+{
+	mKeepAlive = pKeepAlive;
+}
+
+
+void HttpRequest::setIdleTimeout(int pTimeout)
+{
+	if (pTimeout > 0 && !mFinished)
+	{
+		mIdleTimer.start(pTimeout);
+	}
+	else
+	{
+		mIdleTimer.stop();
+	}
+}
+
+
+bool HttpRequest::isPersistentByDefault() const
+{
+	return mParser.http_major > 1 || (mParser.http_major == 1 && mParser.http_minor >= 1);
+}
+
+
 bool HttpRequest::send(const HttpResponse& pResponse)
 {
-	const auto& msg = pResponse.getMessage();
+	// Informational responses like 102 Processing are followed by the final one
+	const bool finalResponse = static_cast<int>(pResponse.getStatus()) >= 200;
+
+	QByteArray msg;
+	const auto& connection = pResponse.getHeader(QByteArrayLiteral("Connection"));
+	if (finalResponse && connection.isEmpty() && (!mKeepAlive || !isPersistentByDefault()))
+	{
+		// HTTP/1.1 connections are persistent unless closed, HTTP/1.0 clients asked for keep-alive explicitly
+		HttpResponse response(pResponse);
+		response.setHeader(QByteArrayLiteral("Connection"), mKeepAlive ? QByteArrayLiteral("keep-alive") : QByteArrayLiteral("close"));
+		msg = response.getMessage();
+	}
+	else
+	{
+		if (connection.toLower() == QByteArrayLiteral("close"))
+		{
+			mKeepAlive = false;
+		}
+		msg = pResponse.getMessage();
+	}
+
 	if (mSocket->write(msg) != msg.size())
 	{
 		qCCritical(network) << "Cannot write response:" << mSocket->error() << '|' << mSocket->errorString();
 		return false;
 	}
+
+	if (finalResponse && mKeepAlive)
+	{
+		mKeepAlive = false;
+		qCDebug(network) << "Keep connection alive after request" << mRequestNumber;
+		Q_EMIT fireKeepAlive(this, mSocket);
+	}
 	return true;
 }
 
 
+void HttpRequest::parse(const QByteArray& pBuffer)
+{
+	const auto parsed = http_parser_execute(&mParser, &mParserSettings, pBuffer.constData(), static_cast<size_t>(pBuffer.size()));
+
+	// See macro HTTP_PARSER_ERRNO if http_errno fails.
+	// We do not use this to avoid -Wold-style-cast warning
+	const auto errorCode = static_cast<http_errno>(mParser.http_errno);
+	if (errorCode == HPE_PAUSED)
+	{
+		// The parser stops after a complete message, the rest belongs to the next request.
+		mPipelinedData = pBuffer.mid(static_cast<int>(parsed));
+	}
+	else if (errorCode != HPE_OK)
+	{
+		qCWarning(network) << "Http request not well-formed:" << http_errno_name(errorCode) << "|" << http_errno_description(errorCode);
+	}
+}
+
+
 void HttpRequest::onReadyRead()
 {
-	while (mSocket->bytesAvailable())
+	if (mFinished)
 	{
-		const auto& buffer = mSocket->readAll();
-		http_parser_execute(&mParser, &mParserSettings, buffer.constData(), static_cast<size_t>(buffer.size()));
+		return;
+	}
 
-		// See macro HTTP_PARSER_ERRNO if http_errno fails.
-		// We do not use this to avoid -Wold-style-cast warning
-		const auto errorCode = static_cast<http_errno>(mParser.http_errno);
-		if (errorCode != HPE_OK)
-		{
-			qCWarning(network) << "Http request not well-formed:" << http_errno_name(errorCode) << "|" << http_errno_description(errorCode);
-		}
+	if (!mPipelinedData.isEmpty())
+	{
+		const QByteArray pipelinedData = mPipelinedData;
+		mPipelinedData.clear();
+		parse(pipelinedData);
+	}
+
+	while (!mFinished && mSocket->bytesAvailable())
+	{
+		parse(mSocket->readAll());
 	}
 
 	if (mFinished)
 	{
+		mIdleTimer.stop();
 		disconnect(mSocket.data(), &QAbstractSocket::readyRead, this, &HttpRequest::onReadyRead);
 		disconnect(mSocket.data(), &QAbstractSocket::disconnected, this, &HttpRequest::deleteLater);
 		Q_EMIT fireMessageComplete(this, mSocket);
@@ -130,6 +269,14 @@ void HttpRequest::onReadyRead()
 }
 
 
+void HttpRequest::onIdleTimeout()
+{
+	qCDebug(network) << "Close idle connection while waiting for request" << mRequestNumber;
+	disconnect(mSocket.data(), &QAbstractSocket::readyRead, this, &HttpRequest::onReadyRead);
+	mSocket->disconnectFromHost();
+}
+
+
 int HttpRequest::onMessageBegin(http_parser* pParser)
 {
 	Q_UNUSED(pParser)
@@ -141,6 +288,8 @@ int HttpRequest::onMessageComplete(http_parser* pParser)
 {
 	CAST_OBJ(pParser)
 	obj->mFinished = true;
+	obj->mKeepAlive = !obj->isUpgrade() && http_should_keep_alive(pParser);
+	http_parser_pause(pParser, 1);
 	qCDebug(network) << "Message completed";
 	return 0;
 }
@@ -149,7 +298,11 @@ int HttpRequest::onMessageComplete(http_parser* pParser)
 int HttpRequest::onHeadersComplete(http_parser* pParser)
 {
 	CAST_OBJ(pParser)
-	obj->insertHeader();
+	for (auto& header : obj->mHeader)
+	{
+		qCDebug(network).nospace() << "Header | " << header.first << ": " << header.second;
+		header.first = header.first.toLower();
+	}
 	qCDebug(network) << obj->getMethod() << " |" << obj->getUrl();
 	qCDebug(network) << "Header completed";
 	return 0;
@@ -159,8 +312,12 @@ int HttpRequest::onHeadersComplete(http_parser* pParser)
 int HttpRequest::onHeaderField(http_parser* pParser, const char* pPos, size_t pLength)
 {
 	CAST_OBJ(pParser)
-	obj->insertHeader();
-	add(obj->mCurrentHeaderField, pPos, pLength);
+	if (obj->mHeader.isEmpty() || obj->mHeaderValueParsed)
+	{
+		obj->mHeader.append(qMakePair(QByteArray(), QByteArray()));
+		obj->mHeaderValueParsed = false;
+	}
+	add(obj->mHeader.last().first, pPos, pLength);
 	return 0;
 }
 
@@ -168,7 +325,11 @@ int HttpRequest::onHeaderField(http_parser* pParser, const char* pPos, size_t pL
 int HttpRequest::onHeaderValue(http_parser* pParser, const char* pPos, size_t pLength)
 {
 	CAST_OBJ(pParser)
-	add(obj->mCurrentHeaderValue, pPos, pLength);
+	if (!obj->mHeader.isEmpty())
+	{
+		add(obj->mHeader.last().second, pPos, pLength);
+		obj->mHeaderValueParsed = true;
+	}
 	return 0;
 }
 
@@ -188,14 +349,3 @@ int HttpRequest::onUrl(http_parser* pParser, const char* pPos, size_t pLength)
 	return 0;
 }
 
-
-void HttpRequest::insertHeader()
-{
-	if (!mCurrentHeaderField.isEmpty() && !mCurrentHeaderValue.isEmpty())
-	{
-		qCDebug(network).nospace() << "Header | " << mCurrentHeaderField << ": " << mCurrentHeaderValue;
-		mHeader.insert(mCurrentHeaderField.toLower(), mCurrentHeaderValue);
-		mCurrentHeaderField.clear();
-		mCurrentHeaderValue.clear();
-	}
-}
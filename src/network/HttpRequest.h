@@ -11,10 +11,12 @@
 
 #include <QAbstractSocket>
 #include <QByteArray>
-#include <QMap>
 #include <QObject>
+#include <QPair>
 #include <QSharedPointer>
+#include <QTimer>
 #include <QUrl>
+#include <QVector>
 
 class test_WebserviceActivationHandler;
 
@@ -39,25 +41,36 @@ class HttpRequest
 
 		static inline void add(QByteArray& pDest, const char* pPos, size_t pLength)
 		{
-			pDest += QByteArray(pPos, static_cast<int>(pLength));
+			pDest.append(pPos, static_cast<int>(pLength));
 		}
 
 
 		QByteArray mUrl;
-		QMap<QByteArray, QByteArray> mHeader;
+		QVector<QPair<QByteArray, QByteArray> > mHeader;
 		QByteArray mBody;
 		QSharedPointer<QAbstractSocket> mSocket;
+		QByteArray mPipelinedData;
+		const int mRequestNumber;
+		QTimer mIdleTimer;
 		http_parser mParser;
 		http_parser_settings mParserSettings;
 
 		bool mFinished;
-		QByteArray mCurrentHeaderField;
-		QByteArray mCurrentHeaderValue;
+		bool mKeepAlive;
+		bool mHeaderValueParsed;
 
-		void insertHeader();
+		void init();
+		void parse(const QByteArray& pBuffer);
+		bool isPersistentByDefault() const;
 
 	public:
 		HttpRequest(QAbstractSocket* pSocket, QObject* pParent = nullptr);
+
+		/*!
+		 * Creates the follow-up request of a persistent connection. Data that was
+		 * already read behind the previous request (pipelining) is parsed first.
+		 */
+		HttpRequest(const QSharedPointer<QAbstractSocket>& pSocket, const QByteArray& pPipelinedData, int pRequestNumber, QObject* pParent = nullptr);
 		virtual ~HttpRequest();
 
 		bool isConnected() const;
@@ -65,17 +78,38 @@ class HttpRequest
 		QByteArray getMethod() const;
 		bool isUpgrade() const;
 		QByteArray getHeader(const QByteArray& pKey) const;
-		const QMap<QByteArray, QByteArray>& getHeader() const;
+		const QVector<QPair<QByteArray, QByteArray> >& getHeader() const;
 		QUrl getUrl() const;
 		const QByteArray& getBody() const;
 
+		/*!
+		 * Number of this request on its connection, starting with 1.
+		 */
+		int getRequestNumber() const;
+		const QByteArray& getPipelinedData() const;
+
+		/*!
+		 * Whether the connection is kept open after the final response. This is only
+		 * valid after fireMessageComplete and can be revoked by setKeepAlive(false).
+		 */
+		bool isKeepAlive() const;
+		void setKeepAlive(bool pKeepAlive);
+
+		/*!
+		 * Closes the connection if no complete request was received within the
+		 * given time in milliseconds. A value of 0 disables the timeout.
+		 */
+		void setIdleTimeout(int pTimeout);
+
 		bool send(const HttpResponse& pResponse);
 
 	private Q_SLOTS:
 		void onReadyRead();
+		void onIdleTimeout();
 
 	Q_SIGNALS:
 		void fireMessageComplete(HttpRequest* pSelf, QSharedPointer<QAbstractSocket> pSocket);
+		void fireKeepAlive(HttpRequest* pSelf, QSharedPointer<QAbstractSocket> pSocket);
 };
 
 } /* namespace governikus */
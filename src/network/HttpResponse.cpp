@@ -117,7 +117,7 @@ QByteArray HttpResponse::getMessage() const
 
 	const auto& statusCode = QByteArray::number(static_cast<int>(mStatus));
 	QByteArray statusMsg(getEnumName(mStatus).data());
-	list += QByteArrayLiteral("HTTP/1.0 ") % statusCode % ' ' % statusMsg.replace('_', ' ');
+	list += QByteArrayLiteral("HTTP/1.1 ") % statusCode % ' ' % statusMsg.replace('_', ' ');
 
 	const auto& end = mHeader.constEnd();
 	for (auto iter = mHeader.constBegin(); iter != end; ++iter)
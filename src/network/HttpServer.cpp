@@ -11,6 +11,8 @@ using namespace governikus;
 Q_DECLARE_LOGGING_CATEGORY(network)
 
 quint16 HttpServer::cPort = 24727;
+int HttpServer::cIdleTimeout = 5000;
+int HttpServer::cMaxRequestsPerConnection = 100;
 
 HttpServer::HttpServer(quint16 pPort)
 	: QObject()
@@ -51,14 +53,21 @@ quint16 HttpServer::getServerPort() const
 }
 
 
+void HttpServer::addRequest(HttpRequest* pRequest)
+{
+	connect(pRequest, &HttpRequest::fireMessageComplete, this, &HttpServer::onMessageComplete);
+	connect(pRequest, &HttpRequest::fireKeepAlive, this, &HttpServer::onKeepAlive);
+	pRequest->setIdleTimeout(cIdleTimeout);
+}
+
+
 void HttpServer::onNewConnection()
 {
 	while (mServer->hasPendingConnections())
 	{
 		auto socket = mServer->nextPendingConnection();
 		socket->startTransaction();
-		auto request = new HttpRequest(socket, this);
-		connect(request, &HttpRequest::fireMessageComplete, this, &HttpServer::onMessageComplete);
+		addRequest(new HttpRequest(socket, this));
 	}
 }
 
@@ -70,6 +79,15 @@ void HttpServer::onMessageComplete(HttpRequest* pRequest, QSharedPointer<QAbstra
 	if (pRequest->isUpgrade())
 	{
 		pRequest->deleteLater();
+
+		// Only the first request of a connection is read in a transaction
+		if (pRequest->getRequestNumber() > 1)
+		{
+			qCWarning(network) << "Upgrade on persistent connection is not supported";
+			pRequest->send(HttpStatusCode::NOT_FOUND);
+			return;
+		}
+
 		pSocket->rollbackTransaction();
 
 		if (pRequest->getHeader(QByteArrayLiteral("upgrade")).toLower() == QByteArrayLiteral("websocket"))
@@ -85,7 +103,21 @@ void HttpServer::onMessageComplete(HttpRequest* pRequest, QSharedPointer<QAbstra
 	}
 	else
 	{
-		pSocket->commitTransaction();
+		if (pSocket->isTransactionStarted())
+		{
+			pSocket->commitTransaction();
+		}
+
+		if (pRequest->getRequestNumber() >= cMaxRequestsPerConnection)
+		{
+			pRequest->setKeepAlive(false);
+		}
 		Q_EMIT fireNewHttpRequest(QSharedPointer<HttpRequest>(pRequest, &QObject::deleteLater));
 	}
 }
+
+
+void HttpServer::onKeepAlive(HttpRequest* pRequest, QSharedPointer<QAbstractSocket> pSocket)
+{
+	addRequest(new HttpRequest(pSocket, pRequest->getPipelinedData(), pRequest->getRequestNumber() + 1, this));
+}
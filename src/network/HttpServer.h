@@ -24,9 +24,21 @@ class HttpServer
 	private:
 		QScopedPointer<QTcpServer, QScopedPointerDeleteLater> mServer;
 
+		void addRequest(HttpRequest* pRequest);
+
 	public:
 		static quint16 cPort;
 
+		/*!
+		 * Milliseconds a connection may stay open without a complete request.
+		 */
+		static int cIdleTimeout;
+
+		/*!
+		 * Maximum number of requests served on one persistent connection.
+		 */
+		static int cMaxRequestsPerConnection;
+
 		HttpServer(quint16 pPort = HttpServer::cPort);
 		virtual ~HttpServer();
 
@@ -36,6 +48,7 @@ class HttpServer
 	private Q_SLOTS:
 		void onNewConnection();
 		void onMessageComplete(HttpRequest* pRequest, QSharedPointer<QAbstractSocket> pSocket);
+		void onKeepAlive(HttpRequest* pRequest, QSharedPointer<QAbstractSocket> pSocket);
 
 	Q_SIGNALS:
 		void fireNewHttpRequest(const QSharedPointer<HttpRequest>& pRequest);
@@ -26,10 +26,36 @@ Q_DECLARE_LOGGING_CATEGORY(network)
 
 bool NetworkManager::mLockProxy = false;
 
+
+namespace
+{
+QSslConfiguration getTlsConfiguration(SecureStorage::TlsSuite pTlsSuite, const QByteArray& pSslSession)
+{
+	// The configurations of SecureStorage are prepared once per suite. Unless a
+	// session is resumed the request shares their data instead of a deep copy.
+	auto cfg = SecureStorage::getInstance().getTlsConfig(pTlsSuite).getConfiguration();
+	if (!pSslSession.isEmpty())
+	{
+		cfg.setSessionTicket(pSslSession);
+	}
+	return cfg;
+}
+
+
+QString getSessionKey(const QUrl& pUrl)
+{
+	return pUrl.adjusted(QUrl::RemoveUserInfo | QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment).toString();
+}
+
+
+}
+
+
 NetworkManager::NetworkManager()
 	: QObject()
 	, mApplicationExitInProgress(false)
 	, mOpenConnectionCount(0)
+	, mSslSessions()
 	, mNetAccessManager(new QNetworkAccessManager())
 {
 #ifndef QT_NO_NETWORKPROXY
@@ -82,10 +108,13 @@ QNetworkReply* NetworkManager::paos(QNetworkRequest& pRequest,
 
 	QNetworkReply* response;
 	SecureStorage::TlsSuite tlsSuite = pUsePsk ? SecureStorage::TlsSuite::PSK : SecureStorage::TlsSuite::DEFAULT;
-	auto cfg = SecureStorage::getInstance().getTlsConfig(tlsSuite).getConfiguration();
-	cfg.setSessionTicket(pSslSession);
-	pRequest.setSslConfiguration(cfg);
+	const QByteArray& sslSession = pUsePsk ? pSslSession : getSslSession(pRequest.url(), pSslSession);
+	pRequest.setSslConfiguration(getTlsConfiguration(tlsSuite, sslSession));
 	response = mNetAccessManager->post(pRequest, pData);
+	if (!pUsePsk)
+	{
+		trackSslSession(response);
+	}
 
 	trackConnection(response, pTimeoutInMilliSeconds);
 	return response;
@@ -102,10 +131,9 @@ QNetworkReply* NetworkManager::get(QNetworkRequest& pRequest,
 	}
 
 	pRequest.setHeader(QNetworkRequest::UserAgentHeader, getUserAgentHeader());
-	auto cfg = SecureStorage::getInstance().getTlsConfig().getConfiguration();
-	cfg.setSessionTicket(pSslSession);
-	pRequest.setSslConfiguration(cfg);
+	pRequest.setSslConfiguration(getTlsConfiguration(SecureStorage::TlsSuite::DEFAULT, getSslSession(pRequest.url(), pSslSession)));
 	QNetworkReply* response = mNetAccessManager->get(pRequest);
+	trackSslSession(response);
 	trackConnection(response, pTimeoutInMilliSeconds);
 	return response;
 }
@@ -120,6 +148,30 @@ bool NetworkManager::checkUpdateServerCertificate(const QNetworkReply& pReply)
 }
 
 
+const QByteArray& NetworkManager::getSslSession(const QUrl& pUrl, const QByteArray& pSslSession) const
+{
+	if (!pSslSession.isEmpty())
+	{
+		return pSslSession;
+	}
+
+	const auto& iter = mSslSessions.constFind(getSessionKey(pUrl));
+	return iter == mSslSessions.constEnd() ? pSslSession : iter.value();
+}
+
+
+void NetworkManager::trackSslSession(QNetworkReply* pResponse)
+{
+	connect(pResponse, &QNetworkReply::encrypted, this, [this, pResponse] {
+				const auto& session = pResponse->sslConfiguration().sessionTicket();
+				if (!session.isEmpty())
+				{
+					mSslSessions.insert(getSessionKey(pResponse->request().url()), session);
+				}
+			});
+}
+
+
 QString NetworkManager::getUserAgentHeader() const
 {
 	const auto& info = VersionInfo::getInstance();
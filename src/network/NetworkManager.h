@@ -11,6 +11,7 @@
 #include <QAtomicInt>
 #include <QAuthenticator>
 #include <QDebug>
+#include <QHash>
 #include <QNetworkAccessManager>
 #include <QNetworkProxy>
 #include <QNetworkReply>
@@ -27,7 +28,10 @@ class NetworkManager
 	private:
 		bool mApplicationExitInProgress;
 		QAtomicInt mOpenConnectionCount;
+		QHash<QString, QByteArray> mSslSessions;
 		void trackConnection(QNetworkReply* pResponse, const int pTimeoutInMilliSeconds);
+		const QByteArray& getSslSession(const QUrl& pUrl, const QByteArray& pSslSession) const;
+		void trackSslSession(QNetworkReply* pResponse);
 
 		static bool mLockProxy;
 		QScopedPointer<QNetworkAccessManager, QScopedPointerDeleteLater> mNetAccessManager;
@@ -66,6 +70,13 @@ class NetworkManager
 		static QString getTlsVersionString(QSsl::SslProtocol pProtocol);
 
 		virtual void clearConnections();
+
+		/*!
+		 * Requests without the PSK suite offer the last session ticket of the
+		 * same origin if no session is given. This allows the server to resume
+		 * the session instead of a full handshake, even if the connection was
+		 * closed or cleared meanwhile.
+		 */
 		virtual QNetworkReply* paos(QNetworkRequest& pRequest,
 				const QByteArray& pNamespace,
 				const QByteArray& pData,
@@ -6,22 +6,41 @@
 
 #include "AppSettings.h"
 #include "Env.h"
-#include "KeyPair.h"
+#include "KeyPairProvider.h"
 #include "TlsChecker.h"
 
 using namespace governikus;
 
-bool RemoteHelper::checkAndGenerateKey()
+bool RemoteHelper::isKeyRequired()
 {
-	auto& settings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
+	const auto& settings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
 
-	if (settings.getKey().isNull()
+	return settings.getKey().isNull()
 			|| settings.getCertificate().isNull()
 			|| settings.getCertificate().expiryDate() < QDateTime::currentDateTime()
-			|| !TlsChecker::hasValidCertificateKeyLength(settings.getCertificate()))
+			|| !TlsChecker::hasValidCertificateKeyLength(settings.getCertificate());
+}
+
+
+void RemoteHelper::prepareKey()
+{
+	if (isKeyRequired())
+	{
+		KeyPairProvider::getInstance().prepare();
+	}
+}
+
+
+bool RemoteHelper::checkAndGenerateKey()
+{
+	auto& settings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
+
+	if (isKeyRequired())
 	{
+		// The remote reader TLS configuration offers RSA cipher suites only, so an
+		// EC identity would not be accepted by other devices.
 		qDebug() << "Generate local keypair...";
-		const auto& pair = KeyPair::generate();
+		const auto& pair = KeyPairProvider::getInstance().take();
 		if (pair.isValid())
 		{
 			settings.setKey(pair.getKey());
@@ -14,7 +14,13 @@ class RemoteHelper
 	private:
 		RemoteHelper() = delete;
 
+		static bool isKeyRequired();
+
 	public:
+		/*!
+		 * Generates the local key pair in background if checkAndGenerateKey() would need a new one.
+		 */
+		static void prepareKey();
 		static bool checkAndGenerateKey();
 };
 
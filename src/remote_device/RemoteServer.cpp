@@ -32,13 +32,15 @@ RemoteServer::~RemoteServer()
 
 void RemoteServerImpl::onConnectedChanged(bool pConnected)
 {
-	if (pConnected)
+	Q_UNUSED(pConnected);
+
+	if (!mWebSocketServer->canAcceptConnection())
 	{
 		mRemoteReaderAdvertiser.reset();
 		return;
 	}
 
-	if (isRunning() && !pConnected)
+	if (isRunning() && !mRemoteReaderAdvertiser)
 	{
 		const auto& ifdName = mWebSocketServer->getServerName();
 		const auto& remoteServiceSettings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
@@ -104,8 +106,8 @@ QSslCertificate RemoteServerImpl::getCurrentCertificate() const
 }
 
 
-const QSharedPointer<ServerMessageHandler>& RemoteServerImpl::getMessageHandler() const
+const QVector<QSharedPointer<ServerMessageHandler> >& RemoteServerImpl::getMessageHandlers() const
 {
 	Q_ASSERT(mWebSocketServer);
-	return mWebSocketServer->getMessageHandler();
+	return mWebSocketServer->getMessageHandlers();
 }
@@ -12,6 +12,7 @@
 #include <QScopedPointer>
 #include <QSslCertificate>
 #include <QString>
+#include <QVector>
 
 namespace governikus
 {
@@ -35,7 +36,7 @@ class RemoteServer
 		virtual void setPairing(bool pEnable = true) = 0;
 		virtual bool isConnected() const = 0;
 		virtual QSslCertificate getCurrentCertificate() const = 0;
-		virtual const QSharedPointer<ServerMessageHandler>& getMessageHandler() const = 0;
+		virtual const QVector<QSharedPointer<ServerMessageHandler> >& getMessageHandlers() const = 0;
 
 	Q_SIGNALS:
 		void fireMessageHandlerAdded(QSharedPointer<ServerMessageHandler> pHandler);
@@ -69,7 +70,7 @@ class RemoteServerImpl
 		virtual void setPairing(bool pEnable = true) override;
 		virtual bool isConnected() const override;
 		virtual QSslCertificate getCurrentCertificate() const override;
-		virtual const QSharedPointer<ServerMessageHandler>& getMessageHandler() const override;
+		virtual const QVector<QSharedPointer<ServerMessageHandler> >& getMessageHandlers() const override;
 };
 
 } /* namespace governikus */
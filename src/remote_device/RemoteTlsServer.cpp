@@ -23,7 +23,10 @@ using namespace governikus;
 
 RemoteTlsServer::RemoteTlsServer()
 	: QTcpServer()
+	, mSocket()
+	, mConnectedSockets()
 	, mPsk()
+	, mCanAcceptConnection()
 {
 #ifndef QT_NO_NETWORKPROXY
 	//listening with proxy leads to socket error QNativeSocketEnginePrivate::InvalidProxyTypeString
@@ -60,9 +63,22 @@ bool RemoteTlsServer::listen()
 }
 
 
+bool RemoteTlsServer::canAcceptConnection() const
+{
+	return !mCanAcceptConnection || mCanAcceptConnection();
+}
+
+
 void RemoteTlsServer::incomingConnection(qintptr pSocketDescriptor)
 {
-	if (mSocket.isNull())
+	if (!canAcceptConnection())
+	{
+		QTcpSocket socket;
+		socket.setSocketDescriptor(pSocketDescriptor);
+		socket.abort();
+		qCDebug(remote_device) << "Maximum number of connections reached... refuse client";
+	}
+	else if (mSocket.isNull())
 	{
 		mSocket = new QSslSocket();
 
@@ -104,7 +120,7 @@ void RemoteTlsServer::incomingConnection(qintptr pSocketDescriptor)
 		QTcpSocket socket;
 		socket.setSocketDescriptor(pSocketDescriptor);
 		socket.abort();
-		qCDebug(remote_device) << "Socket already connected...";
+		qCDebug(remote_device) << "Handshake already in progress...";
 	}
 }
 
@@ -153,6 +169,15 @@ void RemoteTlsServer::onEncrypted()
 		return;
 	}
 
+	// Another client may have been accepted while the handshake was in progress.
+	if (!canAcceptConnection())
+	{
+		qCDebug(remote_device) << "Maximum number of connections reached... abort connection!";
+		mSocket->abort();
+		mSocket->deleteLater();
+		return;
+	}
+
 	qCDebug(remote_device) << "Client connected";
 
 	auto& settings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
@@ -172,7 +197,14 @@ void RemoteTlsServer::onEncrypted()
 	}
 
 	mSocket->disconnect(this);
-	Q_EMIT newConnection(mSocket.data());
+
+	// The socket is owned by the web socket server from now on. Further clients
+	// may be accepted while it is connected as long as canAcceptConnection allows it.
+	QSslSocket* socket = mSocket.data();
+	mSocket.clear();
+	mConnectedSockets.removeAll(QPointer<QSslSocket>());
+	mConnectedSockets += socket;
+	Q_EMIT newConnection(socket);
 }
 
 
@@ -180,10 +212,7 @@ void RemoteTlsServer::setPairing(bool pEnable)
 {
 	if (pEnable)
 	{
-		std::uniform_int_distribution<int> uni(0, 9999);
-		QByteArray pin = QByteArray::number(uni(Randomizer::getInstance().getGenerator()));
-		pin.prepend(4 - pin.size(), '0');
-		mPsk = pin;
+		mPsk = Randomizer::getInstance().createPin(4);
 		Q_EMIT firePskChanged(mPsk);
 	}
 	else if (!mPsk.isEmpty())
@@ -194,7 +223,27 @@ void RemoteTlsServer::setPairing(bool pEnable)
 }
 
 
+void RemoteTlsServer::setAcceptConnection(const std::function<bool()>& pCanAcceptConnection)
+{
+	mCanAcceptConnection = pCanAcceptConnection;
+}
+
+
 QSslCertificate RemoteTlsServer::getCurrentCertificate() const
 {
-	return mSocket ? mSocket->sslConfiguration().peerCertificate() : QSslCertificate();
+	QSslCertificate certificate;
+	for (const auto& socket : mConnectedSockets)
+	{
+		if (socket && socket->state() == QAbstractSocket::ConnectedState)
+		{
+			if (!certificate.isNull())
+			{
+				// There is no current client if several clients are connected.
+				return QSslCertificate();
+			}
+			certificate = socket->sslConfiguration().peerCertificate();
+		}
+	}
+
+	return certificate;
 }
@@ -12,6 +12,9 @@
 #include <QSslPreSharedKeyAuthenticator>
 #include <QSslSocket>
 #include <QTcpServer>
+#include <QVector>
+
+#include <functional>
 
 namespace governikus
 {
@@ -23,7 +26,11 @@ class RemoteTlsServer
 
 	private:
 		QPointer<QSslSocket> mSocket;
+		QVector<QPointer<QSslSocket> > mConnectedSockets;
 		QByteArray mPsk;
+		std::function<bool()> mCanAcceptConnection;
+
+		bool canAcceptConnection() const;
 		virtual void incomingConnection(qintptr pSocketDescriptor) override;
 
 	private Q_SLOTS:
@@ -36,6 +43,16 @@ class RemoteTlsServer
 		RemoteTlsServer();
 		bool listen();
 		void setPairing(bool pEnable = true);
+
+		/*!
+		 * Clients are refused before the handshake if the given function returns false.
+		 */
+		void setAcceptConnection(const std::function<bool()>& pCanAcceptConnection);
+
+		/*!
+		 * Returns the certificate of the connected client or a null
+		 * certificate if none or several clients are connected.
+		 */
 		QSslCertificate getCurrentCertificate() const;
 
 	Q_SIGNALS:
@@ -44,27 +44,83 @@ void RemoteWebSocketServerImpl::onWebsocketConnection()
 	}
 
 	QSharedPointer<QWebSocket> connection(mServer.nextPendingConnection());
-	if (mServerMessageHandler)
+	for (auto iter = mPendingSockets.begin(); iter != mPendingSockets.end(); ++iter)
 	{
+		if (*iter && (*iter)->peerAddress() == connection->peerAddress() && (*iter)->peerPort() == connection->peerPort())
+		{
+			mPendingSockets.erase(iter);
+			break;
+		}
+	}
+
+	if (!canAcceptConnection())
+	{
+		qCDebug(remote_device) << "Maximum number of connections reached:" << mServerMessageHandlers.size();
 		connection->close(QWebSocketProtocol::CloseCodePolicyViolated);
 		return;
 	}
 
 	QSharedPointer<DataChannel> channel(new WebSocketChannel(connection), &QObject::deleteLater);
-	mServerMessageHandler.reset(Env::create<ServerMessageHandler*>(channel));
-	connect(mServerMessageHandler.data(), &ServerMessageHandler::fireClosed, this, &RemoteWebSocketServerImpl::onConnectionClosed);
+	QSharedPointer<ServerMessageHandler> serverMessageHandler(Env::create<ServerMessageHandler*>(channel));
+	connect(serverMessageHandler.data(), &ServerMessageHandler::fireClosed, this, &RemoteWebSocketServerImpl::onConnectionClosed);
+	mServerMessageHandlers += serverMessageHandler;
+	qCDebug(remote_device) << "Client connected | active connections:" << mServerMessageHandlers.size();
+
 	Q_EMIT fireConnectedChanged(isConnected());
-	Q_EMIT fireMessageHandlerAdded(mServerMessageHandler);
+	Q_EMIT fireMessageHandlerAdded(serverMessageHandler);
+}
+
+
+void RemoteWebSocketServerImpl::onTlsConnection(QTcpSocket* pSocket)
+{
+	// The client counts as connected from the tls handshake until the
+	// web socket handshake completes or fails.
+	mPendingSockets.removeAll(QPointer<QTcpSocket>());
+	mPendingSockets += pSocket;
+	mServer.handleConnection(pSocket);
 }
 
 
 void RemoteWebSocketServerImpl::onConnectionClosed()
 {
-	mServerMessageHandler.reset();
+	const auto* serverMessageHandler = qobject_cast<ServerMessageHandler*>(sender());
+	for (auto iter = mServerMessageHandlers.begin(); iter != mServerMessageHandlers.end(); ++iter)
+	{
+		if (iter->data() == serverMessageHandler)
+		{
+			mServerMessageHandlers.erase(iter);
+			break;
+		}
+	}
+
+	qCDebug(remote_device) << "Client disconnected | active connections:" << mServerMessageHandlers.size();
 	Q_EMIT fireConnectedChanged(isConnected());
 }
 
 
+int RemoteWebSocketServerImpl::getPendingConnections() const
+{
+	int count = 0;
+	for (const auto& socket : mPendingSockets)
+	{
+		if (socket && socket->state() == QAbstractSocket::ConnectedState)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+
+int RemoteWebSocketServerImpl::getMaxConnections() const
+{
+	// The pin pad mode is driven by the user interface and
+	// can handle exactly one client at the same time.
+	const auto& settings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
+	return settings.getPinPadMode() ? 1 : settings.getMaxConnections();
+}
+
+
 void RemoteWebSocketServerImpl::onServerError(QWebSocketProtocol::CloseCode pCloseCode)
 {
 	static int timesLogged = 0;
@@ -79,9 +135,13 @@ void RemoteWebSocketServerImpl::onServerError(QWebSocketProtocol::CloseCode pClo
 RemoteWebSocketServerImpl::RemoteWebSocketServerImpl()
 	: mTlsServer(new RemoteTlsServer)
 	, mServer(QString(), QWebSocketServer::NonSecureMode)
-	, mServerMessageHandler()
+	, mServerMessageHandlers()
+	, mPendingSockets()
 {
-	connect(mTlsServer.data(), &RemoteTlsServer::newConnection, &mServer, &QWebSocketServer::handleConnection);
+	mTlsServer->setAcceptConnection([this] {
+				return canAcceptConnection();
+			});
+	connect(mTlsServer.data(), &RemoteTlsServer::newConnection, this, &RemoteWebSocketServerImpl::onTlsConnection);
 	connect(mTlsServer.data(), &RemoteTlsServer::firePskChanged, this, &RemoteWebSocketServer::firePskChanged);
 	connect(&mServer, &QWebSocketServer::newConnection, this, &RemoteWebSocketServerImpl::onWebsocketConnection);
 }
@@ -89,6 +149,11 @@ RemoteWebSocketServerImpl::RemoteWebSocketServerImpl()
 
 RemoteWebSocketServerImpl::~RemoteWebSocketServerImpl()
 {
+	// The tls server is deleted later and must not call back into this object.
+	mTlsServer->setAcceptConnection([] {
+				return false;
+			});
+
 	if (mTlsServer->isListening())
 	{
 		qCDebug(remote_device) << "Shutdown tls server";
@@ -105,7 +170,13 @@ bool RemoteWebSocketServerImpl::isListening() const
 
 bool RemoteWebSocketServerImpl::isConnected() const
 {
-	return !mServerMessageHandler.isNull();
+	return !mServerMessageHandlers.isEmpty();
+}
+
+
+bool RemoteWebSocketServerImpl::canAcceptConnection() const
+{
+	return isListening() && mServerMessageHandlers.size() + getPendingConnections() < getMaxConnections();
 }
 
 
@@ -119,7 +190,8 @@ bool RemoteWebSocketServerImpl::listen(const QString& pServerName)
 void RemoteWebSocketServerImpl::close()
 {
 	mTlsServer->close();
-	mServerMessageHandler.reset();
+	mServerMessageHandlers.clear();
+	mPendingSockets.clear();
 }
 
 
@@ -147,7 +219,7 @@ QSslCertificate RemoteWebSocketServerImpl::getCurrentCertificate() const
 }
 
 
-const QSharedPointer<ServerMessageHandler>& RemoteWebSocketServerImpl::getMessageHandler() const
+const QVector<QSharedPointer<ServerMessageHandler> >& RemoteWebSocketServerImpl::getMessageHandlers() const
 {
-	return mServerMessageHandler;
+	return mServerMessageHandlers;
 }
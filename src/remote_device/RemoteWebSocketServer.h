@@ -12,8 +12,11 @@
 
 #include <QByteArray>
 #include <QMetaObject>
+#include <QPointer>
 #include <QSharedPointer>
 #include <QString>
+#include <QTcpSocket>
+#include <QVector>
 #include <QWebSocket>
 #include <QWebSocketServer>
 
@@ -35,13 +38,14 @@ class RemoteWebSocketServer
 
 		virtual bool isListening() const = 0;
 		virtual bool isConnected() const = 0;
+		virtual bool canAcceptConnection() const = 0;
 		virtual bool listen(const QString& pServerName) = 0;
 		virtual void close() = 0;
 		virtual QString getServerName() const = 0;
 		virtual quint16 getServerPort() const = 0;
 		virtual void setPairing(bool pEnable = true) = 0;
 		virtual QSslCertificate getCurrentCertificate() const = 0;
-		virtual const QSharedPointer<ServerMessageHandler>& getMessageHandler() const = 0;
+		virtual const QVector<QSharedPointer<ServerMessageHandler> >& getMessageHandlers() const = 0;
 
 	Q_SIGNALS:
 		void fireConnectedChanged(bool pConnected);
@@ -57,9 +61,14 @@ class RemoteWebSocketServerImpl
 
 	QScopedPointer<RemoteTlsServer, QScopedPointerDeleteLater> mTlsServer;
 	QWebSocketServer mServer;
-	QSharedPointer<ServerMessageHandler> mServerMessageHandler;
+	QVector<QSharedPointer<ServerMessageHandler> > mServerMessageHandlers;
+	QVector<QPointer<QTcpSocket> > mPendingSockets;
+
+	int getPendingConnections() const;
+	int getMaxConnections() const;
 
 	private Q_SLOTS:
+		void onTlsConnection(QTcpSocket* pSocket);
 		void onWebsocketConnection();
 		void onConnectionClosed();
 		void onServerError(QWebSocketProtocol::CloseCode pCloseCode);
@@ -70,13 +79,14 @@ class RemoteWebSocketServerImpl
 
 		virtual bool isListening() const override;
 		virtual bool isConnected() const override;
+		virtual bool canAcceptConnection() const override;
 		virtual bool listen(const QString& pServerName) override;
 		virtual void close() override;
 		virtual QString getServerName() const override;
 		virtual quint16 getServerPort() const override;
 		virtual void setPairing(bool pEnable = true) override;
 		virtual QSslCertificate getCurrentCertificate() const override;
-		virtual const QSharedPointer<ServerMessageHandler>& getMessageHandler() const override;
+		virtual const QVector<QSharedPointer<ServerMessageHandler> >& getMessageHandlers() const override;
 };
 
 } /* namespace governikus */
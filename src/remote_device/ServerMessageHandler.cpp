@@ -24,6 +24,7 @@
 #include "ReaderManager.h"
 #include "RemoteDispatcher.h"
 
+#include <QHash>
 #include <QLoggingCategory>
 
 
@@ -44,13 +45,23 @@ ServerMessageHandler::~ServerMessageHandler()
 }
 
 
+const int ServerMessageHandlerImpl::STATUS_INTERVAL = 50;
+
+
 ServerMessageHandlerImpl::ServerMessageHandlerImpl(const QSharedPointer<DataChannel>& pDataChannel)
 	: ServerMessageHandler()
 	, MessageReceiver()
 	, mReaderManager(Env::getSingleton<ReaderManager>())
 	, mRemoteDispatcher(Env::create<RemoteDispatcher*>(pDataChannel), &QObject::deleteLater)
 	, mCardConnections()
+	, mStatusTimer()
+	, mPendingStatus()
+	, mSentStatus()
 {
+	mStatusTimer.setSingleShot(true);
+	mStatusTimer.setInterval(STATUS_INTERVAL);
+	connect(&mStatusTimer, &QTimer::timeout, this, &ServerMessageHandlerImpl::onStatusTimeout);
+
 	connect(mRemoteDispatcher.data(), &RemoteDispatcher::fireReceived, this, &ServerMessageHandlerImpl::onReceived);
 	connect(mRemoteDispatcher.data(), &RemoteDispatcher::fireClosed, this, &ServerMessageHandlerImpl::onClosed);
 
@@ -58,18 +69,52 @@ ServerMessageHandlerImpl::ServerMessageHandlerImpl(const QSharedPointer<DataChan
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireReaderRemoved, this, &ServerMessageHandlerImpl::onReaderRemoved);
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireReaderPropertiesUpdated, this, &ServerMessageHandlerImpl::onReaderChanged);
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireCardInserted, this, &ServerMessageHandlerImpl::onReaderChanged);
-	connect(&ReaderManager::getInstance(), &ReaderManager::fireCardRemoved, this, &ServerMessageHandlerImpl::onReaderChanged);
+	connect(&ReaderManager::getInstance(), &ReaderManager::fireCardRemoved, this, &ServerMessageHandlerImpl::onCardRemoved);
 	connect(&ReaderManager::getInstance(), &ReaderManager::fireCardRetryCounterChanged, this, &ServerMessageHandlerImpl::onReaderChanged);
 }
 
 
+ServerMessageHandlerImpl::~ServerMessageHandlerImpl()
+{
+	releaseReaders();
+}
+
+
+void ServerMessageHandlerImpl::setStatusInterval(int pMsec)
+{
+	mStatusTimer.setInterval(pMsec);
+	if (pMsec == 0)
+	{
+		onStatusTimeout();
+	}
+}
+
+
+void ServerMessageHandlerImpl::releaseReaders()
+{
+	if (mReaderManager)
+	{
+		mReaderManager->releaseReaders(this);
+	}
+}
+
+
+void ServerMessageHandlerImpl::removeCardConnection(const QString& pSlotHandle)
+{
+	const auto& cardConnection = mCardConnections.take(pSlotHandle);
+	if (cardConnection)
+	{
+		mReaderManager->releaseReader(cardConnection->getReaderInfo().getName(), this);
+	}
+}
+
+
 void ServerMessageHandlerImpl::process(const QSharedPointer<const GetIfdStatus>& pMessage)
 {
 	if (!pMessage->getSlotName().isEmpty())
 	{
 		const auto& readerInfo = mReaderManager->getReaderInfo(pMessage->getSlotName());
-		const QSharedPointer<IfdStatus> ifdStatusMsg(new IfdStatus(readerInfo));
-		mRemoteDispatcher->send(ifdStatusMsg);
+		sendStatus(QSharedPointer<IfdStatus>(new IfdStatus(readerInfo)), true);
 
 		return;
 	}
@@ -82,8 +127,7 @@ void ServerMessageHandlerImpl::process(const QSharedPointer<const GetIfdStatus>&
 			continue;
 		}
 
-		const QSharedPointer<IfdStatus> ifdStatusMsg(new IfdStatus(readerInfo));
-		mRemoteDispatcher->send(ifdStatusMsg);
+		sendStatus(QSharedPointer<IfdStatus>(new IfdStatus(readerInfo)), true);
 	}
 }
 
@@ -107,7 +151,7 @@ void ServerMessageHandlerImpl::process(const QSharedPointer<const IfdConnect>& p
 		return;
 	}
 
-	if (mCardConnections.contains(pMessage->getSlotName()))
+	if (mCardConnections.contains(pMessage->getSlotName()) || mReaderManager->isReaderReserved(pMessage->getSlotName(), this))
 	{
 		qCWarning(remote_device) << "Card is already connected" << pMessage->getSlotName();
 		const QSharedPointer<IfdConnectResponse> response(new IfdConnectResponse(pMessage->getSlotName(), QStringLiteral("/al/common#unknownError")));
@@ -115,6 +159,14 @@ void ServerMessageHandlerImpl::process(const QSharedPointer<const IfdConnect>& p
 		return;
 	}
 
+	if (!mReaderManager->reserveReader(pMessage->getSlotName(), this))
+	{
+		qCWarning(remote_device) << "Card is connected by another client" << pMessage->getSlotName();
+		const QSharedPointer<IfdConnectResponse> response(new IfdConnectResponse(pMessage->getSlotName(), QStringLiteral("/al/common#unknownError")));
+		mRemoteDispatcher->send(response);
+		return;
+	}
+
 	qCDebug(remote_device) << "Connect card" << pMessage->getSlotName();
 	mReaderManager->callCreateCardConnectionCommand(pMessage->getSlotName(), this, &ServerMessageHandlerImpl::onCreateCardConnectionCommandDone);
 }
@@ -126,6 +178,7 @@ void ServerMessageHandlerImpl::onCreateCardConnectionCommandDone(QSharedPointer<
 	if (pCommand->getCardConnection() == nullptr)
 	{
 		qCWarning(remote_device) << "Cannot connect card" << pCommand->getReaderName();
+		mReaderManager->releaseReader(pCommand->getReaderName(), this);
 		const QSharedPointer<IfdConnectResponse> response(new IfdConnectResponse(pCommand->getReaderName(), QStringLiteral("/al/common#unknownError")));
 		mRemoteDispatcher->send(response);
 		return;
@@ -170,7 +223,7 @@ void ServerMessageHandlerImpl::process(const QSharedPointer<const IfdDisconnect>
 		return;
 	}
 
-	mCardConnections.remove(slotHandle);
+	removeCardConnection(slotHandle);
 	qCInfo(remote_device) << "Card successfully disconnected" << slotHandle;
 	const QSharedPointer<IfdDisconnectResponse> response(new IfdDisconnectResponse(slotHandle));
 	mRemoteDispatcher->send(response);
@@ -363,7 +416,10 @@ void ServerMessageHandlerImpl::unexpectedMessage(const QSharedPointer<const Remo
 
 void ServerMessageHandlerImpl::onClosed()
 {
+	mStatusTimer.stop();
+	mPendingStatus.clear();
 	mCardConnections.clear();
+	releaseReaders();
 
 	Q_EMIT fireClosed();
 }
@@ -390,22 +446,104 @@ void ServerMessageHandlerImpl::onReceived(const QSharedPointer<const RemoteMessa
 }
 
 
+void ServerMessageHandlerImpl::scheduleStatus(const QString& pReaderName)
+{
+	mPendingStatus.insert(pReaderName);
+
+	if (mStatusTimer.interval() == 0)
+	{
+		onStatusTimeout();
+	}
+	else if (!mStatusTimer.isActive())
+	{
+		mStatusTimer.start();
+	}
+}
+
+
+void ServerMessageHandlerImpl::sendStatus(const QSharedPointer<const IfdStatus>& pStatus, bool pForce)
+{
+	const auto& lastStatus = mSentStatus.value(pStatus->getSlotName());
+	if (!pForce && lastStatus && *lastStatus == *pStatus)
+	{
+		qCDebug(remote_device) << "Skip unchanged IFDStatus for" << pStatus->getSlotName();
+		return;
+	}
+
+	mSentStatus.insert(pStatus->getSlotName(), pStatus);
+	mRemoteDispatcher->send(pStatus);
+}
+
+
+void ServerMessageHandlerImpl::onStatusTimeout()
+{
+	mStatusTimer.stop();
+
+	if (mPendingStatus.isEmpty())
+	{
+		return;
+	}
+
+	const auto pendingStatus = mPendingStatus;
+	mPendingStatus.clear();
+
+	if (pendingStatus.size() == 1)
+	{
+		const auto& readerName = *pendingStatus.constBegin();
+		sendStatus(QSharedPointer<IfdStatus>(new IfdStatus(mReaderManager->getReaderInfo(readerName))));
+		return;
+	}
+
+	// Query all readers at once instead of a blocking call per reader
+	QHash<QString, ReaderInfo> readerInfos;
+	const auto& infos = mReaderManager->getReaderInfos();
+	for (const auto& info : infos)
+	{
+		readerInfos.insert(info.getName(), info);
+	}
+
+	for (const auto& readerName : pendingStatus)
+	{
+		sendStatus(QSharedPointer<IfdStatus>(new IfdStatus(readerInfos.value(readerName, ReaderInfo(readerName)))));
+	}
+}
+
+
 void ServerMessageHandlerImpl::onReaderChanged(const QString& pReaderName)
 {
-	ReaderInfo info = mReaderManager->getReaderInfo(pReaderName);
-	if (!info.hasEidCard() && mCardConnections.contains(pReaderName))
+	scheduleStatus(pReaderName);
+}
+
+
+void ServerMessageHandlerImpl::onCardRemoved(const QString& pReaderName)
+{
+	if (mCardConnections.contains(pReaderName))
 	{
 		mCardConnections.remove(pReaderName);
 		qCInfo(remote_device) << "Removed CardConnection for" << pReaderName;
 	}
 
-	mRemoteDispatcher->send(QSharedPointer<IfdStatus>(new IfdStatus(info)));
+	// The removal of a card is not coalesced. Otherwise the client would miss
+	// it if the card is inserted again before the status is sent.
+	const auto& lastStatus = mSentStatus.value(pReaderName);
+	if (lastStatus && lastStatus->getCardAvailable())
+	{
+		mPendingStatus.insert(pReaderName);
+		onStatusTimeout();
+		return;
+	}
+
+	scheduleStatus(pReaderName);
 }
 
 
 void ServerMessageHandlerImpl::onReaderRemoved(const QString& pReaderName)
 {
-	mRemoteDispatcher->send(QSharedPointer<IfdStatus>(new IfdStatus(pReaderName)));
+	mReaderManager->releaseReader(pReaderName, this);
+
+	// Like the removal of a card, see onReaderChanged.
+	mPendingStatus.remove(pReaderName);
+	sendStatus(QSharedPointer<IfdStatus>(new IfdStatus(pReaderName)));
 }
 
 
@@ -8,13 +8,16 @@
 
 #include "CardConnection.h"
 #include "DataChannel.h"
+#include "messages/IfdStatus.h"
 #include "messages/MessageReceiver.h"
 #include "ReaderManager.h"
 #include "RemoteDispatcher.h"
 
 #include <QMap>
 #include <QScopedPointer>
+#include <QSet>
 #include <QSharedPointer>
+#include <QTimer>
 
 
 namespace governikus
@@ -53,8 +56,15 @@ class ServerMessageHandlerImpl
 		QPointer<ReaderManager> mReaderManager;
 		const QSharedPointer<RemoteDispatcher> mRemoteDispatcher;
 		QMap<QString, QSharedPointer<CardConnection> > mCardConnections;
+		QTimer mStatusTimer;
+		QSet<QString> mPendingStatus;
+		QMap<QString, QSharedPointer<const IfdStatus> > mSentStatus;
 
 		QString convertSlotHandleBackwardsCompatibility(const QString& pSlotHandle);
+		void releaseReaders();
+		void removeCardConnection(const QString& pSlotHandle);
+		void scheduleStatus(const QString& pReaderName);
+		void sendStatus(const QSharedPointer<const IfdStatus>& pStatus, bool pForce = false);
 
 		virtual void process(const QSharedPointer<const GetIfdStatus>& pMessage) override;
 		virtual void process(const QSharedPointer<const IfdConnect>& pMessage) override;
@@ -72,10 +82,23 @@ class ServerMessageHandlerImpl
 		void onClosed();
 		void onReceived(const QSharedPointer<const RemoteMessage>& pMessage);
 		void onReaderChanged(const QString& pReaderName);
+		void onCardRemoved(const QString& pReaderName);
 		void onReaderRemoved(const QString& pReaderName);
+		void onStatusTimeout();
 
 	public:
+		static const int STATUS_INTERVAL;
+
 		ServerMessageHandlerImpl(const QSharedPointer<DataChannel>& pDataChannel);
+		virtual ~ServerMessageHandlerImpl() override;
+
+		/*!
+		 * Reader events that occur within pMsec are merged per slot into a single
+		 * IFDStatus. A value of 0 sends every event immediately. The removal of a
+		 * card or reader is always sent immediately. In all cases an IFDStatus
+		 * equal to the last one of the slot is not sent again.
+		 */
+		void setStatusInterval(int pMsec);
 
 		virtual void sendEstablishPaceChannelResponse(const QString& pSlotHandle, const EstablishPACEChannelOutput& pChannelOutput) override;
 		virtual void sendModifyPinResponse(const QString& pSlotHandle, const ResponseApdu& pResponseApdu) override;
@@ -78,6 +78,15 @@ QJsonValue PaceCapabilities::toJson() const
 }
 
 
+bool PaceCapabilities::operator==(const PaceCapabilities& pOther) const
+{
+	return mPace == pOther.mPace
+		   && mEId == pOther.mEId
+		   && mESign == pOther.mESign
+		   && mDestroy == pOther.mDestroy;
+}
+
+
 IfdStatus::IfdStatus(const ReaderInfo& pReaderInfo)
 	: RemoteMessage(RemoteCardMessageType::IFDStatus)
 	, mSlotName(pReaderInfo.getName())
@@ -171,3 +180,13 @@ QJsonDocument IfdStatus::toJson(const QString& pContextHandle) const
 
 	return QJsonDocument(result);
 }
+
+
+bool IfdStatus::operator==(const IfdStatus& pOther) const
+{
+	return mSlotName == pOther.mSlotName
+		   && mPaceCapabilities == pOther.mPaceCapabilities
+		   && mMaxApduLength == pOther.mMaxApduLength
+		   && mConnectedReader == pOther.mConnectedReader
+		   && mCardAvailable == pOther.mCardAvailable;
+}
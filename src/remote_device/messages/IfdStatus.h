@@ -33,6 +33,8 @@ class PaceCapabilities
 		bool getDestroy() const;
 
 		QJsonValue toJson() const;
+
+		bool operator==(const PaceCapabilities& pOther) const;
 };
 
 
@@ -57,6 +59,11 @@ class IfdStatus
 		bool getConnectedReader() const;
 		bool getCardAvailable() const;
 		virtual QJsonDocument toJson(const QString& pContextHandle) const override;
+
+		/*!
+		 * Compares the state of the slot, the context handle is not taken into account.
+		 */
+		bool operator==(const IfdStatus& pOther) const;
 };
 
 
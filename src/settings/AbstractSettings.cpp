@@ -6,6 +6,10 @@
 #include "AbstractSettings.h"
 
 #include <QCoreApplication>
+#include <QMutex>
+#include <QTimer>
+#include <QVector>
+#include <QWeakPointer>
 #ifdef Q_OS_MACOS
 	#include <QFileInfo>
 #endif
@@ -15,10 +19,104 @@
 
 using namespace governikus;
 
+const int AbstractSettings::SYNC_DELAY = 1000;
+
 #ifndef QT_NO_DEBUG
 QSharedPointer<QTemporaryDir> AbstractSettings::mTestDir;
+int AbstractSettings::mSyncCount = 0;
 #endif
 
+namespace
+{
+class PendingSync
+	: public QObject
+{
+	private:
+		QMutex mMutex;
+		QTimer mTimer;
+		QVector<QWeakPointer<QSettings> > mStores;
+
+	public:
+		PendingSync()
+			: QObject()
+			, mMutex()
+			, mTimer(this)
+			, mStores()
+		{
+			mTimer.setSingleShot(true);
+			mTimer.setInterval(AbstractSettings::SYNC_DELAY);
+			connect(&mTimer, &QTimer::timeout, this, &PendingSync::flush);
+
+			if (const auto* app = QCoreApplication::instance())
+			{
+				moveToThread(app->thread());
+				connect(app, &QCoreApplication::aboutToQuit, this, &PendingSync::flush);
+			}
+		}
+
+
+		void add(const QSharedPointer<QSettings>& pStore)
+		{
+			bool schedule = false;
+			{
+				const QMutexLocker locker(&mMutex);
+				for (const auto& store : qAsConst(mStores))
+				{
+					if (store == pStore)
+					{
+						return;
+					}
+				}
+
+				schedule = mStores.isEmpty();
+				mStores += pStore.toWeakRef();
+			}
+
+			if (schedule)
+			{
+				// The timer is not restarted by further modifications to limit the time
+				// a modification is kept in memory only.
+				QMetaObject::invokeMethod(&mTimer, "start", Qt::AutoConnection);
+			}
+		}
+
+
+		void flush()
+		{
+			QVector<QWeakPointer<QSettings> > stores;
+			{
+				const QMutexLocker locker(&mMutex);
+				stores.swap(mStores);
+			}
+
+			if (stores.isEmpty())
+			{
+				return;
+			}
+
+			// QSettings caches the content per file, so the first sync of a file writes
+			// the modifications of all stores and the following ones are no-ops.
+			// The file is replaced atomically by QSaveFile.
+			for (const auto& weakStore : qAsConst(stores))
+			{
+				if (const auto store = weakStore.toStrongRef())
+				{
+					store->sync();
+				}
+			}
+
+#ifndef QT_NO_DEBUG
+			++AbstractSettings::mSyncCount;
+#endif
+		}
+
+
+};
+
+Q_GLOBAL_STATIC(PendingSync, pendingSync)
+} // namespace
+
+
 void AbstractSettings::createLegacyFileMapping()
 {
 #ifdef Q_OS_MACOS
@@ -80,6 +178,18 @@ QSharedPointer<QSettings> AbstractSettings::getStore()
 }
 
 
+void AbstractSettings::syncLater(const QSharedPointer<QSettings>& pStore)
+{
+	pendingSync->add(pStore);
+}
+
+
+void AbstractSettings::syncPending()
+{
+	pendingSync->flush();
+}
+
+
 bool AbstractSettings::appIsBackgroundService() const
 {
 #ifdef Q_OS_ANDROID
@@ -33,13 +33,31 @@ class AbstractSettings
 		AbstractSettings();
 		virtual ~AbstractSettings();
 
+		/*!
+		 * Marks the store as modified. All stores marked within SYNC_DELAY ms
+		 * are written together, so saving many settings costs a single write.
+		 * A crash within SYNC_DELAY loses the changes, so this is meant for
+		 * stores that the user modifies in quick succession only. All others
+		 * must be synced immediately.
+		 */
+		static void syncLater(const QSharedPointer<QSettings>& pStore);
+
 	public:
+		static const int SYNC_DELAY;
+
 #ifndef QT_NO_DEBUG
 		static QSharedPointer<QTemporaryDir> mTestDir;
+		static int mSyncCount;
 #endif
 
 		static QSharedPointer<QSettings> getStore();
 
+		/*!
+		 * Writes all pending modifications immediately.
+		 * This is done automatically on QCoreApplication::aboutToQuit.
+		 */
+		static void syncPending();
+
 		virtual void save() = 0;
 
 		bool appIsBackgroundService() const;
@@ -69,7 +69,7 @@ GeneralSettings::GeneralSettings()
 		mStoreGeneral->setValue(SETTINGS_NAME_AUTO_CLOSE_WINDOW(), true);
 		setAutoStart(GENERAL_SETTINGS_DEFAULT_AUTOSTART);
 		setTransportPinReminder(true);
-		mStoreGeneral->sync();
+		syncLater(mStoreGeneral);
 	}
 
 #ifdef QT_NO_DEBUG
@@ -90,8 +90,8 @@ void GeneralSettings::save()
 {
 	mStoreGeneral->setValue(SETTINGS_NAME_PERSISTENT_SETTINGS_VERSION(), QCoreApplication::applicationVersion());
 
-	mStoreGeneral->sync();
-	mStoreCommon->sync();
+	syncLater(mStoreGeneral);
+	syncLater(mStoreCommon);
 }
 
 
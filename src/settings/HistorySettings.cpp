@@ -39,6 +39,7 @@ HistorySettings::~HistorySettings()
 
 void HistorySettings::save()
 {
+	// History entries are saved once per workflow and must survive a crash, so they are not delayed.
 	mStore->sync();
 }
 
@@ -8,6 +8,7 @@
 #include "Randomizer.h"
 
 #include <openssl/bio.h>
+#include <openssl/ec.h>
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
 
@@ -41,6 +42,12 @@ struct OpenSslCustomDeleter
 	}
 
 
+	static inline void cleanup(EC_KEY* pData)
+	{
+		EC_KEY_free(pData);
+	}
+
+
 	static inline void cleanup(BIO* pData)
 	{
 		BIO_free(pData);
@@ -63,26 +70,69 @@ KeyPair::KeyPair(const QSslKey& pKey, const QSslCertificate& pCert)
 }
 
 
-KeyPair KeyPair::generate()
+KeyPair KeyPair::generate(Type pType)
+{
+	return fromKey(generateKey(pType));
+}
+
+
+QSslKey KeyPair::generateKey(Type pType)
 {
 	if (!Randomizer::getInstance().isSecureRandom())
 	{
 		qCCritical(settings) << "Cannot get enough entropy";
-		return KeyPair();
+		return QSslKey();
 	}
 
-	auto pkey = createKey();
+	auto pkey = pType == Type::EC ? createEcKey() : createRsaKey();
 	if (pkey)
 	{
-		auto cert = createCertificate(pkey);
-		if (cert)
-		{
-			return KeyPair(QSslKey(Qt::HANDLE(pkey), QSsl::PrivateKey), QSslCertificate(rewriteCertificate(cert.data())));
-		}
-		else
-		{
-			OpenSslCustomDeleter::cleanup(pkey);
-		}
+		return QSslKey(Qt::HANDLE(pkey), QSsl::PrivateKey);
+	}
+
+	return QSslKey();
+}
+
+
+KeyPair KeyPair::fromKey(const QSslKey& pKey)
+{
+	if (pKey.isNull())
+	{
+		return KeyPair();
+	}
+
+	QScopedPointer<EVP_PKEY, OpenSslCustomDeleter> pkey(EVP_PKEY_new());
+	if (pkey.isNull())
+	{
+		qCCritical(settings) << "Cannot create EVP_PKEY structure";
+		return KeyPair();
+	}
+
+	int assigned = 0;
+	switch (pKey.algorithm())
+	{
+		case QSsl::Rsa:
+			assigned = EVP_PKEY_set1_RSA(pkey.data(), static_cast<RSA*>(pKey.handle()));
+			break;
+
+		case QSsl::Ec:
+			assigned = EVP_PKEY_set1_EC_KEY(pkey.data(), static_cast<EC_KEY*>(pKey.handle()));
+			break;
+
+		default:
+			break;
+	}
+
+	if (!assigned)
+	{
+		qCCritical(settings) << "Cannot assign key of unsupported type";
+		return KeyPair();
+	}
+
+	auto cert = createCertificate(pkey.data());
+	if (cert)
+	{
+		return KeyPair(pKey, QSslCertificate(rewriteCertificate(cert.data())));
 	}
 
 	return KeyPair();
@@ -101,7 +151,7 @@ const QSslCertificate& KeyPair::getCertificate() const
 }
 
 
-EVP_PKEY* KeyPair::createKey()
+EVP_PKEY* KeyPair::createRsaKey()
 {
 	QScopedPointer<EVP_PKEY, OpenSslCustomDeleter> pkey(EVP_PKEY_new());
 	QScopedPointer<RSA, OpenSslCustomDeleter> rsa(RSA_new());
@@ -131,6 +181,36 @@ EVP_PKEY* KeyPair::createKey()
 }
 
 
+EVP_PKEY* KeyPair::createEcKey()
+{
+	QScopedPointer<EVP_PKEY, OpenSslCustomDeleter> pkey(EVP_PKEY_new());
+	QScopedPointer<EC_KEY, OpenSslCustomDeleter> ec(EC_KEY_new_by_curve_name(NID_X9_62_prime256v1));
+
+	if (pkey.isNull() || ec.isNull())
+	{
+		qCCritical(settings) << "Cannot create EVP_PKEY/EC_KEY structure";
+		return nullptr;
+	}
+
+	// Use the named curve in the certificate instead of the explicit parameters
+	EC_KEY_set_asn1_flag(ec.data(), OPENSSL_EC_NAMED_CURVE);
+	if (!EC_KEY_generate_key(ec.data()))
+	{
+		qCCritical(settings) << "Cannot generate ec key";
+		return nullptr;
+	}
+
+	if (!EVP_PKEY_assign(pkey.data(), EVP_PKEY_EC, ec.data()))
+	{
+		qCCritical(settings) << "Cannot assign ec key";
+		return nullptr;
+	}
+
+	ec.take(); // ec will be managed by pkey!
+	return pkey.take();
+}
+
+
 QSharedPointer<X509> KeyPair::createCertificate(EVP_PKEY* pPkey)
 {
 	QSharedPointer<X509> x509(X509_new(), &X509_free);
@@ -140,17 +220,14 @@ QSharedPointer<X509> KeyPair::createCertificate(EVP_PKEY* pPkey)
 		return nullptr;
 	}
 
-	auto& randomizer = Randomizer::getInstance().getGenerator();
-	std::uniform_int_distribution<long> uni_long(1);
-	std::uniform_int_distribution<qulonglong> uni_qulonglong(1);
-
-	ASN1_INTEGER_set(X509_get_serialNumber(x509.data()), uni_long(randomizer));
+	auto& randomizer = Randomizer::getInstance();
+	ASN1_INTEGER_set(X509_get_serialNumber(x509.data()), randomizer.createNumber<long>(1));
 	// see: https://tools.ietf.org/html/rfc5280#section-4.1.2.5
 	ASN1_TIME_set_string(X509_get_notBefore(x509.data()), "19700101000000Z");
 	ASN1_TIME_set_string(X509_get_notAfter(x509.data()), "99991231235959Z");
 	X509_set_pubkey(x509.data(), pPkey);
 
-	auto randomSerial = QByteArray::number(uni_qulonglong(randomizer));
+	auto randomSerial = QByteArray::number(randomizer.createNumber<qulonglong>(1));
 	QScopedPointer<X509_NAME, OpenSslCustomDeleter> name(X509_NAME_dup(X509_get_subject_name(x509.data())));
 	X509_NAME_add_entry_by_txt(name.data(), "CN", MBSTRING_ASC,
 			reinterpret_cast<const uchar*>(QCoreApplication::applicationName().toLatin1().constData()), -1, -1, 0);
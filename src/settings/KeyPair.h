@@ -19,6 +19,12 @@ namespace governikus
 
 class KeyPair
 {
+	public:
+		enum class Type
+		{
+			RSA, EC
+		};
+
 	private:
 		const QSslKey mKey;
 		const QSslCertificate mCertificate;
@@ -28,10 +34,22 @@ class KeyPair
 
 		static QByteArray rewriteCertificate(X509* pX509);
 		static QSharedPointer<X509> createCertificate(EVP_PKEY* pPkey);
-		static EVP_PKEY* createKey();
+		static EVP_PKEY* createRsaKey();
+		static EVP_PKEY* createEcKey();
 
 	public:
-		static KeyPair generate();
+		static KeyPair generate(Type pType = Type::RSA);
+
+		/*!
+		 * Generates the private key only. This is the expensive part
+		 * of generate() and may be called from any thread.
+		 */
+		static QSslKey generateKey(Type pType = Type::RSA);
+
+		/*!
+		 * Creates a self-signed certificate for the given private key.
+		 */
+		static KeyPair fromKey(const QSslKey& pKey);
 
 		const QSslKey& getKey() const;
 		const QSslCertificate& getCertificate() const;
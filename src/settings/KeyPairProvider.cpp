@@ -0,0 +1,88 @@
+/*
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "KeyPairProvider.h"
+
+#include "SingletonHelper.h"
+
+#include <QLoggingCategory>
+#include <QtConcurrent/QtConcurrentRun>
+
+using namespace governikus;
+
+Q_DECLARE_LOGGING_CATEGORY(settings)
+
+defineSingleton(KeyPairProvider)
+
+
+KeyPairProvider::KeyPairProvider()
+	: mMutex()
+	, mPool()
+{
+}
+
+
+KeyPairProvider::~KeyPairProvider()
+{
+	for (auto& future : mPool)
+	{
+		future.waitForFinished();
+	}
+}
+
+
+KeyPairProvider& KeyPairProvider::getInstance()
+{
+	return *Instance;
+}
+
+
+void KeyPairProvider::prepare(KeyPair::Type pType)
+{
+	const QMutexLocker locker(&mMutex);
+	if (mPool.contains(pType))
+	{
+		return;
+	}
+
+	qCDebug(settings) << "Prepare key pair in background";
+	mPool.insert(pType, QtConcurrent::run([pType] {
+				return KeyPair::generateKey(pType);
+			}));
+}
+
+
+bool KeyPairProvider::isPrepared(KeyPair::Type pType)
+{
+	const QMutexLocker locker(&mMutex);
+	return mPool.contains(pType) && mPool.value(pType).isFinished();
+}
+
+
+KeyPair KeyPairProvider::take(KeyPair::Type pType)
+{
+	bool prepared = false;
+	QFuture<QSslKey> future;
+	{
+		const QMutexLocker locker(&mMutex);
+		prepared = mPool.contains(pType);
+		future = mPool.take(pType);
+	}
+
+	QSslKey key;
+	if (prepared)
+	{
+		// A running generation is closer to its result than a new one
+		key = future.result();
+	}
+
+	if (key.isNull())
+	{
+		qCDebug(settings) << "No prepared key pair available, generate synchronously";
+		key = KeyPair::generateKey(pType);
+	}
+
+	// The certificate is cheap, so it is created on the calling thread
+	return KeyPair::fromKey(key);
+}
@@ -0,0 +1,49 @@
+/*!
+ * \brief Generates key pairs on a background thread ahead of time.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "KeyPair.h"
+
+#include <QFuture>
+#include <QMap>
+#include <QMutex>
+
+namespace governikus
+{
+
+class KeyPairProvider
+{
+	private:
+		QMutex mMutex;
+		QMap<KeyPair::Type, QFuture<QSslKey> > mPool;
+
+		KeyPairProvider(const KeyPairProvider&) = delete;
+		KeyPairProvider& operator=(const KeyPairProvider&) = delete;
+
+	protected:
+		KeyPairProvider();
+		~KeyPairProvider();
+
+	public:
+		static KeyPairProvider& getInstance();
+
+		/*!
+		 * Starts the generation of a key of the given type unless
+		 * one is already available or in progress.
+		 */
+		void prepare(KeyPair::Type pType = KeyPair::Type::RSA);
+		bool isPrepared(KeyPair::Type pType = KeyPair::Type::RSA);
+
+		/*!
+		 * Returns the prepared key pair. If none was prepared
+		 * the key pair is generated synchronously.
+		 */
+		KeyPair take(KeyPair::Type pType = KeyPair::Type::RSA);
+};
+
+
+} /* namespace governikus */
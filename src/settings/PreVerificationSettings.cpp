@@ -17,8 +17,38 @@ SETTINGS_NAME(SETTINGS_NAME_LINKCERTIFICATE, "linkcertificate")
 PreVerificationSettings::PreVerificationSettings()
 	: AbstractSettings()
 	, mStore(getStore())
+	, mLinkCertificates()
+	, mLinkCertificateIndex()
 {
 	mStore->beginGroup(SETTINGS_GROUP_NAME_PREVERIFICATION());
+	loadLinkCertificates();
+}
+
+
+void PreVerificationSettings::loadLinkCertificates()
+{
+	const int itemCount = mStore->beginReadArray(SETTINGS_NAME_LINKCERTIFICATES());
+
+	mLinkCertificates.reserve(itemCount);
+	mLinkCertificateIndex.reserve(itemCount);
+	for (int i = 0; i < itemCount; ++i)
+	{
+		mStore->setArrayIndex(i);
+		const auto& cert = mStore->value(SETTINGS_NAME_LINKCERTIFICATE()).toByteArray();
+		if (!mLinkCertificateIndex.contains(cert))
+		{
+			mLinkCertificateIndex.insert(cert, mLinkCertificates.size());
+			mLinkCertificates += cert;
+		}
+	}
+
+	mStore->endArray();
+
+	if (mLinkCertificates.size() != itemCount)
+	{
+		// Remove duplicates of older versions, so every index is unique
+		updateLinkCertificates(mLinkCertificates);
+	}
 }
 
 
@@ -38,6 +68,22 @@ void PreVerificationSettings::updateLinkCertificates(const QByteArrayList& pLink
 }
 
 
+void PreVerificationSettings::writeLinkCertificate(int pIndex)
+{
+	mStore->beginWriteArray(SETTINGS_NAME_LINKCERTIFICATES(), mLinkCertificates.size());
+	mStore->setArrayIndex(pIndex);
+	if (pIndex < mLinkCertificates.size())
+	{
+		mStore->setValue(SETTINGS_NAME_LINKCERTIFICATE(), mLinkCertificates.at(pIndex));
+	}
+	else
+	{
+		mStore->remove(SETTINGS_NAME_LINKCERTIFICATE());
+	}
+	mStore->endArray();
+}
+
+
 PreVerificationSettings::~PreVerificationSettings()
 {
 }
@@ -45,6 +91,7 @@ PreVerificationSettings::~PreVerificationSettings()
 
 void PreVerificationSettings::save()
 {
+	// The link certificates decide about trust, so they are not delayed.
 	mStore->sync();
 }
 
@@ -63,37 +110,44 @@ void PreVerificationSettings::setEnabled(bool pEnabled)
 
 QByteArrayList PreVerificationSettings::getLinkCertificates() const
 {
-	const int itemCount = mStore->beginReadArray(SETTINGS_NAME_LINKCERTIFICATES());
+	return mLinkCertificates;
+}
 
-	QByteArrayList linkCertificates;
-	linkCertificates.reserve(itemCount);
-	for (int i = 0; i < itemCount; ++i)
-	{
-		mStore->setArrayIndex(i);
-		linkCertificates += mStore->value(SETTINGS_NAME_LINKCERTIFICATE()).toByteArray();
-	}
 
-	mStore->endArray();
-	return linkCertificates;
+bool PreVerificationSettings::containsLinkCertificate(const QByteArray& pCert) const
+{
+	return mLinkCertificateIndex.contains(pCert);
 }
 
 
 void PreVerificationSettings::removeLinkCertificate(const QByteArray& pCert)
 {
-	auto linkCertificates = getLinkCertificates();
-	if (linkCertificates.removeAll(pCert) > 0)
+	const int index = mLinkCertificateIndex.value(pCert, -1);
+	if (index < 0)
+	{
+		return;
+	}
+
+	// The order is not relevant, so the last entry fills the gap
+	// and only two entries of the array are touched.
+	mLinkCertificateIndex.remove(pCert);
+	const QByteArray last = mLinkCertificates.takeLast();
+	if (index < mLinkCertificates.size())
 	{
-		updateLinkCertificates(linkCertificates);
+		mLinkCertificates[index] = last;
+		mLinkCertificateIndex[last] = index;
+		writeLinkCertificate(index);
 	}
+	writeLinkCertificate(mLinkCertificates.size());
 }
 
 
 void PreVerificationSettings::addLinkCertificate(const QByteArray& pCert)
 {
-	auto linkCertificates = getLinkCertificates();
-	if (!linkCertificates.contains(pCert))
+	if (!containsLinkCertificate(pCert))
 	{
-		linkCertificates += pCert;
-		updateLinkCertificates(linkCertificates);
+		mLinkCertificateIndex.insert(pCert, mLinkCertificates.size());
+		mLinkCertificates += pCert;
+		writeLinkCertificate(mLinkCertificates.size() - 1);
 	}
 }
@@ -9,6 +9,7 @@
 #include "AbstractSettings.h"
 
 #include <QByteArrayList>
+#include <QHash>
 
 class test_PreVerificationSettings;
 class test_StatePreVerification;
@@ -27,9 +28,13 @@ class PreVerificationSettings
 
 	private:
 		QSharedPointer<QSettings> mStore;
+		QByteArrayList mLinkCertificates;
+		QHash<QByteArray, int> mLinkCertificateIndex;
 
 		PreVerificationSettings();
+		void loadLinkCertificates();
 		void updateLinkCertificates(const QByteArrayList& pLinkCertificates);
+		void writeLinkCertificate(int pIndex);
 
 	public:
 		virtual ~PreVerificationSettings() override;
@@ -38,6 +43,7 @@ class PreVerificationSettings
 		bool isEnabled() const;
 		void setEnabled(bool pEnabled);
 		QByteArrayList getLinkCertificates() const;
+		bool containsLinkCertificate(const QByteArray& pCert) const;
 		void removeLinkCertificate(const QByteArray& pCert);
 		void addLinkCertificate(const QByteArray& pCert);
 };
@@ -19,6 +19,7 @@ namespace
 SETTINGS_NAME(SETTINGS_GROUP_NAME_REMOTEREADER, "remotereader")
 SETTINGS_NAME(SETTINGS_NAME_DEVICE_NAME, "serverName")
 SETTINGS_NAME(SETTINGS_NAME_PIN_PAD_MODE, "pinPadMode")
+SETTINGS_NAME(SETTINGS_NAME_MAX_CONNECTIONS, "maxConnections")
 SETTINGS_NAME(SETTINGS_ARRAY_NAME_TRUSTED_CERTIFICATES, "trustedCertificates")
 SETTINGS_NAME(SETTINGS_NAME_TRUSTED_CERTIFICATE_ITEM, "certificate")
 SETTINGS_NAME(SETTINGS_NAME_TRUSTED_REMOTE_INFO, "trustedRemoteInfo")
@@ -53,6 +54,7 @@ RemoteServiceSettings::~RemoteServiceSettings()
 
 void RemoteServiceSettings::save()
 {
+	// A lost pairing cannot be restored without the user, so it is not delayed.
 	mStore->sync();
 }
 
@@ -99,6 +101,18 @@ void RemoteServiceSettings::setPinPadMode(bool pPinPadMode)
 }
 
 
+int RemoteServiceSettings::getMaxConnections() const
+{
+	return qMax(1, mStore->value(SETTINGS_NAME_MAX_CONNECTIONS(), 1).toInt());
+}
+
+
+void RemoteServiceSettings::setMaxConnections(int pMaxConnections)
+{
+	mStore->setValue(SETTINGS_NAME_MAX_CONNECTIONS(), qMax(1, pMaxConnections));
+}
+
+
 QList<QSslCertificate> RemoteServiceSettings::getTrustedCertificates() const
 {
 	const int itemCount = mStore->beginReadArray(SETTINGS_ARRAY_NAME_TRUSTED_CERTIFICATES());
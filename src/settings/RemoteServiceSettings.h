@@ -87,6 +87,9 @@ class RemoteServiceSettings
 		bool getPinPadMode() const;
 		void setPinPadMode(bool pPinPadMode);
 
+		int getMaxConnections() const;
+		void setMaxConnections(int pMaxConnections);
+
 		QList<QSslCertificate> getTrustedCertificates() const;
 		void addTrustedCertificate(const QSslCertificate& pCertificate);
 		void removeTrustedCertificate(const QSslCertificate& pCertificate);
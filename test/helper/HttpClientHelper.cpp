@@ -0,0 +1,120 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "HttpClientHelper.h"
+
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QTimer>
+
+using namespace governikus;
+
+HttpClientHelper::HttpClientHelper(quint16 pPort, int pTimeout)
+	: QObject()
+	, mTimeout(pTimeout)
+	, mSocket()
+	, mBuffer()
+	, mResponses()
+{
+	connect(&mSocket, &QTcpSocket::readyRead, this, &HttpClientHelper::onReadyRead);
+
+	mSocket.connectToHost(QHostAddress::LocalHost, pPort);
+	waitForSocket([this](){
+				return mSocket.state() == QAbstractSocket::ConnectedState;
+			});
+}
+
+
+bool HttpClientHelper::waitForSocket(const std::function<bool()>& pCondition)
+{
+	QEventLoop eventLoop;
+	connect(&mSocket, &QTcpSocket::connected, &eventLoop, &QEventLoop::quit);
+	connect(&mSocket, &QTcpSocket::disconnected, &eventLoop, &QEventLoop::quit);
+	connect(&mSocket, &QTcpSocket::readyRead, &eventLoop, &QEventLoop::quit);
+	connect(&mSocket, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::error), &eventLoop, &QEventLoop::quit);
+
+	QTimer timer;
+	timer.setSingleShot(true);
+	connect(&timer, &QTimer::timeout, &eventLoop, &QEventLoop::quit);
+	timer.start(mTimeout);
+
+	while (!pCondition())
+	{
+		if (!timer.isActive() || mSocket.state() == QAbstractSocket::UnconnectedState)
+		{
+			return pCondition();
+		}
+		eventLoop.exec();
+	}
+	return true;
+}
+
+
+void HttpClientHelper::onReadyRead()
+{
+	mBuffer += mSocket.readAll();
+
+	static const QByteArray CONTENT_LENGTH = QByteArrayLiteral("\r\nContent-Length: ");
+	for (;;)
+	{
+		const int headerEnd = mBuffer.indexOf("\r\n\r\n");
+		if (headerEnd == -1)
+		{
+			return;
+		}
+
+		int bodyLength = 0;
+		const int lengthPos = mBuffer.indexOf(CONTENT_LENGTH);
+		if (lengthPos != -1 && lengthPos < headerEnd)
+		{
+			const int valuePos = lengthPos + CONTENT_LENGTH.size();
+			bodyLength = mBuffer.mid(valuePos, mBuffer.indexOf("\r\n", valuePos) - valuePos).toInt();
+		}
+
+		const int responseLength = headerEnd + 4 + bodyLength;
+		if (mBuffer.size() < responseLength)
+		{
+			return;
+		}
+
+		mResponses += mBuffer.left(responseLength);
+		mBuffer.remove(0, responseLength);
+	}
+}
+
+
+QAbstractSocket::SocketState HttpClientHelper::getState() const
+{
+	return mSocket.state();
+}
+
+
+void HttpClientHelper::sendRequest(const QByteArray& pPath, const QByteArray& pHeader)
+{
+	mSocket.write(QByteArrayLiteral("GET ") + pPath + QByteArrayLiteral(" HTTP/1.1\r\nHost: localhost\r\n") + pHeader + QByteArrayLiteral("\r\n"));
+}
+
+
+bool HttpClientHelper::waitForResponses(int pCount)
+{
+	return waitForSocket([this, pCount](){
+				return mResponses.size() >= pCount;
+			});
+}
+
+
+bool HttpClientHelper::waitForDisconnected()
+{
+	return waitForSocket([this](){
+				return mSocket.state() == QAbstractSocket::UnconnectedState;
+			});
+}
+
+
+QByteArrayList HttpClientHelper::takeResponses()
+{
+	QByteArrayList responses;
+	responses.swap(mResponses);
+	return responses;
+}
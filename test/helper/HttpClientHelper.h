@@ -0,0 +1,49 @@
+/*!
+ * \brief Plain HTTP/1.1 client to test persistent connections of \ref HttpServer.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include <functional>
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QTcpSocket>
+
+namespace governikus
+{
+
+class HttpClientHelper
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		const int mTimeout;
+		QTcpSocket mSocket;
+		QByteArray mBuffer;
+		QByteArrayList mResponses;
+
+		bool waitForSocket(const std::function<bool()>& pCondition);
+
+	private Q_SLOTS:
+		void onReadyRead();
+
+	public:
+		HttpClientHelper(quint16 pPort, int pTimeout = 5000);
+
+		QAbstractSocket::SocketState getState() const;
+
+		/*!
+		 * Writes a GET request without waiting for the response. Several calls
+		 * in a row are pipelined on the connection.
+		 */
+		void sendRequest(const QByteArray& pPath, const QByteArray& pHeader = QByteArray());
+
+		bool waitForResponses(int pCount);
+		bool waitForDisconnected();
+		QByteArrayList takeResponses();
+};
+
+} /* namespace governikus */
@@ -48,15 +48,17 @@ void MockDownloader::download(const QUrl& pUpdateUrl)
 	}
 	else
 	{
-		Q_EMIT fireDownloadSuccess(pUpdateUrl, getTimeStamp(), getTestData(pUpdateUrl));
+		Q_EMIT fireDownloadSuccess(pUpdateUrl, getTimeStamp(), getTestData(pUpdateUrl), QByteArray());
 	}
 }
 
 
 void MockDownloader::downloadIfNew(const QUrl& pUpdateUrl,
-		const QDateTime& pCurrentTimestamp)
+		const QDateTime& pCurrentTimestamp,
+		const QByteArray& pCurrentETag)
 {
 	Q_UNUSED(pCurrentTimestamp);
+	Q_UNUSED(pCurrentETag);
 	download(pUpdateUrl);
 }
 
@@ -36,7 +36,8 @@ class MockDownloader
 		void setError(GlobalStatus::Code pErrorCode);
 		void download(const QUrl& pUpdateUrl) override;
 		void downloadIfNew(const QUrl& pUpdateUrl,
-				const QDateTime& pCurrentTimestamp) override;
+				const QDateTime& pCurrentTimestamp,
+				const QByteArray& pCurrentETag = QByteArray()) override;
 };
 
 }
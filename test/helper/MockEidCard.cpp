@@ -0,0 +1,885 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "MockEidCard.h"
+
+#include "asn1/SignatureChecker.h"
+#include "pace/CipherMac.h"
+#include "pace/ec/EcUtil.h"
+#include "pace/ec/EllipticCurveFactory.h"
+#include "pace/KeyDerivationFunction.h"
+#include "pace/SymmetricCipher.h"
+#include "Randomizer.h"
+#include "TestFileHelper.h"
+#include "TlvHelper.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QThread>
+
+#include <openssl/ecdsa.h>
+
+using namespace governikus;
+
+
+namespace
+{
+const int TAG_DYNAMIC_AUTHENTICATION_DATA = 0x7C;
+const int TAG_CRYPTOGRAPHIC_MECHANISM = 0x80;
+const int TAG_PUBLIC_KEY_REFERENCE = 0x83;
+const int TAG_PRIVATE_KEY_REFERENCE = 0x84;
+const int TAG_AUXILIARY_DATA = 0x67;
+const int TAG_EPHEMERAL_PUBLIC_KEY = 0x91;
+const int TAG_CERTIFICATE = 0x7F21;
+const int TAG_PUBLIC_KEY = 0x7F49;
+const int TAG_OID = 0x06;
+const int TAG_PUBLIC_POINT = 0x86;
+
+// Standardized domain parameter brainpoolP256r1 of the ChipAuthenticationDomainParameterInfo in EF.CardSecurity
+const int CHIP_AUTHENTICATION_CURVE = 0x0D;
+
+const int MAX_RETRY_COUNTER = 3;
+
+
+ResponseApdu createResponse(const QByteArray& pData, StatusCode pStatusCode)
+{
+	const auto statusCode = Enum<StatusCode>::getValue(pStatusCode);
+	QByteArray buffer = pData;
+	buffer += static_cast<char>(statusCode >> 8);
+	buffer += static_cast<char>(statusCode & 0xff);
+	return ResponseApdu(buffer);
+}
+
+
+QByteArray getXCoordinate(const QByteArray& pUncompressedPoint)
+{
+	return pUncompressedPoint.mid(1, (pUncompressedPoint.size() - 1) / 2);
+}
+
+
+}
+
+
+const QByteArray MockEidCard::EID_APPLICATION_ID = QByteArray::fromHex("E80704007F00070302");
+
+
+MockEidCard::MockEidCard()
+	: Card()
+	, mConnected(false)
+	, mFiles()
+	, mCurrentFile()
+	, mEidApplicationSelected(false)
+	, mLatency(0)
+	, mShortFileIdSupported(true)
+	, mExtendedLengthSupported(true)
+	, mTransmitCount(0)
+	, mPin(QStringLiteral("123456"))
+	, mCan(QStringLiteral("500540"))
+	, mPuk(QStringLiteral("9876543210"))
+	, mPinRetryCounter(MAX_RETRY_COUNTER)
+	, mPinResumed(false)
+	, mPaceProtocol(nullptr)
+	, mPasswordId(PACE_PASSWORD_ID::PACE_PIN)
+	, mPaceEstablished(false)
+	, mNonce()
+	, mCurve()
+	, mMapping()
+	, mEphemeralKey()
+	, mTerminalPublicKey()
+	, mEncryptionKey()
+	, mMacKey()
+	, mIdIcc()
+	, mSecureMessaging()
+	, mNextSecureMessaging()
+	, mTrustPoint()
+	, mCertificates()
+	, mVerificationKeyReference()
+	, mTerminalReference()
+	, mAuxiliaryData()
+	, mCompressedTerminalKey()
+	, mChallenge()
+	, mTerminalAuthenticated(false)
+	, mChipAuthenticationProtocol(nullptr)
+	, mChipAuthenticationCurve(EllipticCurveFactory::create(CHIP_AUTHENTICATION_CURVE))
+	, mChipAuthenticationKey(EcUtil::create(EC_KEY_new()))
+	, mChipAuthenticated(false)
+{
+	if (!EC_KEY_set_group(mChipAuthenticationKey.data(), mChipAuthenticationCurve.data()) || !EC_KEY_generate_key(mChipAuthenticationKey.data()))
+	{
+		qCritical() << "Cannot generate key of Chip Authentication";
+	}
+
+	// The first bytes of EF.DIR are checked on card recognition
+	setFile(FileRef::efDir(), QByteArray::fromHex("61324F0FE828BD080FA000000167455349474E500F434941207A752044462E655369676E5100730C4F0AA000000167455349474E61094F07A0000002471001610B4F09E80704007F00070302610C4F0AA000000167455349474E"));
+	setFile(FileRef::efCardAccess(), QByteArray::fromHex(TestFileHelper::readFile(QStringLiteral(":/card/efCardAccess.hex"))));
+	setFile(FileRef::efCardSecurity(), QByteArray::fromHex(TestFileHelper::readFile(QStringLiteral(":/card/efCardSecurity.hex"))));
+
+	// DocumentType, GivenNames and FamilyNames of the test card of TR-03110
+	setDataGroup(1, TlvHelper::encode(0x61, TlvHelper::encode(0x13, QByteArrayLiteral("ID"))));
+	setDataGroup(4, TlvHelper::encode(0x64, TlvHelper::encode(0x0C, QByteArrayLiteral("ERIKA"))));
+	setDataGroup(5, TlvHelper::encode(0x65, TlvHelper::encode(0x0C, QByteArrayLiteral("MUSTERMANN"))));
+}
+
+
+MockEidCard::~MockEidCard()
+{
+}
+
+
+CardReturnCode MockEidCard::connect()
+{
+	mConnected = true;
+	resetSession();
+	return CardReturnCode::OK;
+}
+
+
+CardReturnCode MockEidCard::disconnect()
+{
+	mConnected = false;
+	return CardReturnCode::OK;
+}
+
+
+bool MockEidCard::isConnected()
+{
+	return mConnected;
+}
+
+
+CardReturnCode MockEidCard::transmit(const CommandApdu& pCmd, ResponseApdu& pRes)
+{
+	++mTransmitCount;
+	if (mLatency > 0)
+	{
+		QThread::msleep(mLatency);
+	}
+
+	if (!mExtendedLengthSupported && (pCmd.getLc() > CommandApdu::SHORT_MAX_LC || pCmd.getLe() > CommandApdu::SHORT_MAX_LE))
+	{
+		pRes = createResponse(QByteArray(), StatusCode::WRONG_LENGTH);
+		return CardReturnCode::OK;
+	}
+
+	if (CommandApdu::isSecureMessaging(pCmd.getBuffer()))
+	{
+		const QByteArray command = mSecureMessaging ? mSecureMessaging->unwrap(pCmd) : QByteArray();
+		if (command.isEmpty())
+		{
+			// Every error of secure messaging closes the channel, see TR-03110-3, F.4
+			resetSession();
+			pRes = createResponse(QByteArray(), StatusCode::INVALID_SM_OBJECTS);
+			return CardReturnCode::OK;
+		}
+
+		pRes = mSecureMessaging->wrap(process(CommandApdu(command)));
+	}
+	else
+	{
+		if (mSecureMessaging)
+		{
+			// A plain command closes the channel as well
+			resetSession();
+		}
+		pRes = process(pCmd);
+	}
+
+	// The keys of PACE or Chip Authentication protect the commands after the one that established them
+	if (mNextSecureMessaging)
+	{
+		mSecureMessaging.swap(mNextSecureMessaging);
+		mNextSecureMessaging.reset();
+	}
+
+	return CardReturnCode::OK;
+}
+
+
+void MockEidCard::resetSession()
+{
+	mSecureMessaging.reset();
+	mNextSecureMessaging.reset();
+	mPaceProtocol = nullptr;
+	mPaceEstablished = false;
+	mNonce.clear();
+	mMapping.reset();
+	mEphemeralKey.clear();
+	mTerminalPublicKey.clear();
+	mIdIcc.clear();
+	mEidApplicationSelected = false;
+	mCurrentFile.clear();
+	resetTerminalAuthentication();
+}
+
+
+void MockEidCard::resetTerminalAuthentication()
+{
+	mCertificates.clear();
+	if (mTrustPoint)
+	{
+		mCertificates += mTrustPoint;
+	}
+	mVerificationKeyReference.clear();
+	mTerminalReference.clear();
+	mAuxiliaryData.clear();
+	mCompressedTerminalKey.clear();
+	mChallenge.clear();
+	mTerminalAuthenticated = false;
+	mChipAuthenticationProtocol = nullptr;
+	mChipAuthenticated = false;
+}
+
+
+ResponseApdu MockEidCard::process(const CommandApdu& pCmd)
+{
+	switch (static_cast<uchar>(pCmd.getINS()))
+	{
+		case 0xA4:
+			return select(pCmd);
+
+		case 0xB0:
+			return readBinary(pCmd);
+
+		case 0x22:
+			return manageSecurityEnvironment(pCmd);
+
+		case 0x86:
+			return generalAuthenticate(pCmd);
+
+		case 0x2A:
+			return verifyCertificate(pCmd);
+
+		case 0x84:
+			return getChallenge(pCmd);
+
+		case 0x82:
+			return externalAuthenticate(pCmd);
+
+		case 0x2C:
+			return resetRetryCounter(pCmd);
+
+		default:
+			return createResponse(QByteArray(), StatusCode::UNSUPPORTED_INS);
+	}
+}
+
+
+ResponseApdu MockEidCard::select(const CommandApdu& pCmd)
+{
+	if (pCmd.getP1() == static_cast<char>(SelectBuilder::P1::SELECT_MF))
+	{
+		mCurrentFile.clear();
+		mEidApplicationSelected = false;
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	if (pCmd.getP1() == static_cast<char>(SelectBuilder::P1::APPLICATION_ID) && pCmd.getData() == EID_APPLICATION_ID)
+	{
+		mCurrentFile.clear();
+		mEidApplicationSelected = true;
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	if (pCmd.getP1() == static_cast<char>(SelectBuilder::P1::CHILD_EF) && mFiles.contains(pCmd.getData())
+			&& mFiles.value(pCmd.getData()).mEidApplication == mEidApplicationSelected)
+	{
+		mCurrentFile = pCmd.getData();
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	return createResponse(QByteArray(), StatusCode::FILE_NOT_FOUND);
+}
+
+
+ResponseApdu MockEidCard::readBinary(const CommandApdu& pCmd)
+{
+	int offset = 0;
+	const auto p1 = static_cast<uchar>(pCmd.getP1());
+	const auto p2 = static_cast<uchar>(pCmd.getP2());
+	if (p1 & 0x80)
+	{
+		if (!mShortFileIdSupported)
+		{
+			return createResponse(QByteArray(), StatusCode::INVALID_P1P2);
+		}
+
+		const char shortFileId = static_cast<char>(p1 & 0x1f);
+		mCurrentFile.clear();
+		for (auto iter = mFiles.constBegin(); iter != mFiles.constEnd(); ++iter)
+		{
+			if (iter.value().mShortFileId == shortFileId && iter.value().mEidApplication == mEidApplicationSelected)
+			{
+				mCurrentFile = iter.key();
+				break;
+			}
+		}
+
+		if (mCurrentFile.isEmpty())
+		{
+			return createResponse(QByteArray(), StatusCode::FILE_NOT_FOUND);
+		}
+		offset = p2;
+	}
+	else
+	{
+		if (mCurrentFile.isEmpty())
+		{
+			return createResponse(QByteArray(), StatusCode::NO_BINARY_FILE);
+		}
+		offset = (p1 << 8) | p2;
+	}
+
+	const File& file = mFiles[mCurrentFile];
+	if (file.mEidApplication && !mChipAuthenticated)
+	{
+		return createResponse(QByteArray(), StatusCode::ACCESS_DENIED);
+	}
+
+	const QByteArray& content = file.mContent;
+	if (offset > content.size())
+	{
+		return createResponse(QByteArray(), StatusCode::ILLEGAL_OFFSET);
+	}
+
+	const int le = pCmd.getLe();
+	const QByteArray data = content.mid(offset, le);
+	return createResponse(data, data.size() < le ? StatusCode::END_OF_FILE : StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::manageSecurityEnvironment(const CommandApdu& pCmd)
+{
+	const auto p1 = static_cast<uchar>(pCmd.getP1());
+	const auto p2 = static_cast<uchar>(pCmd.getP2());
+	const auto& objects = TlvHelper::decode(pCmd.getData());
+
+	if (p1 == 0xC1 && p2 == 0xA4)
+	{
+		// MSE:Set AT of PACE, also used by the terminal to query the retry counter
+		const auto* protocol = KnownOIDs::getProtocolDescriptor(objects.value(TAG_CRYPTOGRAPHIC_MECHANISM));
+		const QByteArray& passwordId = objects.value(TAG_PUBLIC_KEY_REFERENCE);
+		const QByteArray& parameterId = objects.value(TAG_PRIVATE_KEY_REFERENCE);
+		if (protocol == nullptr || protocol->mProtocol != KnownOIDs::SecurityProtocol::ID_PACE || !protocol->mEcdh
+				|| protocol->mMapping != KnownOIDs::Mapping::GM || protocol->mCipher != KnownOIDs::Cipher::AES_CBC_CMAC
+				|| passwordId.size() != 1 || parameterId.size() != 1)
+		{
+			return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+		}
+
+		const auto curve = EllipticCurveFactory::create(static_cast<uchar>(parameterId.at(0)));
+		if (curve.isNull())
+		{
+			return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+		}
+
+		const auto password = static_cast<PACE_PASSWORD_ID>(passwordId.at(0));
+		if (password != PACE_PASSWORD_ID::PACE_PIN && password != PACE_PASSWORD_ID::PACE_CAN && password != PACE_PASSWORD_ID::PACE_PUK)
+		{
+			return createResponse(QByteArray(), StatusCode::PASSWORD_NOT_FOUND);
+		}
+
+		mPaceProtocol = protocol;
+		mPasswordId = password;
+		mPaceEstablished = false;
+		mCurve = curve;
+		mNonce.clear();
+		mMapping.reset();
+		mEphemeralKey.clear();
+		mTerminalPublicKey.clear();
+		resetTerminalAuthentication();
+		return createResponse(QByteArray(), mPasswordId == PACE_PASSWORD_ID::PACE_PIN ? getPinStatus() : StatusCode::SUCCESS);
+	}
+
+	if (p1 == 0x81 && p2 == 0xB6)
+	{
+		// MSE:Set DST selects the key to verify the next certificate
+		const QByteArray& reference = objects.value(TAG_PUBLIC_KEY_REFERENCE);
+		for (const auto& certificate : qAsConst(mCertificates))
+		{
+			if (certificate->getBody().getCertificateHolderReference() == reference)
+			{
+				mVerificationKeyReference = reference;
+				return createResponse(QByteArray(), StatusCode::SUCCESS);
+			}
+		}
+		return createResponse(QByteArray(), StatusCode::PASSWORD_NOT_FOUND);
+	}
+
+	if (p1 == 0x81 && p2 == 0xA4)
+	{
+		// MSE:Set AT of Terminal Authentication
+		const QByteArray& reference = objects.value(TAG_PUBLIC_KEY_REFERENCE);
+		if (!mPaceEstablished || mCertificates.size() < 2 || mCertificates.last()->getBody().getCertificateHolderReference() != reference)
+		{
+			return createResponse(QByteArray(), StatusCode::PASSWORD_NOT_FOUND);
+		}
+
+		mTerminalReference = reference;
+		mAuxiliaryData = objects.contains(TAG_AUXILIARY_DATA) ? TlvHelper::encode(TAG_AUXILIARY_DATA, objects.value(TAG_AUXILIARY_DATA)) : QByteArray();
+		mCompressedTerminalKey = objects.value(TAG_EPHEMERAL_PUBLIC_KEY);
+		mTerminalAuthenticated = false;
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	if (p1 == 0x41 && p2 == 0xA4)
+	{
+		// MSE:Set AT of Chip Authentication
+		const auto* protocol = KnownOIDs::getProtocolDescriptor(objects.value(TAG_CRYPTOGRAPHIC_MECHANISM));
+		if (protocol == nullptr || protocol->mProtocol != KnownOIDs::SecurityProtocol::ID_CA || !protocol->mEcdh
+				|| protocol->mCipher != KnownOIDs::Cipher::AES_CBC_CMAC)
+		{
+			return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+		}
+		if (!mTerminalAuthenticated)
+		{
+			return createResponse(QByteArray(), StatusCode::ACCESS_DENIED);
+		}
+
+		mChipAuthenticationProtocol = protocol;
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	if (p1 == 0xF4)
+	{
+		// The terminal sends an erase without data to close the channel and expects this error
+		return createResponse(QByteArray(), StatusCode::WRONG_LENGTH);
+	}
+
+	return createResponse(QByteArray(), StatusCode::INVALID_P1P2);
+}
+
+
+ResponseApdu MockEidCard::generalAuthenticate(const CommandApdu& pCmd)
+{
+	const auto& data = TlvHelper::decode(pCmd.getData());
+	if (!data.contains(TAG_DYNAMIC_AUTHENTICATION_DATA))
+	{
+		return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+	}
+
+	const auto& objects = TlvHelper::decode(data.value(TAG_DYNAMIC_AUTHENTICATION_DATA));
+	if (objects.contains(0x80))
+	{
+		return authenticateChip(objects.value(0x80));
+	}
+
+	if (mPaceProtocol == nullptr)
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+	if (objects.isEmpty())
+	{
+		return getNonce();
+	}
+	if (objects.contains(0x81))
+	{
+		return mapNonce(objects.value(0x81));
+	}
+	if (objects.contains(0x83))
+	{
+		return performKeyAgreement(objects.value(0x83));
+	}
+	if (objects.contains(0x85))
+	{
+		return mutualAuthenticate(objects.value(0x85));
+	}
+
+	return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+}
+
+
+ResponseApdu MockEidCard::getNonce()
+{
+	KeyDerivationFunction kdf(mPaceProtocol);
+	SymmetricCipher cipher(mPaceProtocol, kdf.pi(getPassword(mPasswordId)));
+	mNonce = Randomizer::getInstance().createBytes(cipher.getBlockSize());
+
+	const QByteArray encryptedNonce = TlvHelper::encode(0x80, cipher.encrypt(mNonce));
+	return createResponse(TlvHelper::encode(TAG_DYNAMIC_AUTHENTICATION_DATA, encryptedNonce), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::mapNonce(const QByteArray& pTerminalMappingData)
+{
+	if (mNonce.isEmpty())
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+
+	// The generic mapping is symmetric, so the card maps the nonce like the terminal
+	mMapping.reset(new EcdhGenericMapping(mCurve));
+	const QByteArray cardMappingData = mMapping->generateTerminalMappingData();
+	if (cardMappingData.isEmpty() || mMapping->generateEphemeralDomainParameters(pTerminalMappingData, mNonce).isNull())
+	{
+		return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+	}
+
+	return createResponse(TlvHelper::encode(TAG_DYNAMIC_AUTHENTICATION_DATA, TlvHelper::encode(0x82, cardMappingData)), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::performKeyAgreement(const QByteArray& pTerminalPublicKey)
+{
+	if (mMapping.isNull())
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+
+	mEphemeralKey = EcUtil::create(EC_KEY_new());
+	const auto terminalKey = EcUtil::oct2point(mCurve, pTerminalPublicKey);
+	if (terminalKey.isNull() || !EC_KEY_set_group(mEphemeralKey.data(), mCurve.data()) || !EC_KEY_generate_key(mEphemeralKey.data()))
+	{
+		return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+	}
+
+	const QByteArray cardKey = EcUtil::point2oct(mCurve, EC_KEY_get0_public_key(mEphemeralKey.data()));
+	if (cardKey == pTerminalPublicKey)
+	{
+		return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+	}
+
+	const auto sharedPoint = EcUtil::create(EC_POINT_new(mCurve.data()));
+	if (!EC_POINT_mul(mCurve.data(), sharedPoint.data(), nullptr, terminalKey.data(), EC_KEY_get0_private_key(mEphemeralKey.data()), nullptr))
+	{
+		return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+	}
+
+	const QByteArray sharedSecret = getXCoordinate(EcUtil::point2oct(mCurve, sharedPoint.data()));
+	KeyDerivationFunction kdf(mPaceProtocol);
+	mEncryptionKey = kdf.enc(sharedSecret);
+	mMacKey = kdf.mac(sharedSecret);
+	mTerminalPublicKey = pTerminalPublicKey;
+	mIdIcc = getXCoordinate(cardKey);
+
+	return createResponse(TlvHelper::encode(TAG_DYNAMIC_AUTHENTICATION_DATA, TlvHelper::encode(0x84, cardKey)), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::mutualAuthenticate(const QByteArray& pTerminalToken)
+{
+	if (mTerminalPublicKey.isEmpty())
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+
+	const QByteArray oid = mPaceProtocol->getValue();
+	const QByteArray cardKey = EcUtil::point2oct(mCurve, EC_KEY_get0_public_key(mEphemeralKey.data()));
+	CipherMac cipherMac(mPaceProtocol, mMacKey);
+	const bool tokenValid = cipherMac.generate(encodePublicKey(oid, cardKey)) == pTerminalToken;
+
+	if (mPasswordId == PACE_PASSWORD_ID::PACE_PIN)
+	{
+		// A suspended PIN can only be used after PACE with the CAN
+		if (mPinRetryCounter == 0 || (mPinRetryCounter == 1 && !mPinResumed))
+		{
+			return createResponse(QByteArray(), getPinStatus());
+		}
+
+		mPinResumed = false;
+		if (!tokenValid)
+		{
+			--mPinRetryCounter;
+			return createResponse(QByteArray(), getPinStatus());
+		}
+		mPinRetryCounter = MAX_RETRY_COUNTER;
+	}
+	else if (!tokenValid)
+	{
+		return createResponse(QByteArray(), StatusCode::VERIFICATION_FAILED);
+	}
+	else if (mPasswordId == PACE_PASSWORD_ID::PACE_CAN)
+	{
+		mPinResumed = true;
+	}
+
+	QByteArray data = TlvHelper::encode(0x86, cipherMac.generate(encodePublicKey(oid, mTerminalPublicKey)));
+	if (mTrustPoint)
+	{
+		data += TlvHelper::encode(0x87, mTrustPoint->getBody().getCertificateHolderReference());
+	}
+
+	mNextSecureMessaging.reset(new MockSecureMessaging(mPaceProtocol, mEncryptionKey, mMacKey));
+	mPaceEstablished = true;
+	mNonce.clear();
+	mTerminalPublicKey.clear();
+	return createResponse(TlvHelper::encode(TAG_DYNAMIC_AUTHENTICATION_DATA, data), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::authenticateChip(const QByteArray& pTerminalPublicKey)
+{
+	if (!mTerminalAuthenticated || mChipAuthenticationProtocol == nullptr)
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+
+	// The ephemeral key must be the one the terminal committed to in Terminal Authentication
+	if (getXCoordinate(pTerminalPublicKey) != mCompressedTerminalKey)
+	{
+		return createResponse(QByteArray(), StatusCode::VERIFICATION_FAILED);
+	}
+
+	const auto terminalKey = EcUtil::oct2point(mChipAuthenticationCurve, pTerminalPublicKey);
+	const auto sharedPoint = EcUtil::create(EC_POINT_new(mChipAuthenticationCurve.data()));
+	if (terminalKey.isNull() || !EC_POINT_mul(mChipAuthenticationCurve.data(), sharedPoint.data(), nullptr, terminalKey.data(), EC_KEY_get0_private_key(mChipAuthenticationKey.data()), nullptr))
+	{
+		return createResponse(QByteArray(), StatusCode::INVALID_DATAFIELD);
+	}
+
+	const QByteArray sharedSecret = getXCoordinate(EcUtil::point2oct(mChipAuthenticationCurve, sharedPoint.data()));
+	const QByteArray nonce = Randomizer::getInstance().createBytes(8);
+	KeyDerivationFunction kdf(mChipAuthenticationProtocol);
+	const QByteArray macKey = kdf.mac(sharedSecret, nonce);
+	CipherMac cipherMac(mChipAuthenticationProtocol, macKey);
+	const QByteArray token = cipherMac.generate(encodePublicKey(mChipAuthenticationProtocol->getValue(), pTerminalPublicKey));
+
+	mNextSecureMessaging.reset(new MockSecureMessaging(mChipAuthenticationProtocol, kdf.enc(sharedSecret, nonce), macKey));
+	mChipAuthenticated = true;
+
+	const QByteArray data = TlvHelper::encode(0x81, nonce) + TlvHelper::encode(0x82, token);
+	return createResponse(TlvHelper::encode(TAG_DYNAMIC_AUTHENTICATION_DATA, data), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::verifyCertificate(const CommandApdu& pCmd)
+{
+	if (!mPaceEstablished || mVerificationKeyReference.isEmpty())
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+
+	const auto certificate = CVCertificate::fromHex(TlvHelper::encode(TAG_CERTIFICATE, pCmd.getData()).toHex());
+	if (certificate.isNull() || certificate->getBody().getCertificationAuthorityReference() != mVerificationKeyReference)
+	{
+		return createResponse(QByteArray(), StatusCode::VERIFICATION_FAILED);
+	}
+	mVerificationKeyReference.clear();
+
+	auto certificates = mCertificates;
+	certificates += certificate;
+	if (!SignatureChecker(certificates).check())
+	{
+		return createResponse(QByteArray(), StatusCode::VERIFICATION_FAILED);
+	}
+
+	mCertificates = certificates;
+	return createResponse(QByteArray(), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::getChallenge(const CommandApdu& pCmd)
+{
+	if (!mPaceEstablished)
+	{
+		return createResponse(QByteArray(), StatusCode::ACCESS_DENIED);
+	}
+
+	const int le = pCmd.getLe();
+	mChallenge = Randomizer::getInstance().createBytes(le == CommandApdu::NO_LE ? 8 : le);
+	return createResponse(mChallenge, StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::externalAuthenticate(const CommandApdu& pCmd)
+{
+	if (mTerminalReference.isEmpty() || mChallenge.isEmpty())
+	{
+		return createResponse(QByteArray(), StatusCode::NOT_YET_INITIALIZED);
+	}
+
+	// Every challenge is used once
+	const QByteArray challenge = mChallenge;
+	mChallenge.clear();
+
+	// The terminal certificate carries the public point only, the domain parameters are those of the CVCA
+	const auto& terminalBody = mCertificates.last()->getBody();
+	const auto key = EcUtil::create(EC_KEY_dup(mCertificates.first()->getBody().getPublicKey().getEcKey().data()));
+	const EC_GROUP* group = EC_KEY_get0_group(key.data());
+	const auto publicPoint = EcUtil::create(EC_POINT_new(group));
+	const QByteArray point = terminalBody.getPublicKey().getUncompressedPublicPoint();
+	if (!EC_POINT_oct2point(group, publicPoint.data(), reinterpret_cast<const uchar*>(point.constData()), static_cast<size_t>(point.size()), nullptr)
+			|| !EC_KEY_set_public_key(key.data(), publicPoint.data()))
+	{
+		return createResponse(QByteArray(), StatusCode::VERIFICATION_FAILED);
+	}
+
+	const QByteArray signature = pCmd.getData();
+	const int coordinateSize = signature.size() / 2;
+	const auto* signatureData = reinterpret_cast<const uchar*>(signature.constData());
+	const auto ecdsaSignature = EcUtil::create(ECDSA_SIG_new());
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+	BN_bin2bn(signatureData, coordinateSize, ecdsaSignature->r);
+	BN_bin2bn(signatureData + coordinateSize, coordinateSize, ecdsaSignature->s);
+#else
+	ECDSA_SIG_set0(ecdsaSignature.data(), BN_bin2bn(signatureData, coordinateSize, nullptr), BN_bin2bn(signatureData + coordinateSize, coordinateSize, nullptr));
+#endif
+
+	const QByteArray hash = QCryptographicHash::hash(mIdIcc + challenge + mCompressedTerminalKey + mAuxiliaryData, terminalBody.getHashAlgorithm());
+	if (ECDSA_do_verify(reinterpret_cast<const uchar*>(hash.constData()), hash.size(), ecdsaSignature.data(), key.data()) != 1)
+	{
+		return createResponse(QByteArray(), StatusCode::VERIFICATION_FAILED);
+	}
+
+	mTerminalAuthenticated = true;
+	return createResponse(QByteArray(), StatusCode::SUCCESS);
+}
+
+
+ResponseApdu MockEidCard::resetRetryCounter(const CommandApdu& pCmd)
+{
+	if (!mPaceEstablished)
+	{
+		return createResponse(QByteArray(), StatusCode::ACCESS_DENIED);
+	}
+
+	if (pCmd.getP1() == 0x02 && pCmd.getP2() == 0x03)
+	{
+		// Change of the PIN
+		if (mPasswordId != PACE_PASSWORD_ID::PACE_PIN)
+		{
+			return createResponse(QByteArray(), StatusCode::ACCESS_DENIED);
+		}
+
+		mPin = QString::fromLatin1(pCmd.getData());
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	if (pCmd.getP1() == 0x03 && pCmd.getP2() == 0x03)
+	{
+		// Unblock of the PIN
+		if (mPasswordId != PACE_PASSWORD_ID::PACE_PUK)
+		{
+			return createResponse(QByteArray(), StatusCode::ACCESS_DENIED);
+		}
+
+		mPinRetryCounter = MAX_RETRY_COUNTER;
+		return createResponse(QByteArray(), StatusCode::SUCCESS);
+	}
+
+	return createResponse(QByteArray(), StatusCode::INVALID_P1P2);
+}
+
+
+StatusCode MockEidCard::getPinStatus() const
+{
+	switch (mPinRetryCounter)
+	{
+		case 0:
+			return StatusCode::PIN_BLOCKED;
+
+		case 1:
+			return StatusCode::PIN_SUSPENDED;
+
+		case 2:
+			return StatusCode::PIN_RETRY_COUNT_2;
+
+		default:
+			return StatusCode::SUCCESS;
+	}
+}
+
+
+QString MockEidCard::getPassword(PACE_PASSWORD_ID pPasswordId) const
+{
+	switch (pPasswordId)
+	{
+		case PACE_PASSWORD_ID::PACE_PIN:
+			return mPin;
+
+		case PACE_PASSWORD_ID::PACE_CAN:
+			return mCan;
+
+		case PACE_PASSWORD_ID::PACE_PUK:
+			return mPuk;
+
+		default:
+			return QString();
+	}
+}
+
+
+QByteArray MockEidCard::encodePublicKey(const QByteArray& pOid, const QByteArray& pPoint) const
+{
+	return TlvHelper::encode(TAG_PUBLIC_KEY, TlvHelper::encode(TAG_OID, pOid) + TlvHelper::encode(TAG_PUBLIC_POINT, pPoint));
+}
+
+
+void MockEidCard::setFile(const FileRef& pFileRef, const QByteArray& pContent)
+{
+	mFiles.insert(pFileRef.path, {pFileRef.shortFileId, pContent, false});
+}
+
+
+void MockEidCard::setDataGroup(int pNumber, const QByteArray& pContent)
+{
+	const QByteArray fileId = QByteArray(1, 0x01) + static_cast<char>(pNumber);
+	mFiles.insert(fileId, {static_cast<char>(pNumber), pContent, true});
+}
+
+
+void MockEidCard::setLatency(unsigned long pMilliseconds)
+{
+	mLatency = pMilliseconds;
+}
+
+
+void MockEidCard::setPin(const QString& pPin)
+{
+	mPin = pPin;
+}
+
+
+const QString& MockEidCard::getPin() const
+{
+	return mPin;
+}
+
+
+void MockEidCard::setPinRetryCounter(int pRetryCounter)
+{
+	mPinRetryCounter = pRetryCounter;
+}
+
+
+int MockEidCard::getPinRetryCounter() const
+{
+	return mPinRetryCounter;
+}
+
+
+void MockEidCard::setShortFileIdSupported(bool pSupported)
+{
+	mShortFileIdSupported = pSupported;
+}
+
+
+void MockEidCard::setExtendedLengthSupported(bool pSupported)
+{
+	mExtendedLengthSupported = pSupported;
+}
+
+
+int MockEidCard::getTransmitCount() const
+{
+	return mTransmitCount;
+}
+
+
+void MockEidCard::setTrustPoint(const QSharedPointer<const CVCertificate>& pTrustPoint)
+{
+	mTrustPoint = pTrustPoint;
+	resetTerminalAuthentication();
+}
+
+
+QByteArray MockEidCard::getChipAuthenticationPublicKey() const
+{
+	return EcUtil::point2oct(mChipAuthenticationCurve, EC_KEY_get0_public_key(mChipAuthenticationKey.data()));
+}
+
+
+bool MockEidCard::isSecureMessagingActive() const
+{
+	return !mSecureMessaging.isNull();
+}
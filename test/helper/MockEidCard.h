@@ -0,0 +1,159 @@
+/*!
+ * \brief Software eID card for tests and benchmarks of the card layer.
+ *
+ * The card provides a file system with EF.DIR, EF.CardAccess and
+ * EF.CardSecurity that can be selected and read like on a real card.
+ *
+ * The card side of PACE with ECDH generic mapping, Terminal Authentication
+ * version 2 and Chip Authentication version 2 is implemented as well as
+ * the secure messaging that follows PACE and Chip Authentication. The data
+ * groups of the eID application can be read after Chip Authentication. The
+ * PIN can be changed in a PACE channel of the PIN and unblocked in one of
+ * the PUK. Access rights of the CHAT are not checked.
+ *
+ * The card generates its own key for Chip Authentication, so the public key
+ * in EF.CardSecurity does not belong to it. Use getChipAuthenticationPublicKey()
+ * instead.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "asn1/CVCertificate.h"
+#include "Card.h"
+#include "MockSecureMessaging.h"
+#include "pace/ec/EcdhGenericMapping.h"
+
+#include <QByteArray>
+#include <QMap>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <openssl/ec.h>
+
+namespace governikus
+{
+
+class MockEidCard
+	: public Card
+{
+	Q_OBJECT
+
+	private:
+		struct File
+		{
+			char mShortFileId;
+			QByteArray mContent;
+			bool mEidApplication;
+		};
+
+		bool mConnected;
+		QMap<QByteArray, File> mFiles;
+		QByteArray mCurrentFile;
+		bool mEidApplicationSelected;
+		unsigned long mLatency;
+		bool mShortFileIdSupported;
+		bool mExtendedLengthSupported;
+		int mTransmitCount;
+
+		QString mPin;
+		QString mCan;
+		QString mPuk;
+		int mPinRetryCounter;
+		bool mPinResumed;
+
+		const KnownOIDs::ProtocolDescriptor* mPaceProtocol;
+		PACE_PASSWORD_ID mPasswordId;
+		bool mPaceEstablished;
+		QByteArray mNonce;
+		QSharedPointer<EC_GROUP> mCurve;
+		QScopedPointer<EcdhGenericMapping> mMapping;
+		QSharedPointer<EC_KEY> mEphemeralKey;
+		QByteArray mTerminalPublicKey;
+		QByteArray mEncryptionKey;
+		QByteArray mMacKey;
+		QByteArray mIdIcc;
+		QScopedPointer<MockSecureMessaging> mSecureMessaging;
+		QScopedPointer<MockSecureMessaging> mNextSecureMessaging;
+
+		QSharedPointer<const CVCertificate> mTrustPoint;
+		QVector<QSharedPointer<const CVCertificate> > mCertificates;
+		QByteArray mVerificationKeyReference;
+		QByteArray mTerminalReference;
+		QByteArray mAuxiliaryData;
+		QByteArray mCompressedTerminalKey;
+		QByteArray mChallenge;
+		bool mTerminalAuthenticated;
+
+		const KnownOIDs::ProtocolDescriptor* mChipAuthenticationProtocol;
+		QSharedPointer<EC_GROUP> mChipAuthenticationCurve;
+		QSharedPointer<EC_KEY> mChipAuthenticationKey;
+		bool mChipAuthenticated;
+
+		void resetSession();
+		void resetTerminalAuthentication();
+		ResponseApdu process(const CommandApdu& pCmd);
+		ResponseApdu select(const CommandApdu& pCmd);
+		ResponseApdu readBinary(const CommandApdu& pCmd);
+		ResponseApdu manageSecurityEnvironment(const CommandApdu& pCmd);
+		ResponseApdu generalAuthenticate(const CommandApdu& pCmd);
+		ResponseApdu getNonce();
+		ResponseApdu mapNonce(const QByteArray& pTerminalMappingData);
+		ResponseApdu performKeyAgreement(const QByteArray& pTerminalPublicKey);
+		ResponseApdu mutualAuthenticate(const QByteArray& pTerminalToken);
+		ResponseApdu authenticateChip(const QByteArray& pTerminalPublicKey);
+		ResponseApdu verifyCertificate(const CommandApdu& pCmd);
+		ResponseApdu getChallenge(const CommandApdu& pCmd);
+		ResponseApdu externalAuthenticate(const CommandApdu& pCmd);
+		ResponseApdu resetRetryCounter(const CommandApdu& pCmd);
+		StatusCode getPinStatus() const;
+		QString getPassword(PACE_PASSWORD_ID pPasswordId) const;
+		QByteArray encodePublicKey(const QByteArray& pOid, const QByteArray& pPoint) const;
+
+	public:
+		static const QByteArray EID_APPLICATION_ID;
+
+		MockEidCard();
+		virtual ~MockEidCard() override;
+
+		CardReturnCode connect() override;
+		CardReturnCode disconnect() override;
+		bool isConnected() override;
+		CardReturnCode transmit(const CommandApdu& pCmd, ResponseApdu& pRes) override;
+
+		void setFile(const FileRef& pFileRef, const QByteArray& pContent);
+
+		/*!
+		 * Sets the content of a data group of the eID application. The data
+		 * group can be read with its short file identifier.
+		 */
+		void setDataGroup(int pNumber, const QByteArray& pContent);
+
+		/*!
+		 * Delay of every transmit to simulate the communication with a real card.
+		 */
+		void setLatency(unsigned long pMilliseconds);
+
+		void setPin(const QString& pPin);
+		const QString& getPin() const;
+		void setPinRetryCounter(int pRetryCounter);
+		int getPinRetryCounter() const;
+		void setShortFileIdSupported(bool pSupported);
+		void setExtendedLengthSupported(bool pSupported);
+		int getTransmitCount() const;
+
+		/*!
+		 * Sets the CVCA certificate that is used as root of Terminal Authentication.
+		 */
+		void setTrustPoint(const QSharedPointer<const CVCertificate>& pTrustPoint);
+
+		/*!
+		 * Returns the uncompressed public key of Chip Authentication.
+		 */
+		QByteArray getChipAuthenticationPublicKey() const;
+		bool isSecureMessagingActive() const;
+};
+
+} /* namespace governikus */
@@ -0,0 +1,308 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "MockEidServer.h"
+
+#include "Commands.h"
+#include "MockEidCard.h"
+#include "pace/CipherMac.h"
+#include "pace/ec/EcUtil.h"
+#include "pace/ec/EllipticCurveFactory.h"
+#include "pace/KeyDerivationFunction.h"
+#include "TlvHelper.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+
+#include <openssl/ecdsa.h>
+
+using namespace governikus;
+
+
+namespace
+{
+// brainpoolP256r1
+const int CURVE = 0x0D;
+
+const QByteArray ID_TA_ECDSA_SHA_256 = QByteArray::fromHex("04007F00070202020203");
+const QByteArray ID_AT = QByteArray::fromHex("04007F000703010202");
+const QByteArray ID_DESCRIPTION = QByteArray::fromHex("04007F000703010301");
+
+const char ROLE_CVCA = char(0xC0);
+const char ROLE_DV_OFFICIAL_DOMESTIC = char(0x80);
+const char ROLE_AT = 0x00;
+
+// Unpacked BCD of 2018-01-01 and 2029-12-31
+const QByteArray EFFECTIVE_DATE = QByteArray::fromHex("010800010001");
+const QByteArray EXPIRATION_DATE = QByteArray::fromHex("020901020301");
+
+
+QByteArray toBytes(const BIGNUM* pNumber, int pSize = 0)
+{
+	QByteArray bytes(BN_num_bytes(pNumber), 0x00);
+	BN_bn2bin(pNumber, reinterpret_cast<uchar*>(bytes.data()));
+	if (bytes.size() < pSize)
+	{
+		bytes.prepend(QByteArray(pSize - bytes.size(), 0x00));
+	}
+	return bytes;
+}
+
+
+}
+
+
+MockEidServer::MockEidServer(const QByteArray& pCertificateDescription)
+	: mCurve(EllipticCurveFactory::create(CURVE))
+	, mCvcaKey(createKey())
+	, mDvKey(createKey())
+	, mTerminalKey(createKey())
+	, mEphemeralKey(createKey())
+	, mCvca()
+	, mDv()
+	, mTerminal()
+	, mSecureMessaging()
+{
+	const QByteArray cvcaReference = QByteArrayLiteral("DEMOCKCVCA00001");
+	const QByteArray dvReference = QByteArrayLiteral("DEMOCKDV00001");
+	const QByteArray terminalReference = QByteArrayLiteral("DEMOCKAT00001");
+
+	mCvca = createCertificate(cvcaReference, cvcaReference, encodePublicKey(mCvcaKey, true), encodeChat(ROLE_CVCA), mCvcaKey);
+	mDv = createCertificate(cvcaReference, dvReference, encodePublicKey(mDvKey, false), encodeChat(ROLE_DV_OFFICIAL_DOMESTIC), mCvcaKey);
+	mTerminal = createCertificate(dvReference, terminalReference, encodePublicKey(mTerminalKey, false), encodeChat(ROLE_AT), mDvKey,
+			pCertificateDescription.isEmpty() ? QByteArray() : encodeDescriptionExtension(pCertificateDescription));
+}
+
+
+MockEidServer::~MockEidServer()
+{
+}
+
+
+QSharedPointer<EC_KEY> MockEidServer::createKey() const
+{
+	const auto key = EcUtil::create(EC_KEY_new());
+	if (!EC_KEY_set_group(key.data(), mCurve.data()) || !EC_KEY_generate_key(key.data()))
+	{
+		qCritical() << "Cannot generate key";
+	}
+	return key;
+}
+
+
+QByteArray MockEidServer::getPublicPoint(const QSharedPointer<EC_KEY>& pKey) const
+{
+	return EcUtil::point2oct(mCurve, EC_KEY_get0_public_key(pKey.data()));
+}
+
+
+QByteArray MockEidServer::encodePublicKey(const QSharedPointer<EC_KEY>& pKey, bool pDomainParameters) const
+{
+	const auto prime = EcUtil::create(BN_new());
+	const auto firstCoefficient = EcUtil::create(BN_new());
+	const auto secondCoefficient = EcUtil::create(BN_new());
+	const auto order = EcUtil::create(BN_new());
+	const auto cofactor = EcUtil::create(BN_new());
+	if (!EC_GROUP_get_curve_GFp(mCurve.data(), prime.data(), firstCoefficient.data(), secondCoefficient.data(), nullptr)
+			|| !EC_GROUP_get_order(mCurve.data(), order.data(), nullptr)
+			|| !EC_GROUP_get_cofactor(mCurve.data(), cofactor.data(), nullptr))
+	{
+		qCritical() << "Cannot get domain parameters";
+		return QByteArray();
+	}
+
+	// Only the CVCA certificate contains the domain parameters, see TR-03110-3, D.3.1
+	const int size = BN_num_bytes(prime.data());
+	QByteArray data = TlvHelper::encode(0x06, ID_TA_ECDSA_SHA_256);
+	if (pDomainParameters)
+	{
+		data += TlvHelper::encode(0x81, toBytes(prime.data()));
+		data += TlvHelper::encode(0x82, toBytes(firstCoefficient.data(), size));
+		data += TlvHelper::encode(0x83, toBytes(secondCoefficient.data(), size));
+		data += TlvHelper::encode(0x84, EcUtil::point2oct(mCurve, EC_GROUP_get0_generator(mCurve.data())));
+		data += TlvHelper::encode(0x85, toBytes(order.data()));
+	}
+	data += TlvHelper::encode(0x86, getPublicPoint(pKey));
+	if (pDomainParameters)
+	{
+		data += TlvHelper::encode(0x87, toBytes(cofactor.data()));
+	}
+	return TlvHelper::encode(0x7F49, data);
+}
+
+
+QByteArray MockEidServer::encodeChat(char pRole) const
+{
+	// All rights of an authentication terminal except the write access to the data groups
+	const QByteArray rights = QByteArray(1, pRole) + QByteArray::fromHex("00FFFFF7");
+	return TlvHelper::encode(0x7F4C, TlvHelper::encode(0x06, ID_AT) + TlvHelper::encode(0x53, rights));
+}
+
+
+QByteArray MockEidServer::sign(const QSharedPointer<EC_KEY>& pKey, const QByteArray& pData) const
+{
+	const QByteArray hash = QCryptographicHash::hash(pData, QCryptographicHash::Sha256);
+	const auto signature = EcUtil::create(ECDSA_do_sign(reinterpret_cast<const uchar*>(hash.constData()), hash.size(), pKey.data()));
+	if (signature.isNull())
+	{
+		qCritical() << "Cannot sign data";
+		return QByteArray();
+	}
+
+	const BIGNUM* r = nullptr;
+	const BIGNUM* s = nullptr;
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+	r = signature->r;
+	s = signature->s;
+#else
+	ECDSA_SIG_get0(signature.data(), &r, &s);
+#endif
+
+	// The plain signature format concatenates both values with the size of the order, see TR-03111, 5.2.1
+	const int size = (EC_GROUP_get_degree(mCurve.data()) + 7) / 8;
+	return toBytes(r, size) + toBytes(s, size);
+}
+
+
+QByteArray MockEidServer::encodeDescriptionExtension(const QByteArray& pCertificateDescription) const
+{
+	// The hash algorithm belongs to id-TA-ECDSA-SHA-256 of the terminal key
+	const QByteArray hash = QCryptographicHash::hash(pCertificateDescription, QCryptographicHash::Sha256);
+	const QByteArray description = TlvHelper::encode(0x06, ID_DESCRIPTION) + TlvHelper::encode(0x80, hash);
+	return TlvHelper::encode(0x65, TlvHelper::encode(0x73, description));
+}
+
+
+QSharedPointer<const CVCertificate> MockEidServer::createCertificate(const QByteArray& pCar, const QByteArray& pChr, const QByteArray& pPublicKey,
+		const QByteArray& pChat, const QSharedPointer<EC_KEY>& pSigningKey, const QByteArray& pExtensions) const
+{
+	QByteArray body;
+	body += TlvHelper::encode(0x5F29, QByteArray(1, 0x00));
+	body += TlvHelper::encode(0x42, pCar);
+	body += pPublicKey;
+	body += TlvHelper::encode(0x5F20, pChr);
+	body += pChat;
+	body += TlvHelper::encode(0x5F25, EFFECTIVE_DATE);
+	body += TlvHelper::encode(0x5F24, EXPIRATION_DATE);
+	body += pExtensions;
+	body = TlvHelper::encode(0x7F4E, body);
+
+	const QByteArray certificate = TlvHelper::encode(0x7F21, body + TlvHelper::encode(0x5F37, sign(pSigningKey, body)));
+	return CVCertificate::fromHex(certificate.toHex());
+}
+
+
+const QSharedPointer<const CVCertificate>& MockEidServer::getTrustPoint() const
+{
+	return mCvca;
+}
+
+
+CVCertificateChain MockEidServer::getCertificateChain() const
+{
+	return CVCertificateChain(QVector<QSharedPointer<const CVCertificate> >({mDv, mTerminal}), false);
+}
+
+
+QByteArray MockEidServer::getChat() const
+{
+	return encodeChat(ROLE_AT);
+}
+
+
+QString MockEidServer::getEphemeralPublicKeyAsHex() const
+{
+	return QString::fromLatin1(getPublicPoint(mEphemeralKey).toHex());
+}
+
+
+QString MockEidServer::createSignatureAsHex(const QByteArray& pIdIcc, const QByteArray& pChallenge) const
+{
+	const QByteArray ephemeralPublicKey = getPublicPoint(mEphemeralKey);
+	const QByteArray compressedEphemeralPublicKey = ephemeralPublicKey.mid(1, (ephemeralPublicKey.size() - 1) / 2);
+	return QString::fromLatin1(sign(mTerminalKey, pIdIcc + pChallenge + compressedEphemeralPublicKey).toHex());
+}
+
+
+bool MockEidServer::verifyChipAuthentication(const QByteArray& pCardPublicKey, const QByteArray& pNonce, const QByteArray& pAuthenticationToken)
+{
+	const auto cardKey = EcUtil::oct2point(mCurve, pCardPublicKey);
+	const auto sharedPoint = EcUtil::create(EC_POINT_new(mCurve.data()));
+	if (cardKey.isNull() || !EC_POINT_mul(mCurve.data(), sharedPoint.data(), nullptr, cardKey.data(), EC_KEY_get0_private_key(mEphemeralKey.data()), nullptr))
+	{
+		return false;
+	}
+
+	const QByteArray sharedPointData = EcUtil::point2oct(mCurve, sharedPoint.data());
+	const QByteArray sharedSecret = sharedPointData.mid(1, (sharedPointData.size() - 1) / 2);
+	const auto* protocol = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_ca::ECDH_AES_CBC_CMAC_128);
+	KeyDerivationFunction kdf(protocol);
+	const QByteArray macKey = kdf.mac(sharedSecret, pNonce);
+
+	const QByteArray ephemeralPublicKey = getPublicPoint(mEphemeralKey);
+	const QByteArray publicKeyData = TlvHelper::encode(0x06, protocol->getValue()) + TlvHelper::encode(0x86, ephemeralPublicKey);
+	CipherMac cipherMac(protocol, macKey);
+	if (cipherMac.generate(TlvHelper::encode(0x7F49, publicKeyData)) != pAuthenticationToken)
+	{
+		return false;
+	}
+
+	mSecureMessaging.reset(new SecureMessaging(protocol, kdf.enc(sharedSecret, pNonce), macKey));
+	return true;
+}
+
+
+QVector<CommandApdu> MockEidServer::createReadDataGroupCommands(int pNumber)
+{
+	return QVector<CommandApdu>({
+				SelectBuilder(FileRef(static_cast<char>(SelectBuilder::P1::APPLICATION_ID), MockEidCard::EID_APPLICATION_ID)).build(),
+				ReadBinaryBuilder(0, CommandApdu::SHORT_MAX_LE, static_cast<char>(pNumber)).build()
+			});
+}
+
+
+CommandApdu MockEidServer::encrypt(const CommandApdu& pCommand)
+{
+	Q_ASSERT(!mSecureMessaging.isNull());
+	return mSecureMessaging->encrypt(pCommand);
+}
+
+
+bool MockEidServer::decrypt(const ResponseApdu& pSecuredResponse, ResponseApdu& pResponse)
+{
+	Q_ASSERT(!mSecureMessaging.isNull());
+	return mSecureMessaging->decrypt(pSecuredResponse, pResponse);
+}
+
+
+CardReturnCode MockEidServer::readDataGroup(const QSharedPointer<CardConnectionWorker>& pWorker, int pNumber, QByteArray& pContent)
+{
+	if (mSecureMessaging.isNull())
+	{
+		return CardReturnCode::COMMAND_FAILED;
+	}
+
+	for (const auto& command : createReadDataGroupCommands(pNumber))
+	{
+		ResponseApdu securedResponse;
+		const CardReturnCode returnCode = pWorker->transmit(encrypt(command), securedResponse);
+		if (returnCode != CardReturnCode::OK)
+		{
+			return returnCode;
+		}
+
+		ResponseApdu response;
+		if (!decrypt(securedResponse, response))
+		{
+			return CardReturnCode::COMMAND_FAILED;
+		}
+		if (response.getReturnCode() != StatusCode::SUCCESS && response.getReturnCode() != StatusCode::END_OF_FILE)
+		{
+			return CardReturnCode::COMMAND_FAILED;
+		}
+		pContent = response.getData();
+	}
+
+	return CardReturnCode::OK;
+}
@@ -0,0 +1,108 @@
+/*!
+ * \brief Counterpart of MockEidCard that plays the eID server.
+ *
+ * The server owns the keys and certificates of a CVCA, a DV and a terminal
+ * and provides the data an eID server sends with DIDAuthenticate for
+ * Terminal Authentication and Chip Authentication. After Chip Authentication
+ * the data groups are read with the keys of the server like the eID server
+ * does by Transmit.
+ *
+ * If a certificate description is passed, its hash is stored in the
+ * extension of the terminal certificate to be checked against the
+ * description sent with DIDAuthenticate EAC1.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "asn1/CVCertificateChain.h"
+#include "CardConnectionWorker.h"
+#include "pace/SecureMessaging.h"
+
+#include <QByteArray>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include <openssl/ec.h>
+
+namespace governikus
+{
+
+class MockEidServer
+{
+	private:
+		QSharedPointer<EC_GROUP> mCurve;
+		QSharedPointer<EC_KEY> mCvcaKey;
+		QSharedPointer<EC_KEY> mDvKey;
+		QSharedPointer<EC_KEY> mTerminalKey;
+		QSharedPointer<EC_KEY> mEphemeralKey;
+		QSharedPointer<const CVCertificate> mCvca;
+		QSharedPointer<const CVCertificate> mDv;
+		QSharedPointer<const CVCertificate> mTerminal;
+		QScopedPointer<SecureMessaging> mSecureMessaging;
+
+		QSharedPointer<EC_KEY> createKey() const;
+		QByteArray getPublicPoint(const QSharedPointer<EC_KEY>& pKey) const;
+		QByteArray encodePublicKey(const QSharedPointer<EC_KEY>& pKey, bool pDomainParameters) const;
+		QByteArray encodeChat(char pRole) const;
+		QByteArray sign(const QSharedPointer<EC_KEY>& pKey, const QByteArray& pData) const;
+		QByteArray encodeDescriptionExtension(const QByteArray& pCertificateDescription) const;
+		QSharedPointer<const CVCertificate> createCertificate(const QByteArray& pCar, const QByteArray& pChr, const QByteArray& pPublicKey,
+				const QByteArray& pChat, const QSharedPointer<EC_KEY>& pSigningKey, const QByteArray& pExtensions = QByteArray()) const;
+
+		Q_DISABLE_COPY(MockEidServer)
+
+	public:
+		explicit MockEidServer(const QByteArray& pCertificateDescription = QByteArray());
+		~MockEidServer();
+
+		/*!
+		 * The self-signed CVCA certificate to be stored as trust point of the card.
+		 */
+		const QSharedPointer<const CVCertificate>& getTrustPoint() const;
+
+		/*!
+		 * The DV and terminal certificate sent with DIDAuthenticate EAC2.
+		 */
+		CVCertificateChain getCertificateChain() const;
+
+		/*!
+		 * The CHAT of the terminal certificate for PACE.
+		 */
+		QByteArray getChat() const;
+
+		/*!
+		 * The uncompressed ephemeral public key of Chip Authentication.
+		 */
+		QString getEphemeralPublicKeyAsHex() const;
+
+		/*!
+		 * Signs the challenge of DIDAuthenticate EAC1 for Terminal Authentication.
+		 */
+		QString createSignatureAsHex(const QByteArray& pIdIcc, const QByteArray& pChallenge) const;
+
+		/*!
+		 * Verifies the authentication token of Chip Authentication and switches
+		 * to the keys of the card for readDataGroup.
+		 */
+		bool verifyChipAuthentication(const QByteArray& pCardPublicKey, const QByteArray& pNonce, const QByteArray& pAuthenticationToken);
+
+		/*!
+		 * The commands to select the eID application and to read a data group.
+		 */
+		static QVector<CommandApdu> createReadDataGroupCommands(int pNumber);
+
+		/*!
+		 * Secures a command with the keys of Chip Authentication. The response
+		 * has to be passed to decrypt() before the next command is secured.
+		 */
+		CommandApdu encrypt(const CommandApdu& pCommand);
+		bool decrypt(const ResponseApdu& pSecuredResponse, ResponseApdu& pResponse);
+
+		CardReturnCode readDataGroup(const QSharedPointer<CardConnectionWorker>& pWorker, int pNumber, QByteArray& pContent);
+};
+
+} /* namespace governikus */
@@ -0,0 +1,326 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "MockEidServerNetworkManager.h"
+
+#include "MockNetworkReply.h"
+#include "TestFileHelper.h"
+#include "TlvHelper.h"
+
+#include <QDebug>
+#include <QTimer>
+#include <QUuid>
+#include <QXmlStreamReader>
+
+using namespace governikus;
+
+
+namespace
+{
+const QByteArray ID_PLAIN_FORMAT = QByteArray::fromHex("04007F00070301030101");
+
+const char* const ENVELOPE = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+							 "<soap:Envelope xmlns:soap=\"http://schemas.xmlsoap.org/soap/envelope/\" xmlns:wsa=\"http://www.w3.org/2005/03/addressing\">"
+							 "<soap:Header><wsa:MessageID>%1</wsa:MessageID><wsa:RelatesTo>%2</wsa:RelatesTo></soap:Header>"
+							 "<soap:Body>%3</soap:Body>"
+							 "</soap:Envelope>";
+
+const char* const DID_AUTHENTICATE = "<DIDAuthenticate xmlns=\"urn:iso:std:iso-iec:24727:tech:schema\">"
+									 "<DIDName>PIN</DIDName>"
+									 "<AuthenticationProtocolData xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+									 "Protocol=\"urn:oid:1.3.162.15480.3.0.14.2\" xsi:type=\"%1\">%2</AuthenticationProtocolData>"
+									 "</DIDAuthenticate>";
+
+const char* const TRANSMIT = "<Transmit xmlns=\"urn:iso:std:iso-iec:24727:tech:schema\">"
+							 "<SlotHandle>00</SlotHandle>"
+							 "<InputAPDUInfo><InputAPDU>%1</InputAPDU></InputAPDUInfo>"
+							 "</Transmit>";
+
+const char* const START_PAOS_RESPONSE = "<StartPAOSResponse xmlns=\"urn:iso:std:iso-iec:24727:tech:schema\">"
+										"<Result xmlns=\"urn:oasis:names:tc:dss:1.0:core:schema\">%1</Result>"
+										"</StartPAOSResponse>";
+
+const char* const TC_TOKEN = "<?xml version=\"1.0\"?>"
+							 "<TCTokenType>"
+							 "<ServerAddress>https://eid-server.example.de/entrypoint</ServerAddress>"
+							 "<SessionIdentifier>1A2BB129</SessionIdentifier>"
+							 "<RefreshAddress>%1</RefreshAddress>"
+							 "<CommunicationErrorAddress>%1</CommunicationErrorAddress>"
+							 "<Binding>urn:liberty:paos:2006-08</Binding>"
+							 "<PathSecurity-Protocol>urn:ietf:rfc:4279</PathSecurity-Protocol>"
+							 "<PathSecurity-Parameters><PSK>4BC1A0B5</PSK></PathSecurity-Parameters>"
+							 "</TCTokenType>";
+
+
+QString createElement(const QString& pName, const QString& pValue)
+{
+	return QStringLiteral("<%1>%2</%1>").arg(pName, pValue);
+}
+
+
+QByteArray createCertificateDescription(const QUrl& pSubjectUrl)
+{
+	QByteArray description;
+	description += TlvHelper::encode(0x06, ID_PLAIN_FORMAT);
+	description += TlvHelper::encode(0xA1, TlvHelper::encode(0x0C, QByteArrayLiteral("Governikus GmbH & Co. KG")));
+	description += TlvHelper::encode(0xA3, TlvHelper::encode(0x0C, QByteArrayLiteral("MockEidServer")));
+	description += TlvHelper::encode(0xA4, TlvHelper::encode(0x13, pSubjectUrl.toString().toLatin1()));
+	description += TlvHelper::encode(0xA5, TlvHelper::encode(0x0C, QByteArrayLiteral("Benchmark of the self authentication")));
+	return TlvHelper::encode(0x30, description);
+}
+
+
+QUrl createRefreshUrl(const QUrl& pTcTokenUrl)
+{
+	QUrl url(pTcTokenUrl);
+	url.setScheme(QStringLiteral("http"));
+	return url;
+}
+
+
+/*!
+ * Collects the text of all elements by their local name. Elements
+ * without text are contained with an empty value.
+ */
+QMap<QString, QString> readElements(const QByteArray& pXml)
+{
+	QMap<QString, QString> elements;
+	QString name;
+
+	QXmlStreamReader reader(pXml);
+	while (!reader.atEnd())
+	{
+		reader.readNext();
+		if (reader.isStartElement())
+		{
+			name = reader.name().toString();
+			elements.insert(name, QString());
+		}
+		else if (reader.isCharacters() && !reader.isWhitespace())
+		{
+			elements.insert(name, reader.text().toString().trimmed());
+		}
+	}
+
+	if (reader.hasError())
+	{
+		qCritical() << "Cannot parse message:" << reader.errorString();
+	}
+	return elements;
+}
+
+
+} // namespace
+
+
+MockEidServerNetworkManager::MockEidServerNetworkManager(const QUrl& pTcTokenUrl)
+	: NetworkManager()
+	, mTcTokenUrl(pTcTokenUrl)
+	, mRefreshUrl(createRefreshUrl(pTcTokenUrl))
+	, mCertificateDescription(createCertificateDescription(pTcTokenUrl.adjusted(QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment)))
+	, mServer(mCertificateDescription)
+	, mChipAuthenticationPublicKey()
+	, mCommands()
+	, mDataGroups()
+{
+}
+
+
+MockEidServerNetworkManager::~MockEidServerNetworkManager()
+{
+}
+
+
+QNetworkReply* MockEidServerNetworkManager::createReply(const QNetworkRequest& pRequest, const QByteArray& pData, HttpStatusCode pStatusCode) const
+{
+	auto* const reply = new MockNetworkReply(pData, pStatusCode);
+	reply->setRequest(pRequest);
+
+	// Like a real reply, finish after the caller connected to the signals
+	QTimer::singleShot(0, reply, [reply] {
+				reply->fireFinished();
+			});
+	return reply;
+}
+
+
+QByteArray MockEidServerNetworkManager::createEnvelope(const QString& pRelatesTo, const QString& pBody) const
+{
+	const QString messageId = QStringLiteral("urn:uuid:") + QUuid::createUuid().toString().remove(QLatin1Char('{')).remove(QLatin1Char('}'));
+	return QString::fromLatin1(ENVELOPE).arg(messageId, pRelatesTo, pBody).toUtf8();
+}
+
+
+QString MockEidServerNetworkManager::createDidAuthenticateEac1() const
+{
+	QString data;
+	for (const auto& certificate : mServer.getCertificateChain())
+	{
+		data += createElement(QStringLiteral("Certificate"), QString::fromLatin1(certificate->encode().toHex()));
+	}
+	data += createElement(QStringLiteral("CertificateDescription"), QString::fromLatin1(mCertificateDescription.toHex()));
+	data += createElement(QStringLiteral("RequiredCHAT"), QString::fromLatin1(mServer.getChat().toHex()));
+	return QString::fromLatin1(DID_AUTHENTICATE).arg(QStringLiteral("EAC1InputType"), data);
+}
+
+
+QString MockEidServerNetworkManager::createDidAuthenticateEac2(const QMap<QString, QString>& pElements) const
+{
+	const QByteArray idIcc = QByteArray::fromHex(pElements.value(QStringLiteral("IDPICC")).toLatin1());
+	const QByteArray challenge = QByteArray::fromHex(pElements.value(QStringLiteral("Challenge")).toLatin1());
+
+	QString data;
+	data += createElement(QStringLiteral("EphemeralPublicKey"), mServer.getEphemeralPublicKeyAsHex());
+	data += createElement(QStringLiteral("Signature"), mServer.createSignatureAsHex(idIcc, challenge));
+	return QString::fromLatin1(DID_AUTHENTICATE).arg(QStringLiteral("EAC2InputType"), data);
+}
+
+
+QString MockEidServerNetworkManager::createTransmit()
+{
+	Q_ASSERT(!mCommands.isEmpty());
+
+	const CommandApdu command = mServer.encrypt(mCommands.first().second);
+	return QString::fromLatin1(TRANSMIT).arg(QString::fromLatin1(command.getBuffer().toHex()));
+}
+
+
+QString MockEidServerNetworkManager::createStartPaosResponse(bool pOk) const
+{
+	const QString result = pOk
+			? createElement(QStringLiteral("ResultMajor"), QStringLiteral("http://www.bsi.bund.de/ecard/api/1.1/resultmajor#ok"))
+			: createElement(QStringLiteral("ResultMajor"), QStringLiteral("http://www.bsi.bund.de/ecard/api/1.1/resultmajor#error"))
+			+ createElement(QStringLiteral("ResultMinor"), QStringLiteral("http://www.bsi.bund.de/ecard/api/1.1/resultminor/al/common#internalError"));
+	return QString::fromLatin1(START_PAOS_RESPONSE).arg(result);
+}
+
+
+QString MockEidServerNetworkManager::processChipAuthentication(const QMap<QString, QString>& pElements)
+{
+	const QByteArray nonce = QByteArray::fromHex(pElements.value(QStringLiteral("Nonce")).toLatin1());
+	const QByteArray authenticationToken = QByteArray::fromHex(pElements.value(QStringLiteral("AuthenticationToken")).toLatin1());
+	if (!mServer.verifyChipAuthentication(mChipAuthenticationPublicKey, nonce, authenticationToken))
+	{
+		qCritical() << "Chip Authentication failed";
+		return createStartPaosResponse(false);
+	}
+
+	mCommands.clear();
+	for (int dataGroup : {1, 4, 5})
+	{
+		for (const auto& command : MockEidServer::createReadDataGroupCommands(dataGroup))
+		{
+			mCommands += qMakePair(dataGroup, command);
+		}
+	}
+	return createTransmit();
+}
+
+
+QString MockEidServerNetworkManager::processTransmitResponse(const QMap<QString, QString>& pElements)
+{
+	Q_ASSERT(!mCommands.isEmpty());
+
+	const int dataGroup = mCommands.takeFirst().first;
+	ResponseApdu response;
+	if (!mServer.decrypt(ResponseApdu(QByteArray::fromHex(pElements.value(QStringLiteral("OutputAPDU")).toLatin1())), response)
+			|| (response.getReturnCode() != StatusCode::SUCCESS && response.getReturnCode() != StatusCode::END_OF_FILE))
+	{
+		qCritical() << "Cannot read data group" << dataGroup;
+		return createStartPaosResponse(false);
+	}
+
+	// The selection of the application precedes the reading of every data group
+	mDataGroups.insert(dataGroup, response.getData());
+	return mCommands.isEmpty() ? createStartPaosResponse(true) : createTransmit();
+}
+
+
+QNetworkReply* MockEidServerNetworkManager::paos(QNetworkRequest& pRequest,
+		const QByteArray& pNamespace,
+		const QByteArray& pData,
+		bool pUsePsk,
+		const QByteArray& pSslSession,
+		int pTimeoutInMilliSeconds)
+{
+	Q_UNUSED(pNamespace);
+	Q_UNUSED(pUsePsk);
+	Q_UNUSED(pSslSession);
+	Q_UNUSED(pTimeoutInMilliSeconds);
+
+	const auto& elements = readElements(pData);
+	const QString resultMajor = elements.value(QStringLiteral("ResultMajor"));
+
+	QString body;
+	if (elements.contains(QStringLiteral("StartPAOS")))
+	{
+		body = createDidAuthenticateEac1();
+	}
+	else if (!resultMajor.endsWith(QLatin1String("#ok")))
+	{
+		qCritical() << "Client reports error:" << resultMajor << elements.value(QStringLiteral("ResultMinor"));
+		body = createStartPaosResponse(false);
+	}
+	else if (elements.contains(QStringLiteral("TransmitResponse")))
+	{
+		body = processTransmitResponse(elements);
+	}
+	else if (elements.contains(QStringLiteral("AuthenticationToken")))
+	{
+		body = processChipAuthentication(elements);
+	}
+	else if (elements.contains(QStringLiteral("Challenge")))
+	{
+		body = createDidAuthenticateEac2(elements);
+	}
+	else
+	{
+		qCritical() << "Unexpected message:" << pData;
+		body = createStartPaosResponse(false);
+	}
+
+	return createReply(pRequest, createEnvelope(elements.value(QStringLiteral("MessageID")), body), HttpStatusCode::OK);
+}
+
+
+QNetworkReply* MockEidServerNetworkManager::get(QNetworkRequest& pRequest,
+		const QByteArray& pSslSession,
+		int pTimeoutInMilliSeconds)
+{
+	Q_UNUSED(pSslSession);
+	Q_UNUSED(pTimeoutInMilliSeconds);
+
+	if (pRequest.url() == mTcTokenUrl)
+	{
+		mCommands.clear();
+		mDataGroups.clear();
+		return createReply(pRequest, QString::fromLatin1(TC_TOKEN).arg(mRefreshUrl.toString().toHtmlEscaped()).toUtf8(), HttpStatusCode::OK);
+	}
+
+	if (pRequest.url() == mRefreshUrl)
+	{
+		return createReply(pRequest, TestFileHelper::readFile(QStringLiteral(":/self/SelfAuthenticationData.xml")), HttpStatusCode::OK);
+	}
+
+	qCritical() << "Unexpected request:" << pRequest.url();
+	return createReply(pRequest, QByteArray(), HttpStatusCode::NOT_FOUND);
+}
+
+
+void MockEidServerNetworkManager::setChipAuthenticationPublicKey(const QByteArray& pPublicKey)
+{
+	mChipAuthenticationPublicKey = pPublicKey;
+}
+
+
+const QSharedPointer<const CVCertificate>& MockEidServerNetworkManager::getTrustPoint() const
+{
+	return mServer.getTrustPoint();
+}
+
+
+const QMap<int, QByteArray>& MockEidServerNetworkManager::getDataGroups() const
+{
+	return mDataGroups;
+}
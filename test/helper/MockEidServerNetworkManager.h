@@ -0,0 +1,89 @@
+/*!
+ * \brief Mock \ref NetworkManager that plays the service provider and the
+ * eID server of a self authentication with \ref MockEidServer.
+ *
+ * A GET request of the TcToken URL is answered with a TcToken and starts
+ * a new session. The server answers StartPAOS with
+ * DIDAuthenticate EAC1 and the response with DIDAuthenticate EAC2. After
+ * Chip Authentication it reads the data groups 1, 4 and 5 with one Transmit
+ * per command and finishes with StartPAOSResponse.
+ *
+ * The subject URL of the certificate description is the origin of the
+ * TcToken URL. The refresh address of the TcToken is the TcToken URL with
+ * the http scheme and a GET request of it is answered with the data of the
+ * self authentication. As the replies never pass a TLS handshake, the developer
+ * mode is needed to accept the refresh address without a server certificate.
+ *
+ * EF.CardSecurity of \ref MockEidCard does not contain the key of Chip
+ * Authentication, so it has to be set with setChipAuthenticationPublicKey().
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "MockEidServer.h"
+#include "HttpStatusCode.h"
+#include "NetworkManager.h"
+
+#include <QByteArray>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+namespace governikus
+{
+
+class MockEidServerNetworkManager
+	: public NetworkManager
+{
+	Q_OBJECT
+
+	private:
+		const QUrl mTcTokenUrl;
+		const QUrl mRefreshUrl;
+		const QByteArray mCertificateDescription;
+		MockEidServer mServer;
+		QByteArray mChipAuthenticationPublicKey;
+		QVector<QPair<int, CommandApdu> > mCommands;
+		QMap<int, QByteArray> mDataGroups;
+
+		QNetworkReply* createReply(const QNetworkRequest& pRequest, const QByteArray& pData, HttpStatusCode pStatusCode) const;
+		QByteArray createEnvelope(const QString& pRelatesTo, const QString& pBody) const;
+		QString createDidAuthenticateEac1() const;
+		QString createDidAuthenticateEac2(const QMap<QString, QString>& pElements) const;
+		QString createTransmit();
+		QString createStartPaosResponse(bool pOk) const;
+		QString processChipAuthentication(const QMap<QString, QString>& pElements);
+		QString processTransmitResponse(const QMap<QString, QString>& pElements);
+
+	public:
+		explicit MockEidServerNetworkManager(const QUrl& pTcTokenUrl);
+		virtual ~MockEidServerNetworkManager() override;
+
+		virtual QNetworkReply* paos(QNetworkRequest& pRequest,
+				const QByteArray& pNamespace,
+				const QByteArray& pData,
+				bool pUsePsk = true,
+				const QByteArray& pSslSession = QByteArray(),
+				int pTimeoutInMilliSeconds = 30000) override;
+		virtual QNetworkReply* get(QNetworkRequest& pRequest,
+				const QByteArray& pSslSession = QByteArray(),
+				int pTimeoutInMilliSeconds = 30000) override;
+
+		void setChipAuthenticationPublicKey(const QByteArray& pPublicKey);
+
+		/*!
+		 * The trust point of the server to be stored in \ref MockEidCard.
+		 */
+		const QSharedPointer<const CVCertificate>& getTrustPoint() const;
+
+		/*!
+		 * The data groups read in the current session.
+		 */
+		const QMap<int, QByteArray>& getDataGroups() const;
+};
+
+} /* namespace governikus */
@@ -14,7 +14,7 @@ using namespace governikus;
 MockNetworkManager::MockNetworkManager()
 	: mNextReply(nullptr)
 	, mLastReply(nullptr)
-	, mLastRequest(nullptr)
+	, mLastRequest()
 {
 }
 
@@ -65,7 +65,7 @@ QNetworkReply* MockNetworkManager::get(QNetworkRequest& pRequest,
 	Q_UNUSED(pSslSession);
 	Q_UNUSED(pTimeoutInMilliSeconds);
 
-	mLastRequest = &pRequest;
+	mLastRequest.reset(new QNetworkRequest(pRequest));
 
 	return getReply(pRequest);
 }
@@ -9,6 +9,8 @@
 #include "MockNetworkReply.h"
 #include "NetworkManager.h"
 
+#include <QSharedPointer>
+
 namespace governikus
 {
 
@@ -21,7 +23,7 @@ class MockNetworkManager
 		QString mFilename;
 		MockNetworkReply* mNextReply;
 		MockNetworkReply* mLastReply;
-		QNetworkRequest* mLastRequest;
+		QSharedPointer<QNetworkRequest> mLastRequest;
 
 		MockNetworkReply* getReply(const QNetworkRequest& pRequest);
 
@@ -61,7 +63,7 @@ class MockNetworkManager
 
 		QNetworkRequest* getLastRequest() const
 		{
-			return mLastRequest;
+			return mLastRequest.data();
 		}
 
 
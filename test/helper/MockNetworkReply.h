@@ -57,6 +57,12 @@ class MockNetworkReply
 		}
 
 
+		void setResponseHeader(const QByteArray& pHeaderName, const QByteArray& pValue)
+		{
+			setRawHeader(pHeaderName, pValue);
+		}
+
+
 };
 
 } /* namespace governikus */
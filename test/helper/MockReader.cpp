@@ -45,14 +45,21 @@ MockReader::~MockReader()
 
 MockCard* MockReader::setCard(const MockCardConfig& pCardConfig, const QByteArray& pEfCardAccess)
 {
-	setCard(pCardConfig, EFCardAccess::decode(pEfCardAccess));
-	return mCard.data();
+	return setCard(pCardConfig, EFCardAccess::decode(pEfCardAccess));
 }
 
 
 MockCard* MockReader::setCard(const MockCardConfig& pCardConfig, const QSharedPointer<EFCardAccess>& pEfCardAccess)
 {
-	mCard.reset(new MockCard(pCardConfig));
+	auto* const card = new MockCard(pCardConfig);
+	mCard.reset(card);
 	mReaderInfo.setCardInfo(CardInfo(CardType::EID_CARD, pEfCardAccess));
-	return mCard.data();
+	return card;
+}
+
+
+void MockReader::insertCard(Card* pCard)
+{
+	mCard.reset(pCard);
+	mReaderInfo.setCardInfo(CardInfo(CardType::UNKNOWN));
 }
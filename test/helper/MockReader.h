@@ -20,7 +20,7 @@ class MockReader
 {
 	Q_OBJECT
 
-	QScopedPointer<MockCard> mCard;
+	QScopedPointer<Card> mCard;
 
 	public:
 		static MockReader* createMockReader(const QVector<TransmitConfig>& pTransmitConfig = QVector<TransmitConfig>(), const QByteArray& pEfCardAccess = QByteArray());
@@ -46,6 +46,11 @@ class MockReader
 		MockCard* setCard(const MockCardConfig& pCardConfig, const QByteArray& pEfCardAccess);
 		MockCard* setCard(const MockCardConfig& pCardConfig, const QSharedPointer<EFCardAccess>& pEfCardAccess = QSharedPointer<EFCardAccess>());
 
+		/*!
+		 * Takes ownership of the card. The card info has to be determined by CardInfoFactory.
+		 */
+		void insertCard(Card* pCard);
+
 		ReaderInfo& getReaderInfo()
 		{
 			return mReaderInfo;
@@ -0,0 +1,138 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "MockSecureMessaging.h"
+
+#include "TlvHelper.h"
+
+#include <QtEndian>
+
+using namespace governikus;
+
+
+namespace
+{
+const int TAG_ENCRYPTED_DATA = 0x87;
+const int TAG_PROTECTED_LE = 0x97;
+const int TAG_PROCESSING_STATUS = 0x99;
+const int TAG_CHECKSUM = 0x8E;
+const char PADDING_INDICATOR = 0x01;
+}
+
+
+MockSecureMessaging::MockSecureMessaging(const KnownOIDs::ProtocolDescriptor* pProtocol, const QByteArray& pEncKey, const QByteArray& pMacKey)
+	: mCipher(pProtocol, pEncKey)
+	, mCipherMac(pProtocol, pMacKey)
+	, mSendSequenceCounter(0)
+{
+}
+
+
+QByteArray MockSecureMessaging::pad(const QByteArray& pData) const
+{
+	const int paddingSize = mCipher.getBlockSize() - pData.size() % mCipher.getBlockSize();
+	return pData + char(0x80) + QByteArray(paddingSize - 1, 0x00);
+}
+
+
+QByteArray MockSecureMessaging::unpad(const QByteArray& pData) const
+{
+	const int position = pData.lastIndexOf(char(0x80));
+	return position == -1 ? QByteArray() : pData.left(position);
+}
+
+
+QByteArray MockSecureMessaging::getSendSequenceCounter() const
+{
+	char converted[sizeof(mSendSequenceCounter)];
+	qToBigEndian(mSendSequenceCounter, converted);
+	return QByteArray(mCipher.getBlockSize() - static_cast<int>(sizeof(converted)), 0x00) + QByteArray(converted, sizeof(converted));
+}
+
+
+QByteArray MockSecureMessaging::getEncryptedIv()
+{
+	mCipher.setIv(QByteArray(mCipher.getBlockSize(), 0x00));
+	return mCipher.encrypt(getSendSequenceCounter());
+}
+
+
+QByteArray MockSecureMessaging::unwrap(const CommandApdu& pSecuredCommand)
+{
+	++mSendSequenceCounter;
+
+	const auto& objects = TlvHelper::decode(pSecuredCommand.getData());
+	if (!objects.contains(TAG_CHECKSUM))
+	{
+		return QByteArray();
+	}
+
+	QByteArray encryptedData;
+	if (objects.contains(TAG_ENCRYPTED_DATA))
+	{
+		encryptedData = TlvHelper::encode(TAG_ENCRYPTED_DATA, objects.value(TAG_ENCRYPTED_DATA));
+	}
+	QByteArray protectedLe;
+	if (objects.contains(TAG_PROTECTED_LE))
+	{
+		protectedLe = TlvHelper::encode(TAG_PROTECTED_LE, objects.value(TAG_PROTECTED_LE));
+	}
+
+	const QByteArray header = pSecuredCommand.getBuffer().left(4);
+	QByteArray dataToMac = pad(header) + encryptedData + protectedLe;
+	if (!encryptedData.isEmpty() || !protectedLe.isEmpty())
+	{
+		dataToMac = pad(dataToMac);
+	}
+	if (mCipherMac.generate(getSendSequenceCounter() + dataToMac) != objects.value(TAG_CHECKSUM))
+	{
+		return QByteArray();
+	}
+
+	QByteArray data;
+	if (!encryptedData.isEmpty())
+	{
+		const QByteArray& cryptogram = objects.value(TAG_ENCRYPTED_DATA);
+		if (cryptogram.isEmpty() || cryptogram.at(0) != PADDING_INDICATOR)
+		{
+			return QByteArray();
+		}
+		mCipher.setIv(getEncryptedIv());
+		data = unpad(mCipher.decrypt(cryptogram.mid(1)));
+	}
+
+	int le = CommandApdu::NO_LE;
+	const QByteArray& leBytes = objects.value(TAG_PROTECTED_LE);
+	for (char byte : leBytes)
+	{
+		le = (le << 8) | static_cast<uchar>(byte);
+	}
+	if (!leBytes.isEmpty() && le == 0)
+	{
+		le = leBytes.size() == 1 ? CommandApdu::SHORT_MAX_LE : CommandApdu::EXTENDED_MAX_LE;
+	}
+
+	const char cla = static_cast<char>(header.at(0) & ~CommandApdu::CLA_SECURE_MESSAGING);
+	return CommandApdu(cla, header.at(1), header.at(2), header.at(3), data, le).getBuffer();
+}
+
+
+ResponseApdu MockSecureMessaging::wrap(const ResponseApdu& pResponse)
+{
+	++mSendSequenceCounter;
+
+	const QByteArray statusCode = pResponse.getBuffer().right(2);
+	const QByteArray data = pResponse.getData();
+
+	QByteArray encryptedData;
+	if (!data.isEmpty())
+	{
+		mCipher.setIv(getEncryptedIv());
+		encryptedData = TlvHelper::encode(TAG_ENCRYPTED_DATA, PADDING_INDICATOR + mCipher.encrypt(pad(data)));
+	}
+	const QByteArray processingStatus = TlvHelper::encode(TAG_PROCESSING_STATUS, statusCode);
+
+	const QByteArray mac = mCipherMac.generate(getSendSequenceCounter() + pad(encryptedData + processingStatus));
+	return ResponseApdu(encryptedData + processingStatus + TlvHelper::encode(TAG_CHECKSUM, mac) + statusCode);
+}
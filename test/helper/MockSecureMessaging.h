@@ -0,0 +1,46 @@
+/*!
+ * \brief Card side of the secure messaging of \ref SecureMessaging.
+ *
+ * Commands protected by the terminal are verified and decrypted, responses
+ * are encrypted and protected for the terminal, see TR-03110-3, F.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "Apdu.h"
+#include "pace/CipherMac.h"
+#include "pace/SymmetricCipher.h"
+
+#include <QByteArray>
+
+namespace governikus
+{
+
+class MockSecureMessaging
+{
+	private:
+		SymmetricCipher mCipher;
+		CipherMac mCipherMac;
+		quint32 mSendSequenceCounter;
+
+		QByteArray pad(const QByteArray& pData) const;
+		QByteArray unpad(const QByteArray& pData) const;
+		QByteArray getSendSequenceCounter() const;
+		QByteArray getEncryptedIv();
+
+		Q_DISABLE_COPY(MockSecureMessaging)
+
+	public:
+		MockSecureMessaging(const KnownOIDs::ProtocolDescriptor* pProtocol, const QByteArray& pEncKey, const QByteArray& pMacKey);
+
+		/*!
+		 * Returns the plain command or an empty buffer, if the MAC is wrong
+		 * or the data objects are malformed.
+		 */
+		QByteArray unwrap(const CommandApdu& pSecuredCommand);
+		ResponseApdu wrap(const ResponseApdu& pResponse);
+};
+
+} /* namespace governikus */
@@ -0,0 +1,96 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "ReplayCard.h"
+
+#include <QLoggingCategory>
+#include <QThread>
+
+using namespace governikus;
+
+Q_DECLARE_LOGGING_CATEGORY(card)
+
+
+ReplayCard::ReplayCard(const QVector<ApduRecord>& pRecords)
+	: mConnected(false)
+	, mRecords(pRecords)
+	, mPosition(0)
+	, mLatencyFactor(0.0)
+	, mMismatchCount(0)
+{
+}
+
+
+ReplayCard::~ReplayCard()
+{
+}
+
+
+CardReturnCode ReplayCard::connect()
+{
+	mConnected = true;
+	return CardReturnCode::OK;
+}
+
+
+CardReturnCode ReplayCard::disconnect()
+{
+	mConnected = false;
+	return CardReturnCode::OK;
+}
+
+
+bool ReplayCard::isConnected()
+{
+	return mConnected;
+}
+
+
+CardReturnCode ReplayCard::transmit(const CommandApdu& pCmd, ResponseApdu& pRes)
+{
+	if (isFinished())
+	{
+		qCWarning(card) << "Recording exhausted after" << mPosition << "commands";
+		return CardReturnCode::COMMAND_FAILED;
+	}
+
+	const ApduRecord& record = mRecords.at(mPosition++);
+	if (record.getCommand() != pCmd.getBuffer())
+	{
+		qCDebug(card) << "Command" << mPosition << "differs from recording:" << pCmd.getBuffer().toHex() << "|" << record.getCommand().toHex();
+		++mMismatchCount;
+	}
+
+	if (mLatencyFactor > 0.0)
+	{
+		QThread::usleep(static_cast<unsigned long>(record.getDuration() * mLatencyFactor));
+	}
+
+	pRes.setBuffer(record.getResponse());
+	return record.getReturnCode();
+}
+
+
+void ReplayCard::setLatencyFactor(double pFactor)
+{
+	mLatencyFactor = pFactor;
+}
+
+
+int ReplayCard::getPosition() const
+{
+	return mPosition;
+}
+
+
+int ReplayCard::getMismatchCount() const
+{
+	return mMismatchCount;
+}
+
+
+bool ReplayCard::isFinished() const
+{
+	return mPosition >= mRecords.size();
+}
@@ -0,0 +1,55 @@
+/*!
+ * \brief Card that answers from an APDU recording of \ref ApduRecorder.
+ *
+ * The recorded responses are returned in the order of the recording. A
+ * command that differs from the recorded one is answered anyway and counted
+ * as mismatch. Sessions with secure messaging use fresh keys on every run,
+ * so their recordings only replay the timing of the card, not a valid
+ * protocol run.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "ApduRecorder.h"
+#include "Card.h"
+
+#include <QVector>
+
+namespace governikus
+{
+
+class ReplayCard
+	: public Card
+{
+	Q_OBJECT
+
+	private:
+		bool mConnected;
+		const QVector<ApduRecord> mRecords;
+		int mPosition;
+		double mLatencyFactor;
+		int mMismatchCount;
+
+	public:
+		ReplayCard(const QVector<ApduRecord>& pRecords);
+		virtual ~ReplayCard() override;
+
+		CardReturnCode connect() override;
+		CardReturnCode disconnect() override;
+		bool isConnected() override;
+		CardReturnCode transmit(const CommandApdu& pCmd, ResponseApdu& pRes) override;
+
+		/*!
+		 * Every transmit is delayed by the recorded duration multiplied
+		 * with the factor. A factor of 0 answers immediately.
+		 */
+		void setLatencyFactor(double pFactor);
+
+		int getPosition() const;
+		int getMismatchCount() const;
+		bool isFinished() const;
+};
+
+} /* namespace governikus */
@@ -0,0 +1,60 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "ReplayReader.h"
+
+#include "CardConnectionWorker.h"
+
+using namespace governikus;
+
+
+ReplayReader::ReplayReader(const QString& pReaderName)
+	: Reader(ReaderManagerPlugInType::UNKNOWN, pReaderName)
+	, mCard()
+{
+	mReaderInfo.setBasicReader(true);
+	mReaderInfo.setConnected(true);
+}
+
+
+ReplayReader::~ReplayReader()
+{
+}
+
+
+Card* ReplayReader::getCard() const
+{
+	return mCard.data();
+}
+
+
+ReplayCard* ReplayReader::insertCard(const QVector<ApduRecord>& pRecords, double pLatencyFactor)
+{
+	auto* const card = new ReplayCard(pRecords);
+	card->setLatencyFactor(pLatencyFactor);
+	mCard.reset(card);
+
+	QSharedPointer<CardConnectionWorker> cardConnection = createCardConnectionWorker();
+	CardInfoFactory::create(cardConnection, mReaderInfo);
+
+	Q_EMIT fireCardInserted(getName());
+	return card;
+}
+
+
+ReplayCard* ReplayReader::insertCard(const QString& pFilename, double pLatencyFactor)
+{
+	return insertCard(ApduRecorder::load(pFilename), pLatencyFactor);
+}
+
+
+void ReplayReader::removeCard()
+{
+	if (mCard)
+	{
+		mCard.reset();
+		mReaderInfo.setCardInfo(CardInfo(CardType::NONE));
+		Q_EMIT fireCardRemoved(getName());
+	}
+}
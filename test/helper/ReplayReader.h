@@ -0,0 +1,48 @@
+/*!
+ * \brief Reader with a \ref ReplayCard for headless benchmarks of workflows.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "Reader.h"
+#include "ReplayCard.h"
+
+#include <QScopedPointer>
+
+
+namespace governikus
+{
+
+class ReplayReader
+	: public Reader
+{
+	Q_OBJECT
+
+	private:
+		QScopedPointer<ReplayCard, QScopedPointerDeleteLater> mCard;
+
+		virtual CardEvent updateCard() override
+		{
+			return CardEvent::NONE;
+		}
+
+
+	public:
+		ReplayReader(const QString& pReaderName = QStringLiteral("ReplayReader"));
+		virtual ~ReplayReader() override;
+
+		virtual Card* getCard() const override;
+
+		/*!
+		 * Inserts a card that answers from the given recording. The card is
+		 * recognized like a real one, so the recording has to start with the
+		 * commands of the card recognition.
+		 */
+		ReplayCard* insertCard(const QVector<ApduRecord>& pRecords, double pLatencyFactor = 0.0);
+		ReplayCard* insertCard(const QString& pFilename, double pLatencyFactor = 0.0);
+		void removeCard();
+};
+
+} /* namespace governikus */
@@ -0,0 +1,72 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "ReplayReaderManagerPlugIn.h"
+
+using namespace governikus;
+
+
+ReplayReaderManagerPlugIn* ReplayReaderManagerPlugIn::mInstance = nullptr;
+
+
+ReplayReaderManagerPlugIn::ReplayReaderManagerPlugIn()
+	: ReaderManagerPlugIn(ReaderManagerPlugInType::UNKNOWN, true)
+	, mReaders()
+{
+	mInstance = this;
+}
+
+
+ReplayReaderManagerPlugIn::~ReplayReaderManagerPlugIn()
+{
+	qDeleteAll(mReaders);
+	mInstance = nullptr;
+}
+
+
+ReplayReaderManagerPlugIn& ReplayReaderManagerPlugIn::getInstance()
+{
+	if (!mInstance)
+	{
+		qFatal("ReplayReaderManagerPlugIn not yet instantiated");
+	}
+	return *mInstance;
+}
+
+
+QList<Reader*> ReplayReaderManagerPlugIn::getReaders() const
+{
+	QList<Reader*> readers;
+	readers.reserve(mReaders.size());
+	for (ReplayReader* reader : mReaders)
+	{
+		readers += reader;
+	}
+	return readers;
+}
+
+
+ReplayReader* ReplayReaderManagerPlugIn::addReader(const QString& pReaderName)
+{
+	auto reader = new ReplayReader(pReaderName);
+
+	connect(reader, &Reader::fireCardInserted, this, &ReaderManagerPlugIn::fireCardInserted);
+	connect(reader, &Reader::fireCardRemoved, this, &ReaderManagerPlugIn::fireCardRemoved);
+	connect(reader, &Reader::fireCardRetryCounterChanged, this, &ReaderManagerPlugIn::fireCardRetryCounterChanged);
+
+	mReaders.insert(pReaderName, reader);
+	Q_EMIT fireReaderAdded(pReaderName);
+
+	return reader;
+}
+
+
+void ReplayReaderManagerPlugIn::removeReader(const QString& pReaderName)
+{
+	if (auto reader = mReaders.take(pReaderName))
+	{
+		Q_EMIT fireReaderRemoved(reader->getName());
+		delete reader;
+	}
+}
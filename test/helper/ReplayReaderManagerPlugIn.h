@@ -0,0 +1,43 @@
+/*!
+ * \brief Implementation of \ref ReaderManagerPlugIn with readers that answer from APDU recordings.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include "ReaderManagerPlugIn.h"
+#include "ReplayReader.h"
+
+#include <QMap>
+#include <QString>
+
+
+namespace governikus
+{
+
+class ReplayReaderManagerPlugIn
+	: public ReaderManagerPlugIn
+{
+	Q_OBJECT
+	Q_PLUGIN_METADATA(IID "governikus.ReaderManagerPlugIn" FILE "ReplayReaderManagerPlugIn.metadata.json")
+	Q_INTERFACES(governikus::ReaderManagerPlugIn)
+
+	private:
+		static ReplayReaderManagerPlugIn* mInstance;
+		QMap<QString, ReplayReader*> mReaders;
+
+	public:
+		ReplayReaderManagerPlugIn();
+		virtual ~ReplayReaderManagerPlugIn() override;
+
+		static ReplayReaderManagerPlugIn& getInstance();
+
+		virtual QList<Reader*> getReaders() const override;
+
+		ReplayReader* addReader(const QString& pReaderName);
+		void removeReader(const QString& pReaderName);
+};
+
+
+} /* namespace governikus */
@@ -0,0 +1,81 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "TlvHelper.h"
+
+using namespace governikus;
+
+
+QByteArray TlvHelper::encode(int pTag, const QByteArray& pValue)
+{
+	QByteArray buffer;
+	if (pTag > 0xff)
+	{
+		buffer += static_cast<char>(pTag >> 8);
+	}
+	buffer += static_cast<char>(pTag & 0xff);
+
+	const int length = pValue.size();
+	if (length > 0xff)
+	{
+		buffer += char(0x82);
+		buffer += static_cast<char>(length >> 8);
+	}
+	else if (length > 0x7f)
+	{
+		buffer += char(0x81);
+	}
+	buffer += static_cast<char>(length & 0xff);
+
+	return buffer + pValue;
+}
+
+
+QMap<int, QByteArray> TlvHelper::decode(const QByteArray& pData)
+{
+	QMap<int, QByteArray> objects;
+
+	int pos = 0;
+	while (pos < pData.size())
+	{
+		int tag = static_cast<uchar>(pData.at(pos++));
+		if ((tag & 0x1f) == 0x1f)
+		{
+			if (pos >= pData.size())
+			{
+				return QMap<int, QByteArray>();
+			}
+			tag = (tag << 8) | static_cast<uchar>(pData.at(pos++));
+		}
+
+		if (pos >= pData.size())
+		{
+			return QMap<int, QByteArray>();
+		}
+		int length = static_cast<uchar>(pData.at(pos++));
+		if (length & 0x80)
+		{
+			const int lengthSize = length & 0x7f;
+			if (lengthSize == 0 || lengthSize > 2 || pos + lengthSize > pData.size())
+			{
+				return QMap<int, QByteArray>();
+			}
+
+			length = 0;
+			for (int i = 0; i < lengthSize; ++i)
+			{
+				length = (length << 8) | static_cast<uchar>(pData.at(pos++));
+			}
+		}
+
+		if (pos + length > pData.size())
+		{
+			return QMap<int, QByteArray>();
+		}
+		objects.insert(tag, pData.mid(pos, length));
+		pos += length;
+	}
+
+	return objects;
+}
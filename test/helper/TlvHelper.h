@@ -0,0 +1,30 @@
+/*!
+ * \brief Helper to encode and decode BER-TLV data objects of card commands.
+ *
+ * Tags are handled as integer of their raw bytes, e.g. 0x87 or 0x7F49.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QMap>
+
+namespace governikus
+{
+
+class TlvHelper
+{
+	public:
+		static QByteArray encode(int pTag, const QByteArray& pValue);
+
+		/*!
+		 * Decodes the data objects of one level. Nested objects stay encoded
+		 * in the value of their parent. Returns an empty map, if the data is
+		 * malformed.
+		 */
+		static QMap<int, QByteArray> decode(const QByteArray& pData);
+};
+
+} /* namespace governikus */
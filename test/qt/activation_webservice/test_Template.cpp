@@ -80,6 +80,56 @@ class test_Template
 		}
 
 
+		void parseKeys()
+		{
+			Template tplt(QStringLiteral("${A${B}} $${C} ${} ${D"));
+			QCOMPARE(tplt.getContextKeys(), QSet<QString>({QStringLiteral("B"), QStringLiteral("C"), QString()}));
+
+			tplt.setContextParameter(QStringLiteral("B"), QStringLiteral("x"));
+			tplt.setContextParameter(QStringLiteral("C"), QStringLiteral("y"));
+			tplt.setContextParameter(QString(), QStringLiteral("z"));
+			QCOMPARE(tplt.render(), QLatin1String("${Ax} $y z ${D"));
+		}
+
+
+		void renderDoesNotExpandValues()
+		{
+			Template tplt(QStringLiteral("${KEY_1}|${KEY_2}"));
+
+			tplt.setContextParameter(QStringLiteral("KEY_1"), QStringLiteral("${KEY_2}"));
+			tplt.setContextParameter(QStringLiteral("KEY_2"), QStringLiteral("le"));
+			QCOMPARE(tplt.render(), QLatin1String("${KEY_2}|le"));
+		}
+
+
+		void fromFileIsParsedOnce()
+		{
+			Template first = Template::fromFile(QStringLiteral(":/html_templates/error.html"));
+			first.setContextParameter(QStringLiteral("TITLE"), QStringLiteral("first"));
+
+			// Context parameters of one copy do not leak into the cached template
+			const Template second = Template::fromFile(QStringLiteral(":/html_templates/error.html"));
+			QCOMPARE(second.getContextKeys(), first.getContextKeys());
+			QVERIFY(first.render().contains(QLatin1String("first")));
+			QVERIFY(!second.render().contains(QLatin1String("first")));
+		}
+
+
+		void benchmarkRenderErrorPage()
+		{
+			QBENCHMARK
+			{
+				Template tplt = Template::fromFile(QStringLiteral(":/html_templates/error.html"));
+				const auto& keys = tplt.getContextKeys();
+				for (const auto& key : keys)
+				{
+					tplt.setContextParameter(key, key.toLower());
+				}
+				QVERIFY(!tplt.render().isEmpty());
+			}
+		}
+
+
 		void renderErrorPage()
 		{
 			QString title("test titel");
@@ -25,6 +25,23 @@ class test_WebserviceActivationHandler
 	QSharedPointer<HttpRequest> mRequest;
 	QScopedPointer<QSignalSpy> mShowUiSpy, mShowUserInfoSpy, mAuthenticationSpy;
 
+	QByteArray getBody() const
+	{
+		return mSocket->mWriteBuffer.mid(mSocket->mWriteBuffer.indexOf("\r\n\r\n") + 4);
+	}
+
+
+	QByteArray getHeaderValue(const QByteArray& pKey) const
+	{
+		const int start = mSocket->mWriteBuffer.indexOf("\r\n" + pKey + ": ");
+		if (start == -1)
+		{
+			return QByteArray();
+		}
+		const int valueStart = start + pKey.size() + 4;
+		return mSocket->mWriteBuffer.mid(valueStart, mSocket->mWriteBuffer.indexOf("\r\n", valueStart) - valueStart);
+	}
+
 	private Q_SLOTS:
 		void initTestCase()
 		{
@@ -183,7 +200,128 @@ class test_WebserviceActivationHandler
 			mRequest->mUrl = QByteArray("http://localhost:24727/eID-Client?unknownRequest");
 
 			mHandler.onNewRequest(mRequest);
-			QVERIFY(mSocket->mWriteBuffer.contains("HTTP/1.0 404 NOT FOUND"));
+			QVERIFY(mSocket->mWriteBuffer.contains("HTTP/1.1 404 NOT FOUND"));
+		}
+
+
+		void imageRequest()
+		{
+			mHandler.mResourceCache.clear();
+			mRequest->mUrl = QByteArray("/images/npa.svg");
+
+			mHandler.onNewRequest(mRequest);
+			QVERIFY(mSocket->mWriteBuffer.startsWith("HTTP/1.1 200 OK"));
+			QCOMPARE(getHeaderValue("Content-Type"), QByteArray("image/svg+xml"));
+			QVERIFY(getHeaderValue("Content-Encoding").isNull());
+			QCOMPARE(getHeaderValue("Vary"), QByteArray("Accept-Encoding"));
+			const auto& eTag = getHeaderValue("ETag");
+			QVERIFY(eTag.startsWith('"'));
+
+			QFile file(QStringLiteral(":/images/npa.svg"));
+			QVERIFY(file.open(QIODevice::ReadOnly));
+			QCOMPARE(getBody(), file.readAll());
+			QVERIFY(mHandler.mResourceCache.contains(QStringLiteral(":/images/npa.svg")));
+
+			mSocket->mWriteBuffer.clear();
+			mHandler.onNewRequest(mRequest);
+			QCOMPARE(getHeaderValue("ETag"), eTag);
+			QCOMPARE(mHandler.mResourceCache.size(), 1);
+		}
+
+
+		void imageRequest_notModified_data()
+		{
+			QTest::addColumn<QByteArray>("ifNoneMatch");
+			QTest::addColumn<bool>("notModified");
+
+			QTest::newRow("match") << QByteArray() << true;
+			QTest::newRow("list") << QByteArray("\"other\", ") << true;
+			QTest::newRow("any") << QByteArray("*") << true;
+			QTest::newRow("other") << QByteArray("\"other\"") << false;
+		}
+
+
+		void imageRequest_notModified()
+		{
+			QFETCH(QByteArray, ifNoneMatch);
+			QFETCH(bool, notModified);
+
+			mRequest->mUrl = QByteArray("/images/npa.svg");
+			mHandler.onNewRequest(mRequest);
+			const auto& eTag = getHeaderValue("ETag");
+
+			if (ifNoneMatch.isEmpty() || ifNoneMatch.endsWith(", "))
+			{
+				ifNoneMatch += eTag;
+			}
+			mSocket->mWriteBuffer.clear();
+			mRequest->mHeader.append(qMakePair(QByteArray("if-none-match"), ifNoneMatch));
+			mHandler.onNewRequest(mRequest);
+
+			if (notModified)
+			{
+				QVERIFY(mSocket->mWriteBuffer.startsWith("HTTP/1.1 304 NOT MODIFIED"));
+				QVERIFY(getBody().isEmpty());
+			}
+			else
+			{
+				QVERIFY(mSocket->mWriteBuffer.startsWith("HTTP/1.1 200 OK"));
+			}
+			QCOMPARE(getHeaderValue("ETag"), eTag);
+		}
+
+
+		void imageRequest_deflate()
+		{
+			mRequest->mUrl = QByteArray("/images/npa.svg");
+			mRequest->mHeader.append(qMakePair(QByteArray("accept-encoding"), QByteArray("gzip, deflate")));
+
+			mHandler.onNewRequest(mRequest);
+			QCOMPARE(getHeaderValue("Content-Encoding"), QByteArray("deflate"));
+
+			QFile file(QStringLiteral(":/images/npa.svg"));
+			QVERIFY(file.open(QIODevice::ReadOnly));
+			const auto& content = file.readAll();
+			QVERIFY(getBody().size() < content.size());
+
+			QByteArray compressed(4, '\0');
+			qToBigEndian(static_cast<quint32>(content.size()), compressed.data());
+			compressed += getBody();
+			QCOMPARE(qUncompress(compressed), content);
+		}
+
+
+		void imageRequest_unknown()
+		{
+			mRequest->mUrl = QByteArray("/images/unknown.png");
+
+			mHandler.onNewRequest(mRequest);
+			QVERIFY(mSocket->mWriteBuffer.startsWith("HTTP/1.1 404 NOT FOUND"));
+			QVERIFY(!mHandler.mResourceCache.contains(QStringLiteral(":/images/unknown.png")));
+		}
+
+
+		void benchmarkRequests_data()
+		{
+			QTest::addColumn<QByteArray>("url");
+
+			QTest::newRow("image") << QByteArray("/images/npa.svg");
+			QTest::newRow("status") << QByteArray("/eID-Client?status");
+			QTest::newRow("unknown") << QByteArray("/eID-Client?unknownRequest");
+		}
+
+
+		void benchmarkRequests()
+		{
+			QFETCH(QByteArray, url);
+			mRequest->mUrl = url;
+
+			QBENCHMARK
+			{
+				mSocket->mWriteBuffer.clear();
+				mHandler.onNewRequest(mRequest);
+			}
+			QVERIFY(!mSocket->mWriteBuffer.isEmpty());
 		}
 
 
@@ -191,7 +329,7 @@ class test_WebserviceActivationHandler
 		{
 			QCoreApplication::setApplicationVersion("1.0.0");
 			mRequest->mUrl = QByteArray("http://localhost:24727/eID-Client?ShowUI");
-			mRequest->mHeader.insert("user-agent", QCoreApplication::applicationName().toUtf8() + '/' + QCoreApplication::applicationVersion().toUtf8() + " (TR-03124-1/1.2)");
+			mRequest->mHeader.append(qMakePair(QByteArray("user-agent"), QCoreApplication::applicationName().toUtf8() + '/' + QCoreApplication::applicationVersion().toUtf8() + " (TR-03124-1/1.2)"));
 
 			mHandler.onNewRequest(mRequest);
 
@@ -206,7 +344,7 @@ class test_WebserviceActivationHandler
 			QSignalSpy spy(&LogHandler::getInstance(), &LogHandler::fireLog);
 			QCoreApplication::setApplicationVersion("1.0.0");
 			mRequest->mUrl = QByteArray("http://localhost:24727/eID-Client?ShowUI");
-			mRequest->mHeader.insert("user-agent", QCoreApplication::applicationName().toUtf8() + "/0.0.0 (TR-03124-1/1.2)");
+			mRequest->mHeader.append(qMakePair(QByteArray("user-agent"), QCoreApplication::applicationName().toUtf8() + "/0.0.0 (TR-03124-1/1.2)"));
 
 			mHandler.onNewRequest(mRequest);
 
@@ -226,7 +364,7 @@ class test_WebserviceActivationHandler
 			QSignalSpy spy(&LogHandler::getInstance(), &LogHandler::fireLog);
 			QCoreApplication::setApplicationVersion("1.0.0");
 			mRequest->mUrl = QByteArray("http://localhost:24727/eID-Client?ShowUI");
-			mRequest->mHeader.insert("user-agent", QCoreApplication::applicationName().toUtf8() + "/2.0.0 (TR-03124-1/1.2)");
+			mRequest->mHeader.append(qMakePair(QByteArray("user-agent"), QCoreApplication::applicationName().toUtf8() + "/2.0.0 (TR-03124-1/1.2)"));
 
 			mHandler.onNewRequest(mRequest);
 
@@ -99,6 +99,86 @@ class test_KnownOIDs
 		}
 
 
+		void protocolDescriptor_data()
+		{
+			QTest::addColumn<QByteArray>("value");
+			QTest::addColumn<int>("protocol");
+			QTest::addColumn<bool>("ecdh");
+			QTest::addColumn<int>("mapping");
+			QTest::addColumn<int>("cipher");
+			QTest::addColumn<int>("keySize");
+			QTest::addColumn<int>("hash");
+
+			QTest::newRow("id_CA::DH_3DES_CBC_CBC") << QByteArray::fromHex("04007F00070202030101") << int(KnownOIDs::SecurityProtocol::ID_CA) << false << int(KnownOIDs::Mapping::NONE) << int(KnownOIDs::Cipher::DES3_CBC_CBC) << 16 << int(QCryptographicHash::Sha1);
+			QTest::newRow("id_CA::ECDH_AES_CBC_CMAC_256") << QByteArray::fromHex("04007F00070202030204") << int(KnownOIDs::SecurityProtocol::ID_CA) << true << int(KnownOIDs::Mapping::NONE) << int(KnownOIDs::Cipher::AES_CBC_CMAC) << 32 << int(QCryptographicHash::Sha256);
+			QTest::newRow("id_PACE::DH::GM_AES_CBC_CMAC_128") << QByteArray::fromHex("04007F00070202040102") << int(KnownOIDs::SecurityProtocol::ID_PACE) << false << int(KnownOIDs::Mapping::GM) << int(KnownOIDs::Cipher::AES_CBC_CMAC) << 16 << int(QCryptographicHash::Sha1);
+			QTest::newRow("id_PACE::ECDH::GM_AES_CBC_CMAC_192") << QByteArray::fromHex("04007F00070202040203") << int(KnownOIDs::SecurityProtocol::ID_PACE) << true << int(KnownOIDs::Mapping::GM) << int(KnownOIDs::Cipher::AES_CBC_CMAC) << 24 << int(QCryptographicHash::Sha256);
+			QTest::newRow("id_PACE::DH::IM_3DES_CBC_CBC") << QByteArray::fromHex("04007F00070202040301") << int(KnownOIDs::SecurityProtocol::ID_PACE) << false << int(KnownOIDs::Mapping::IM) << int(KnownOIDs::Cipher::DES3_CBC_CBC) << 16 << int(QCryptographicHash::Sha1);
+			QTest::newRow("id_PACE::ECDH::IM_AES_CBC_CMAC_256") << QByteArray::fromHex("04007F00070202040404") << int(KnownOIDs::SecurityProtocol::ID_PACE) << true << int(KnownOIDs::Mapping::IM) << int(KnownOIDs::Cipher::AES_CBC_CMAC) << 32 << int(QCryptographicHash::Sha256);
+		}
+
+
+		void protocolDescriptor()
+		{
+			QFETCH(QByteArray, value);
+			QFETCH(int, protocol);
+			QFETCH(bool, ecdh);
+			QFETCH(int, mapping);
+			QFETCH(int, cipher);
+			QFETCH(int, keySize);
+			QFETCH(int, hash);
+
+			const auto* descriptor = KnownOIDs::getProtocolDescriptor(value);
+			QVERIFY(descriptor != nullptr);
+			QCOMPARE(descriptor->getValue(), value);
+			QCOMPARE(int(descriptor->mProtocol), protocol);
+			QCOMPARE(descriptor->mEcdh, ecdh);
+			QCOMPARE(int(descriptor->mMapping), mapping);
+			QCOMPARE(int(descriptor->mCipher), cipher);
+			QCOMPARE(descriptor->mKeySize, keySize);
+			QCOMPARE(int(descriptor->mHashAlgorithm), hash);
+		}
+
+
+		void protocolDescriptorByEnum()
+		{
+			QCOMPARE(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_ca::DH_AES_CBC_CMAC_192)->getValue(), QByteArray::fromHex("04007F00070202030103"));
+			QCOMPARE(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_ca::ECDH_3DES_CBC_CBC)->getValue(), QByteArray::fromHex("04007F00070202030201"));
+			QCOMPARE(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::DH::GM_AES_CBC_CMAC_256)->getValue(), QByteArray::fromHex("04007F00070202040104"));
+			QCOMPARE(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::DH::IM_AES_CBC_CMAC_128)->getValue(), QByteArray::fromHex("04007F00070202040302"));
+			QCOMPARE(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128)->getValue(), QByteArray::fromHex("04007F00070202040202"));
+			QCOMPARE(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::IM_AES_CBC_CMAC_192)->getValue(), QByteArray::fromHex("04007F00070202040403"));
+
+			QVERIFY(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_ca::DH) == nullptr);
+			QVERIFY(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_ca::ECDH) == nullptr);
+			QVERIFY(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::DH::IM) == nullptr);
+			QVERIFY(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM) == nullptr);
+		}
+
+
+		void unknownProtocolDescriptor_data()
+		{
+			QTest::addColumn<QByteArray>("value");
+
+			QTest::newRow("empty") << QByteArray();
+			QTest::newRow("id_PACE::ECDH::GM") << QByteArray::fromHex("04007F000702020402");
+			QTest::newRow("id_TA::ECDSA_SHA_256") << QByteArray::fromHex("04007F00070202020203");
+			QTest::newRow("id_CA::ECDH_unknown_cipher") << QByteArray::fromHex("04007F00070202030205");
+			QTest::newRow("id_CA_unknown_family") << QByteArray::fromHex("04007F00070202030302");
+			QTest::newRow("id_PACE_unknown_family") << QByteArray::fromHex("04007F00070202040502");
+			QTest::newRow("wrong_prefix") << QByteArray::fromHex("04007F00070302040202");
+			QTest::newRow("too_long") << QByteArray::fromHex("04007F0007020204020201");
+		}
+
+
+		void unknownProtocolDescriptor()
+		{
+			QFETCH(QByteArray, value);
+
+			QVERIFY(KnownOIDs::getProtocolDescriptor(value) == nullptr);
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_KnownOIDs)
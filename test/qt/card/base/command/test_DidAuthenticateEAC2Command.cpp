@@ -0,0 +1,147 @@
+/*!
+ * \brief Tests for \ref DidAuthenticateEAC2Command against a \ref MockEidCard
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "command/DidAuthenticateEAC2Command.h"
+
+#include "CardInfoFactory.h"
+#include "command/DidAuthenticateEAC1Command.h"
+#include "Commands.h"
+#include "EstablishPACEChannel.h"
+#include "MockEidCard.h"
+#include "MockEidServer.h"
+#include "MockReader.h"
+
+#include <QtCore>
+#include <QtTest>
+
+using namespace governikus;
+
+
+class test_DidAuthenticateEAC2Command
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QScopedPointer<MockEidServer> mServer;
+		QScopedPointer<MockReader> mReader;
+		MockEidCard* mCard = nullptr;
+		QSharedPointer<CardConnectionWorker> mWorker;
+		QByteArray mIdIcc;
+
+
+		template<typename T> QSharedPointer<T> execute(T* pCommand)
+		{
+			QSignalSpy spy(pCommand, &BaseCardCommand::commandDone);
+			QMetaObject::invokeMethod(pCommand, "execute");
+			if (spy.count() != 1)
+			{
+				return QSharedPointer<T>();
+			}
+			return qSharedPointerCast<T>(spy.takeFirst().at(0).value<QSharedPointer<BaseCardCommand> >());
+		}
+
+
+		QByteArray getChallenge()
+		{
+			const auto command = execute(new DidAuthenticateEAC1Command(mWorker));
+			return command ? command->getChallenge() : QByteArray();
+		}
+
+
+		QSharedPointer<DidAuthenticateEAC2Command> authenticate(const QString& pSignatureAsHex)
+		{
+			return execute(new DidAuthenticateEAC2Command(mWorker, mServer->getCertificateChain(), mServer->getEphemeralPublicKeyAsHex(), pSignatureAsHex, QByteArray()));
+		}
+
+
+	private Q_SLOTS:
+		void init()
+		{
+			mServer.reset(new MockEidServer());
+			mReader.reset(new MockReader());
+			mCard = new MockEidCard();
+			mCard->setTrustPoint(mServer->getTrustPoint());
+			mReader->insertCard(mCard);
+			mCard->connect();
+			mWorker = CardConnectionWorker::create(mReader.data());
+			QVERIFY(CardInfoFactory::create(mWorker, mReader->getReaderInfo()));
+
+			EstablishPACEChannelOutput output;
+			QCOMPARE(mWorker->establishPaceChannel(PACE_PASSWORD_ID::PACE_PIN, QStringLiteral("123456"), mServer->getChat(), QByteArray(), output), CardReturnCode::OK);
+			QCOMPARE(output.getCARcurr(), mServer->getTrustPoint()->getBody().getCertificateHolderReference());
+			mIdIcc = output.getIDicc();
+		}
+
+
+		void cleanup()
+		{
+			mWorker.clear();
+			mReader.reset();
+			mServer.reset();
+		}
+
+
+		void readDataGroupAfterChipAuthentication()
+		{
+			const QByteArray challenge = getChallenge();
+			QCOMPARE(challenge.size(), 8);
+
+			const auto command = authenticate(mServer->createSignatureAsHex(mIdIcc, challenge));
+			QVERIFY(command);
+			QCOMPARE(command->getReturnCode(), CardReturnCode::OK);
+			QVERIFY(!command->getEfCardSecurityAsHex().isEmpty());
+			QVERIFY(mServer->verifyChipAuthentication(mCard->getChipAuthenticationPublicKey(),
+					QByteArray::fromHex(command->getNonceAsHex()), QByteArray::fromHex(command->getAuthTokenAsHex())));
+
+			QByteArray content;
+			QCOMPARE(mServer->readDataGroup(mWorker, 4, content), CardReturnCode::OK);
+			QCOMPARE(content, QByteArray::fromHex("64070C05") + QByteArrayLiteral("ERIKA"));
+			QCOMPARE(mServer->readDataGroup(mWorker, 5, content), CardReturnCode::OK);
+			QCOMPARE(content, QByteArray::fromHex("650C0C0A") + QByteArrayLiteral("MUSTERMANN"));
+		}
+
+
+		void wrongSignature()
+		{
+			const QByteArray challenge = getChallenge();
+			QCOMPARE(challenge.size(), 8);
+
+			const auto command = authenticate(mServer->createSignatureAsHex(mIdIcc, QByteArray(challenge.size(), 0x00)));
+			QVERIFY(command);
+			QCOMPARE(command->getReturnCode(), CardReturnCode::PROTOCOL_ERROR);
+			QVERIFY(command->getNonceAsHex().isEmpty());
+		}
+
+
+		void untrustedCertificateChain()
+		{
+			MockEidServer otherServer;
+			mCard->setTrustPoint(otherServer.getTrustPoint());
+
+			const QByteArray challenge = getChallenge();
+			const auto command = authenticate(mServer->createSignatureAsHex(mIdIcc, challenge));
+			QVERIFY(command);
+			QCOMPARE(command->getReturnCode(), CardReturnCode::PROTOCOL_ERROR);
+		}
+
+
+		void dataGroupNeedsChipAuthentication()
+		{
+			ResponseApdu response;
+			const FileRef application(static_cast<char>(SelectBuilder::P1::APPLICATION_ID), MockEidCard::EID_APPLICATION_ID);
+			QCOMPARE(mWorker->transmit(SelectBuilder(application).build(), response), CardReturnCode::OK);
+			QCOMPARE(response.getReturnCode(), StatusCode::SUCCESS);
+
+			QCOMPARE(mWorker->transmit(ReadBinaryBuilder(0, CommandApdu::SHORT_MAX_LE, 4).build(), response), CardReturnCode::OK);
+			QCOMPARE(response.getReturnCode(), StatusCode::ACCESS_DENIED);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_DidAuthenticateEAC2Command)
+#include "test_DidAuthenticateEAC2Command.moc"
@@ -0,0 +1,231 @@
+/*!
+ * \brief Unit tests and benchmark for recording APDUs with \ref ApduRecorder
+ * and replaying them with \ref ReplayCard.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "ApduRecorder.h"
+
+#include "CardConnectionWorker.h"
+#include "MockEidCard.h"
+#include "MockReader.h"
+#include "ReaderManager.h"
+#include "ReplayReaderManagerPlugIn.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+Q_IMPORT_PLUGIN(ReplayReaderManagerPlugIn)
+
+using namespace governikus;
+
+
+class test_ApduRecorder
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QTemporaryDir mDir;
+
+		QVector<ApduRecord> recordRecognition(const QString& pName, unsigned long pLatency = 0, int* pTransmitCount = nullptr)
+		{
+			const QString filename = mDir.filePath(pName);
+			if (!ApduRecorder::getInstance().start(filename))
+			{
+				return QVector<ApduRecord>();
+			}
+
+			MockReader reader;
+			auto* const card = new MockEidCard();
+			card->setLatency(pLatency);
+			reader.insertCard(card);
+			card->connect();
+
+			const bool recognized = CardInfoFactory::create(CardConnectionWorker::create(&reader), reader.getReaderInfo());
+			ApduRecorder::getInstance().stop();
+
+			if (pTransmitCount)
+			{
+				*pTransmitCount = card->getTransmitCount();
+			}
+			return recognized ? ApduRecorder::load(filename) : QVector<ApduRecord>();
+		}
+
+	private Q_SLOTS:
+		void initTestCase()
+		{
+			QVERIFY(mDir.isValid());
+			ReaderManager::getInstance().init();
+			ReaderManager::getInstance().getPlugInInfos(); // just to wait until initialization finished
+		}
+
+
+		void cleanupTestCase()
+		{
+			ReaderManager::getInstance().shutdown();
+		}
+
+
+		void cleanup()
+		{
+			ApduRecorder::getInstance().stop();
+		}
+
+
+		void notRecording()
+		{
+			QVERIFY(!ApduRecorder::getInstance().isRecording());
+			QVERIFY(!ApduRecorder::getInstance().start(mDir.filePath(QStringLiteral("missing/dir.apdu"))));
+			QVERIFY(!ApduRecorder::getInstance().isRecording());
+		}
+
+
+		void jsonRoundTrip()
+		{
+			const ApduRecord record(QByteArray::fromHex("00a4020c02011c"), QByteArray::fromHex("9000"), CardReturnCode::OK, 1234, 5678);
+			const ApduRecord parsed = ApduRecord::fromJson(record.toJson());
+
+			QCOMPARE(parsed.getCommand(), record.getCommand());
+			QCOMPARE(parsed.getResponse(), record.getResponse());
+			QCOMPARE(parsed.getReturnCode(), CardReturnCode::OK);
+			QCOMPARE(parsed.getOffset(), qint64(1234));
+			QCOMPARE(parsed.getDuration(), qint64(5678));
+		}
+
+
+		void recordCardRecognition()
+		{
+			int transmitCount = 0;
+			const auto& records = recordRecognition(QStringLiteral("recognition.apdu"), 2, &transmitCount);
+
+			QVERIFY(transmitCount > 0);
+			QCOMPARE(records.size(), transmitCount);
+
+			qint64 offset = 0;
+			for (const auto& record : records)
+			{
+				QVERIFY(!record.getCommand().isEmpty());
+				QVERIFY(!record.getResponse().isEmpty());
+				QCOMPARE(record.getReturnCode(), CardReturnCode::OK);
+				QVERIFY(record.getOffset() >= offset);
+				QVERIFY(record.getDuration() >= 2000);
+				offset = record.getOffset() + record.getDuration();
+			}
+		}
+
+
+		void invalidLinesSkipped()
+		{
+			const QString filename = mDir.filePath(QStringLiteral("invalid.apdu"));
+			QFile file(filename);
+			QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+			file.write("{\"command\":\"00b0810000\",\"response\":\"9000\",\"returnCode\":\"OK\",\"offset\":1,\"duration\":2}\n");
+			file.write("\n");
+			file.write("garbage\n");
+			file.write("{\"command\":\"00b0820000\",\"response\":\"6a82\",\"returnCode\":\"OK\",\"offset\":3,\"duration\":4}\n");
+			file.close();
+
+			const auto& records = ApduRecorder::load(filename);
+			QCOMPARE(records.size(), 2);
+			QCOMPARE(records.at(1).getResponse(), QByteArray::fromHex("6a82"));
+			QVERIFY(ApduRecorder::load(mDir.filePath(QStringLiteral("missing.apdu"))).isEmpty());
+		}
+
+
+		void replayCardRecognition()
+		{
+			const auto& records = recordRecognition(QStringLiteral("replay.apdu"));
+			QVERIFY(!records.isEmpty());
+
+			ReplayReader reader;
+			ReplayCard* const card = reader.insertCard(records);
+
+			QVERIFY(reader.getReaderInfo().hasEidCard());
+			QCOMPARE(reader.getReaderInfo().getRetryCounter(), 3);
+			QVERIFY(card->isFinished());
+			QCOMPARE(card->getMismatchCount(), 0);
+		}
+
+
+		void replayThroughReaderManager()
+		{
+			const auto& records = recordRecognition(QStringLiteral("original.apdu"));
+			QVERIFY(!records.isEmpty());
+
+			const QString filename = mDir.filePath(QStringLiteral("replayed.apdu"));
+			QVERIFY(ApduRecorder::getInstance().start(filename));
+			ReplayReader* const reader = ReplayReaderManagerPlugIn::getInstance().addReader(QStringLiteral("ReplayReader"));
+			ReplayCard* const card = reader->insertCard(records);
+			ApduRecorder::getInstance().stop();
+
+			QVERIFY(card->isFinished());
+			QCOMPARE(card->getMismatchCount(), 0);
+			QTRY_VERIFY(ReaderManager::getInstance().getReaderInfo(QStringLiteral("ReplayReader")).hasEidCard());
+
+			const auto& replayed = ApduRecorder::load(filename);
+			QCOMPARE(replayed.size(), records.size());
+			for (int i = 0; i < records.size(); ++i)
+			{
+				QCOMPARE(replayed.at(i).getCommand(), records.at(i).getCommand());
+				QCOMPARE(replayed.at(i).getResponse(), records.at(i).getResponse());
+				QCOMPARE(replayed.at(i).getReturnCode(), records.at(i).getReturnCode());
+			}
+
+			ReplayReaderManagerPlugIn::getInstance().removeReader(QStringLiteral("ReplayReader"));
+			QTRY_VERIFY(!ReaderManager::getInstance().getReaderInfo(QStringLiteral("ReplayReader")).isConnected());
+		}
+
+
+		void replayMismatch()
+		{
+			const QVector<ApduRecord> records({
+						ApduRecord(QByteArray::fromHex("00b0810000"), QByteArray::fromHex("6a82"), CardReturnCode::OK)
+					});
+			ReplayCard card(records);
+
+			ResponseApdu response;
+			QCOMPARE(card.transmit(CommandApdu(QByteArray::fromHex("00b0820000")), response), CardReturnCode::OK);
+			QCOMPARE(response.getBuffer(), QByteArray::fromHex("6a82"));
+			QCOMPARE(card.getMismatchCount(), 1);
+
+			QCOMPARE(card.transmit(CommandApdu(QByteArray::fromHex("00b0820000")), response), CardReturnCode::COMMAND_FAILED);
+			QCOMPARE(card.getPosition(), 1);
+		}
+
+
+		void replayOverhead_data()
+		{
+			QTest::addColumn<double>("latencyFactor");
+
+			QTest::newRow("without card time") << 0.0;
+			QTest::newRow("recorded card time") << 1.0;
+		}
+
+
+		void replayOverhead()
+		{
+			QFETCH(double, latencyFactor);
+
+			const auto& records = recordRecognition(QStringLiteral("overhead.apdu"), 1);
+			QVERIFY(!records.isEmpty());
+
+			QBENCHMARK
+			{
+				MockReader reader;
+				auto* const card = new ReplayCard(records);
+				card->setLatencyFactor(latencyFactor);
+				reader.insertCard(card);
+				card->connect();
+
+				QVERIFY(CardInfoFactory::create(CardConnectionWorker::create(&reader), reader.getReaderInfo()));
+				QCOMPARE(card->getMismatchCount(), 0);
+			}
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_ApduRecorder)
+#include "test_ApduRecorder.moc"
@@ -0,0 +1,131 @@
+/*!
+ * \brief Benchmark and unit tests for card recognition in \ref CardInfoFactory
+ * with a software eID card.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "CardInfo.h"
+
+#include "CardConnectionWorker.h"
+#include "MockEidCard.h"
+#include "MockReader.h"
+#include "TestFileHelper.h"
+
+#include <QElapsedTimer>
+#include <QtTest>
+
+using namespace governikus;
+
+
+class test_CardInfoFactory
+	: public QObject
+{
+	Q_OBJECT
+
+	private Q_SLOTS:
+		void recognizeCard_data()
+		{
+			QTest::addColumn<bool>("shortFileId");
+			QTest::addColumn<bool>("extendedLength");
+			QTest::addColumn<int>("latency");
+			QTest::addColumn<int>("transmitCount");
+
+			QTest::newRow("short file id, extended length") << true << true << 0 << 5;
+			QTest::newRow("short file id, short length") << true << false << 0 << 9;
+			QTest::newRow("select fallback") << false << true << 0 << 13;
+			QTest::newRow("short file id, extended length, 20 ms latency") << true << true << 20 << 5;
+			QTest::newRow("select fallback, 20 ms latency") << false << true << 20 << 13;
+		}
+
+
+		void recognizeCard()
+		{
+			QFETCH(bool, shortFileId);
+			QFETCH(bool, extendedLength);
+			QFETCH(int, latency);
+			QFETCH(int, transmitCount);
+
+			MockReader reader;
+			if (!extendedLength)
+			{
+				reader.getReaderInfo().setMaxApduLength(CommandApdu::SHORT_MAX_LE);
+			}
+
+			auto* const card = new MockEidCard();
+			card->setShortFileIdSupported(shortFileId);
+			card->setExtendedLengthSupported(extendedLength);
+			card->setLatency(static_cast<ulong>(latency));
+			reader.insertCard(card);
+			QCOMPARE(card->connect(), CardReturnCode::OK);
+
+			const auto worker = CardConnectionWorker::create(&reader);
+			QElapsedTimer timer;
+			timer.start();
+			QVERIFY(CardInfoFactory::create(worker, reader.getReaderInfo()));
+			const qint64 elapsed = timer.elapsed();
+
+			QVERIFY(reader.getReaderInfo().hasEidCard());
+			QCOMPARE(reader.getReaderInfo().getRetryCounter(), 3);
+			QCOMPARE(card->getTransmitCount(), transmitCount);
+			QCOMPARE(worker->getTransmitCount(), transmitCount);
+
+			// Each command costs one round trip, so the latency dominates the recognition time
+			const qint64 expected = static_cast<qint64>(latency) * transmitCount;
+			QVERIFY2(elapsed >= expected, qPrintable(QStringLiteral("%1 ms < %2 ms").arg(elapsed).arg(expected)));
+			QVERIFY2(elapsed < expected + 1000, qPrintable(QStringLiteral("%1 ms >= %2 ms").arg(elapsed).arg(expected + 1000)));
+		}
+
+
+		void readEfCardSecurity_data()
+		{
+			QTest::addColumn<bool>("shortFileId");
+			QTest::addColumn<bool>("extendedLength");
+
+			QTest::newRow("short file id, extended length") << true << true;
+			QTest::newRow("short file id, short length") << true << false;
+			QTest::newRow("select fallback") << false << false;
+		}
+
+
+		void readEfCardSecurity()
+		{
+			QFETCH(bool, shortFileId);
+			QFETCH(bool, extendedLength);
+
+			MockReader reader;
+			if (!extendedLength)
+			{
+				reader.getReaderInfo().setMaxApduLength(CommandApdu::SHORT_MAX_LE);
+			}
+
+			auto* const card = new MockEidCard();
+			card->setShortFileIdSupported(shortFileId);
+			card->setExtendedLengthSupported(extendedLength);
+			reader.insertCard(card);
+			QCOMPARE(card->connect(), CardReturnCode::OK);
+
+			const auto worker = CardConnectionWorker::create(&reader);
+			QByteArray content;
+			QCOMPARE(worker->readFile(FileRef::efCardSecurity(), content), CardReturnCode::OK);
+			QCOMPARE(content, QByteArray::fromHex(TestFileHelper::readFile(QStringLiteral(":/card/efCardSecurity.hex"))));
+		}
+
+
+		void noEidCard()
+		{
+			MockReader reader;
+			auto* const card = new MockEidCard();
+			card->setFile(FileRef::efDir(), QByteArray::fromHex("61094F07A000000247100161"));
+			reader.insertCard(card);
+			QCOMPARE(card->connect(), CardReturnCode::OK);
+
+			QVERIFY(!CardInfoFactory::create(CardConnectionWorker::create(&reader), reader.getReaderInfo()));
+			QVERIFY(!reader.getReaderInfo().hasEidCard());
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_CardInfoFactory)
+#include "test_CardInfoFactory.moc"
@@ -6,11 +6,14 @@
 
 #include "messages/BluetoothMessageParser.h"
 #include "messages/BluetoothMessageStatusInd.h"
+#include "messages/BluetoothMessageTransferApduResponse.h"
 #include "messages/parameter/BluetoothMessageParameterApduResponse.h"
 #include "messages/parameter/BluetoothMessageParameterStatusChange.h"
 #include <QtCore/QtCore>
 #include <QtTest/QtTest>
 
+#include <random>
+
 using namespace governikus;
 
 class test_BluetoothMessageParser
@@ -18,6 +21,43 @@ class test_BluetoothMessageParser
 {
 	Q_OBJECT
 
+	private:
+		static QByteArray createTransferApduResponse(const QByteArray& pApdu)
+		{
+			const auto apduLength = pApdu.size();
+			QByteArray message = QByteArray::fromHex("06020000" "02000001" "00000000" "05000000");
+			message[14] = static_cast<char>((apduLength >> 8) & 0xFF);
+			message[15] = static_cast<char>(apduLength & 0xFF);
+			message += pApdu;
+			message += QByteArray((4 - apduLength % 4) % 4, '\0');
+			return message;
+		}
+
+
+		static QByteArray createTransferApduResponseStream(int pCount, int pApduLength)
+		{
+			QByteArray stream;
+			for (int i = 0; i < pCount; ++i)
+			{
+				stream += createTransferApduResponse(QByteArray(pApduLength - 2, static_cast<char>(i)) + QByteArray::fromHex("9000"));
+			}
+			return stream;
+		}
+
+
+		static void verifyConsumedBytes(const QByteArray& pData, const BluetoothMessageParser& pParser)
+		{
+			QVERIFY(pData.endsWith(pParser.getRemainingBytes()));
+
+			int consumed = 0;
+			for (const auto& message : pParser.getMessages())
+			{
+				consumed += message->toData().size();
+			}
+			QCOMPARE(consumed + pParser.getRemainingBytes().size(), pData.size());
+		}
+
+
 	private Q_SLOTS:
 		void initTestCase()
 		{
@@ -188,6 +228,123 @@ class test_BluetoothMessageParser
 		}
 
 
+		void parseTransferApduResponseStream()
+		{
+			const QByteArray stream = createTransferApduResponseStream(50, 255);
+			BluetoothMessageParser parser(stream);
+			QCOMPARE(parser.getMessages().size(), 50);
+			QVERIFY(parser.getRemainingBytes().isEmpty());
+
+			for (int i = 0; i < parser.getMessages().size(); ++i)
+			{
+				const auto& message = parser.getMessages().at(i);
+				QCOMPARE(message->getBluetoothMsgId(), BluetoothMsgId::TransferApduResponse);
+				const auto paramApdu = message->getParameter(BluetoothParamId::ResponseAPDU).staticCast<const BluetoothMessageParameterApduResponse>();
+				QCOMPARE(paramApdu->getResponseApdu(), QByteArray(253, static_cast<char>(i)) + QByteArray::fromHex("9000"));
+			}
+		}
+
+
+		void responseApduOutlivesMessage()
+		{
+			QByteArray responseApdu;
+			{
+				const QByteArray stream = createTransferApduResponse(QByteArray::fromHex("0102039000"));
+				BluetoothMessageParser parser(stream);
+				QCOMPARE(parser.getMessages().size(), 1);
+
+				const auto message = parser.getMessages().at(0).staticCast<const BluetoothMessageTransferApduResponse>();
+				responseApdu = message->getResponseAPDU();
+				QVERIFY(responseApdu.constData() < stream.constData() || responseApdu.constData() >= stream.constData() + stream.size());
+			}
+
+			QCOMPARE(responseApdu, QByteArray::fromHex("0102039000"));
+		}
+
+
+		void fuzzTruncatedStream()
+		{
+			const QByteArray stream = createTransferApduResponseStream(3, 7);
+			for (int length = 0; length <= stream.size(); ++length)
+			{
+				const QByteArray data = stream.left(length);
+				BluetoothMessageParser parser(data);
+				verifyConsumedBytes(data, parser);
+				QVERIFY(parser.getMessages().size() <= 3);
+			}
+		}
+
+
+		void fuzzRandomStream()
+		{
+			std::mt19937 generator(4711);
+			std::uniform_int_distribution<int> byteDistribution(0, 255);
+			std::uniform_int_distribution<int> lengthDistribution(0, 64);
+
+			for (int round = 0; round < 2000; ++round)
+			{
+				QByteArray data;
+				const int length = lengthDistribution(generator);
+				for (int i = 0; i < length; ++i)
+				{
+					data += static_cast<char>(byteDistribution(generator));
+				}
+
+				BluetoothMessageParser parser(data);
+				QVERIFY(data.endsWith(parser.getRemainingBytes()));
+				for (const auto& message : parser.getMessages())
+				{
+					QVERIFY(!message->toString().isEmpty());
+				}
+			}
+		}
+
+
+		void fuzzCorruptedStream()
+		{
+			const QByteArray stream = createTransferApduResponseStream(4, 32);
+			std::mt19937 generator(815);
+			std::uniform_int_distribution<int> positionDistribution(0, stream.size() - 1);
+			std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+			for (int round = 0; round < 2000; ++round)
+			{
+				QByteArray data = stream;
+				data[positionDistribution(generator)] = static_cast<char>(byteDistribution(generator));
+
+				BluetoothMessageParser parser(data);
+				QVERIFY(data.endsWith(parser.getRemainingBytes()));
+				QVERIFY(parser.getMessages().size() <= data.size() / 4);
+			}
+		}
+
+
+		void benchmarkTransferApduResponseStream_data()
+		{
+			QTest::addColumn<int>("count");
+			QTest::addColumn<int>("apduLength");
+
+			QTest::newRow("1 x 258") << 1 << 258;
+			QTest::newRow("100 x 258") << 100 << 258;
+			QTest::newRow("1000 x 258") << 1000 << 258;
+			QTest::newRow("10 x 65535") << 10 << 65535;
+		}
+
+
+		void benchmarkTransferApduResponseStream()
+		{
+			QFETCH(int, count);
+			QFETCH(int, apduLength);
+
+			const QByteArray stream = createTransferApduResponseStream(count, apduLength);
+			QBENCHMARK
+			{
+				BluetoothMessageParser parser(stream);
+				QCOMPARE(parser.getMessages().size(), count);
+			}
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_BluetoothMessageParser)
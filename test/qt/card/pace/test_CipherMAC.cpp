@@ -24,7 +24,7 @@ class test_CipherMAC
 	private Q_SLOTS:
 		void unknownAlgorithm()
 		{
-			QByteArray paceAlgo("unknown-algorithm");
+			const KnownOIDs::ProtocolDescriptor* paceAlgo = nullptr;
 			KeyDerivationFunction kdf(paceAlgo);
 			QByteArray key = kdf.mac("123456");
 			CipherMac cipherMac(paceAlgo, key);
@@ -38,7 +38,7 @@ class test_CipherMAC
 
 		void wrongKeySize()
 		{
-			QByteArray paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
 			QByteArray key("123456");
 			CipherMac cipherMac(paceAlgo, key);
 
@@ -51,7 +51,7 @@ class test_CipherMAC
 
 		void tripleDes()
 		{
-			QByteArray paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_3DES_CBC_CBC);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_3DES_CBC_CBC);
 			KeyDerivationFunction kdf(paceAlgo);
 			QByteArray key = kdf.mac("123456");
 			CipherMac cipherMac(paceAlgo, key);
@@ -65,7 +65,7 @@ class test_CipherMAC
 
 		void aes128()
 		{
-			QByteArray paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128);
 			KeyDerivationFunction kdf(paceAlgo);
 			QByteArray key = kdf.mac("123456");
 			CipherMac cipherMac(paceAlgo, key);
@@ -79,7 +79,7 @@ class test_CipherMAC
 
 		void aes196()
 		{
-			QByteArray paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_192);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_192);
 			KeyDerivationFunction kdf(paceAlgo);
 			QByteArray key = kdf.mac("123456");
 			CipherMac cipherMac(paceAlgo, key);
@@ -93,7 +93,7 @@ class test_CipherMAC
 
 		void aes256()
 		{
-			QByteArray paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
 			KeyDerivationFunction kdf(paceAlgo);
 			QByteArray key = kdf.mac("123456");
 			CipherMac cipherMac(paceAlgo, key);
@@ -107,7 +107,7 @@ class test_CipherMAC
 
 		void multipleuse()
 		{
-			QByteArray paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
 			KeyDerivationFunction kdf(paceAlgo);
 			QByteArray key = kdf.mac("123456");
 			CipherMac cipherMac(paceAlgo, key);
@@ -35,7 +35,7 @@ class test_KeyDerivationFunction
 
 		void unknownAlgorithm()
 		{
-			KeyDerivationFunction kdf("unknown-algorithm");
+			KeyDerivationFunction kdf(nullptr);
 
 			QByteArray key = kdf.pi("123456");
 
@@ -48,7 +48,7 @@ class test_KeyDerivationFunction
 		{
 			QSignalSpy spyLog(&LogHandler::getInstance(), &LogHandler::fireLog);
 
-			KeyDerivationFunction kdf = toByteArray(KnownOIDs::id_PACE::ECDH::GM_3DES_CBC_CBC);
+			KeyDerivationFunction kdf(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_3DES_CBC_CBC));
 
 			QCOMPARE(spyLog.count(), 1);
 			QVERIFY(TestFileHelper::containsLog(spyLog, QLatin1String("3DES not supported")));
@@ -58,7 +58,7 @@ class test_KeyDerivationFunction
 
 		void aes128Key()
 		{
-			KeyDerivationFunction kdf = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128);
+			KeyDerivationFunction kdf(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128));
 
 			QByteArray key = kdf.pi("123456");
 
@@ -69,7 +69,7 @@ class test_KeyDerivationFunction
 
 		void aes196Key()
 		{
-			KeyDerivationFunction kdf = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_192);
+			KeyDerivationFunction kdf(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_192));
 
 			QByteArray key = kdf.pi("123456");
 
@@ -80,7 +80,7 @@ class test_KeyDerivationFunction
 
 		void aes256Key()
 		{
-			KeyDerivationFunction kdf = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256);
+			KeyDerivationFunction kdf(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_256));
 
 			QByteArray key = kdf.pi("123456");
 
@@ -89,6 +89,19 @@ class test_KeyDerivationFunction
 		}
 
 
+		void chipAuthenticationNonce()
+		{
+			KeyDerivationFunction kdf(KnownOIDs::getProtocolDescriptor(KnownOIDs::id_ca::ECDH_AES_CBC_CMAC_128));
+			const QByteArray secret = QByteArray::fromHex("28768d20701247dae81804c9e780ede582a9996db4a315020b2733197db84925");
+			const QByteArray nonce = QByteArray::fromHex("0102030405060708");
+
+			QVERIFY(kdf.isInitialized());
+			QCOMPARE(kdf.enc(secret).toHex(), QByteArray("f5f0e35c0d7161ee6724ee513a0d9a7f"));
+			QCOMPARE(kdf.enc(secret, nonce).toHex(), QByteArray("c01602c8062c0a5db9b93466f2a637ce"));
+			QCOMPARE(kdf.mac(secret, nonce).toHex(), QByteArray("52175375e43d1f054448d142d4decd7e"));
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_KeyDerivationFunction)
@@ -6,6 +6,8 @@
 
 #include "pace/PaceHandler.h"
 
+#include "CardInfoFactory.h"
+#include "MockEidCard.h"
 #include "MockReader.h"
 #include "TestFileHelper.h"
 
@@ -212,6 +214,40 @@ class test_PaceHandler
 		}
 
 
+		void establishPaceChannel_eidCard_data()
+		{
+			QTest::addColumn<QString>("pin");
+			QTest::addColumn<CardReturnCode>("returnCode");
+			QTest::addColumn<int>("retryCounter");
+			QTest::addColumn<bool>("secureMessaging");
+
+			QTest::newRow("correct") << QStringLiteral("123456") << CardReturnCode::OK << 3 << true;
+			QTest::newRow("wrong") << QStringLiteral("654321") << CardReturnCode::INVALID_PIN << 2 << false;
+		}
+
+
+		void establishPaceChannel_eidCard()
+		{
+			QFETCH(QString, pin);
+			QFETCH(CardReturnCode, returnCode);
+			QFETCH(int, retryCounter);
+			QFETCH(bool, secureMessaging);
+
+			MockReader reader;
+			auto* const card = new MockEidCard();
+			reader.insertCard(card);
+			card->connect();
+			const auto worker = CardConnectionWorker::create(&reader);
+			QVERIFY(CardInfoFactory::create(worker, reader.getReaderInfo()));
+
+			PaceHandler paceHandler(worker);
+			QCOMPARE(paceHandler.establishPaceChannel(PACE_PASSWORD_ID::PACE_PIN, pin), returnCode);
+			QCOMPARE(card->getPinRetryCounter(), retryCounter);
+			QCOMPARE(card->isSecureMessagingActive(), secureMessaging);
+			QCOMPARE(paceHandler.getIdIcc().isEmpty(), !secureMessaging);
+		}
+
+
 		// testcase TS_PACE_2.5.1c TR-03105
 		void failureOnMseSetAt()
 		{
@@ -11,6 +11,55 @@
 
 #include "TestFileHelper.h"
 
+#if defined(__SANITIZE_ADDRESS__)
+	#define ADDRESS_SANITIZER
+#elif defined(__has_feature)
+	#if __has_feature(address_sanitizer)
+		#define ADDRESS_SANITIZER
+	#endif
+#endif
+
+#if defined(__GLIBC__) && !defined(ADDRESS_SANITIZER)
+	#define COUNT_ALLOCATIONS
+
+// QByteArray allocates with malloc, so it is replaced for this test to count the allocations of an APDU.
+extern "C" void* __libc_malloc(size_t pSize);
+extern "C" void* __libc_realloc(void* pPtr, size_t pSize);
+
+namespace
+{
+bool cCountAllocations = false;
+int cAllocations = 0;
+size_t cAllocatedBytes = 0;
+
+inline void countAllocation(size_t pSize)
+{
+	if (cCountAllocations)
+	{
+		++cAllocations;
+		cAllocatedBytes += pSize;
+	}
+}
+
+
+} // namespace
+
+extern "C" void* malloc(size_t pSize) __THROW
+{
+	countAllocation(pSize);
+	return __libc_malloc(pSize);
+}
+
+
+extern "C" void* realloc(void* pPtr, size_t pSize) __THROW
+{
+	countAllocation(pSize);
+	return __libc_realloc(pPtr, pSize);
+}
+
+
+#endif
+
 using namespace governikus;
 
 class test_CommandApdu
@@ -48,6 +97,101 @@ class test_CommandApdu
 		}
 
 
+		void testSingleAllocation_data()
+		{
+			QTest::addColumn<int>("dataLength");
+			QTest::addColumn<int>("le");
+
+			QTest::newRow("no data") << 0 << 0;
+			QTest::newRow("short") << 200 << 0xff;
+			QTest::newRow("extended data") << 300 << 0;
+			QTest::newRow("extended le") << 10 << CommandApdu::EXTENDED_MAX_LE;
+		}
+
+
+		void testSingleAllocation()
+		{
+			QFETCH(int, dataLength);
+			QFETCH(int, le);
+
+			const QByteArray data(dataLength, 0x42);
+			const CommandApdu apdu(CommandApdu::CLA, char(0xb0), 0, 0, data, le);
+
+			// The buffer was allocated once with enough capacity and never grown
+			QCOMPARE(apdu.getBuffer().capacity(), 4 + 3 + dataLength + 3);
+			QCOMPARE(apdu.getData(), data);
+			QCOMPARE(apdu.getLe(), le);
+		}
+
+
+		void testAllocationCount_data()
+		{
+			testSingleAllocation_data();
+		}
+
+
+		void testAllocationCount()
+		{
+#ifndef COUNT_ALLOCATIONS
+			QSKIP("Allocations can only be counted with glibc and without AddressSanitizer");
+#else
+			QFETCH(int, dataLength);
+			QFETCH(int, le);
+
+			const QByteArray data(dataLength, 0x42);
+			const ResponseApdu response(QByteArray::fromHex("0102039000"));
+
+			cAllocations = 0;
+			cAllocatedBytes = 0;
+			cCountAllocations = true;
+			const CommandApdu apdu(CommandApdu::CLA, char(0xb0), 0, 0, data, le);
+			const int buildAllocations = cAllocations;
+
+			cAllocations = 0;
+			cAllocatedBytes = 0;
+			const QByteArray view = apdu.getDataView();
+			const int viewAllocations = cAllocations;
+			const size_t viewBytes = cAllocatedBytes;
+
+			cAllocations = 0;
+			const StatusCode returnCode = response.getReturnCode();
+			const int returnCodeAllocations = cAllocations;
+			cCountAllocations = false;
+
+			QCOMPARE(buildAllocations, 1);
+			QCOMPARE(returnCodeAllocations, 0);
+			QCOMPARE(returnCode, StatusCode::SUCCESS);
+
+			// A view needs a QByteArray header at most, the data is not copied
+			QCOMPARE(view.size(), dataLength);
+			QVERIFY(viewAllocations <= 1);
+			QVERIFY(viewBytes < 64);
+#endif
+		}
+
+
+		void testViews()
+		{
+			const CommandApdu extended(CommandApdu::CLA, char(0xb0), 1, 2, QByteArray(300, 0x42), 0);
+			QCOMPARE(extended.getHeaderView(), QByteArray::fromHex("00b00102"));
+			QCOMPARE(extended.getHeaderView().constData(), extended.getBuffer().constData());
+			QCOMPARE(extended.getDataView(), QByteArray(300, 0x42));
+			QCOMPARE(extended.getDataView().constData(), extended.getBuffer().constData() + 7);
+
+			const CommandApdu shortApdu(QByteArray::fromHex("0022c1a40380010300"));
+			QCOMPARE(shortApdu.getDataView(), QByteArray::fromHex("800103"));
+			QCOMPARE(shortApdu.getDataView().constData(), shortApdu.getBuffer().constData() + 5);
+
+			const CommandApdu noData(QByteArray::fromHex("00b0000000"));
+			QVERIFY(noData.getDataView().isEmpty());
+
+			const ResponseApdu response(QByteArray::fromHex("0102039000"));
+			QCOMPARE(response.getDataView(), QByteArray::fromHex("010203"));
+			QCOMPARE(response.getDataView().constData(), response.getBuffer().constData());
+			QCOMPARE(response.getReturnCode(), StatusCode::SUCCESS);
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_CommandApdu)
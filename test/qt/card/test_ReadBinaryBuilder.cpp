@@ -0,0 +1,43 @@
+/*!
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "Commands.h"
+
+#include <QtCore/QtCore>
+#include <QtTest/QtTest>
+
+using namespace governikus;
+
+class test_ReadBinaryBuilder
+	: public QObject
+{
+	Q_OBJECT
+
+	private Q_SLOTS:
+		void readWithOffset()
+		{
+			const CommandApdu command = ReadBinaryBuilder(0x01ff, 0xff).build();
+			QCOMPARE(command.getBuffer().toHex(), QByteArray("00b001ffff"));
+		}
+
+
+		void readWithShortFileId()
+		{
+			const CommandApdu command = ReadBinaryBuilder(0, 0x5a, FileRef::efDir().shortFileId).build();
+			QCOMPARE(command.getBuffer().toHex(), QByteArray("00b09e005a"));
+		}
+
+
+		void readWithShortFileIdExtendedLength()
+		{
+			const CommandApdu command = ReadBinaryBuilder(0, CommandApdu::EXTENDED_MAX_LE, FileRef::efCardAccess().shortFileId).build();
+			QCOMPARE(command.getBuffer().toHex(), QByteArray("00b09c00000000"));
+			QCOMPARE(command.getLe(), CommandApdu::EXTENDED_MAX_LE);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_ReadBinaryBuilder)
+#include "test_ReadBinaryBuilder.moc"
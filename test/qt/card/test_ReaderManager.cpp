@@ -151,6 +151,87 @@ class test_ReaderManager
 		}
 
 
+		void reserveReader()
+		{
+			QObject firstOwner;
+			QObject secondOwner;
+			ReaderManager& readerManager = ReaderManager::getInstance();
+			const QString readerName = QStringLiteral("MockReader 0815");
+			QSignalSpy spy(&readerManager, &ReaderManager::fireReaderAdded);
+			MockReaderManagerPlugIn::getInstance().addReader(readerName);
+			MockReaderManagerPlugIn::getInstance().addReader("MockReader 4711");
+			QTRY_COMPARE(spy.count(), 2);
+
+			QVERIFY(readerManager.isReaderAvailable(readerName, &firstOwner));
+			QVERIFY(readerManager.reserveReader(readerName, &firstOwner));
+			QVERIFY(readerManager.reserveReader(readerName, &firstOwner));
+			QVERIFY(readerManager.isReaderReserved(readerName, &firstOwner));
+			QVERIFY(!readerManager.isReaderAvailable(readerName, &secondOwner));
+			QVERIFY(!readerManager.isReaderAvailable(readerName));
+			QVERIFY(!readerManager.reserveReader(readerName, &secondOwner));
+
+			readerManager.releaseReader(readerName, &secondOwner);
+			QVERIFY(readerManager.isReaderReserved(readerName, &firstOwner));
+
+			readerManager.releaseReader(readerName, &firstOwner);
+			QVERIFY(readerManager.reserveReader(readerName, &secondOwner));
+			QVERIFY(readerManager.reserveReader(QStringLiteral("MockReader 4711"), &secondOwner));
+
+			readerManager.releaseReaders(&secondOwner);
+			QVERIFY(readerManager.isReaderAvailable(readerName));
+			QVERIFY(readerManager.isReaderAvailable(QStringLiteral("MockReader 4711")));
+
+			MockReaderManagerPlugIn::getInstance().removeReader(readerName);
+			MockReaderManagerPlugIn::getInstance().removeReader("MockReader 4711");
+		}
+
+
+		void reserveUnknownReader()
+		{
+			QObject owner;
+			ReaderManager& readerManager = ReaderManager::getInstance();
+
+			QVERIFY(!readerManager.reserveReader(QStringLiteral("UnknownReader"), &owner));
+			QVERIFY(!readerManager.isReaderReserved(QStringLiteral("UnknownReader"), &owner));
+			QVERIFY(readerManager.isReaderAvailable(QStringLiteral("UnknownReader")));
+		}
+
+
+		void releaseReservationOnReaderRemoved()
+		{
+			QObject owner;
+			ReaderManager& readerManager = ReaderManager::getInstance();
+			QSignalSpy addedSpy(&readerManager, &ReaderManager::fireReaderAdded);
+			QSignalSpy spy(&readerManager, &ReaderManager::fireReaderRemoved);
+			MockReaderManagerPlugIn::getInstance().addReader("MockReader 4711");
+			QVERIFY(addedSpy.wait());
+			QVERIFY(readerManager.reserveReader(QStringLiteral("MockReader 4711"), &owner));
+
+			MockReaderManagerPlugIn::getInstance().removeReader("MockReader 4711");
+
+			QVERIFY(spy.wait());
+			QVERIFY(readerManager.isReaderAvailable(QStringLiteral("MockReader 4711")));
+		}
+
+
+		void releaseReservationOnOwnerDestroyed()
+		{
+			ReaderManager& readerManager = ReaderManager::getInstance();
+			QSignalSpy spy(&readerManager, &ReaderManager::fireReaderAdded);
+			MockReaderManagerPlugIn::getInstance().addReader("MockReader 4711");
+			QVERIFY(spy.wait());
+
+			QScopedPointer<QObject> owner(new QObject());
+			QVERIFY(readerManager.reserveReader(QStringLiteral("MockReader 4711"), owner.data()));
+			QVERIFY(!readerManager.isReaderAvailable(QStringLiteral("MockReader 4711")));
+
+			owner.reset();
+			QVERIFY(readerManager.isReaderAvailable(QStringLiteral("MockReader 4711")));
+
+			MockReaderManagerPlugIn::getInstance().removeReader("MockReader 4711");
+		}
+
+
 		void getInvalidReaderInfoWithAndWithoutInitializedReaderManager()
 		{
 			{
@@ -83,7 +83,7 @@ class test_SecureMessaging
 	private Q_SLOTS:
 		void init()
 		{
-			auto paceAlgo = toByteArray(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128);
+			const auto* paceAlgo = KnownOIDs::getProtocolDescriptor(KnownOIDs::id_PACE::ECDH::GM_AES_CBC_CMAC_128);
 			QByteArray encKey("F1234567890ABCDE");
 			QByteArray macKey("1234567890ABCDEF");
 			mSecureMessaging.reset(new SecureMessaging(paceAlgo, encKey, macKey));
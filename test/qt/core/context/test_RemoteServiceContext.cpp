@@ -0,0 +1,73 @@
+/*!
+ * \brief Tests for the remote service context.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "context/RemoteServiceContext.h"
+
+#include "ServerMessageHandler.h"
+
+#include <QSharedPointer>
+#include <QtTest>
+
+
+using namespace governikus;
+
+
+class MockServerMessageHandler
+	: public ServerMessageHandler
+{
+	Q_OBJECT
+
+	public:
+		virtual void sendEstablishPaceChannelResponse(const QString&, const EstablishPACEChannelOutput&) override
+		{
+		}
+
+
+		virtual void sendModifyPinResponse(const QString&, const ResponseApdu&) override
+		{
+		}
+
+
+		void close()
+		{
+			Q_EMIT fireClosed();
+		}
+
+
+};
+
+
+class test_RemoteServiceContext
+	: public QObject
+{
+	Q_OBJECT
+
+	private Q_SLOTS:
+		void messageHandlerClosed()
+		{
+			RemoteServiceContext context;
+			const QSharedPointer<MockServerMessageHandler> handler(new MockServerMessageHandler());
+			const QSharedPointer<MockServerMessageHandler> otherHandler(new MockServerMessageHandler());
+			connect(handler.data(), &ServerMessageHandler::fireClosed, &context, &RemoteServiceContext::onMessageHandlerClosed);
+			connect(otherHandler.data(), &ServerMessageHandler::fireClosed, &context, &RemoteServiceContext::onMessageHandlerClosed);
+
+			context.setMessageHandler(handler);
+			context.setPin(QStringLiteral("123456"));
+
+			otherHandler->close();
+			QCOMPARE(context.getMessageHandler(), handler.staticCast<ServerMessageHandler>());
+			QCOMPARE(context.getPin(), QStringLiteral("123456"));
+
+			handler->close();
+			QVERIFY(context.getMessageHandler().isNull());
+			QVERIFY(context.getPin().isEmpty());
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_RemoteServiceContext)
+#include "test_RemoteServiceContext.moc"
@@ -0,0 +1,216 @@
+/*!
+ * \brief Benchmarks of the self authentication and the change of the PIN
+ * with a \ref MockEidCard.
+ *
+ * Every workflow is an own data row of a QBENCHMARK. The time spent in every
+ * state is collected meanwhile and reported afterwards as an own data row
+ * with its mean walltime per run. The test plays the service provider and
+ * the eID server of the self authentication with \ref MockEidServerNetworkManager.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "controller/ChangePinController.h"
+#include "controller/SelfAuthController.h"
+
+#include "AppSettings.h"
+#include "CardInfoFactory.h"
+#include "context/ChangePinContext.h"
+#include "context/SelfAuthContext.h"
+#include "Env.h"
+#include "MockEidCard.h"
+#include "MockEidServerNetworkManager.h"
+#include "MockReaderManagerPlugIn.h"
+#include "ReaderManager.h"
+#include "SecureStorage.h"
+
+#include <QElapsedTimer>
+#include <QtPlugin>
+#include <QtTest>
+
+
+using namespace governikus;
+
+
+Q_IMPORT_PLUGIN(MockReaderManagerPlugIn)
+
+
+namespace
+{
+const QString READER_NAME = QStringLiteral("MockEidReader");
+const QString SELF_AUTH = QStringLiteral("SelfAuthController");
+const QString CHANGE_PIN = QStringLiteral("ChangePinController");
+const QString TOTAL = QStringLiteral("Total");
+}
+
+
+class test_WorkflowBenchmark
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QScopedPointer<MockEidServerNetworkManager> mNetworkManager;
+		MockEidCard* mCard;
+		QMap<QString, qint64> mElapsed;
+		QMap<QString, int> mRuns;
+
+
+		void addElapsed(const QString& pWorkflow, const QString& pPhase, QElapsedTimer& pTimer)
+		{
+			mElapsed[pWorkflow + QLatin1Char('/') + pPhase] += pTimer.nsecsElapsed();
+			mElapsed[pWorkflow + QLatin1Char('/') + TOTAL] += pTimer.nsecsElapsed();
+			pTimer.restart();
+		}
+
+
+		void run(const QString& pWorkflow, const QSharedPointer<WorkflowContext>& pContext, WorkflowController& pController)
+		{
+			QElapsedTimer timer;
+			QString currentState;
+			connect(pContext.data(), &WorkflowContext::fireStateChanged, this, [&](const QString& pNextState){
+						if (!currentState.isEmpty())
+						{
+							addElapsed(pWorkflow, currentState, timer);
+						}
+						currentState = pNextState;
+						timer.restart();
+						pContext->setStateApproved();
+					});
+
+			QSignalSpy controllerFinished(&pController, &WorkflowController::fireComplete);
+			timer.start();
+			pController.run();
+			QVERIFY(controllerFinished.wait());
+			addElapsed(pWorkflow, currentState, timer);
+			++mRuns[pWorkflow];
+
+			QCOMPARE(pContext->getStatus().getStatusCode(), GlobalStatus::Code::No_Error);
+		}
+
+
+		void runSelfAuthController()
+		{
+			const QSharedPointer<SelfAuthContext> context(new SelfAuthContext());
+			context->setReaderPlugInTypes({ReaderManagerPlugInType::UNKNOWN});
+			context->setPin(mCard->getPin());
+
+			SelfAuthController controller(context);
+			run(SELF_AUTH, context, controller);
+			QVERIFY(context->getSelfAuthenticationData().isValid());
+			QCOMPARE(mNetworkManager->getDataGroups().size(), 3);
+		}
+
+
+		void runChangePinController()
+		{
+			const QString pin = mCard->getPin();
+			const QString newPin = pin == QLatin1String("123456") ? QStringLiteral("654321") : QStringLiteral("123456");
+
+			const QSharedPointer<ChangePinContext> context(new ChangePinContext());
+			context->setReaderPlugInTypes({ReaderManagerPlugInType::UNKNOWN});
+			context->setPin(pin);
+			context->setNewPin(newPin);
+
+			ChangePinController controller(context);
+			run(CHANGE_PIN, context, controller);
+			QCOMPARE(mCard->getPin(), newPin);
+		}
+
+	private Q_SLOTS:
+		void initTestCase()
+		{
+			auto& generalSettings = Env::getSingleton<AppSettings>()->getGeneralSettings();
+			generalSettings.setDeveloperMode(true);
+			Env::getSingleton<AppSettings>()->getPreVerificationSettings().setEnabled(false);
+
+			const QUrl tcTokenUrl = SecureStorage::getInstance().getSelfAuthenticationUrl(generalSettings.useSelfAuthTestUri());
+			mNetworkManager.reset(new MockEidServerNetworkManager(tcTokenUrl));
+			Env::set(NetworkManager::staticMetaObject, mNetworkManager.data());
+
+			ReaderManager::getInstance().init();
+			ReaderManager::getInstance().getPlugInInfos(); // just to wait until initialization finished
+
+			MockReader* const reader = MockReaderManagerPlugIn::getInstance().addReader(READER_NAME);
+			mCard = new MockEidCard();
+			mCard->setTrustPoint(mNetworkManager->getTrustPoint());
+			mNetworkManager->setChipAuthenticationPublicKey(mCard->getChipAuthenticationPublicKey());
+			reader->insertCard(mCard);
+			mCard->connect();
+			QVERIFY(CardInfoFactory::create(CardConnectionWorker::create(reader), reader->getReaderInfo()));
+			Q_EMIT reader->fireCardInserted(READER_NAME);
+		}
+
+
+		void cleanupTestCase()
+		{
+			MockReaderManagerPlugIn::getInstance().removeReader(READER_NAME);
+			ReaderManager::getInstance().shutdown();
+
+			Env::set(NetworkManager::staticMetaObject);
+			mNetworkManager.reset();
+
+			auto& settings = *Env::getSingleton<AppSettings>();
+			settings.getGeneralSettings().setDeveloperMode(false);
+			settings.getPreVerificationSettings().setEnabled(true);
+		}
+
+
+		void workflow_data()
+		{
+			QTest::addColumn<QString>("workflow");
+
+			QTest::newRow(qPrintable(SELF_AUTH)) << SELF_AUTH;
+			QTest::newRow(qPrintable(CHANGE_PIN)) << CHANGE_PIN;
+		}
+
+
+		void workflow()
+		{
+			QFETCH(QString, workflow);
+
+			QBENCHMARK{
+				if (workflow == SELF_AUTH)
+				{
+					runSelfAuthController();
+				}
+				else
+				{
+					runChangePinController();
+				}
+
+				if (QTest::currentTestFailed())
+				{
+					return;
+				}
+			}
+		}
+
+
+		void phases_data()
+		{
+			QTest::addColumn<QString>("phase");
+			QTest::addColumn<int>("runs");
+
+			const auto& phases = mElapsed.keys();
+			for (const auto& phase : phases)
+			{
+				QTest::newRow(qPrintable(phase)) << phase << mRuns.value(phase.section(QLatin1Char('/'), 0, 0));
+			}
+		}
+
+
+		void phases()
+		{
+			QFETCH(QString, phase);
+			QFETCH(int, runs);
+
+			QVERIFY(runs > 0);
+			QTest::setBenchmarkResult(mElapsed.value(phase) / 1000000.0 / runs, QTest::WalltimeMilliseconds);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_WorkflowBenchmark)
+#include "test_WorkflowBenchmark.moc"
@@ -5,6 +5,7 @@
  */
 
 #include "SelfAuthenticationData.h"
+
 #include <QtTest>
 
 using namespace governikus;
@@ -26,6 +27,31 @@ class test_SelfAuthenticationData
 		}
 
 
+		static QByteArray readFixture(const QString& pFileName)
+		{
+			QFile file(pFileName);
+			return file.open(QIODevice::ReadOnly | QIODevice::Text) ? file.readAll() : QByteArray();
+		}
+
+
+		static qint64 readPeakMemory()
+		{
+			QFile status(QStringLiteral("/proc/self/status"));
+			if (status.open(QIODevice::ReadOnly | QIODevice::Text))
+			{
+				const auto& lines = status.readAll().split('\n');
+				for (const auto& line : lines)
+				{
+					if (line.startsWith("VmHWM:"))
+					{
+						return line.mid(6).trimmed().split(' ').first().toLongLong();
+					}
+				}
+			}
+			return -1;
+		}
+
+
 	public:
 		test_SelfAuthenticationData()
 			: selfAuthenticationDataXmlFile(":/self/SelfAuthenticationData.xml")
@@ -103,6 +129,137 @@ class test_SelfAuthenticationData
 		}
 
 
+		void orderedSelfData()
+		{
+			const SelfAuthenticationData selfAuthenticationData(readFixture(QStringLiteral(":/self/SelfAuthenticationData.xml")));
+			QVERIFY(selfAuthenticationData.isValid());
+
+			// Empty elements like AcademicTitle are not part of the data
+			QStringList values;
+			const auto& orderedSelfData = selfAuthenticationData.getOrderedSelfData();
+			for (const auto& entry : orderedSelfData)
+			{
+				values += entry.second;
+			}
+			QCOMPARE(values, QStringList({
+						QStringLiteral("MUSTERMANN"),
+						QStringLiteral("GABLER"),
+						QStringLiteral("ERIKA"),
+						QStringLiteral("12.08.1964"),
+						QStringLiteral("BERLIN"),
+						QStringLiteral("HEIDESTRASSE 17"),
+						QStringLiteral("51147 K\u00D6LN"),
+						QStringLiteral("D"),
+						QStringLiteral("TP"),
+						QStringLiteral("This data has not been stored in this chip generation."),
+						QStringLiteral("D")
+					}));
+		}
+
+
+		void textContent()
+		{
+			const QByteArray data("<eID xmlns=\"http://bsi.bund.de/eID/\">"
+								  "<PersonalData>"
+								  "<GivenNames> ERIKA <!-- comment --><![CDATA[&]]> MARIA</GivenNames>"
+								  "<FamilyNames>  </FamilyNames>"
+								  "<Unknown><GivenNames>IGNORED</GivenNames></Unknown>"
+								  "<DateOfBirth><DateValue>1964-08-12+01:00</DateValue><DateValue>1970-01-01+01:00</DateValue></DateOfBirth>"
+								  "<PlaceOfResidence><StructuredPlace><City>K&#214;LN</City><Unknown/><City>BONN</City></StructuredPlace></PlaceOfResidence>"
+								  "</PersonalData>"
+								  "<OperationsAllowedByUser>"
+								  "<GivenNames>ALLOWED</GivenNames>"
+								  "<FamilyNames>ALLOWED</FamilyNames>"
+								  "<DateOfBirth>ALLOWED</DateOfBirth>"
+								  "<PlaceOfResidence>ALLOWED</PlaceOfResidence>"
+								  "</OperationsAllowedByUser>"
+								  "</eID>");
+
+			const SelfAuthenticationData selfAuthenticationData(data);
+			QVERIFY(selfAuthenticationData.isValid());
+			QCOMPARE(selfAuthenticationData.getValue(SelfAuthData::GivenNames), QStringLiteral(" ERIKA & MARIA"));
+			QVERIFY(selfAuthenticationData.getValue(SelfAuthData::FamilyNames).isNull());
+			QCOMPARE(selfAuthenticationData.getValue(SelfAuthData::DateOfBirth), QStringLiteral("1964-08-12+01:00"));
+			QCOMPARE(selfAuthenticationData.getValue(SelfAuthData::PlaceOfResidenceCity), QStringLiteral("K\u00D6LN"));
+		}
+
+
+		void invalidData_data()
+		{
+			QTest::addColumn<QByteArray>("data");
+
+			const QByteArray data = readFixture(QStringLiteral(":/self/SelfAuthenticationData.xml"));
+			QTest::newRow("truncated") << data.left(data.indexOf("<ns2:RestrictedID>"));
+			QTest::newRow("no permissions") << QByteArray(data).replace("OperationsAllowedByUser", "Unknown");
+			QTest::newRow("no personal data") << QByteArray(data).replace("PersonalData", "Unknown");
+		}
+
+
+		void invalidData()
+		{
+			QFETCH(QByteArray, data);
+
+			const SelfAuthenticationData selfAuthenticationData(data);
+			QVERIFY(!selfAuthenticationData.isValid());
+			QVERIFY(selfAuthenticationData.getValue(SelfAuthData::GivenNames).isNull());
+			QVERIFY(selfAuthenticationData.getOrderedSelfData().isEmpty());
+		}
+
+
+		void benchmarkParse_data()
+		{
+			QTest::addColumn<QString>("fileName");
+
+			QTest::newRow("SelfAuthenticationData") << QStringLiteral(":/self/SelfAuthenticationData.xml");
+			QTest::newRow("NoStreet") << QStringLiteral(":/self/SelfAuthenticationDataNoStreet.xml");
+			QTest::newRow("NoAddress") << QStringLiteral(":/self/SelfAuthenticationDataNoAddress.xml");
+		}
+
+
+		void benchmarkParse()
+		{
+			QFETCH(QString, fileName);
+			const QByteArray data = readFixture(fileName);
+
+			QLoggingCategory::setFilterRules(QStringLiteral("secure.debug=false"));
+			QBENCHMARK
+			{
+				const SelfAuthenticationData selfAuthenticationData(data);
+				QVERIFY(selfAuthenticationData.isValid());
+			}
+			QLoggingCategory::setFilterRules(QString());
+		}
+
+
+		void peakMemory()
+		{
+#ifndef Q_OS_LINUX
+			QSKIP("Peak memory is read from /proc/self/status");
+#endif
+
+			// Unrelated elements are skipped while streaming, a DOM allocates a node for each one
+			QByteArray padding;
+			for (int i = 0; i < 50000; ++i)
+			{
+				padding += "<ns3:Padding>x</ns3:Padding>";
+			}
+			const QByteArray data = readFixture(QStringLiteral(":/self/SelfAuthenticationData.xml")).replace("<ns3:Result>", padding + "<ns3:Result>");
+
+			QLoggingCategory::setFilterRules(QStringLiteral("secure.debug=false"));
+			const qint64 before = readPeakMemory();
+			const SelfAuthenticationData selfAuthenticationData(data);
+			const qint64 after = readPeakMemory();
+			QLoggingCategory::setFilterRules(QString());
+
+			QVERIFY(selfAuthenticationData.isValid());
+			QCOMPARE(selfAuthenticationData.getValue(SelfAuthData::GivenNames), QStringLiteral("ERIKA"));
+
+			// The data is decoded to UTF-16 once, a DOM of the padding alone would need about ten times its size
+			QVERIFY(before > 0);
+			QVERIFY2(after - before < 4 * data.size() / 1024, qPrintable(QStringLiteral("%1 kB peak memory increase").arg(after - before)));
+		}
+
+
 		void tryToParseClosedFile()
 		{
 			selfAuthenticationDataXmlFile.close();
@@ -69,6 +69,84 @@ class test_PdfExporter
 		}
 
 
+		void historyAsync()
+		{
+			QVector<HistoryInfo> entries;
+			for (int i = 0; i < 250; ++i)
+			{
+				entries << HistoryInfo("SubjectName", "SubjectUrl", "Usage", QDateTime::currentDateTime(), "TermOfUsage", "RequestedData");
+			}
+			AppSettings::getInstance().getHistorySettings().setHistoryInfos(entries);
+
+			QTemporaryFile file;
+			QVERIFY(file.open());
+
+			PdfExporter exporter(file.fileName(), false, false);
+			QSemaphore uiThreadAlive;
+			QVector<QPair<int, int> > progress;
+			QThread* progressThread = nullptr;
+			connect(&exporter, &PdfExporter::fireProgress, [&uiThreadAlive, &progress, &progressThread](int pCurrent, int pTotal){
+						progressThread = QThread::currentThread();
+						if (progress.isEmpty())
+						{
+							// The export waits until the UI thread processed its events
+							uiThreadAlive.acquire();
+						}
+						progress += qMakePair(pCurrent, pTotal);
+					});
+
+			const auto& future = exporter.exportHistoryAsync();
+			QVERIFY(!future.isFinished());
+			QTimer::singleShot(0, [&uiThreadAlive](){
+						uiThreadAlive.release();
+					});
+			QTRY_VERIFY(future.isFinished());
+			QVERIFY(future.result());
+
+			QVERIFY(progressThread != QThread::currentThread());
+			QCOMPARE(progress.size(), 100);
+			int current = 0;
+			for (const auto& entry : qAsConst(progress))
+			{
+				QVERIFY(entry.first > current);
+				QCOMPARE(entry.second, entries.size());
+				current = entry.first;
+			}
+			QCOMPARE(current, entries.size());
+			QVERIFY(QFileInfo(file.fileName()).size() > 50000);
+		}
+
+
+		void benchmarkHistory_data()
+		{
+			QTest::addColumn<int>("count");
+
+			QTest::newRow("1000") << 1000;
+			QTest::newRow("10000") << 10000;
+		}
+
+
+		void benchmarkHistory()
+		{
+			QFETCH(int, count);
+
+			QVector<HistoryInfo> entries;
+			entries.reserve(count);
+			for (int i = 0; i < count; ++i)
+			{
+				entries << HistoryInfo("SubjectName", "SubjectUrl", "Usage", QDateTime::currentDateTime(), "TermOfUsage", "RequestedData");
+			}
+
+			QTemporaryFile file;
+			QVERIFY(file.open());
+
+			PdfExporter exporter(file.fileName(), false, false);
+			QBENCHMARK_ONCE {
+				QVERIFY(exporter.exportHistory(entries));
+			}
+		}
+
+
 		void selfInfo_data()
 		{
 			QTest::addColumn<int>("min");
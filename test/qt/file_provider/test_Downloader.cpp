@@ -84,6 +84,19 @@ class test_Downloader
 
 		void cleanup()
 		{
+			// Finish every reply that a test left running, otherwise it blocks
+			// a connection of the following tests.
+			Downloader* const downloader = Env::getSingleton<Downloader>();
+			while (!downloader->mRunningRequests.isEmpty())
+			{
+				auto* const reply = qobject_cast<MockNetworkReply*>(downloader->mRunningRequests.constBegin().key());
+				QVERIFY(reply);
+				reply->abort();
+				reply->setNetworkError(QNetworkReply::OperationCanceledError, QStringLiteral("Operation canceled"));
+				reply->fireFinished();
+			}
+			QVERIFY(downloader->mPendingRequests.isEmpty());
+
 			Env::clear();
 		}
 
@@ -173,6 +186,125 @@ class test_Downloader
 			QVERIFY(lastRequest);
 			QCOMPARE(lastRequest->rawHeader(QByteArray("If-Modified-Since")), QLocale::c().toString(timestampInCache, QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1());
 			QCOMPARE(lastRequest->rawHeader(QByteArray("If-Modified-Since")), QByteArray("Sat, 01 Jul 2017 12:00:00 GMT"));
+			QVERIFY(!lastRequest->hasRawHeader(QByteArray("If-None-Match")));
+		}
+
+
+		void conditionalDownloadWithETag()
+		{
+			const QByteArray fileContent("Some icon data");
+			MockNetworkReply* const reply = new MockNetworkReply(fileContent, HttpStatusCode::OK);
+			reply->setFileModificationTimestamp(QDateTime(QDate(2017, 7, 1), QTime(12, 00, 0, 0)));
+			reply->setResponseHeader(QByteArrayLiteral("ETag"), QByteArrayLiteral("\"new\""));
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->setNextReply(reply);
+
+			Downloader* const downloader = Env::getSingleton<Downloader>();
+			QSignalSpy spy(downloader, &Downloader::fireDownloadSuccess);
+
+			const QUrl url("http://server/reader/icons/icon.png");
+			downloader->downloadIfNew(url, QDateTime(QDate(2017, 6, 1), QTime(12, 00, 0, 0)), QByteArrayLiteral("\"old\""));
+
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->fireFinished();
+
+			QCOMPARE(spy.count(), 1);
+			QCOMPARE(spy.first().at(3).toByteArray(), QByteArray("\"new\""));
+
+			QNetworkRequest* const lastRequest = Env::getSingleton<NetworkManager, MockNetworkManager>()->getLastRequest();
+			QVERIFY(lastRequest);
+			QCOMPARE(lastRequest->rawHeader(QByteArray("If-None-Match")), QByteArray("\"old\""));
+		}
+
+
+		void coalesceDuplicateDownloads()
+		{
+			const QByteArray fileContent("Some icon data");
+			MockNetworkReply* const reply = new MockNetworkReply(fileContent, HttpStatusCode::OK);
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->setNextReply(reply);
+
+			Downloader* const downloader = Env::getSingleton<Downloader>();
+			QSignalSpy replySpy(Env::getSingleton<NetworkManager, MockNetworkManager>(), &MockNetworkManager::fireReply);
+			QSignalSpy spy(downloader, &Downloader::fireDownloadSuccess);
+
+			const QUrl url("http://server/reader/icons/icon.png");
+			downloader->download(url);
+			downloader->download(url);
+			downloader->downloadIfNew(url, QDateTime(QDate(2017, 6, 1), QTime(12, 00, 0, 0)));
+			QCOMPARE(replySpy.count(), 1);
+
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->fireFinished();
+			QCOMPARE(spy.count(), 1);
+
+			downloader->download(url);
+			QCOMPARE(replySpy.count(), 2);
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->fireFinished();
+		}
+
+
+		void conditionalDownloadDoesNotCoverDownload()
+		{
+			Downloader* const downloader = Env::getSingleton<Downloader>();
+			QSignalSpy replySpy(Env::getSingleton<NetworkManager, MockNetworkManager>(), &MockNetworkManager::fireReply);
+
+			const QUrl url("http://server/reader/icons/icon.png");
+			downloader->downloadIfNew(url, QDateTime(QDate(2017, 6, 1), QTime(12, 00, 0, 0)), QByteArrayLiteral("\"old\""));
+			downloader->downloadIfNew(url, QDateTime(QDate(2017, 6, 1), QTime(12, 00, 0, 0)), QByteArrayLiteral("\"old\""));
+			QCOMPARE(replySpy.count(), 1);
+
+			downloader->downloadIfNew(url, QDateTime(QDate(2017, 6, 1), QTime(12, 00, 0, 0)), QByteArrayLiteral("\"other\""));
+			QCOMPARE(replySpy.count(), 2);
+			QCOMPARE(Env::getSingleton<NetworkManager, MockNetworkManager>()->getLastRequest()->rawHeader(QByteArray("If-None-Match")), QByteArray("\"other\""));
+
+			downloader->download(url);
+			QCOMPARE(replySpy.count(), 3);
+			QNetworkRequest* const lastRequest = Env::getSingleton<NetworkManager, MockNetworkManager>()->getLastRequest();
+			QVERIFY(!lastRequest->hasRawHeader(QByteArray("If-Modified-Since")));
+			QVERIFY(!lastRequest->hasRawHeader(QByteArray("If-None-Match")));
+		}
+
+
+		void downloadMakesPendingRequestUnconditional()
+		{
+			Downloader* const downloader = Env::getSingleton<Downloader>();
+			QSignalSpy replySpy(Env::getSingleton<NetworkManager, MockNetworkManager>(), &MockNetworkManager::fireReply);
+
+			const int maxConnections = Downloader::cMaxConnectionsPerHost;
+			for (int i = 0; i < maxConnections; ++i)
+			{
+				downloader->download(QUrl(QStringLiteral("http://server/reader/icons/icon%1.png").arg(i)));
+			}
+
+			const QUrl url("http://server/reader/icons/icon.png");
+			downloader->downloadIfNew(url, QDateTime(QDate(2017, 6, 1), QTime(12, 00, 0, 0)), QByteArrayLiteral("\"old\""));
+			downloader->download(url);
+			QCOMPARE(replySpy.count(), maxConnections);
+			QCOMPARE(downloader->mPendingRequests.size(), 1);
+
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->fireFinished();
+			QCOMPARE(replySpy.count(), maxConnections + 1);
+			QNetworkRequest* const lastRequest = Env::getSingleton<NetworkManager, MockNetworkManager>()->getLastRequest();
+			QCOMPARE(lastRequest->url(), url);
+			QVERIFY(!lastRequest->hasRawHeader(QByteArray("If-Modified-Since")));
+			QVERIFY(!lastRequest->hasRawHeader(QByteArray("If-None-Match")));
+		}
+
+
+		void limitParallelDownloadsPerHost()
+		{
+			Downloader* const downloader = Env::getSingleton<Downloader>();
+			QSignalSpy replySpy(Env::getSingleton<NetworkManager, MockNetworkManager>(), &MockNetworkManager::fireReply);
+
+			const int maxConnections = Downloader::cMaxConnectionsPerHost;
+			downloader->download(QUrl(QStringLiteral("http://other/reader/icons/icon.png")));
+			for (int i = 0; i <= maxConnections; ++i)
+			{
+				downloader->download(QUrl(QStringLiteral("http://server/reader/icons/icon%1.png").arg(i)));
+			}
+			QCOMPARE(replySpy.count(), maxConnections + 1);
+			QCOMPARE(downloader->mPendingRequests.size(), 1);
+
+			Env::getSingleton<NetworkManager, MockNetworkManager>()->fireFinished();
+			QCOMPARE(replySpy.count(), maxConnections + 2);
+			QVERIFY(downloader->mPendingRequests.isEmpty());
 		}
 
 
@@ -141,11 +141,12 @@ class test_UpdatableFile
 
 			QVERIFY(!updatableFile.isDirty());
 
+			// Changes of other processes are noticed by the file watcher of the manifest
 			touchFileInCache(dirtyFilename, updatableFile);
-			QVERIFY(updatableFile.isDirty());
+			QTRY_VERIFY(updatableFile.isDirty());
 
 			removeFileFromCache(dirtyFilename, updatableFile);
-			QVERIFY(!updatableFile.isDirty());
+			QTRY_VERIFY(!updatableFile.isDirty());
 		}
 
 
@@ -161,7 +162,7 @@ class test_UpdatableFile
 			QVERIFY(updatableFile.isDirty());
 
 			removeFileFromCache(dirtyFilename, updatableFile);
-			QVERIFY(!updatableFile.isDirty());
+			QTRY_VERIFY(!updatableFile.isDirty());
 		}
 
 
@@ -224,7 +225,7 @@ class test_UpdatableFile
 			QSignalSpy spy(&updatableFile, &UpdatableFile::fireUpdated);
 			QCOMPARE(updatableFile.lookupPath(), QStringLiteral(":/updatable-files/reader/img_ACS_ACR1252U.png"));
 
-			QCOMPARE(spy.count(), 1);
+			QTRY_COMPARE(spy.count(), 1);
 			QVERIFY(!updatableFile.isDirty());
 			QCOMPARE(updatableFile.lookupPath(), updatableFile.getSectionCachePath() + mSep + filenameInCache);
 		}
@@ -245,7 +246,7 @@ class test_UpdatableFile
 
 			updatableFile.update();
 
-			QCOMPARE(spy.count(), 1);
+			QTRY_COMPARE(spy.count(), 1);
 			const QString fileName = updatableFile.getName() + QLatin1Char('_') + downloader.getTimeStampString();
 			const QString filePath = updatableFile.getSectionCachePath() + "/" + fileName;
 			QFile testfile(filePath);
@@ -277,6 +278,101 @@ class test_UpdatableFile
 		}
 
 
+		void testManifestIsLoadedOnce()
+		{
+			const QString filename("img_ACS_ACR1252V.png");
+			const QString filenameInCache = filename + QStringLiteral("_20170601102132");
+			UpdatableFile updatableFile(mSection, filename, QStringLiteral("DEFAULT_TEST"));
+			touchFileInCache(filenameInCache, updatableFile);
+			QTest::qWait(100);
+
+			const int loadCount = updatableFile.mManifest->mLoadCount;
+			for (int i = 0; i < 100; ++i)
+			{
+				QCOMPARE(updatableFile.lookupPath(), updatableFile.getSectionCachePath() + mSep + filenameInCache);
+				QVERIFY(!updatableFile.isDirty());
+			}
+			QVERIFY(updatableFile.mManifest->mLoadCount - loadCount <= 1);
+
+			removeFileFromCache(filenameInCache, updatableFile);
+			QTRY_COMPARE(updatableFile.lookupPath(), QStringLiteral("DEFAULT_TEST"));
+		}
+
+
+		void testManifestIsSharedBySection()
+		{
+			UpdatableFile updatableFile1(mSection, QStringLiteral("img_ACS_ACR1252U.png"));
+			UpdatableFile updatableFile2(mSection, QStringLiteral("img_ACS_ACR1252V.png"));
+			UpdatableFile updatableFile3(QStringLiteral("provider"), QStringLiteral("img_ACS_ACR1252V.png"));
+
+			QVERIFY(updatableFile1.mManifest);
+			QCOMPARE(updatableFile1.mManifest, updatableFile2.mManifest);
+			QVERIFY(updatableFile1.mManifest != updatableFile3.mManifest);
+		}
+
+
+		void testManifestIsUpdatedByDownload()
+		{
+			MockDownloader downloader;
+			Env::set(Downloader::staticMetaObject, &downloader);
+
+			const QString filename("img_updatetest.png");
+			UpdatableFile updatableFile(mSection, filename, QStringLiteral("DEFAULT_TEST"));
+			QCOMPARE(updatableFile.lookupPath(), QStringLiteral("DEFAULT_TEST"));
+			downloader.setTestData(updatableFile.updateUrl(mSection, filename), QByteArray("Testdata"));
+
+			QSignalSpy spy(&updatableFile, &UpdatableFile::fireUpdated);
+			updatableFile.update();
+			QTRY_COMPARE(spy.count(), 1);
+
+			// No need to wait for the file watcher
+			const QString fileName = filename + QLatin1Char('_') + downloader.getTimeStampString();
+			QCOMPARE(updatableFile.lookupPath(), updatableFile.getSectionCachePath() + mSep + fileName);
+
+			removeFileFromCache(fileName, updatableFile);
+		}
+
+
+		void benchmarkLookup_data()
+		{
+			QTest::addColumn<int>("count");
+
+			QTest::newRow("100") << 100;
+			QTest::newRow("2500") << 2500;
+		}
+
+
+		void benchmarkLookup()
+		{
+			QFETCH(int, count);
+
+			const QString section = QStringLiteral("benchmark");
+			QVector<QSharedPointer<UpdatableFile> > files;
+			for (int i = 0; i < count; ++i)
+			{
+				const QString name = QStringLiteral("provider_icon_%1.svg").arg(i);
+				const QSharedPointer<UpdatableFile> file(new UpdatableFile(section, name, QStringLiteral("DEFAULT")));
+				if (i % 2 == 0)
+				{
+					QFile cacheFile(file->getSectionCachePath() + mSep + name + QStringLiteral("_20170601102132"));
+					QVERIFY(cacheFile.open(QIODevice::WriteOnly));
+				}
+				files += file;
+			}
+
+			QBENCHMARK {
+				for (const auto& file : qAsConst(files))
+				{
+					file->lookupPath();
+				}
+			}
+
+			QCOMPARE(files.at(0)->lookupPath(), files.at(0)->getSectionCachePath() + QStringLiteral("/provider_icon_0.svg_20170601102132"));
+			QCOMPARE(files.at(1)->lookupPath(), QStringLiteral("DEFAULT"));
+			QVERIFY(QDir(files.at(0)->getSectionCachePath()).removeRecursively());
+		}
+
+
 	public:
 		test_UpdatableFile()
 			: mSection("reader")
@@ -621,6 +621,73 @@ class test_Env
 		}
 
 
+		void mockAfterLookup()
+		{
+			// The slot of a type must not hide a later override
+			QScopedPointer<AbstractTestInstance> obj(Env::create<AbstractTestInstance*>());
+			QCOMPARE(obj->dummy(), QLatin1String("impl"));
+			auto orig = Env::getSingleton<TestInstance>();
+			QCOMPARE(orig->something(), QLatin1String("orig"));
+
+			TestMockedInstance mock;
+			Env::set(TestInstance::staticMetaObject, &mock);
+			Env::setCreator<AbstractTestInstance*>(std::function<AbstractTestInstance*()>([](){
+						return new MockedAbstractTestInstance();
+					}));
+			QCOMPARE(Env::getSingleton<TestInstance>(), static_cast<TestInstance*>(&mock));
+			obj.reset(Env::create<AbstractTestInstance*>());
+			QCOMPARE(obj->dummy(), QLatin1String("mocked"));
+
+			Env::clear();
+			QCOMPARE(Env::getSingleton<TestInstance>(), orig);
+			obj.reset(Env::create<AbstractTestInstance*>());
+			QCOMPARE(obj->dummy(), QLatin1String("impl"));
+		}
+
+
+		void benchmarkSingleton_data()
+		{
+			QTest::addColumn<bool>("slot");
+
+			QTest::newRow("slot") << true;
+			QTest::newRow("map") << false;
+		}
+
+
+		void benchmarkSingleton()
+		{
+			QFETCH(bool, slot);
+
+			// Some more entries like in a running application
+			Env::getSingleton<AbstractTestInstance>();
+			Env::getSingleton<TestAbstractUnmanagedInstance>();
+			const auto expected = Env::getSingleton<TestInstance>();
+			const auto id = TestInstance::staticMetaObject.className();
+
+			quintptr sum = 0;
+			if (slot)
+			{
+				QBENCHMARK {
+					for (int i = 0; i < 10000; ++i)
+					{
+						sum += reinterpret_cast<quintptr>(Env::getSingleton<TestInstance>());
+					}
+				}
+			}
+			else
+			{
+				QBENCHMARK {
+					for (int i = 0; i < 10000; ++i)
+					{
+						sum += reinterpret_cast<quintptr>(Env::getInstance().fetchStoredSingleton(id));
+					}
+				}
+			}
+			QVERIFY(sum != 0);
+			QCOMPARE(Env::getSingleton<TestInstance>(), expected);
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_Env)
@@ -7,6 +7,9 @@
 #include "Randomizer.h"
 
 #include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtTest>
 #include <random>
 
@@ -18,16 +21,23 @@ class test_Randomizer
 	Q_OBJECT
 
 	private Q_SLOTS:
-		void defaultSeed()
+		void secureSeeded()
 		{
-			QVERIFY(Randomizer::getInstance().getGenerator().default_seed == 5489u);
+			Randomizer& randomizer = Randomizer::getInstance();
+			QVERIFY(randomizer.isSecureRandom());
 		}
 
 
-		void secureSeeded()
+		void unixoidEntropy()
 		{
-			Randomizer& randomizer = Randomizer::getInstance();
-			QVERIFY(randomizer.isSecureRandom());
+#ifndef Q_OS_LINUX
+			QSKIP("getrandom is only available on Linux");
+#endif
+
+			// A failed call must not add the untouched buffer as entropy
+			const auto& entropy = Randomizer::getEntropyUnixoid<quint64>();
+			QCOMPARE(entropy.size(), 1);
+			QVERIFY(entropy.first() != 0);
 		}
 
 
@@ -48,6 +58,160 @@ class test_Randomizer
 		}
 
 
+		void createBytes()
+		{
+			auto& randomizer = Randomizer::getInstance();
+			const int count = 3 * RandomGenerator::BUFFER_SIZE + 17;
+
+			const QByteArray bytes1 = randomizer.createBytes(count);
+			const QByteArray bytes2 = randomizer.createBytes(count);
+			QCOMPARE(bytes1.size(), count);
+			QCOMPARE(bytes2.size(), count);
+			QVERIFY(bytes1 != bytes2);
+			QVERIFY(bytes1.count('\0') < count / 64);
+			QVERIFY(randomizer.createBytes(0).isEmpty());
+		}
+
+
+		void createPin()
+		{
+			auto& randomizer = Randomizer::getInstance();
+
+			QSet<QByteArray> pins;
+			for (int i = 0; i < 100; ++i)
+			{
+				const QByteArray pin = randomizer.createPin(4);
+				QCOMPARE(pin.size(), 4);
+				for (const char digit : pin)
+				{
+					QVERIFY(digit >= '0' && digit <= '9');
+				}
+				pins += pin;
+			}
+			QVERIFY(pins.size() > 90);
+		}
+
+
+		void createNumber()
+		{
+			auto& randomizer = Randomizer::getInstance();
+			for (int i = 0; i < 1000; ++i)
+			{
+				const long serial = randomizer.createNumber<long>(1);
+				QVERIFY(serial >= 1);
+
+				const int number = randomizer.createNumber<int>(5, 7);
+				QVERIFY(number >= 5 && number <= 7);
+			}
+		}
+
+
+		void forwardSecrecy()
+		{
+			RandomGenerator generator(QByteArrayLiteral("seed"));
+			generator();
+			const QByteArray key = generator.mKey;
+
+			QByteArray output(RandomGenerator::BUFFER_SIZE / 2, '\0');
+			generator.fill(output.data(), output.size());
+
+			// Returned bytes are wiped from the buffer
+			QCOMPARE(generator.mBuffer.left(generator.mPosition), QByteArray(generator.mPosition, '\0'));
+			QCOMPARE(generator.mKey, key);
+
+			// The key is replaced on every refill
+			generator.fill(output.data(), output.size());
+			QVERIFY(generator.mKey != key);
+			QCOMPARE(generator.mKey.size(), 32);
+		}
+
+
+		void systemRandomMixedIn()
+		{
+			RandomGenerator generator1(QByteArrayLiteral("seed"));
+			RandomGenerator generator2(QByteArrayLiteral("seed"));
+			QVERIFY(generator1.mKey != generator2.mKey);
+			QVERIFY(generator1() != generator2());
+		}
+
+
+		void generatorPerThread()
+		{
+			const int threadCount = 8;
+			const int blockSize = 16;
+			const int blockCount = 4096;
+
+			QThreadPool pool;
+			pool.setMaxThreadCount(threadCount);
+			QAtomicInt running;
+
+			QVector<QFuture<QPair<quintptr, QByteArray> > > futures;
+			for (int i = 0; i < threadCount; ++i)
+			{
+				futures += QtConcurrent::run(&pool, [&running] {
+							// Wait for all threads to use the generators concurrently
+							running.fetchAndAddOrdered(1);
+							while (running.loadAcquire() < threadCount)
+							{
+								QThread::yieldCurrentThread();
+							}
+
+							auto& randomizer = Randomizer::getInstance();
+							QByteArray bytes;
+							for (int j = 0; j < blockCount; ++j)
+							{
+								bytes += randomizer.createBytes(blockSize);
+							}
+							return qMakePair(reinterpret_cast<quintptr>(&randomizer.getGenerator()), bytes);
+						});
+			}
+
+			QSet<quintptr> generators;
+			QSet<QByteArray> blocks;
+			for (auto& future : futures)
+			{
+				const auto& result = future.result();
+				generators += result.first;
+				QCOMPARE(result.second.size(), blockSize * blockCount);
+				for (int j = 0; j < blockCount; ++j)
+				{
+					blocks += result.second.mid(j * blockSize, blockSize);
+				}
+			}
+
+			QCOMPARE(generators.size(), threadCount);
+			QCOMPARE(blocks.size(), threadCount * blockCount);
+		}
+
+
+		void benchmarkThroughput_data()
+		{
+			QTest::addColumn<bool>("buffered");
+
+			QTest::newRow("mt19937") << false;
+			QTest::newRow("buffered") << true;
+		}
+
+
+		void benchmarkThroughput()
+		{
+			QFETCH(bool, buffered);
+
+			const int count = 1024 * 1024 / 4;
+			std::mt19937 mt19937(std::random_device()());
+			auto& generator = Randomizer::getInstance().getGenerator();
+
+			quint32 result = 0;
+			QBENCHMARK {
+				for (int i = 0; i < count; ++i)
+				{
+					result ^= buffered ? generator() : static_cast<quint32>(mt19937());
+				}
+			}
+			Q_UNUSED(result);
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_Randomizer)
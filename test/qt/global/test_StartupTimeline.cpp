@@ -0,0 +1,173 @@
+/*!
+ * \brief Unit tests for \ref StartupTimeline
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "StartupTimeline.h"
+
+#include <QThread>
+#include <QThreadPool>
+#include <QtTest/QtTest>
+
+using namespace governikus;
+
+using Execution = StartupTimeline::Execution;
+
+class test_StartupTimeline
+	: public QObject
+{
+	Q_OBJECT
+
+	private Q_SLOTS:
+		void blockingSteps()
+		{
+			StartupTimeline timeline;
+			QSignalSpy spy(&timeline, &StartupTimeline::fireStepFinished);
+			QStringList executed;
+
+			timeline.addStep(QStringLiteral("first"), Execution::BLOCKING, [&executed](){
+						executed += QStringLiteral("first");
+						return true;
+					});
+			timeline.addStep(QStringLiteral("second"), Execution::BLOCKING, [&executed](){
+						executed += QStringLiteral("second");
+						return true;
+					}, {QStringLiteral("first")});
+
+			QVERIFY(timeline.run());
+			QCOMPARE(executed, QStringList({QStringLiteral("first"), QStringLiteral("second")}));
+			QCOMPARE(spy.count(), 2);
+			QCOMPARE(spy.at(0).at(0).toString(), QStringLiteral("first"));
+			QVERIFY(spy.at(0).at(3).toBool());
+			QVERIFY(spy.at(1).at(1).toLongLong() >= spy.at(0).at(1).toLongLong() + spy.at(0).at(2).toLongLong());
+		}
+
+
+		void failingBlockingStep()
+		{
+			StartupTimeline timeline;
+			bool executed = false;
+
+			timeline.addStep(QStringLiteral("fail"), Execution::BLOCKING, [](){
+						return false;
+					});
+			timeline.addStep(QStringLiteral("never"), Execution::BLOCKING, [&executed](){
+						executed = true;
+						return true;
+					});
+
+			QTest::ignoreMessage(QtCriticalMsg, QRegularExpression(QStringLiteral("^Startup step \"fail\" failed after")));
+			QVERIFY(!timeline.run());
+			QVERIFY(!executed);
+		}
+
+
+		void concurrentStep()
+		{
+			StartupTimeline timeline;
+			QThread* workerThread = nullptr;
+			QThread* blockingThread = nullptr;
+			bool dependencyFinished = false;
+
+			timeline.addStep(QStringLiteral("concurrent"), Execution::CONCURRENT, [&workerThread](){
+						QThread::msleep(50);
+						workerThread = QThread::currentThread();
+						return true;
+					});
+			timeline.addStep(QStringLiteral("blocking"), Execution::BLOCKING, [&workerThread, &blockingThread, &dependencyFinished](){
+						dependencyFinished = workerThread != nullptr;
+						blockingThread = QThread::currentThread();
+						return true;
+					}, {QStringLiteral("concurrent")});
+
+			QVERIFY(timeline.run());
+			QVERIFY(dependencyFinished);
+			QCOMPARE(blockingThread, QThread::currentThread());
+			QVERIFY(workerThread != QThread::currentThread());
+		}
+
+
+		void failingConcurrentDependency()
+		{
+			StartupTimeline timeline;
+			bool executed = false;
+
+			timeline.addStep(QStringLiteral("concurrent"), Execution::CONCURRENT, [](){
+						return false;
+					});
+			timeline.addStep(QStringLiteral("blocking"), Execution::BLOCKING, [&executed](){
+						executed = true;
+						return true;
+					}, {QStringLiteral("concurrent")});
+
+			QTest::ignoreMessage(QtCriticalMsg, QRegularExpression(QStringLiteral("^Startup step \"concurrent\" failed after")));
+			QTest::ignoreMessage(QtCriticalMsg, "Cannot run startup step \"blocking\" because a dependency failed");
+			QVERIFY(!timeline.run());
+			QVERIFY(!executed);
+		}
+
+
+		void concurrentStepsOverlap()
+		{
+			if (QThreadPool::globalInstance()->maxThreadCount() < 2)
+			{
+				QSKIP("Thread pool cannot run two steps at once");
+			}
+
+			StartupTimeline timeline;
+			QSignalSpy spy(&timeline, &StartupTimeline::fireStepFinished);
+			const auto sleep = [](){
+						QThread::msleep(200);
+						return true;
+					};
+
+			timeline.addStep(QStringLiteral("first"), Execution::CONCURRENT, sleep);
+			timeline.addStep(QStringLiteral("second"), Execution::CONCURRENT, sleep);
+			timeline.addStep(QStringLiteral("join"), Execution::BLOCKING, [](){
+						return true;
+					}, {QStringLiteral("first"), QStringLiteral("second")});
+
+			QVERIFY(timeline.run());
+			QTRY_COMPARE(spy.count(), 3);
+			QVERIFY(timeline.elapsed() < 400);
+		}
+
+
+		void deferredSteps()
+		{
+			StartupTimeline timeline;
+			QSignalSpy readySpy(&timeline, &StartupTimeline::fireReady);
+			QSignalSpy finishedSpy(&timeline, &StartupTimeline::fireDeferredStepsFinished);
+			QStringList executed;
+
+			timeline.addStep(QStringLiteral("blocking"), Execution::BLOCKING, [&executed](){
+						executed += QStringLiteral("blocking");
+						return true;
+					});
+			timeline.addStep(QStringLiteral("deferred1"), Execution::DEFERRED, [&executed](){
+						executed += QStringLiteral("deferred1");
+						return true;
+					}, {QStringLiteral("blocking")});
+			timeline.addStep(QStringLiteral("deferred2"), Execution::DEFERRED, [&executed](){
+						executed += QStringLiteral("deferred2");
+						return true;
+					}, {QStringLiteral("deferred1")});
+
+			QVERIFY(timeline.run());
+			QCOMPARE(executed, QStringList({QStringLiteral("blocking")}));
+
+			timeline.ready();
+			timeline.ready();
+			QCOMPARE(readySpy.count(), 1);
+			QCOMPARE(executed.size(), 1);
+
+			QTRY_COMPARE(finishedSpy.count(), 1);
+			QCOMPARE(executed, QStringList({QStringLiteral("blocking"), QStringLiteral("deferred1"), QStringLiteral("deferred2")}));
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_StartupTimeline)
+#include "test_StartupTimeline.moc"
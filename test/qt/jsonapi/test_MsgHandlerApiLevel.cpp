@@ -23,7 +23,7 @@ class test_MsgHandlerApiLevel
 			MsgContext context;
 			context.setApiLevel(MsgLevel::v1);
 			MsgHandlerApiLevel msg(qAsConst(context));
-			QCOMPARE(msg.toJson(), QByteArray("{\"available\":[1],\"current\":1,\"msg\":\"API_LEVEL\"}"));
+			QCOMPARE(msg.toJson(), QByteArray("{\"available\":[1,2],\"current\":1,\"msg\":\"API_LEVEL\"}"));
 		}
 
 
@@ -32,7 +32,7 @@ class test_MsgHandlerApiLevel
 			MsgContext context;
 			context.setApiLevel(MsgHandler::DEFAULT_MSG_LEVEL);
 			MsgHandlerApiLevel msg(qAsConst(context));
-			QCOMPARE(msg.toJson(), QByteArray("{\"available\":[1],\"current\":1,\"msg\":\"API_LEVEL\"}"));
+			QCOMPARE(msg.toJson(), QByteArray("{\"available\":[1,2],\"current\":1,\"msg\":\"API_LEVEL\"}"));
 		}
 
 
@@ -40,7 +40,7 @@ class test_MsgHandlerApiLevel
 		{
 			MessageDispatcher dispatcher;
 			QByteArray msg = "{\"cmd\": \"GET_API_LEVEL\"}";
-			QCOMPARE(dispatcher.processCommand(msg), QByteArray("{\"available\":[1],\"current\":1,\"msg\":\"API_LEVEL\"}"));
+			QCOMPARE(dispatcher.processCommand(msg), QByteArray("{\"available\":[1,2],\"current\":1,\"msg\":\"API_LEVEL\"}"));
 		}
 
 
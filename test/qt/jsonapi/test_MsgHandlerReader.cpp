@@ -123,6 +123,55 @@ class test_MsgHandlerReader
 		}
 
 
+		void changedFieldsOnly()
+		{
+			ReaderInfo info(QStringLiteral("MockReader 0815"));
+			info.setConnected(true);
+
+			const MsgHandlerReader added(info, QJsonObject());
+			QCOMPARE(added.toJson(), QByteArray("{\"attached\":true,\"card\":null,\"msg\":\"READER\",\"name\":\"MockReader 0815\"}"));
+
+			const MsgHandlerReader unchanged(info, MsgHandlerReader::createReaderInfo(info));
+			QVERIFY(unchanged.isVoid());
+			QVERIFY(unchanged.getOutput().isEmpty());
+
+			ReaderInfo cardInserted(QStringLiteral("MockReader 0815"), ReaderManagerPlugInType::UNKNOWN, CardInfo(CardType::EID_CARD, QSharedPointer<const EFCardAccess>(), 3));
+			cardInserted.setConnected(true);
+			const MsgHandlerReader inserted(cardInserted, MsgHandlerReader::createReaderInfo(info));
+			QCOMPARE(inserted.toJson(), QByteArray("{\"card\":{\"deactivated\":false,\"inoperative\":false,\"retryCounter\":3},\"msg\":\"READER\",\"name\":\"MockReader 0815\"}"));
+
+			const ReaderInfo removed(QStringLiteral("MockReader 0815"));
+			const MsgHandlerReader detached(removed, MsgHandlerReader::createReaderInfo(cardInserted));
+			QCOMPARE(detached.toJson(), QByteArray("{\"attached\":false,\"card\":null,\"msg\":\"READER\",\"name\":\"MockReader 0815\"}"));
+		}
+
+
+		void changedFieldsOnlyWithApiLevel()
+		{
+			MockReader* reader = MockReaderManagerPlugIn::getInstance().addReader("MockReader 0815");
+
+			MessageDispatcher dispatcher;
+			const QByteArray expected("{\"attached\":true,\"card\":null,\"msg\":\"READER\",\"name\":\"MockReader 0815\"}");
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), expected);
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), expected);
+
+			dispatcher.processCommand("{\"cmd\": \"SET_API_LEVEL\", \"level\": 2}");
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), expected);
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), QByteArray());
+
+			reader->setCard(MockCardConfig());
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), QByteArray("{\"card\":{\"deactivated\":false,\"inoperative\":false,\"retryCounter\":-1},\"msg\":\"READER\",\"name\":\"MockReader 0815\"}"));
+
+			// the full state is sent again after switching back and forth
+			dispatcher.processCommand("{\"cmd\": \"SET_API_LEVEL\", \"level\": 1}");
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), QByteArray("{\"attached\":true,\"card\":{\"deactivated\":false,\"inoperative\":false,\"retryCounter\":-1},\"msg\":\"READER\",\"name\":\"MockReader 0815\"}"));
+			dispatcher.processCommand("{\"cmd\": \"SET_API_LEVEL\", \"level\": 2}");
+			QCOMPARE(dispatcher.createMsgReader(QStringLiteral("MockReader 0815")), QByteArray("{\"attached\":true,\"card\":{\"deactivated\":false,\"inoperative\":false,\"retryCounter\":-1},\"msg\":\"READER\",\"name\":\"MockReader 0815\"}"));
+
+			MockReaderManagerPlugIn::getInstance().removeReader("MockReader 0815");
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_MsgHandlerReader)
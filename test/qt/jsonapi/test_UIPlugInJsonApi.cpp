@@ -0,0 +1,183 @@
+/*!
+ * \brief Unit tests for \ref UIPlugInJsonApi
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "UIPlugInJsonApi.h"
+
+#include "MockReaderManagerPlugIn.h"
+#include "ReaderManager.h"
+
+#include <QElapsedTimer>
+#include <QtTest>
+
+Q_IMPORT_PLUGIN(MockReaderManagerPlugIn)
+
+using namespace governikus;
+
+class test_UIPlugInJsonApi
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		static void fireReaderEvents(int pRounds, const QStringList& pReaderNames)
+		{
+			auto& readerManager = ReaderManager::getInstance();
+			for (int i = 0; i < pRounds; ++i)
+			{
+				for (const auto& name : pReaderNames)
+				{
+					Q_EMIT readerManager.fireCardInserted(name);
+					Q_EMIT readerManager.fireCardRemoved(name);
+				}
+			}
+		}
+
+
+		static void setApiLevel(UIPlugInJsonApi& pApi, int pLevel)
+		{
+			QSignalSpy spy(&pApi, &UIPlugInJsonApi::fireMessage);
+			pApi.doMessageProcessing("{\"cmd\": \"SET_API_LEVEL\", \"level\": " + QByteArray::number(pLevel) + '}');
+			QVERIFY(!spy.isEmpty());
+			QVERIFY(spy.first().at(0).toByteArray().contains("\"current\":" + QByteArray::number(pLevel)));
+		}
+
+	private Q_SLOTS:
+		void initTestCase()
+		{
+			ReaderManager::getInstance().init();
+			ReaderManager::getInstance().getPlugInInfos(); // just to wait until initialization finished
+			MockReaderManagerPlugIn::getInstance().addReader("MockReader 0815");
+			MockReaderManagerPlugIn::getInstance().addReader("MockReader 4711");
+		}
+
+
+		void cleanupTestCase()
+		{
+			ReaderManager::getInstance().shutdown();
+		}
+
+
+		void coalesceReaderEvents()
+		{
+			UIPlugInJsonApi api;
+			setApiLevel(api, 2);
+			QSignalSpy spy(&api, &UIPlugInJsonApi::fireMessage);
+
+			fireReaderEvents(50, {QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 4711")});
+			QCOMPARE(spy.count(), 0);
+
+			QTRY_COMPARE(spy.count(), 2);
+			QVERIFY(spy.at(0).at(0).toByteArray().contains("\"name\":\"MockReader 0815\""));
+			QVERIFY(spy.at(1).at(0).toByteArray().contains("\"name\":\"MockReader 4711\""));
+
+			QTest::qWait(2 * UIPlugInJsonApi::READER_EVENT_INTERVAL);
+			QCOMPARE(spy.count(), 2);
+		}
+
+
+		void disabledCoalescing()
+		{
+			UIPlugInJsonApi api;
+			setApiLevel(api, 2);
+			api.setReaderEventInterval(0);
+			QSignalSpy spy(&api, &UIPlugInJsonApi::fireMessage);
+
+			fireReaderEvents(5, {QStringLiteral("MockReader 0815")});
+			QCOMPARE(spy.count(), 10);
+		}
+
+
+		void noCoalescingBelowApiLevel2()
+		{
+			UIPlugInJsonApi api;
+			QSignalSpy spy(&api, &UIPlugInJsonApi::fireMessage);
+
+			fireReaderEvents(5, {QStringLiteral("MockReader 0815")});
+			QCOMPARE(spy.count(), 10);
+			for (const auto& param : qAsConst(spy))
+			{
+				QVERIFY(param.at(0).toByteArray().contains("\"attached\":true"));
+			}
+
+			QTest::qWait(2 * UIPlugInJsonApi::READER_EVENT_INTERVAL);
+			QCOMPARE(spy.count(), 10);
+		}
+
+
+		void flushPendingEventsOnDisable()
+		{
+			UIPlugInJsonApi api;
+			setApiLevel(api, 2);
+			QSignalSpy spy(&api, &UIPlugInJsonApi::fireMessage);
+
+			fireReaderEvents(5, {QStringLiteral("MockReader 0815")});
+			QCOMPARE(spy.count(), 0);
+
+			api.setReaderEventInterval(0);
+			QCOMPARE(spy.count(), 1);
+		}
+
+
+		void flushPendingEventsOnApiLevel1()
+		{
+			UIPlugInJsonApi api;
+			setApiLevel(api, 2);
+			QSignalSpy spy(&api, &UIPlugInJsonApi::fireMessage);
+
+			fireReaderEvents(5, {QStringLiteral("MockReader 0815")});
+			QCOMPARE(spy.count(), 0);
+
+			setApiLevel(api, 1);
+			QCOMPARE(spy.count(), 2);
+			QVERIFY(spy.at(1).at(0).toByteArray().contains("\"name\":\"MockReader 0815\""));
+		}
+
+
+		void eventStorm_data()
+		{
+			QTest::addColumn<int>("interval");
+
+			QTest::newRow("immediate") << 0;
+			QTest::newRow("coalesced") << UIPlugInJsonApi::READER_EVENT_INTERVAL;
+		}
+
+
+		void eventStorm()
+		{
+			QFETCH(int, interval);
+
+			const QStringList readerNames({QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 4711")});
+			const int rounds = 500;
+			const int events = rounds * readerNames.size() * 2;
+
+			UIPlugInJsonApi api;
+			setApiLevel(api, 2);
+			api.setReaderEventInterval(interval);
+			QSignalSpy spy(&api, &UIPlugInJsonApi::fireMessage);
+
+			QElapsedTimer timer;
+			timer.start();
+			fireReaderEvents(rounds, readerNames);
+			const qint64 emitTime = timer.elapsed();
+
+			QTRY_VERIFY(spy.count() >= readerNames.size());
+			if (interval > 0)
+			{
+				QCOMPARE(spy.count(), readerNames.size());
+			}
+			else
+			{
+				QCOMPARE(spy.count(), events);
+			}
+
+			QTest::setBenchmarkResult(emitTime, QTest::WalltimeMilliseconds);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_UIPlugInJsonApi)
+#include "test_UIPlugInJsonApi.moc"
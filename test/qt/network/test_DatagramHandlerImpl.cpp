@@ -195,6 +195,42 @@ class test_DatagramHandlerImpl
 		}
 
 
+		void cacheSerializedData()
+		{
+			QSharedPointer<DatagramHandlerImpl> datagramHandlerImpl = QSharedPointer<DatagramHandler>(Env::create<DatagramHandler*>(false)).dynamicCast<DatagramHandlerImpl>();
+			QVERIFY(datagramHandlerImpl);
+
+			QJsonObject obj;
+			obj["test"] = "dummy";
+			const QJsonDocument doc(obj);
+
+			const auto& data = datagramHandlerImpl->serialize(doc);
+			QCOMPARE(data, QByteArray("{\"test\":\"dummy\"}"));
+			QCOMPARE(datagramHandlerImpl->serialize(doc).constData(), data.constData());
+
+			obj["test"] = "other";
+			QCOMPARE(datagramHandlerImpl->serialize(QJsonDocument(obj)), QByteArray("{\"test\":\"other\"}"));
+		}
+
+
+		void cacheBroadcastAddresses()
+		{
+			QSharedPointer<DatagramHandlerImpl> datagramHandlerImpl = QSharedPointer<DatagramHandler>(Env::create<DatagramHandler*>(false)).dynamicCast<DatagramHandlerImpl>();
+			QVERIFY(datagramHandlerImpl);
+			QVERIFY(!datagramHandlerImpl->mBroadcastAddressesAge.isValid());
+
+			datagramHandlerImpl->getBroadcastAddresses();
+			QVERIFY(datagramHandlerImpl->mBroadcastAddressesAge.isValid());
+
+			const QHostAddress dummy(QStringLiteral("192.0.2.255"));
+			datagramHandlerImpl->mBroadcastAddresses = {dummy};
+			QCOMPARE(datagramHandlerImpl->getBroadcastAddresses(), QVector<QHostAddress>({dummy}));
+
+			datagramHandlerImpl->invalidateBroadcastAddresses();
+			QVERIFY(!datagramHandlerImpl->getBroadcastAddresses().contains(dummy));
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_DatagramHandlerImpl)
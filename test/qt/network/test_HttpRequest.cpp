@@ -86,6 +86,102 @@ class test_HttpRequest
 		}
 
 
+		void splitHeader()
+		{
+			MockSocket* socket = new MockSocket;
+			socket->mReaderBufferChunk = 3;
+			socket->mReadBuffer = QByteArray("GET /eID-Client?status HTTP/1.1\r\n"
+											 "Host: 127.0.0.1:24727\r\n"
+											 "X-Empty:\r\n"
+											 "Accept: text/html\r\n"
+											 "accept: application/json\r\n"
+											 "\r\n");
+
+			HttpRequest request(socket);
+			QCOMPARE(request.getHeader().size(), 4);
+			QCOMPARE(request.getHeader().at(0).first, QByteArray("host"));
+			QCOMPARE(request.getHeader("host"), QByteArray("127.0.0.1:24727"));
+			QCOMPARE(request.getHeader().at(1).first, QByteArray("x-empty"));
+			QVERIFY(request.getHeader("x-empty").isEmpty());
+			QCOMPARE(request.getHeader("accept"), QByteArray("application/json"));
+			QVERIFY(request.getHeader("unknown").isNull());
+			QCOMPARE(request.getUrl(), QUrl("/eID-Client?status"));
+		}
+
+
+		void keepAlive_data()
+		{
+			QTest::addColumn<QByteArray>("version");
+			QTest::addColumn<QByteArray>("connection");
+			QTest::addColumn<bool>("keepAlive");
+			QTest::addColumn<QByteArray>("responseConnection");
+
+			QTest::newRow("HTTP/1.1") << QByteArray("HTTP/1.1") << QByteArray() << true << QByteArray();
+			QTest::newRow("HTTP/1.1 close") << QByteArray("HTTP/1.1") << QByteArray("Connection: close\r\n") << false << QByteArray("Connection: close\r\n");
+			QTest::newRow("HTTP/1.0") << QByteArray("HTTP/1.0") << QByteArray() << false << QByteArray("Connection: close\r\n");
+			QTest::newRow("HTTP/1.0 keep-alive") << QByteArray("HTTP/1.0") << QByteArray("Connection: keep-alive\r\n") << true << QByteArray("Connection: keep-alive\r\n");
+		}
+
+
+		void keepAlive()
+		{
+			QFETCH(QByteArray, version);
+			QFETCH(QByteArray, connection);
+			QFETCH(bool, keepAlive);
+			QFETCH(QByteArray, responseConnection);
+
+			MockSocket* socket = new MockSocket;
+			socket->mReadBuffer = "GET /eID-Client?status " + version + "\r\nHost: localhost\r\n" + connection + "\r\n";
+
+			HttpRequest request(socket);
+			QSignalSpy spy(&request, &HttpRequest::fireKeepAlive);
+			QCOMPARE(request.isKeepAlive(), keepAlive);
+
+			QVERIFY(request.send(HttpStatusCode::PROCESSING));
+			QCOMPARE(spy.count(), 0);
+			QVERIFY(!socket->mWriteBuffer.contains("Connection:"));
+
+			QVERIFY(request.send(HttpStatusCode::OK));
+			QCOMPARE(spy.count(), keepAlive ? 1 : 0);
+			QVERIFY(socket->mWriteBuffer.startsWith("HTTP/1.1 102 PROCESSING"));
+			if (responseConnection.isEmpty())
+			{
+				QVERIFY(!socket->mWriteBuffer.contains("Connection:"));
+			}
+			else
+			{
+				QVERIFY(socket->mWriteBuffer.contains(responseConnection));
+			}
+		}
+
+
+		void pipelining()
+		{
+			const QByteArray first("GET /first HTTP/1.1\r\nHost: localhost\r\n\r\n");
+			const QByteArray second("GET /second HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+			MockSocket* socket = new MockSocket;
+			socket->mReadBuffer = first + second + "GET /third";
+
+			HttpRequest firstRequest(socket);
+			QCOMPARE(firstRequest.getUrl(), QUrl("/first"));
+			QCOMPARE(firstRequest.getRequestNumber(), 1);
+			QCOMPARE(firstRequest.getPipelinedData(), second + "GET /third");
+
+			QSignalSpy spyKeepAlive(&firstRequest, &HttpRequest::fireKeepAlive);
+			QVERIFY(firstRequest.send(HttpStatusCode::OK));
+			QCOMPARE(spyKeepAlive.count(), 1);
+			const auto sharedSocket = qvariant_cast<QSharedPointer<QAbstractSocket> >(spyKeepAlive.takeFirst().at(1));
+
+			HttpRequest secondRequest(sharedSocket, firstRequest.getPipelinedData(), 2);
+			QSignalSpy spyComplete(&secondRequest, &HttpRequest::fireMessageComplete);
+			QTRY_COMPARE(spyComplete.count(), 1);
+			QCOMPARE(secondRequest.getUrl(), QUrl("/second"));
+			QCOMPARE(secondRequest.getRequestNumber(), 2);
+			QCOMPARE(secondRequest.getPipelinedData(), QByteArray("GET /third"));
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_HttpRequest)
@@ -31,7 +31,7 @@ class test_HttpResponse
 			response.setStatus(HttpStatusCode::NON_AUTHORITATIVE_INFORMATION);
 			const auto& msg = response.getMessage();
 
-			QVERIFY(msg.contains("HTTP/1.0 203 NON AUTHORITATIVE INFORMATION"));
+			QVERIFY(msg.contains("HTTP/1.1 203 NON AUTHORITATIVE INFORMATION"));
 			QVERIFY(msg.contains("Content-Length: 0"));
 			QVERIFY(msg.contains("Date: "));
 			QVERIFY(msg.contains("Server: Test_network_HttpResponse/1.2 (TR-03124-1/1.3)"));
@@ -46,7 +46,7 @@ class test_HttpResponse
 			response.setBody(QByteArray("this is dummy content"), QByteArray("text/plain"));
 			const auto& msg = response.getMessage();
 
-			QVERIFY(msg.contains("HTTP/1.0 200 OK"));
+			QVERIFY(msg.contains("HTTP/1.1 200 OK"));
 			QVERIFY(msg.contains("Content-Length: 21"));
 			QVERIFY(msg.contains("Content-Type: text/plain"));
 			QVERIFY(msg.contains("Server: Test_network_HttpResponse/1.2 (TR-03124-1/1.3)"));
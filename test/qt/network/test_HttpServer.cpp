@@ -7,6 +7,7 @@
 #include "HttpServer.h"
 
 #include "Env.h"
+#include "HttpClientHelper.h"
 #include "LogHandler.h"
 #include "MockSocket.h"
 
@@ -27,6 +28,13 @@ class test_HttpServer
 	private:
 		QNetworkAccessManager mAccessManager;
 
+		static void respondWithPath(HttpServer& pServer)
+		{
+			connect(&pServer, &HttpServer::fireNewHttpRequest, [](const QSharedPointer<HttpRequest>& pRequest){
+						pRequest->send(HttpResponse(HttpStatusCode::OK, pRequest->getUrl().toEncoded(), QByteArrayLiteral("text/plain")));
+					});
+		}
+
 	private Q_SLOTS:
 		void initTestCase()
 		{
@@ -37,6 +45,8 @@ class test_HttpServer
 		void init()
 		{
 			HttpServer::cPort = 0;
+			HttpServer::cIdleTimeout = 5000;
+			HttpServer::cMaxRequestsPerConnection = 100;
 		}
 
 
@@ -157,6 +167,136 @@ class test_HttpServer
 		}
 
 
+		void keepAlive()
+		{
+			HttpServer server;
+			respondWithPath(server);
+			QSignalSpy spyServer(&server, &HttpServer::fireNewHttpRequest);
+
+			HttpClientHelper client(server.getServerPort());
+			QCOMPARE(client.getState(), QAbstractSocket::ConnectedState);
+			for (int i = 1; i <= 3; ++i)
+			{
+				client.sendRequest("/" + QByteArray::number(i));
+				QVERIFY(client.waitForResponses(1));
+				const auto& response = client.takeResponses().first();
+				QVERIFY(response.startsWith("HTTP/1.1 200 OK"));
+				QVERIFY(!response.contains("Connection:"));
+				QVERIFY(response.endsWith("\r\n\r\n/" + QByteArray::number(i)));
+			}
+
+			QCOMPARE(spyServer.count(), 3);
+			QCOMPARE(client.getState(), QAbstractSocket::ConnectedState);
+			const auto& request = qvariant_cast<QSharedPointer<HttpRequest> >(spyServer.last().at(0));
+			QCOMPARE(request->getRequestNumber(), 3);
+		}
+
+
+		void pipelining()
+		{
+			HttpServer server;
+			respondWithPath(server);
+
+			HttpClientHelper client(server.getServerPort());
+			for (int i = 1; i <= 10; ++i)
+			{
+				client.sendRequest("/" + QByteArray::number(i));
+			}
+
+			QVERIFY(client.waitForResponses(10));
+			const auto& responses = client.takeResponses();
+			QCOMPARE(responses.size(), 10);
+			for (int i = 1; i <= 10; ++i)
+			{
+				QVERIFY(responses.at(i - 1).endsWith("\r\n\r\n/" + QByteArray::number(i)));
+			}
+			QCOMPARE(client.getState(), QAbstractSocket::ConnectedState);
+		}
+
+
+		void pipeliningWithDelayedResponse()
+		{
+			HttpServer server;
+			QVector<QSharedPointer<HttpRequest> > requests;
+			connect(&server, &HttpServer::fireNewHttpRequest, [&requests](const QSharedPointer<HttpRequest>& pRequest){
+						requests += pRequest;
+					});
+
+			HttpClientHelper client(server.getServerPort());
+			client.sendRequest("/first");
+			client.sendRequest("/second");
+
+			// The next request is not handed out before the previous one is answered
+			QTRY_COMPARE(requests.size(), 1);
+			QTest::qWait(50);
+			QCOMPARE(requests.size(), 1);
+
+			QVERIFY(requests.first()->send(HttpStatusCode::PROCESSING));
+			QTest::qWait(50);
+			QCOMPARE(requests.size(), 1);
+
+			QVERIFY(requests.first()->send(HttpStatusCode::OK));
+			QTRY_COMPARE(requests.size(), 2);
+			QCOMPARE(requests.last()->getUrl(), QUrl("/second"));
+		}
+
+
+		void maxRequestsPerConnection()
+		{
+			HttpServer::cMaxRequestsPerConnection = 2;
+			HttpServer server;
+			respondWithPath(server);
+
+			HttpClientHelper client(server.getServerPort());
+			client.sendRequest("/1");
+			client.sendRequest("/2");
+			client.sendRequest("/3");
+
+			QVERIFY(client.waitForDisconnected());
+			const auto& responses = client.takeResponses();
+			QCOMPARE(responses.size(), 2);
+			QVERIFY(!responses.at(0).contains("Connection:"));
+			QVERIFY(responses.at(1).contains("Connection: close"));
+		}
+
+
+		void connectionClose()
+		{
+			HttpServer server;
+			respondWithPath(server);
+
+			HttpClientHelper client(server.getServerPort());
+			client.sendRequest("/", "Connection: close\r\n");
+
+			QVERIFY(client.waitForDisconnected());
+			const auto& responses = client.takeResponses();
+			QCOMPARE(responses.size(), 1);
+			QVERIFY(responses.first().contains("Connection: close"));
+		}
+
+
+		void idleTimeout()
+		{
+			HttpServer::cIdleTimeout = 100;
+			HttpServer server;
+			respondWithPath(server);
+
+			HttpClientHelper client(server.getServerPort());
+			client.sendRequest("/");
+			QVERIFY(client.waitForResponses(1));
+			QCOMPARE(client.getState(), QAbstractSocket::ConnectedState);
+
+			QSignalSpy spy(&LogHandler::getInstance(), &LogHandler::fireLog);
+			QVERIFY(client.waitForDisconnected());
+			bool logged = false;
+			for (const auto& param : qAsConst(spy))
+			{
+				logged |= param.at(0).toString().contains("Close idle connection while waiting for request 2");
+			}
+			QVERIFY(logged);
+		}
+
+
 };
 
 QTEST_GUILESS_MAIN(test_HttpServer)
@@ -0,0 +1,108 @@
+/*!
+ * \brief Load tests for \ref HttpServer with a local client polling the status.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "HttpServer.h"
+
+#include "HttpClientHelper.h"
+
+#include <QElapsedTimer>
+#include <QtTest>
+
+
+using namespace governikus;
+
+
+class test_HttpServerLoad
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QScopedPointer<HttpServer> mServer;
+
+	private Q_SLOTS:
+		void initTestCase()
+		{
+			HttpServer::cPort = 0;
+			mServer.reset(new HttpServer());
+			QVERIFY(mServer->isListening());
+
+			connect(mServer.data(), &HttpServer::fireNewHttpRequest, [](const QSharedPointer<HttpRequest>& pRequest){
+						HttpResponse response(HttpStatusCode::OK);
+						response.setHeader(QByteArrayLiteral("Access-Control-Allow-Origin"), QByteArrayLiteral("*"));
+						response.setBody(QByteArrayLiteral("Implementation-Title: AusweisApp2"), QByteArrayLiteral("text/plain; charset=utf-8"));
+						pRequest->send(response);
+					});
+		}
+
+
+		void cleanupTestCase()
+		{
+			mServer.reset();
+		}
+
+
+		void statusPolls_data()
+		{
+			QTest::addColumn<int>("pollCount");
+			QTest::addColumn<int>("requestsPerConnection");
+			QTest::addColumn<int>("pipelineDepth");
+
+			QTest::newRow("connection per poll") << 1000 << 1 << 1;
+			QTest::newRow("keep-alive") << 5000 << 100 << 1;
+			QTest::newRow("keep-alive pipelined") << 5000 << 100 << 10;
+		}
+
+
+		void statusPolls()
+		{
+			QFETCH(int, pollCount);
+			QFETCH(int, requestsPerConnection);
+			QFETCH(int, pipelineDepth);
+
+			const QByteArray connectionHeader = requestsPerConnection == 1 ? QByteArrayLiteral("Connection: close\r\n") : QByteArray();
+			int connections = 0;
+
+			QElapsedTimer timer;
+			timer.start();
+			for (int polls = 0; polls < pollCount; polls += requestsPerConnection)
+			{
+				HttpClientHelper client(mServer->getServerPort());
+				QCOMPARE(client.getState(), QAbstractSocket::ConnectedState);
+				++connections;
+
+				for (int i = 0; i < requestsPerConnection; i += pipelineDepth)
+				{
+					for (int j = 0; j < pipelineDepth; ++j)
+					{
+						client.sendRequest(QByteArrayLiteral("/eID-Client?Status"), connectionHeader);
+					}
+
+					QVERIFY(client.waitForResponses(pipelineDepth));
+					const auto& responses = client.takeResponses();
+					QCOMPARE(responses.size(), pipelineDepth);
+					for (const auto& response : responses)
+					{
+						QVERIFY(response.startsWith("HTTP/1.1 200 OK"));
+						QVERIFY(response.endsWith("AusweisApp2"));
+					}
+				}
+
+				if (requestsPerConnection == HttpServer::cMaxRequestsPerConnection || requestsPerConnection == 1)
+				{
+					QVERIFY(client.waitForDisconnected());
+				}
+			}
+
+			QCOMPARE(connections, pollCount / requestsPerConnection);
+			QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_HttpServerLoad)
+#include "test_HttpServerLoad.moc"
@@ -7,6 +7,7 @@
 #include "context/SelfAuthContext.h"
 #include "controller/SelfAuthController.h"
 #include "Env.h"
+#include "KeyPair.h"
 #include "LogHandler.h"
 #include "NetworkManager.h"
 #include "SecureStorage.h"
@@ -18,10 +19,181 @@
 #include <QtNetwork>
 #include <QtTest>
 
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+
 using namespace governikus;
 
 Q_DECLARE_METATYPE(QSharedPointer<GlobalStatus> )
 
+
+/*!
+ * A https server that shares one SSL_CTX between all connections. Unlike a
+ * server based on QSslSocket it is able to resume sessions. Every request is
+ * answered with an empty response and the connection is closed afterwards.
+ */
+class ResumingTlsServer
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QTcpServer mServer;
+		QSharedPointer<SSL_CTX> mContext;
+		QHash<QTcpSocket*, SSL*> mConnections;
+		QHash<QTcpSocket*, QByteArray> mRequests;
+		int mHandshakes;
+		int mResumedHandshakes;
+
+		void flush(QTcpSocket* pSocket, SSL* pSsl)
+		{
+			char buffer[4096];
+			int length;
+			while ((length = BIO_read(SSL_get_wbio(pSsl), buffer, sizeof(buffer))) > 0)
+			{
+				pSocket->write(buffer, length);
+			}
+		}
+
+
+		void onReadyRead(QTcpSocket* pSocket)
+		{
+			SSL* const ssl = mConnections.value(pSocket);
+			const QByteArray data = pSocket->readAll();
+			BIO_write(SSL_get_rbio(ssl), data.constData(), data.size());
+
+			if (!SSL_is_init_finished(ssl))
+			{
+				const int result = SSL_do_handshake(ssl);
+				if (result == 1)
+				{
+					++mHandshakes;
+					mResumedHandshakes += SSL_session_reused(ssl) ? 1 : 0;
+				}
+				else if (SSL_get_error(ssl, result) != SSL_ERROR_WANT_READ)
+				{
+					pSocket->abort();
+					return;
+				}
+			}
+
+			if (SSL_is_init_finished(ssl))
+			{
+				char buffer[4096];
+				QByteArray& request = mRequests[pSocket];
+				int length;
+				while ((length = SSL_read(ssl, buffer, sizeof(buffer))) > 0)
+				{
+					request.append(buffer, length);
+				}
+
+				if (request.contains("\r\n\r\n"))
+				{
+					const QByteArray response("HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+					SSL_write(ssl, response.constData(), response.size());
+					SSL_shutdown(ssl);
+					flush(pSocket, ssl);
+					pSocket->disconnectFromHost();
+					return;
+				}
+			}
+
+			flush(pSocket, ssl);
+		}
+
+
+	private Q_SLOTS:
+		void onNewConnection()
+		{
+			while (QTcpSocket* socket = mServer.nextPendingConnection())
+			{
+				SSL* const ssl = SSL_new(mContext.data());
+				SSL_set_bio(ssl, BIO_new(BIO_s_mem()), BIO_new(BIO_s_mem()));
+				SSL_set_accept_state(ssl);
+				mConnections.insert(socket, ssl);
+
+				connect(socket, &QTcpSocket::readyRead, this, [this, socket] {
+							onReadyRead(socket);
+						});
+				connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+							SSL_free(mConnections.take(socket));
+							mRequests.remove(socket);
+							socket->deleteLater();
+						});
+			}
+		}
+
+
+	public:
+		ResumingTlsServer()
+			: QObject()
+			, mServer()
+			, mContext(SSL_CTX_new(SSLv23_server_method()), &SSL_CTX_free)
+			, mConnections()
+			, mRequests()
+			, mHandshakes(0)
+			, mResumedHandshakes(0)
+		{
+#ifdef SSL_OP_NO_TLSv1_3
+			// The session ticket of Qt refers to the handshake of TLS 1.2
+			SSL_CTX_set_options(mContext.data(), SSL_OP_NO_TLSv1_3);
+#endif
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+			SSL_CTX_set_ecdh_auto(mContext.data(), 1);
+#endif
+
+			const auto& pair = KeyPair::generate();
+			const QByteArray key = pair.getKey().toPem();
+			const QSharedPointer<BIO> keyBio(BIO_new_mem_buf(key.constData(), key.size()), &BIO_free);
+			const QSharedPointer<EVP_PKEY> privateKey(PEM_read_bio_PrivateKey(keyBio.data(), nullptr, nullptr, nullptr), &EVP_PKEY_free);
+			SSL_CTX_use_PrivateKey(mContext.data(), privateKey.data());
+
+			const QByteArray cert = pair.getCertificate().toPem();
+			const QSharedPointer<BIO> certBio(BIO_new_mem_buf(cert.constData(), cert.size()), &BIO_free);
+			const QSharedPointer<X509> certificate(PEM_read_bio_X509(certBio.data(), nullptr, nullptr, nullptr), &X509_free);
+			SSL_CTX_use_certificate(mContext.data(), certificate.data());
+
+			connect(&mServer, &QTcpServer::newConnection, this, &ResumingTlsServer::onNewConnection);
+		}
+
+
+		virtual ~ResumingTlsServer() override
+		{
+			for (auto iter = mConnections.constBegin(); iter != mConnections.constEnd(); ++iter)
+			{
+				disconnect(iter.key(), nullptr, this, nullptr);
+				SSL_free(iter.value());
+			}
+		}
+
+
+		bool listen()
+		{
+			return mServer.listen(QHostAddress::LocalHost);
+		}
+
+
+		QUrl getUrl() const
+		{
+			return QUrl(QStringLiteral("https://127.0.0.1:%1/").arg(mServer.serverPort()));
+		}
+
+
+		int getHandshakeCount() const
+		{
+			return mHandshakes;
+		}
+
+
+		int getResumedHandshakeCount() const
+		{
+			return mResumedHandshakes;
+		}
+
+
+};
+
+
 class test_NetworkManager
 	: public QObject
 {
@@ -75,6 +247,49 @@ class test_NetworkManager
 		}
 
 
+		void sessionTicket()
+		{
+			const QByteArray session = QByteArrayLiteral("ticket");
+
+			QNetworkRequest resumed(QUrl("https://dummy"));
+			Env::getSingleton<NetworkManager>()->get(resumed, session, 1);
+			QCOMPARE(resumed.sslConfiguration().sessionTicket(), session);
+
+			QNetworkRequest request(QUrl("https://dummy"));
+			Env::getSingleton<NetworkManager>()->get(request, QByteArray(), 1);
+			QVERIFY(request.sslConfiguration().sessionTicket().isEmpty());
+			QCOMPARE(request.sslConfiguration(), SecureStorage::getInstance().getTlsConfig().getConfiguration());
+		}
+
+
+		void resumeSessionOfOrigin()
+		{
+			ResumingTlsServer server;
+			QVERIFY(server.listen());
+
+			auto* const networkManager = Env::getSingleton<NetworkManager>();
+			for (int i = 0; i < 3; ++i)
+			{
+				QNetworkRequest request(server.getUrl());
+				QNetworkReply* const reply = networkManager->get(request);
+				connect(reply, QOverload<const QList<QSslError>&>::of(&QNetworkReply::sslErrors), reply, [reply] {
+							reply->ignoreSslErrors();
+						});
+
+				QSignalSpy finished(reply, &QNetworkReply::finished);
+				QVERIFY(finished.wait());
+				QCOMPARE(reply->error(), QNetworkReply::NoError);
+				reply->deleteLater();
+
+				// A new connection has to do a handshake
+				networkManager->clearConnections();
+			}
+
+			QCOMPARE(server.getHandshakeCount(), 3);
+			QCOMPARE(server.getResumedHandshakeCount(), 2);
+		}
+
+
 		void serviceUnavailableEnums()
 		{
 			MockNetworkReply reply;
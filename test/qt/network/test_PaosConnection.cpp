@@ -0,0 +1,212 @@
+/*!
+ * \brief Benchmark of the TLS connection of a PAOS conversation of \ref NetworkManager
+ * with a local TLS-PSK server.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "NetworkManager.h"
+
+#include "Env.h"
+#include "KeyPair.h"
+#include "SecureStorage.h"
+
+#include <QElapsedTimer>
+#include <QSslPreSharedKeyAuthenticator>
+#include <QSslSocket>
+#include <QTcpServer>
+#include <QtTest>
+
+using namespace governikus;
+
+
+namespace
+{
+const QByteArray PSK_IDENTITY = QByteArrayLiteral("session");
+const QByteArray PSK = QByteArray::fromHex("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef");
+const QByteArray PAOS_RESPONSE = QByteArrayLiteral("<soap:Envelope/>");
+
+
+class PskServer
+	: public QTcpServer
+{
+	private:
+		const KeyPair mPair;
+		int mHandshakeCount;
+		int mRequestCount;
+
+		void onReadyRead(QSslSocket* pSocket, QByteArray& pBuffer)
+		{
+			pBuffer += pSocket->readAll();
+			for (int headerEnd = pBuffer.indexOf("\r\n\r\n"); headerEnd >= 0; headerEnd = pBuffer.indexOf("\r\n\r\n"))
+			{
+				int contentLength = 0;
+				const auto& lines = pBuffer.left(headerEnd).split('\n');
+				for (const auto& line : lines)
+				{
+					if (line.toLower().startsWith("content-length:"))
+					{
+						contentLength = line.mid(15).trimmed().toInt();
+					}
+				}
+
+				if (pBuffer.size() < headerEnd + 4 + contentLength)
+				{
+					return;
+				}
+				pBuffer.remove(0, headerEnd + 4 + contentLength);
+
+				++mRequestCount;
+				pSocket->write(QByteArrayLiteral("HTTP/1.1 200 OK\r\nContent-Type: application/vnd.paos+xml\r\nContent-Length: ")
+						+ QByteArray::number(PAOS_RESPONSE.size()) + QByteArrayLiteral("\r\n\r\n") + PAOS_RESPONSE);
+			}
+		}
+
+	protected:
+		virtual void incomingConnection(qintptr pSocketDescriptor) override
+		{
+			auto config = SecureStorage::getInstance().getTlsConfig(SecureStorage::TlsSuite::PSK).getConfiguration();
+			config.setPrivateKey(mPair.getKey());
+			config.setLocalCertificate(mPair.getCertificate());
+			config.setPeerVerifyMode(QSslSocket::VerifyNone);
+
+			auto* const socket = new QSslSocket(this);
+			socket->setSslConfiguration(config);
+			connect(socket, &QSslSocket::preSharedKeyAuthenticationRequired, this, [](QSslPreSharedKeyAuthenticator* pAuthenticator){
+						if (pAuthenticator->identity() == PSK_IDENTITY)
+						{
+							pAuthenticator->setPreSharedKey(PSK);
+						}
+					});
+			connect(socket, &QSslSocket::encrypted, this, [this]{
+						++mHandshakeCount;
+					});
+			const auto buffer = QSharedPointer<QByteArray>::create();
+			connect(socket, &QSslSocket::readyRead, this, [this, socket, buffer]{
+						onReadyRead(socket, *buffer);
+					});
+			connect(socket, &QSslSocket::disconnected, socket, &QObject::deleteLater);
+
+			socket->setSocketDescriptor(pSocketDescriptor);
+			socket->startServerEncryption();
+		}
+
+	public:
+		PskServer()
+			: QTcpServer()
+			, mPair(KeyPair::generate())
+			, mHandshakeCount(0)
+			, mRequestCount(0)
+		{
+		}
+
+
+		int getHandshakeCount() const
+		{
+			return mHandshakeCount;
+		}
+
+
+		int getRequestCount() const
+		{
+			return mRequestCount;
+		}
+
+
+};
+
+
+}
+
+
+class test_PaosConnection
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QScopedPointer<PskServer> mServer;
+
+		QByteArray sendPaos(int pIndex)
+		{
+			QNetworkRequest request(QUrl(QStringLiteral("https://127.0.0.1:%1/paos").arg(mServer->serverPort())));
+			request.setRawHeader("requestid", PSK_IDENTITY);
+			const QByteArray data = QByteArrayLiteral("<soap:Envelope>") + QByteArray::number(pIndex) + QByteArrayLiteral("</soap:Envelope>");
+
+			QScopedPointer<QNetworkReply, QScopedPointerDeleteLater> reply(Env::getSingleton<NetworkManager>()->paos(request, "urn:liberty:paos:2006-08", data));
+			connect(reply.data(), &QNetworkReply::sslErrors, reply.data(), [&reply]{
+						// The certificate of the test server is self-signed.
+						reply->ignoreSslErrors();
+					});
+			connect(reply.data(), &QNetworkReply::preSharedKeyAuthenticationRequired, this, [](QSslPreSharedKeyAuthenticator* pAuthenticator){
+						pAuthenticator->setIdentity(PSK_IDENTITY);
+						pAuthenticator->setPreSharedKey(PSK);
+					});
+
+			QSignalSpy finished(reply.data(), &QNetworkReply::finished);
+			if (!reply->isFinished() && !finished.wait(10000))
+			{
+				return QByteArray();
+			}
+			if (reply->error() != QNetworkReply::NoError)
+			{
+				qWarning() << reply->errorString();
+				return QByteArray();
+			}
+			return reply->readAll();
+		}
+
+	private Q_SLOTS:
+		void init()
+		{
+			mServer.reset(new PskServer());
+			QVERIFY(mServer->listen(QHostAddress::LocalHost));
+			Env::getSingleton<NetworkManager>()->clearConnections();
+		}
+
+
+		void cleanup()
+		{
+			Env::getSingleton<NetworkManager>()->clearConnections();
+			mServer.reset();
+		}
+
+
+		void conversation_data()
+		{
+			QTest::addColumn<bool>("reuseConnection");
+			QTest::addColumn<int>("messageCount");
+
+			QTest::newRow("connection per message") << false << 20;
+			QTest::newRow("reused connection") << true << 20;
+		}
+
+
+		void conversation()
+		{
+			QFETCH(bool, reuseConnection);
+			QFETCH(int, messageCount);
+
+			QElapsedTimer timer;
+			timer.start();
+			for (int i = 0; i < messageCount; ++i)
+			{
+				if (!reuseConnection)
+				{
+					Env::getSingleton<NetworkManager>()->clearConnections();
+				}
+
+				QCOMPARE(sendPaos(i), PAOS_RESPONSE);
+			}
+			const qint64 elapsed = timer.nsecsElapsed();
+
+			QCOMPARE(mServer->getRequestCount(), messageCount);
+			QCOMPARE(mServer->getHandshakeCount(), reuseConnection ? 1 : messageCount);
+			QTest::setBenchmarkResult(static_cast<qreal>(elapsed) / messageCount, QTest::WalltimeNanoseconds);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_PaosConnection)
+#include "test_PaosConnection.moc"
@@ -25,7 +25,7 @@ class RemoteWebSocketServerMock
 		QString mServerName;
 		bool mPairing;
 		bool mListening = false, mConnected = false;
-		QSharedPointer<ServerMessageHandler> mEmptyHandler;
+		QVector<QSharedPointer<ServerMessageHandler> > mMessageHandlers;
 
 		bool isListening() const override
 		{
@@ -39,6 +39,12 @@ class RemoteWebSocketServerMock
 		}
 
 
+		bool canAcceptConnection() const override
+		{
+			return mListening && !mConnected;
+		}
+
+
 		void setConnected(bool pConnected)
 		{
 			if (mConnected != pConnected)
@@ -93,9 +99,9 @@ class RemoteWebSocketServerMock
 		}
 
 
-		const QSharedPointer<ServerMessageHandler>& getMessageHandler() const override
+		const QVector<QSharedPointer<ServerMessageHandler> >& getMessageHandlers() const override
 		{
-			return mEmptyHandler;
+			return mMessageHandlers;
 		}
 
 
@@ -33,6 +33,20 @@ class test_RemoteTlsServer
 		QByteArray psk;
 		const KeyPair pair = KeyPair::generate();
 
+
+		QSharedPointer<QSslSocket> createPairedClient(const KeyPair& pPair)
+		{
+			auto config = SecureStorage::getInstance().getTlsConfigRemote().getConfiguration();
+			config.setPrivateKey(pPair.getKey());
+			config.setLocalCertificate(pPair.getCertificate());
+			config.setCaCertificates({AppSettings::getInstance().getRemoteServiceSettings().getCertificate()});
+
+			QSharedPointer<QSslSocket> client(new QSslSocket());
+			client->setSslConfiguration(config);
+			client->ignoreSslErrors({QSslError(QSslError::HostNameMismatch, AppSettings::getInstance().getRemoteServiceSettings().getCertificate())});
+			return client;
+		}
+
 	private Q_SLOTS:
 		void checkFailingConnectionOnDifferentMode_data()
 		{
@@ -219,6 +233,68 @@ class test_RemoteTlsServer
 		}
 
 
+		void refuseClientIfConnectionLimitReached()
+		{
+			QVERIFY(RemoteHelper::checkAndGenerateKey());
+			auto& settings = AppSettings::getInstance().getRemoteServiceSettings();
+			settings.setTrustedCertificates({pair.getCertificate()});
+			QVERIFY(settings.getRemoteInfo(pair.getCertificate()).getLastConnected().isNull());
+
+			bool canAcceptConnection = false;
+			RemoteTlsServer server;
+			server.setAcceptConnection([&canAcceptConnection] {
+						return canAcceptConnection;
+					});
+			QVERIFY(server.listen());
+			QSignalSpy newConnection(&server, &RemoteTlsServer::newConnection);
+
+			const auto refusedClient = createPairedClient(pair);
+			QSignalSpy refusedClientEncrypted(refusedClient.data(), &QSslSocket::encrypted);
+			QSignalSpy refusedClientDisconnected(refusedClient.data(), &QAbstractSocket::disconnected);
+			refusedClient->connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(), server.serverPort());
+			QTRY_COMPARE(refusedClientDisconnected.count(), 1);
+			QCOMPARE(refusedClientEncrypted.count(), 0);
+			QCOMPARE(newConnection.count(), 0);
+			QVERIFY(settings.getRemoteInfo(pair.getCertificate()).getLastConnected().isNull());
+			QCOMPARE(server.getCurrentCertificate(), QSslCertificate());
+
+			canAcceptConnection = true;
+			const auto client = createPairedClient(pair);
+			QSignalSpy clientEncrypted(client.data(), &QSslSocket::encrypted);
+			client->connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(), server.serverPort());
+			QTRY_COMPARE(newConnection.count(), 1);
+			QTRY_COMPARE(clientEncrypted.count(), 1);
+			QVERIFY(!settings.getRemoteInfo(pair.getCertificate()).getLastConnected().isNull());
+			QCOMPARE(server.getCurrentCertificate(), pair.getCertificate());
+		}
+
+
+		void noCurrentCertificateForSeveralClients()
+		{
+			QVERIFY(RemoteHelper::checkAndGenerateKey());
+			const KeyPair otherPair = KeyPair::generate();
+			auto& settings = AppSettings::getInstance().getRemoteServiceSettings();
+			settings.setTrustedCertificates({pair.getCertificate(), otherPair.getCertificate()});
+
+			RemoteTlsServer server;
+			QVERIFY(server.listen());
+			QSignalSpy newConnection(&server, &RemoteTlsServer::newConnection);
+
+			const auto client = createPairedClient(pair);
+			client->connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(), server.serverPort());
+			QTRY_COMPARE(newConnection.count(), 1);
+			QCOMPARE(server.getCurrentCertificate(), pair.getCertificate());
+
+			const auto otherClient = createPairedClient(otherPair);
+			otherClient->connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(), server.serverPort());
+			QTRY_COMPARE(newConnection.count(), 2);
+			QCOMPARE(server.getCurrentCertificate(), QSslCertificate());
+
+			client->disconnectFromHost();
+			QTRY_COMPARE(server.getCurrentCertificate(), otherPair.getCertificate());
+		}
+
+
 		void setPairing()
 		{
 			RemoteTlsServer server;
@@ -262,6 +262,54 @@ class test_RemoteWebSocketServer
 		}
 
 
+		void multipleConnections()
+		{
+			const int maxConnections = 3;
+			const KeyPair pair = KeyPair::generate();
+			auto& settings = Env::getSingleton<AppSettings>()->getRemoteServiceSettings();
+			settings.setTrustedCertificates({pair.getCertificate()});
+			settings.setPinPadMode(false);
+			settings.setMaxConnections(maxConnections);
+			QVERIFY(mServer->listen(QStringLiteral("TestServer")));
+
+			auto config = SecureStorage::getInstance().getTlsConfigRemote().getConfiguration();
+			config.setPrivateKey(pair.getKey());
+			config.setLocalCertificate(pair.getCertificate());
+			config.setCaCertificates({settings.getCertificate()});
+
+			QSignalSpy handlerSpy(mServer.data(), &RemoteWebSocketServer::fireMessageHandlerAdded);
+			QVector<QSharedPointer<QWebSocket> > clients;
+			QVector<QSharedPointer<PskHandler> > pskHandlers;
+			for (int i = 0; i <= maxConnections; ++i)
+			{
+				QSharedPointer<QWebSocket> client(new QWebSocket());
+				client->setSslConfiguration(config);
+				pskHandlers += QSharedPointer<PskHandler>(new PskHandler(client.data()));
+				clients += client;
+
+				QSignalSpy spy(client.data(), i < maxConnections ? &QWebSocket::connected : &QWebSocket::disconnected);
+				client->open(QString("wss://127.0.0.1:").append(QString::number(mServer->getServerPort())));
+				QTRY_COMPARE(spy.count(), 1);
+				QVERIFY(mServer->canAcceptConnection() == (i + 1 < maxConnections));
+			}
+
+			QCOMPARE(handlerSpy.count(), maxConnections);
+			for (int i = 0; i < maxConnections; ++i)
+			{
+				QCOMPARE(clients.at(i)->state(), QAbstractSocket::SocketState::ConnectedState);
+			}
+			QCOMPARE(clients.last()->state(), QAbstractSocket::SocketState::UnconnectedState);
+
+			QSignalSpy connectedSpy(mServer.data(), &RemoteWebSocketServer::fireConnectedChanged);
+			clients.first()->close();
+			QTRY_COMPARE(connectedSpy.count(), 1);
+			QVERIFY(mServer->isConnected());
+			QVERIFY(mServer->canAcceptConnection());
+
+			settings.setMaxConnections(1);
+		}
+
+
 		void isConnected()
 		{
 #if defined(Q_OS_FREEBSD)
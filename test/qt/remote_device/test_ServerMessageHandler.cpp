@@ -7,21 +7,29 @@
 #include "ServerMessageHandler.h"
 
 #include "LogHandler.h"
+#include "messages/GetIfdStatus.h"
 #include "messages/IfdConnectResponse.h"
 #include "messages/IfdError.h"
 #include "messages/IfdEstablishContext.h"
 #include "messages/IfdEstablishContextResponse.h"
 #include "messages/RemoteMessageParser.h"
 #include "MockDataChannel.h"
+#include "MockReaderManagerPlugIn.h"
+#include "ReaderManager.h"
 #include "TestFileHelper.h"
 
+#include <QElapsedTimer>
 #include <QSignalSpy>
+#include <QtPlugin>
 #include <QtTest>
 
 
 using namespace governikus;
 
 
+Q_IMPORT_PLUGIN(MockReaderManagerPlugIn)
+
+
 class test_ServerMessageHandler
 	: public QObject
 {
@@ -110,11 +118,61 @@ class test_ServerMessageHandler
 		}
 
 
+		static void fireReaderEvents(int pRounds, const QStringList& pReaderNames)
+		{
+			auto& readerManager = ReaderManager::getInstance();
+			for (int i = 0; i < pRounds; ++i)
+			{
+				for (const auto& name : pReaderNames)
+				{
+					Q_EMIT readerManager.fireCardInserted(name);
+					Q_EMIT readerManager.fireCardRetryCounterChanged(name);
+					Q_EMIT readerManager.fireCardRemoved(name);
+				}
+			}
+		}
+
+
+		QString establishContext(QSignalSpy& pSendSpy)
+		{
+			IfdEstablishContext establishContext(QStringLiteral("IFDInterface_WebSocket_v0"), DeviceInfo::getName());
+			mDataChannel->onReceived(establishContext.toJson(QString()).toJson());
+
+			const IfdEstablishContextResponse response(RemoteMessage::parseByteArray(pSendSpy.last().at(0).toByteArray()));
+			pSendSpy.clear();
+			return response.getContextHandle();
+		}
+
+
+		static QStringList getSlotNames(const QSignalSpy& pSpy)
+		{
+			QStringList slotNames;
+			for (const auto& arguments : pSpy)
+			{
+				const IfdStatus status(RemoteMessage::parseByteArray(arguments.at(0).toByteArray()));
+				slotNames += status.getSlotName();
+			}
+
+			// Pending IFDStatus messages of several slots are sent in no particular order
+			slotNames.sort();
+			return slotNames;
+		}
+
+
 	private Q_SLOTS:
 		void initTestCase()
 		{
 			LogHandler::getInstance().init();
+			ReaderManager::getInstance().init();
+			ReaderManager::getInstance().getPlugInInfos(); // just to wait until initialization finished
+			MockReaderManagerPlugIn::getInstance().addReader(QStringLiteral("MockReader 0815"));
+			MockReaderManagerPlugIn::getInstance().addReader(QStringLiteral("MockReader 4711"));
+		}
+
 
+		void cleanupTestCase()
+		{
+			ReaderManager::getInstance().shutdown();
 		}
 
 
@@ -222,6 +280,149 @@ class test_ServerMessageHandler
 		}
 
 
+		void coalesceReaderEvents()
+		{
+			QSignalSpy sendSpy(mDataChannel.data(), &MockDataChannel::fireSend);
+			ServerMessageHandlerImpl serverMessageHandler(mDataChannel);
+			establishContext(sendSpy);
+
+			fireReaderEvents(50, {QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 4711")});
+			QCOMPARE(sendSpy.count(), 0);
+
+			QTRY_COMPARE(sendSpy.count(), 2);
+			QCOMPARE(getSlotNames(sendSpy), QStringList({QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 4711")}));
+
+			QTest::qWait(2 * ServerMessageHandlerImpl::STATUS_INTERVAL);
+			QCOMPARE(sendSpy.count(), 2);
+		}
+
+
+		void skipUnchangedStatus()
+		{
+			QSignalSpy sendSpy(mDataChannel.data(), &MockDataChannel::fireSend);
+			ServerMessageHandlerImpl serverMessageHandler(mDataChannel);
+			serverMessageHandler.setStatusInterval(0);
+			establishContext(sendSpy);
+
+			fireReaderEvents(5, {QStringLiteral("MockReader 0815")});
+			QCOMPARE(sendSpy.count(), 1);
+
+			Q_EMIT ReaderManager::getInstance().fireReaderRemoved(QStringLiteral("MockReader 0815"));
+			QCOMPARE(sendSpy.count(), 2);
+			const IfdStatus removed(RemoteMessage::parseByteArray(sendSpy.last().at(0).toByteArray()));
+			QCOMPARE(removed.getSlotName(), QStringLiteral("MockReader 0815"));
+			QVERIFY(!removed.getConnectedReader());
+
+			Q_EMIT ReaderManager::getInstance().fireReaderRemoved(QStringLiteral("MockReader 0815"));
+			QCOMPARE(sendSpy.count(), 2);
+
+			Q_EMIT ReaderManager::getInstance().fireReaderAdded(QStringLiteral("MockReader 0815"));
+			QCOMPARE(sendSpy.count(), 3);
+		}
+
+
+		void getIfdStatusIsAlwaysAnswered()
+		{
+			QSignalSpy sendSpy(mDataChannel.data(), &MockDataChannel::fireSend);
+			ServerMessageHandlerImpl serverMessageHandler(mDataChannel);
+			serverMessageHandler.setStatusInterval(0);
+			const QString contextHandle = establishContext(sendSpy);
+
+			fireReaderEvents(1, {QStringLiteral("MockReader 0815")});
+			QCOMPARE(sendSpy.count(), 1);
+
+			const GetIfdStatus getIfdStatus(QStringLiteral("MockReader 0815"));
+			mDataChannel->onReceived(getIfdStatus.toJson(contextHandle).toJson());
+			QCOMPARE(sendSpy.count(), 2);
+			QCOMPARE(getSlotNames(sendSpy), QStringList({QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 0815")}));
+		}
+
+
+		void cardRemovedAndInsertedWithinStatusInterval()
+		{
+			const QString readerName = QStringLiteral("MockReader flicker");
+			QSignalSpy readerAdded(&ReaderManager::getInstance(), &ReaderManager::fireReaderAdded);
+			MockReader* const reader = MockReaderManagerPlugIn::getInstance().addReader(readerName);
+			reader->setCard(MockCardConfig());
+			QTRY_COMPARE(readerAdded.count(), 1);
+
+			{
+				QSignalSpy sendSpy(mDataChannel.data(), &MockDataChannel::fireSend);
+				ServerMessageHandlerImpl serverMessageHandler(mDataChannel);
+				const QString contextHandle = establishContext(sendSpy);
+
+				const GetIfdStatus getIfdStatus(readerName);
+				mDataChannel->onReceived(getIfdStatus.toJson(contextHandle).toJson());
+				QCOMPARE(sendSpy.count(), 1);
+				QVERIFY(IfdStatus(RemoteMessage::parseByteArray(sendSpy.takeFirst().at(0).toByteArray())).getCardAvailable());
+
+				reader->removeCard();
+				Q_EMIT ReaderManager::getInstance().fireCardRemoved(readerName);
+				QCOMPARE(sendSpy.count(), 1);
+				QVERIFY(!IfdStatus(RemoteMessage::parseByteArray(sendSpy.last().at(0).toByteArray())).getCardAvailable());
+
+				reader->setCard(MockCardConfig());
+				Q_EMIT ReaderManager::getInstance().fireCardInserted(readerName);
+				QCOMPARE(sendSpy.count(), 1);
+
+				QTRY_COMPARE(sendSpy.count(), 2);
+				QVERIFY(IfdStatus(RemoteMessage::parseByteArray(sendSpy.last().at(0).toByteArray())).getCardAvailable());
+				QCOMPARE(getSlotNames(sendSpy), QStringList({readerName, readerName}));
+			}
+
+			MockReaderManagerPlugIn::getInstance().removeReader(readerName);
+		}
+
+
+		void cardRemovedWithoutCardInLastStatus()
+		{
+			QSignalSpy sendSpy(mDataChannel.data(), &MockDataChannel::fireSend);
+			ServerMessageHandlerImpl serverMessageHandler(mDataChannel);
+			establishContext(sendSpy);
+
+			// The client has not seen a card, so the removal is coalesced like any other event
+			Q_EMIT ReaderManager::getInstance().fireCardRemoved(QStringLiteral("MockReader 0815"));
+			Q_EMIT ReaderManager::getInstance().fireCardRemoved(QStringLiteral("MockReader 4711"));
+			QCOMPARE(sendSpy.count(), 0);
+
+			QTRY_COMPARE(sendSpy.count(), 2);
+			QCOMPARE(getSlotNames(sendSpy), QStringList({QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 4711")}));
+		}
+
+
+		void readerStorm_data()
+		{
+			QTest::addColumn<int>("interval");
+
+			QTest::newRow("immediate") << 0;
+			QTest::newRow("coalesced") << ServerMessageHandlerImpl::STATUS_INTERVAL;
+		}
+
+
+		void readerStorm()
+		{
+			QFETCH(int, interval);
+
+			const QStringList readerNames({QStringLiteral("MockReader 0815"), QStringLiteral("MockReader 4711")});
+			const int rounds = 200;
+
+			QSignalSpy sendSpy(mDataChannel.data(), &MockDataChannel::fireSend);
+			ServerMessageHandlerImpl serverMessageHandler(mDataChannel);
+			serverMessageHandler.setStatusInterval(interval);
+			establishContext(sendSpy);
+
+			QElapsedTimer timer;
+			timer.start();
+			fireReaderEvents(rounds, readerNames);
+			const qint64 emitTime = timer.elapsed();
+
+			QTRY_COMPARE(sendSpy.count(), readerNames.size());
+			QTest::qWait(2 * ServerMessageHandlerImpl::STATUS_INTERVAL);
+			QCOMPARE(sendSpy.count(), readerNames.size());
+			QTest::setBenchmarkResult(emitTime, QTest::WalltimeMilliseconds);
+		}
+
+
 };
 
 
@@ -0,0 +1,196 @@
+/*!
+ * \brief Load tests for several \ref ServerMessageHandler serving
+ * different clients and readers at the same time.
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "ServerMessageHandler.h"
+
+#include "Env.h"
+#include "LogHandler.h"
+#include "messages/IfdConnect.h"
+#include "messages/IfdEstablishContext.h"
+#include "messages/IfdTransmit.h"
+#include "MockReaderManagerPlugIn.h"
+#include "ReaderManager.h"
+#include "WebSocketChannel.h"
+#include "WebSocketHelper.h"
+
+#include <QElapsedTimer>
+#include <QtPlugin>
+#include <QtTest>
+#include <QWebSocketServer>
+
+
+using namespace governikus;
+
+
+Q_IMPORT_PLUGIN(MockReaderManagerPlugIn)
+
+
+class test_ServerMessageHandlerLoad
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		QScopedPointer<QWebSocketServer> mServer;
+		QVector<QSharedPointer<ServerMessageHandler> > mHandlers;
+
+		static bool isMessage(const QJsonObject& pObject, const QString& pType)
+		{
+			return pObject.value(QLatin1String("msg")).toString() == pType;
+		}
+
+
+		QString establishContext(WebSocketHelper& pClient)
+		{
+			const IfdEstablishContext establishContext(IfdVersion::Version::v0, QStringLiteral("LoadTest"));
+			pClient.sendMessage(QString::fromUtf8(establishContext.toJson(QString()).toJson()));
+
+			QString contextHandle;
+			pClient.waitForMessage([&contextHandle](const QJsonObject& pObject){
+						if (isMessage(pObject, QStringLiteral("IFDEstablishContextResponse")))
+						{
+							contextHandle = pObject.value(QLatin1String("ContextHandle")).toString();
+							return true;
+						}
+						return false;
+					});
+			return contextHandle;
+		}
+
+
+		QJsonObject connectReader(WebSocketHelper& pClient, const QString& pContextHandle, const QString& pReaderName)
+		{
+			const IfdConnect connect(pReaderName);
+			pClient.sendMessage(QString::fromUtf8(connect.toJson(pContextHandle).toJson()));
+
+			QJsonObject response;
+			pClient.waitForMessage([&response](const QJsonObject& pObject){
+						if (isMessage(pObject, QStringLiteral("IFDConnectResponse")))
+						{
+							response = pObject;
+							return true;
+						}
+						return false;
+					});
+			return response;
+		}
+
+	private Q_SLOTS:
+		void initTestCase()
+		{
+			LogHandler::getInstance().init();
+			ReaderManager::getInstance().init();
+			ReaderManager::getInstance().getPlugInInfos(); // just to wait until initialization finished
+
+			mServer.reset(new QWebSocketServer(QStringLiteral("LoadTest"), QWebSocketServer::NonSecureMode));
+			connect(mServer.data(), &QWebSocketServer::newConnection, this, [this](){
+						while (mServer->hasPendingConnections())
+						{
+							QSharedPointer<QWebSocket> connection(mServer->nextPendingConnection());
+							QSharedPointer<DataChannel> channel(new WebSocketChannel(connection), &QObject::deleteLater);
+							mHandlers += QSharedPointer<ServerMessageHandler>(Env::create<ServerMessageHandler*>(channel));
+						}
+					});
+			QVERIFY(mServer->listen(QHostAddress::LocalHost));
+		}
+
+
+		void cleanupTestCase()
+		{
+			mServer.reset();
+			ReaderManager::getInstance().shutdown();
+		}
+
+
+		void cleanup()
+		{
+			mHandlers.clear();
+			const auto& readerNames = MockReaderManagerPlugIn::getInstance().mReaders.keys();
+			for (const auto& readerName : readerNames)
+			{
+				MockReaderManagerPlugIn::getInstance().removeReader(readerName);
+			}
+		}
+
+
+		void transmitLoops_data()
+		{
+			QTest::addColumn<int>("clientCount");
+			QTest::addColumn<int>("transmitCount");
+
+			QTest::newRow("1 client") << 1 << 200;
+			QTest::newRow("4 clients") << 4 << 200;
+			QTest::newRow("8 clients") << 8 << 200;
+		}
+
+
+		void transmitLoops()
+		{
+			QFETCH(int, clientCount);
+			QFETCH(int, transmitCount);
+
+			const QVector<TransmitConfig> transmits(transmitCount, TransmitConfig(CardReturnCode::OK, QByteArray::fromHex("9000")));
+			QVector<QSharedPointer<WebSocketHelper> > clients;
+			QStringList slotHandles;
+			QStringList contextHandles;
+			for (int i = 0; i < clientCount; ++i)
+			{
+				const QString readerName = QStringLiteral("MockReader %1").arg(i);
+				MockReader* reader = MockReaderManagerPlugIn::getInstance().addReader(readerName);
+				reader->setCard(MockCardConfig(transmits));
+
+				QSharedPointer<WebSocketHelper> client(new WebSocketHelper(mServer->serverPort()));
+				QCOMPARE(client->getState(), QAbstractSocket::SocketState::ConnectedState);
+
+				const QString contextHandle = establishContext(*client);
+				QVERIFY(!contextHandle.isEmpty());
+				QVERIFY(!contextHandles.contains(contextHandle));
+
+				const auto& response = connectReader(*client, contextHandle, readerName);
+				QVERIFY(!response.value(QLatin1String("ResultMajor")).toString().endsWith(QLatin1String("#error")));
+
+				clients += client;
+				contextHandles += contextHandle;
+				slotHandles += response.value(QLatin1String("SlotHandle")).toString();
+			}
+			QTRY_COMPARE(mHandlers.size(), clientCount);
+
+			if (clientCount > 1)
+			{
+				// A reader is owned by the client that connected it first
+				const auto& response = connectReader(*clients.at(1), contextHandles.at(1), QStringLiteral("MockReader 0"));
+				QVERIFY(response.value(QLatin1String("ResultMajor")).toString().endsWith(QLatin1String("#error")));
+			}
+
+			QElapsedTimer timer;
+			timer.start();
+			for (int round = 0; round < transmitCount; ++round)
+			{
+				for (int i = 0; i < clientCount; ++i)
+				{
+					const IfdTransmit transmit(slotHandles.at(i), QByteArray::fromHex("00A4040C"));
+					clients.at(i)->sendMessage(QString::fromUtf8(transmit.toJson(contextHandles.at(i)).toJson()));
+				}
+
+				for (int i = 0; i < clientCount; ++i)
+				{
+					QVERIFY(clients.at(i)->waitForMessage([&](const QJsonObject& pObject){
+								return isMessage(pObject, QStringLiteral("IFDTransmitResponse"))
+									   && pObject.value(QLatin1String("SlotHandle")).toString() == slotHandles.at(i)
+									   && pObject.value(QLatin1String("ResponseAPDUs")).toArray().first().toString() == QLatin1String("9000");
+							}));
+				}
+			}
+
+			QTest::setBenchmarkResult(static_cast<double>(timer.elapsed()) / transmitCount, QTest::WalltimeMilliseconds);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_ServerMessageHandlerLoad)
+#include "test_ServerMessageHandlerLoad.moc"
@@ -0,0 +1,181 @@
+/*!
+ * \brief Unit tests for the delayed persistence of \ref AbstractSettings
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "GeneralSettings.h"
+#include "HistorySettings.h"
+#include "RemoteServiceSettings.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QtTest>
+
+
+using namespace governikus;
+
+
+class test_AbstractSettings
+	: public QObject
+{
+	Q_OBJECT
+
+	private:
+		static QByteArray readStoreFile()
+		{
+			QFile file(AbstractSettings::getStore()->fileName());
+			if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+			{
+				return QByteArray();
+			}
+			return file.readAll();
+		}
+
+
+		// QSettings caches files per process. A copy is read like the next start of the application would do.
+		static QSharedPointer<QSettings> reopenStoreFile(const QString& pName)
+		{
+			const QString copy = AbstractSettings::mTestDir->filePath(pName);
+			QFile::remove(copy);
+			if (!QFile::copy(AbstractSettings::getStore()->fileName(), copy))
+			{
+				return QSharedPointer<QSettings>();
+			}
+			return QSharedPointer<QSettings>(new QSettings(copy, QSettings::IniFormat));
+		}
+
+	private Q_SLOTS:
+		void init()
+		{
+			AbstractSettings::mTestDir.clear();
+		}
+
+
+		void generalSettingsWrittenAfterDelay()
+		{
+			GeneralSettings settings;
+			settings.setAutoUpdateCheck(true);
+			settings.save();
+			AbstractSettings::syncPending();
+
+			settings.setAutoUpdateCheck(false);
+			settings.save();
+
+			// A crash before the timer fires loses the modification
+			const auto store = reopenStoreFile(QStringLiteral("crash.ini"));
+			QVERIFY(store);
+			QCOMPARE(store->value(QStringLiteral("common/autoUpdateCheck")).toBool(), true);
+
+			QTRY_VERIFY_WITH_TIMEOUT(readStoreFile().contains("autoUpdateCheck=false"), 5 * AbstractSettings::SYNC_DELAY);
+		}
+
+
+		void syncPendingWritesAllStores()
+		{
+			GeneralSettings general;
+			HistorySettings history;
+
+			general.setAutoCloseWindowAfterAuthentication(false);
+			general.setAutoUpdateCheck(false);
+			general.save();
+			history.setEnabled(false);
+			history.save();
+			AbstractSettings::syncPending();
+
+			const auto store = reopenStoreFile(QStringLiteral("restart.ini"));
+			QVERIFY(store);
+			QCOMPARE(store->value(QStringLiteral("autoCloseWindow")).toBool(), false);
+			QCOMPARE(store->value(QStringLiteral("common/autoUpdateCheck")).toBool(), false);
+			QCOMPARE(store->value(QStringLiteral("history/enable")).toBool(), false);
+			QCOMPARE(store->value(QStringLiteral("persistentSettingsVersion")).toString(), QCoreApplication::applicationVersion());
+		}
+
+
+		void historySettingsWrittenImmediately()
+		{
+			HistorySettings settings;
+			AbstractSettings::syncPending();
+
+			settings.setEnabled(false);
+			settings.save();
+
+			const auto store = reopenStoreFile(QStringLiteral("history.ini"));
+			QVERIFY(store);
+			QCOMPARE(store->value(QStringLiteral("history/enable")).toBool(), false);
+		}
+
+
+		void remoteServiceSettingsWrittenImmediately()
+		{
+			RemoteServiceSettings settings;
+			AbstractSettings::syncPending();
+
+			settings.setServerName(QStringLiteral("Immediately"));
+			settings.save();
+
+			const auto store = reopenStoreFile(QStringLiteral("immediately.ini"));
+			QVERIFY(store);
+			QCOMPARE(store->value(QStringLiteral("remotereader/serverName")).toString(), QStringLiteral("Immediately"));
+		}
+
+
+		void writtenOnDestruction()
+		{
+			{
+				GeneralSettings settings;
+				AbstractSettings::syncPending();
+
+				settings.setAutoUpdateCheck(false);
+				settings.save();
+			}
+
+			const auto store = reopenStoreFile(QStringLiteral("destroyed.ini"));
+			QVERIFY(store);
+			QCOMPARE(store->value(QStringLiteral("common/autoUpdateCheck")).toBool(), false);
+		}
+
+
+		void manyFlips_data()
+		{
+			QTest::addColumn<bool>("syncEverySave");
+
+			QTest::newRow("sync per save") << true;
+			QTest::newRow("delayed") << false;
+		}
+
+
+		void manyFlips()
+		{
+			QFETCH(bool, syncEverySave);
+
+			const int flips = 500;
+			GeneralSettings settings;
+			AbstractSettings::syncPending();
+			const int syncCount = AbstractSettings::mSyncCount;
+
+			QElapsedTimer timer;
+			timer.start();
+			for (int i = 0; i < flips; ++i)
+			{
+				settings.setAutoCloseWindowAfterAuthentication(i % 2 == 0);
+				settings.save();
+				if (syncEverySave)
+				{
+					AbstractSettings::syncPending();
+				}
+			}
+			AbstractSettings::syncPending();
+			const qint64 elapsed = timer.elapsed();
+
+			const int writes = AbstractSettings::mSyncCount - syncCount;
+			QCOMPARE(writes, syncEverySave ? flips : 1);
+			QVERIFY(readStoreFile().contains("autoCloseWindow=false"));
+			QTest::setBenchmarkResult(elapsed, QTest::WalltimeMilliseconds);
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_AbstractSettings)
+#include "test_AbstractSettings.moc"
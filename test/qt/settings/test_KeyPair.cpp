@@ -76,6 +76,38 @@ class test_KeyPair
 		}
 
 
+		void validEcKey()
+		{
+			const KeyPair pair = KeyPair::generate(KeyPair::Type::EC);
+			QVERIFY(pair.isValid());
+			const auto& key = pair.getKey();
+			QCOMPARE(key.length(), 256);
+			QCOMPARE(key.algorithm(), QSsl::Ec);
+			QCOMPARE(key.type(), QSsl::PrivateKey);
+
+			const auto& cert = pair.getCertificate();
+			QVERIFY(cert.isSelfSigned());
+			QCOMPARE(cert.publicKey().length(), 256);
+			QCOMPARE(cert.publicKey().algorithm(), QSsl::Ec);
+			QVERIFY(TlsChecker::hasValidCertificateKeyLength(cert));
+		}
+
+
+		void fromKey()
+		{
+			const QSslKey key = KeyPair::generateKey();
+			QVERIFY(!key.isNull());
+
+			const KeyPair pair = KeyPair::fromKey(key);
+			QVERIFY(pair.isValid());
+			QCOMPARE(pair.getKey(), key);
+			QCOMPARE(pair.getCertificate().publicKey().algorithm(), QSsl::Rsa);
+			QVERIFY(pair.getCertificate().isSelfSigned());
+
+			QVERIFY(!KeyPair::fromKey(QSslKey()).isValid());
+		}
+
+
 		void multiCertificate()
 		{
 			const KeyPair pair1 = KeyPair::generate();
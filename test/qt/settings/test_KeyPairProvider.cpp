@@ -0,0 +1,116 @@
+/*!
+ * \brief Unit tests for \ref KeyPairProvider
+ *
+ * \copyright Copyright (c) 2018 Governikus GmbH & Co. KG, Germany
+ */
+
+#include "KeyPairProvider.h"
+
+#include <QElapsedTimer>
+#include <QtTest>
+
+using namespace governikus;
+
+Q_DECLARE_METATYPE(KeyPair::Type)
+
+
+class test_KeyPairProvider
+	: public QObject
+{
+	Q_OBJECT
+
+	private Q_SLOTS:
+		void init()
+		{
+			// Drain the pool of a previous test
+			auto& provider = KeyPairProvider::getInstance();
+			if (provider.isPrepared(KeyPair::Type::RSA))
+			{
+				provider.take(KeyPair::Type::RSA);
+			}
+			if (provider.isPrepared(KeyPair::Type::EC))
+			{
+				provider.take(KeyPair::Type::EC);
+			}
+		}
+
+
+		void preparedInBackground_data()
+		{
+			QTest::addColumn<KeyPair::Type>("type");
+
+			QTest::newRow("rsa") << KeyPair::Type::RSA;
+			QTest::newRow("ec") << KeyPair::Type::EC;
+		}
+
+
+		void preparedInBackground()
+		{
+			QFETCH(KeyPair::Type, type);
+			const auto algorithm = type == KeyPair::Type::EC ? QSsl::Ec : QSsl::Rsa;
+
+			auto& provider = KeyPairProvider::getInstance();
+			QVERIFY(!provider.isPrepared(type));
+
+			provider.prepare(type);
+			QTRY_VERIFY_WITH_TIMEOUT(provider.isPrepared(type), 30000);
+
+			QElapsedTimer timer;
+			timer.start();
+			const KeyPair pair = provider.take(type);
+			const qint64 elapsed = timer.elapsed();
+			QVERIFY2(elapsed < 100, qPrintable(QStringLiteral("Prepared key pair taken after %1 ms").arg(elapsed)));
+
+			QVERIFY(pair.isValid());
+			QCOMPARE(pair.getKey().algorithm(), algorithm);
+			QCOMPARE(pair.getCertificate().publicKey().algorithm(), algorithm);
+			QVERIFY(!provider.isPrepared(type));
+		}
+
+
+		void prepareTwice()
+		{
+			auto& provider = KeyPairProvider::getInstance();
+			provider.prepare();
+			provider.prepare();
+			QTRY_VERIFY_WITH_TIMEOUT(provider.isPrepared(), 30000);
+
+			const KeyPair pair1 = provider.take();
+			QVERIFY(pair1.isValid());
+			QVERIFY(!provider.isPrepared());
+
+			const KeyPair pair2 = provider.take();
+			QVERIFY(pair2.isValid());
+			QVERIFY(pair1.getKey() != pair2.getKey());
+		}
+
+
+		void emptyPool()
+		{
+			auto& provider = KeyPairProvider::getInstance();
+			QVERIFY(!provider.isPrepared());
+
+			const KeyPair pair = provider.take();
+
+			QVERIFY(pair.isValid());
+			QCOMPARE(pair.getKey().algorithm(), QSsl::Rsa);
+			QCOMPARE(pair.getKey().length(), 2048);
+			QVERIFY(!provider.isPrepared());
+		}
+
+
+		void takeWhileRunning()
+		{
+			auto& provider = KeyPairProvider::getInstance();
+			provider.prepare();
+
+			const KeyPair pair = provider.take();
+			QVERIFY(pair.isValid());
+			QVERIFY(!provider.isPrepared());
+		}
+
+
+};
+
+QTEST_GUILESS_MAIN(test_KeyPairProvider)
+#include "test_KeyPairProvider.moc"
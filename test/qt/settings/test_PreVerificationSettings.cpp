@@ -117,6 +117,97 @@ class test_PreVerificationSettings
 		}
 
 
+		void testContains()
+		{
+			PreVerificationSettings settings;
+			settings.addLinkCertificate(cvcs.at(0));
+			QVERIFY(settings.containsLinkCertificate(cvcs.at(0)));
+			QVERIFY(!settings.containsLinkCertificate(cvcs.at(1)));
+
+			settings.removeLinkCertificate(cvcs.at(0));
+			QVERIFY(!settings.containsLinkCertificate(cvcs.at(0)));
+		}
+
+
+		void testReload()
+		{
+			{
+				PreVerificationSettings settings;
+				settings.addLinkCertificate(cvcs.at(0));
+				settings.addLinkCertificate(cvcs.at(1));
+				settings.addLinkCertificate(cvcs.at(2));
+				settings.addLinkCertificate(cvcs.at(3));
+				settings.removeLinkCertificate(cvcs.at(1));
+				QCOMPARE(settings.getLinkCertificates(), QByteArrayList({cvcs.at(0), cvcs.at(3), cvcs.at(2)}));
+			}
+
+			PreVerificationSettings settings;
+			QCOMPARE(settings.getLinkCertificates(), QByteArrayList({cvcs.at(0), cvcs.at(3), cvcs.at(2)}));
+			QVERIFY(settings.containsLinkCertificate(cvcs.at(3)));
+			QVERIFY(!settings.containsLinkCertificate(cvcs.at(1)));
+		}
+
+
+		void testDuplicatesRemovedOnLoad()
+		{
+			{
+				PreVerificationSettings settings;
+				settings.updateLinkCertificates({cvcs.at(0), cvcs.at(1), cvcs.at(0)});
+			}
+
+			PreVerificationSettings settings;
+			QCOMPARE(settings.getLinkCertificates(), QByteArrayList({cvcs.at(0), cvcs.at(1)}));
+
+			settings.removeLinkCertificate(cvcs.at(0));
+			QCOMPARE(settings.getLinkCertificates(), QByteArrayList({cvcs.at(1)}));
+			QCOMPARE(settings.mStore->value(QStringLiteral("linkcertificates/size")).toInt(), 1);
+		}
+
+
+		void benchmarkManyCertificates_data()
+		{
+			QTest::addColumn<int>("count");
+
+			QTest::newRow("100") << 100;
+			QTest::newRow("500") << 500;
+		}
+
+
+		void benchmarkManyCertificates()
+		{
+			QFETCH(int, count);
+
+			QByteArrayList certificates;
+			for (int i = 0; i < count; ++i)
+			{
+				certificates += cvcs.at(i % cvcs.size()) + QByteArray::number(i);
+			}
+
+			QBENCHMARK_ONCE {
+				PreVerificationSettings settings;
+				for (const auto& cert : qAsConst(certificates))
+				{
+					settings.addLinkCertificate(cert);
+					settings.addLinkCertificate(cert);
+				}
+				for (int i = 0; i < count; i += 2)
+				{
+					settings.removeLinkCertificate(certificates.at(i));
+				}
+				settings.save();
+
+				QCOMPARE(settings.getLinkCertificates().size(), count / 2);
+			}
+
+			PreVerificationSettings settings;
+			QCOMPARE(settings.getLinkCertificates().size(), count / 2);
+			for (int i = 0; i < count; ++i)
+			{
+				QCOMPARE(settings.containsLinkCertificate(certificates.at(i)), i % 2 == 1);
+			}
+		}
+
+
 		void testEnabled()
 		{
 			PreVerificationSettings settings;
@@ -57,6 +57,17 @@ class test_RemoteServiceSettings
 		}
 
 
+		void testMaxConnections()
+		{
+			RemoteServiceSettings settings;
+			QCOMPARE(settings.getMaxConnections(), 1);
+			settings.setMaxConnections(4);
+			QCOMPARE(settings.getMaxConnections(), 4);
+			settings.setMaxConnections(0);
+			QCOMPARE(settings.getMaxConnections(), 1);
+		}
+
+
 		void testDuplicatedTrustedCertificates()
 		{
 			const KeyPair pair1 = KeyPair::generate();